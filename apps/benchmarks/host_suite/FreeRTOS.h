@@ -0,0 +1,26 @@
+// $Id$
+/*
+ * Minimal FreeRTOS replacement for host builds
+ * Only the functions used by the sequencer and midifile modules are provided.
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+#ifndef _FREERTOS_H
+#define _FREERTOS_H
+
+#include <stdlib.h>
+
+#define pvPortMalloc(size) malloc(size)
+#define vPortFree(ptr)     free(ptr)
+
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+
+#endif /* _FREERTOS_H */
@@ -0,0 +1,1684 @@
+// $Id$
+/*
+ * Host Benchmark Suite
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <seq_bpm.h>
+#include <seq_midi_out.h>
+#include <mid_parser.h>
+#include <diskio.h>
+#include <ff.h>
+#include <file.h>
+#include <sid.h>
+#include <app_lcd.h>
+#include <glcd_font.h>
+
+#include "benchmark.h"
+#include "hal_stub.h"
+#include "sdcard_sim.h"
+#include "glcd_sim.h"
+#include "vgm_sim.h"
+#include "mid_file.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// the demo song is played multiple times to get stable results
+#define MIDIFILE_LOOPS     20
+
+// synthetic sequencer workloads (384 ppqn like MBSEQ V4)
+#define SEQ_PPQN           384
+#define SEQ_STEP_TICKS     (SEQ_PPQN/4)
+#define SEQ_NUM_TRACKS     16
+#define SEQ_NUM_STEPS      64
+#define SEQ_LOOPS          16
+#define SEQ_ECHO_REPEATS   15
+#define SEQ_ECHO_DELAY     (SEQ_PPQN/8)
+
+// max number of ticks to play the remaining events after a workload
+#define SEQ_FINISH_MAX_TICKS 1000000
+
+// receive workloads
+#define RX_NUM_PACKAGES    400000
+#define RX_SYSEX_DUMP_LEN  256
+
+// SysEx search workload (taken from apps/benchmarks/midi_parser)
+#define SEARCH_NUM_ENTRIES 256
+#define SEARCH_LOOPS       10000
+
+// SD Card workloads: number of transferred sectors
+#define SDCARD_NUM_SECTORS 2048
+
+// FILE handle workload: cluster size of the formatted card, max. file size, number of seek+read operations
+#define FILE_CLUSTER_SIZE  1024
+#define FILE_NUM_FILES     3
+#define FILE_MAX_SIZE      (32*1024)
+#define FILE_NUM_OPS       20000
+
+// SID workloads: number of SID_Update() calls, max. number of register transfers per call
+#define SID_NUM_UPDATES    100000
+#define SID_LOG_SIZE       (SID_NUM*SID_REGS_NUM + 1)
+
+// GLCD workloads: number of redrawn screens, knob and meter icons per display
+#define GLCD_NUM_FRAMES    2000
+#define GLCD_NUM_ICONS     4
+
+// OSC workloads: size of the recorded packet stream, number of replays
+#define OSC_STREAM_SIZE    (256*1024)
+#define OSC_LOOPS          20
+
+// VGM scheduler workload: number of random operations, max. number of heads
+#define VGM_NUM_OPS        200000
+#define VGM_NUM_HEADS      64
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+static s32 BENCHMARK_MidiFile(benchmark_result_t *result);
+static s32 BENCHMARK_Tracks(benchmark_result_t *result);
+static s32 BENCHMARK_Echo(benchmark_result_t *result);
+static s32 BENCHMARK_Sustain(benchmark_result_t *result);
+static s32 BENCHMARK_RxCC(benchmark_result_t *result);
+static s32 BENCHMARK_RxSysEx(benchmark_result_t *result);
+static s32 BENCHMARK_SysExSearch(benchmark_result_t *result);
+static s32 BENCHMARK_SDCardRead1(benchmark_result_t *result);
+static s32 BENCHMARK_SDCardRead8(benchmark_result_t *result);
+static s32 BENCHMARK_SDCardWrite1(benchmark_result_t *result);
+static s32 BENCHMARK_SDCardWrite8(benchmark_result_t *result);
+static s32 BENCHMARK_SDCardFatPattern(benchmark_result_t *result);
+static s32 BENCHMARK_FileHandles(benchmark_result_t *result);
+static s32 BENCHMARK_SidCompareAll(benchmark_result_t *result);
+static s32 BENCHMARK_SidDirtyBitmap(benchmark_result_t *result);
+static s32 BENCHMARK_GlcdDirect(benchmark_result_t *result);
+static s32 BENCHMARK_GlcdFrameBuffer(benchmark_result_t *result);
+static s32 BENCHMARK_OscLinear(benchmark_result_t *result);
+static s32 BENCHMARK_OscCompiled(benchmark_result_t *result);
+static s32 BENCHMARK_VgmScheduler(benchmark_result_t *result);
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+static const benchmark_func_t benchmark_table[] = {
+  BENCHMARK_MidiFile,
+  BENCHMARK_Tracks,
+  BENCHMARK_Echo,
+  BENCHMARK_Sustain,
+  BENCHMARK_RxCC,
+  BENCHMARK_RxSysEx,
+  BENCHMARK_SysExSearch,
+  BENCHMARK_SDCardRead1,
+  BENCHMARK_SDCardRead8,
+  BENCHMARK_SDCardWrite1,
+  BENCHMARK_SDCardWrite8,
+  BENCHMARK_SDCardFatPattern,
+  BENCHMARK_FileHandles,
+  BENCHMARK_SidCompareAll,
+  BENCHMARK_SidDirtyBitmap,
+  BENCHMARK_GlcdDirect,
+  BENCHMARK_GlcdFrameBuffer,
+  BENCHMARK_OscLinear,
+  BENCHMARK_OscCompiled,
+  BENCHMARK_VgmScheduler,
+};
+
+#define NUM_BENCHMARKS (sizeof(benchmark_table)/sizeof(benchmark_func_t))
+
+// virtual BPM tick, incremented as fast as possible
+static u32 bpm_tick;
+
+// number of packages which should be sent by the scheduler
+static u32 expected_packages;
+
+// number of packages forwarded by MIOS32_MIDI_Receive_Handler
+static u32 received_packages;
+
+// for deterministic results we use our own random generator
+static u32 random_seed;
+
+static u8 search_storage[SEARCH_NUM_ENTRIES*10];
+static u8 search_string[10];
+
+static u8 sdcard_data[SDCARD_NUM_SECTORS*512];
+static u8 sdcard_buffer[255*512];
+
+// FILE handle workload: content of the files, reference file objects of FatFs
+static FATFS file_mkfs_fs;
+static u8 file_data[FILE_NUM_FILES][FILE_MAX_SIZE];
+static u32 file_size[FILE_NUM_FILES];
+static FIL file_ref[FILE_NUM_FILES];
+static u8 file_buffer[2][3*FILE_CLUSTER_SIZE];
+
+// register transfers of modules/sid (recorded via SID_UPDATE_REG_HOOK) and of the reference model
+static u32 sid_log[SID_LOG_SIZE];
+static u32 sid_log_num;
+static u32 sid_ref_log[SID_LOG_SIZE];
+static u32 sid_ref_log_num;
+
+// registers of the reference model
+static sid_regs_t sid_ref_regs[SID_NUM];
+static sid_regs_t sid_ref_regs_shadow[SID_NUM];
+
+// GLCD workloads: icon numbers, and checksums of the screens rendered by the direct variant
+static u8 glcd_knob[GLCD_SIM_NUM_DISPLAYS][GLCD_NUM_ICONS];
+static u8 glcd_meter[GLCD_SIM_NUM_DISPLAYS][GLCD_NUM_ICONS];
+static u32 glcd_ref_checksum[GLCD_NUM_FRAMES];
+static u32 glcd_ref_num_frames;
+
+// OSC workloads: packet stream (each packet is stored with a 32bit length prefix),
+// and checksum over the method calls of the linear variant
+static u8 osc_stream[OSC_STREAM_SIZE];
+static u32 osc_stream_len;
+static u32 osc_num_calls;
+static u32 osc_checksum;
+static u32 osc_ref_num_calls;
+static u32 osc_ref_checksum;
+
+// if set, the last screen of the GLCD workloads is written into a PGM file
+static u8 frame_dump;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Simple linear congruential random generator
+/////////////////////////////////////////////////////////////////////////////
+static u32 BENCHMARK_Random(u32 range)
+{
+  random_seed = random_seed * 1664525 + 1013904223;
+  return (random_seed >> 8) % range;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Callbacks for the sequencer modules
+/////////////////////////////////////////////////////////////////////////////
+static s32 BENCHMARK_BPM_IsRunning(void)
+{
+  return 1; // always running
+}
+
+static u32 BENCHMARK_BPM_TickGet(void)
+{
+  return bpm_tick;
+}
+
+static s32 BENCHMARK_BPM_Set(float bpm)
+{
+  return 0; // tempo changes are ignored
+}
+
+static void BENCHMARK_NotifyPackage(mios32_midi_port_t port, mios32_midi_package_t midi_package)
+{
+  ++received_packages;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Initialisation
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_Init(u32 mode)
+{
+  HAL_STUB_Init(0);
+  MIOS32_MIDI_Init(0);
+
+  // init MIDI file handler
+  MID_FILE_Init(0);
+
+  // init MIDI parser module
+  MID_PARSER_Init(0);
+
+  // initialize MIDI handler and drive it from the virtual BPM tick
+  SEQ_MIDI_OUT_Init(0);
+  SEQ_MIDI_OUT_Callback_BPM_IsRunning_Set(BENCHMARK_BPM_IsRunning);
+  SEQ_MIDI_OUT_Callback_BPM_TickGet_Set(BENCHMARK_BPM_TickGet);
+  SEQ_MIDI_OUT_Callback_BPM_Set_Set(BENCHMARK_BPM_Set);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Enables the PGM dump of the GLCD workloads
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_FrameDumpSet(u8 enable)
+{
+  frame_dump = enable;
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the number of available benchmarks
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_NumGet(void)
+{
+  return NUM_BENCHMARKS;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Runs the given benchmark
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_Run(u32 num, benchmark_result_t *result)
+{
+  if( num >= NUM_BENCHMARKS )
+    return -1; // invalid benchmark
+
+  memset(result, 0, sizeof(benchmark_result_t));
+  random_seed = 42;
+
+  return benchmark_table[num](result);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Help functions for the scheduler benchmarks
+/////////////////////////////////////////////////////////////////////////////
+static void BENCHMARK_SeqReset(void)
+{
+  SEQ_MIDI_OUT_FlushQueue();
+  SEQ_MIDI_OUT_FreeHeap();
+
+  seq_midi_out_allocated = 0;
+  seq_midi_out_max_allocated = 0;
+  seq_midi_out_dropouts = 0;
+
+  HAL_STUB_TxCounterReset();
+  expected_packages = 0;
+  bpm_tick = 0;
+}
+
+static s32 BENCHMARK_SeqSend(mios32_midi_port_t port, mios32_midi_package_t p, seq_midi_out_event_type_t event_type, u32 timestamp, u32 len)
+{
+  s32 status = SEQ_MIDI_OUT_Send(port, p, event_type, timestamp, len);
+
+  if( status >= 0 ) {
+    if( event_type == SEQ_MIDI_OUT_OnOffEvent && len )
+      expected_packages += 2;
+    else if( event_type != SEQ_MIDI_OUT_TempoEvent )
+      ++expected_packages;
+  }
+
+  return status;
+}
+
+// processes the current tick and measures the handler time
+static void BENCHMARK_SeqTick(benchmark_result_t *result, unsigned long long start_ns)
+{
+  SEQ_MIDI_OUT_Handler();
+
+  unsigned long long delta = HAL_STUB_TimeNsGet() - start_ns;
+  result->time_ns += delta;
+  if( delta > result->max_call_ns )
+    result->max_call_ns = delta;
+}
+
+// plays all remaining events and takes over the results
+static void BENCHMARK_SeqFinish(benchmark_result_t *result, u32 expected_sent_packages)
+{
+  u32 finish_tick = bpm_tick + SEQ_FINISH_MAX_TICKS;
+  while( seq_midi_out_allocated ) {
+    if( ++bpm_tick >= finish_tick ) {
+      // events are stuck in the queue
+      result->failed = 1;
+      SEQ_MIDI_OUT_FlushQueue();
+      break;
+    }
+    BENCHMARK_SeqTick(result, HAL_STUB_TimeNsGet());
+  }
+
+  result->num_events = HAL_STUB_TxCounterGet();
+  result->high_water = seq_midi_out_max_allocated;
+  result->dropouts = seq_midi_out_dropouts;
+
+  if( result->num_events != expected_sent_packages )
+    result->failed = 1;
+}
+
+static mios32_midi_package_t BENCHMARK_NotePackage(u8 chn, u8 note, u8 velocity, u8 tag)
+{
+  mios32_midi_package_t p;
+
+  p.ALL = 0;
+  p.type = NoteOn;
+  p.event = NoteOn;
+  p.chn = chn;
+  p.note = note;
+  p.velocity = velocity;
+  p.cable = tag;
+
+  return p;
+}
+
+static mios32_midi_package_t BENCHMARK_CCPackage(u8 chn, u8 cc, u8 value, u8 tag)
+{
+  mios32_midi_package_t p;
+
+  p.ALL = 0;
+  p.type = CC;
+  p.event = CC;
+  p.chn = chn;
+  p.cc_number = cc;
+  p.value = value;
+  p.cable = tag;
+
+  return p;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Plays the demo song of apps/benchmarks/seq_scheduler
+/////////////////////////////////////////////////////////////////////////////
+static s32 BENCHMARK_MidiFile_PlayEvent(u8 track, mios32_midi_package_t midi_package, u32 tick)
+{
+  seq_midi_out_event_type_t event_type = SEQ_MIDI_OUT_OnEvent;
+  if( midi_package.event == NoteOff || (midi_package.event == NoteOn && midi_package.velocity == 0) )
+    event_type = SEQ_MIDI_OUT_OffEvent;
+  else if( midi_package.event != NoteOn )
+    event_type = SEQ_MIDI_OUT_CCEvent;
+
+  BENCHMARK_SeqSend(USB0, midi_package, event_type, tick, 0);
+
+  return 0; // no error
+}
+
+static s32 BENCHMARK_MidiFile_PlayMeta(u8 track, u8 meta, u32 len, u8 *buffer, u32 tick)
+{
+  return 0; // no error
+}
+
+static s32 BENCHMARK_MidiFile(benchmark_result_t *result)
+{
+  result->name = "midifile demo song";
+
+  MID_PARSER_InstallFileCallbacks(&MID_FILE_read, &MID_FILE_eof, &MID_FILE_seek);
+  MID_PARSER_InstallEventCallbacks(&BENCHMARK_MidiFile_PlayEvent, &BENCHMARK_MidiFile_PlayMeta);
+
+  BENCHMARK_SeqReset();
+
+  int loop;
+  for(loop=0; loop<MIDIFILE_LOOPS; ++loop) {
+    MID_FILE_open("dummy");
+    MID_PARSER_Read();
+
+    u32 tick_offset = bpm_tick;
+    while( 1 ) {
+      unsigned long long start_ns = HAL_STUB_TimeNsGet();
+      s32 status = MID_PARSER_FetchEvents(bpm_tick - tick_offset, 1);
+      BENCHMARK_SeqTick(result, start_ns);
+      if( status <= 0 )
+	break;
+      ++bpm_tick;
+    }
+  }
+
+  BENCHMARK_SeqFinish(result, expected_packages);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// 16 tracks x 64 steps with chords, CCs, humanized timestamps and long gates
+/////////////////////////////////////////////////////////////////////////////
+static s32 BENCHMARK_Tracks(benchmark_result_t *result)
+{
+  result->name = "16 tracks x 64 steps";
+
+  BENCHMARK_SeqReset();
+
+  u32 end_tick = SEQ_LOOPS * SEQ_NUM_STEPS * SEQ_STEP_TICKS;
+  for(bpm_tick=0; bpm_tick<end_tick; ++bpm_tick) {
+    unsigned long long start_ns = HAL_STUB_TimeNsGet();
+
+    // MIDI clock at 24 ppqn
+    if( (bpm_tick % (SEQ_PPQN/24)) == 0 ) {
+      mios32_midi_package_t p;
+      p.ALL = 0;
+      p.type = 0x5;
+      p.evnt0 = 0xf8;
+      BENCHMARK_SeqSend(UART0, p, SEQ_MIDI_OUT_ClkEvent, bpm_tick, 0);
+    }
+
+    if( (bpm_tick % SEQ_STEP_TICKS) == 0 ) {
+      u8 track;
+      for(track=0; track<SEQ_NUM_TRACKS; ++track) {
+	mios32_midi_port_t port = USB0 + (track & 3);
+	u32 humanize = BENCHMARK_Random(SEQ_STEP_TICKS/4);
+
+	if( BENCHMARK_Random(2) )
+	  BENCHMARK_SeqSend(port, BENCHMARK_CCPackage(track, 74, BENCHMARK_Random(128), track), SEQ_MIDI_OUT_CCEvent, bpm_tick + humanize, 0);
+
+	if( BENCHMARK_Random(4) ) {
+	  u8 num_notes = 1 + (track & 3);
+	  u32 gate = SEQ_STEP_TICKS/2 + BENCHMARK_Random(8*SEQ_STEP_TICKS);
+	  u8 note;
+	  for(note=0; note<num_notes; ++note) {
+	    mios32_midi_package_t p = BENCHMARK_NotePackage(track, 36 + BENCHMARK_Random(60), 1 + BENCHMARK_Random(127), track);
+	    BENCHMARK_SeqSend(port, p, SEQ_MIDI_OUT_OnOffEvent, bpm_tick + humanize, gate);
+	  }
+	}
+      }
+    }
+
+    BENCHMARK_SeqTick(result, start_ns);
+  }
+
+  BENCHMARK_SeqFinish(result, expected_packages);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// 16 tracks with heavy echo: each note is repeated 15 times
+/////////////////////////////////////////////////////////////////////////////
+static s32 BENCHMARK_Echo(benchmark_result_t *result)
+{
+  result->name = "16 tracks heavy echo";
+
+  BENCHMARK_SeqReset();
+
+  u32 end_tick = SEQ_LOOPS * SEQ_NUM_STEPS * SEQ_STEP_TICKS;
+  for(bpm_tick=0; bpm_tick<end_tick; ++bpm_tick) {
+    unsigned long long start_ns = HAL_STUB_TimeNsGet();
+
+    if( (bpm_tick % SEQ_STEP_TICKS) == 0 ) {
+      u8 track;
+      for(track=0; track<SEQ_NUM_TRACKS; ++track) {
+	if( BENCHMARK_Random(4) ) {
+	  mios32_midi_port_t port = USB0 + (track & 3);
+	  u8 note = 36 + BENCHMARK_Random(60);
+	  u8 velocity = 127;
+	  u32 gate = SEQ_STEP_TICKS/2 + BENCHMARK_Random(SEQ_STEP_TICKS);
+
+	  u8 repeat;
+	  for(repeat=0; repeat<=SEQ_ECHO_REPEATS; ++repeat) {
+	    mios32_midi_package_t p = BENCHMARK_NotePackage(track, note, velocity, track);
+	    BENCHMARK_SeqSend(port, p, SEQ_MIDI_OUT_OnOffEvent, bpm_tick + repeat*SEQ_ECHO_DELAY, gate);
+	    velocity = (velocity > 8) ? (velocity - 8) : 1;
+	  }
+	}
+      }
+    }
+
+    BENCHMARK_SeqTick(result, start_ns);
+  }
+
+  BENCHMARK_SeqFinish(result, expected_packages);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Sustained notes: Off events are queued at 0xffffffff and re-scheduled
+// at the next step like MBSEQ does for sustained tracks
+/////////////////////////////////////////////////////////////////////////////
+static s32 BENCHMARK_Sustain(benchmark_result_t *result)
+{
+  result->name = "16 tracks sustain+reschedule";
+
+  BENCHMARK_SeqReset();
+
+  u32 end_tick = SEQ_LOOPS * SEQ_NUM_STEPS * SEQ_STEP_TICKS;
+  for(bpm_tick=0; bpm_tick<end_tick; ++bpm_tick) {
+    unsigned long long start_ns = HAL_STUB_TimeNsGet();
+
+    if( (bpm_tick % SEQ_STEP_TICKS) == 0 ) {
+      u8 track;
+      for(track=0; track<SEQ_NUM_TRACKS; ++track) {
+	mios32_midi_port_t port = USB0 + (track & 3);
+
+	// play off events of previous step
+	SEQ_MIDI_OUT_ReSchedule(track, SEQ_MIDI_OUT_OffEvent, bpm_tick ? (bpm_tick-1) : 0, NULL);
+
+	u8 note;
+	for(note=0; note<4; ++note) {
+	  mios32_midi_package_t p = BENCHMARK_NotePackage(track, 36 + BENCHMARK_Random(60), 100, track);
+	  BENCHMARK_SeqSend(port, p, SEQ_MIDI_OUT_OnEvent, bpm_tick, 0);
+	  p.velocity = 0;
+	  BENCHMARK_SeqSend(port, p, SEQ_MIDI_OUT_OffEvent, 0xffffffff, 0);
+	}
+      }
+    }
+
+    BENCHMARK_SeqTick(result, start_ns);
+  }
+
+  // release remaining sustained notes
+  while( seq_midi_out_allocated ) {
+    unsigned long long start_ns = HAL_STUB_TimeNsGet();
+
+    u8 track;
+    for(track=0; track<SEQ_NUM_TRACKS; ++track)
+      SEQ_MIDI_OUT_ReSchedule(track, SEQ_MIDI_OUT_OffEvent, bpm_tick, NULL);
+
+    BENCHMARK_SeqTick(result, start_ns);
+    ++bpm_tick;
+  }
+
+  BENCHMARK_SeqFinish(result, expected_packages);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Help function for the receive benchmarks: the package generator fills the
+// buffers of all UARTs, and MIOS32_MIDI_Receive_Handler drains them
+/////////////////////////////////////////////////////////////////////////////
+static void BENCHMARK_RxDrain(benchmark_result_t *result)
+{
+  u8 uart;
+  u8 pending;
+  do {
+    unsigned long long start_ns = HAL_STUB_TimeNsGet();
+    MIOS32_MIDI_Receive_Handler(BENCHMARK_NotifyPackage);
+    unsigned long long delta = HAL_STUB_TimeNsGet() - start_ns;
+
+    result->time_ns += delta;
+    if( delta > result->max_call_ns )
+      result->max_call_ns = delta;
+
+    pending = 0;
+    for(uart=0; uart<MIOS32_UART_NUM; ++uart) {
+      u32 queued = HAL_STUB_RX_BUFFER_SIZE - HAL_STUB_RxBufferFree(uart);
+      if( queued > result->high_water )
+	result->high_water = queued;
+      if( queued )
+	pending = 1;
+    }
+  } while( pending );
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Dense CC streams on all UARTs
+/////////////////////////////////////////////////////////////////////////////
+static s32 BENCHMARK_RxCC(benchmark_result_t *result)
+{
+  result->name = "rx CC flood (4 UARTs)";
+
+  received_packages = 0;
+
+  u32 sent = 0;
+  while( sent < RX_NUM_PACKAGES ) {
+    u8 uart;
+    for(uart=0; uart<MIOS32_UART_NUM; ++uart) {
+      while( sent < RX_NUM_PACKAGES && HAL_STUB_RxBufferFree(uart) > 0 ) {
+	HAL_STUB_RxPackagePut(uart, BENCHMARK_CCPackage(sent & 0xf, (sent >> 4) & 0x7f, sent & 0x7f, 0));
+	++sent;
+      }
+    }
+
+    BENCHMARK_RxDrain(result);
+  }
+
+  result->num_events = received_packages;
+  if( received_packages != sent )
+    result->failed = 1;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// SysEx dumps on all UARTs, UART0 additionally sends a MIOS32 query after
+// each dump which has to be answered
+/////////////////////////////////////////////////////////////////////////////
+static const u8 sysex_query[] = { 0xf0, 0x00, 0x00, 0x7e, 0x32, 0x00, 0x00, 0x01, 0xf7 };
+
+static u8 BENCHMARK_RxSysExByte(u8 uart, u32 *pos)
+{
+  u32 stream_len = RX_SYSEX_DUMP_LEN + ((uart == 0) ? sizeof(sysex_query) : 0);
+  u32 p = (*pos)++;
+  if( *pos >= stream_len )
+    *pos = 0;
+
+  if( p == 0 )
+    return 0xf0;
+  if( p < (RX_SYSEX_DUMP_LEN-1) )
+    return (p == 1) ? 0x43 : (p & 0x7f);
+  if( p == (RX_SYSEX_DUMP_LEN-1) )
+    return 0xf7;
+  return sysex_query[p - RX_SYSEX_DUMP_LEN];
+}
+
+static s32 BENCHMARK_RxSysEx(benchmark_result_t *result)
+{
+  result->name = "rx SysEx flood (4 UARTs)";
+
+  received_packages = 0;
+  HAL_STUB_TxCounterReset();
+
+  u32 stream_pos[MIOS32_UART_NUM];
+  memset(stream_pos, 0, sizeof(stream_pos));
+
+  u32 sent = 0;
+  while( sent < RX_NUM_PACKAGES ) {
+    u8 uart;
+    for(uart=0; uart<MIOS32_UART_NUM; ++uart) {
+      while( sent < RX_NUM_PACKAGES && HAL_STUB_RxBufferFree(uart) > 0 ) {
+	mios32_midi_package_t p;
+	u8 bytes[3];
+	u8 num_bytes = 0;
+	u8 b;
+
+	do {
+	  b = BENCHMARK_RxSysExByte(uart, &stream_pos[uart]);
+	  bytes[num_bytes++] = b;
+	} while( num_bytes < 3 && b != 0xf7 );
+
+	p.ALL = 0;
+	p.type = (b == 0xf7) ? (0x4 + num_bytes) : 0x4; // 5..7: SysEx ends with 1..3 bytes
+	p.evnt0 = bytes[0];
+	p.evnt1 = (num_bytes >= 2) ? bytes[1] : 0x00;
+	p.evnt2 = (num_bytes >= 3) ? bytes[2] : 0x00;
+
+	HAL_STUB_RxPackagePut(uart, p);
+	++sent;
+      }
+    }
+
+    BENCHMARK_RxDrain(result);
+  }
+
+  result->num_events = sent;
+
+  // the MIOS32 queries have to be answered
+  if( !HAL_STUB_TxCounterGet() )
+    result->failed = 1;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Linear SysEx string search (same algorithm like apps/benchmarks/midi_parser)
+/////////////////////////////////////////////////////////////////////////////
+static s32 BENCHMARK_SysExSearch(benchmark_result_t *result)
+{
+  result->name = "SysEx linear search";
+
+  int i;
+  for(i=0; i<SEARCH_NUM_ENTRIES; ++i) {
+    u8 *entry = (u8 *)&search_storage[i*10];
+    entry[0] = 0xf0;
+    entry[1] = 0x01;
+    entry[2] = 0x02;
+    entry[3] = 0x03;
+    entry[4] = 0x04;
+    entry[5] = 0x05;
+    entry[6] = 0x06;
+    entry[7] = i & 0x7f;
+    entry[8] = i >> 7;
+    entry[9] = 0xff;
+  }
+
+  int n = SEARCH_NUM_ENTRIES-1;
+  memcpy(search_string, &search_storage[n*10], 10);
+
+  int loop;
+  for(loop=0; loop<SEARCH_LOOPS; ++loop) {
+    unsigned long long start_ns = HAL_STUB_TimeNsGet();
+
+    s32 found = -1;
+    for(i=0; i<SEARCH_NUM_ENTRIES; ++i) {
+      volatile u8 *s1 = (u8 *)&search_storage[i*10];
+      volatile u8 *s2 = (u8 *)&search_string[0];
+
+      while( *s1 == *s2 && *s1 != 0xff && *s2 != 0xff ) {
+	++s1;
+	++s2;
+      }
+
+      if( *s1 == *s2 ) {
+	found = i;
+	break;
+      }
+    }
+
+    unsigned long long delta = HAL_STUB_TimeNsGet() - start_ns;
+    result->time_ns += delta;
+    if( delta > result->max_call_ns )
+      result->max_call_ns = delta;
+
+    if( found != n )
+      result->failed = 1;
+  }
+
+  result->num_events = SEARCH_LOOPS;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// SD Card workloads: sectors are transferred through the FatFs disk layer
+// and MIOS32_SDCARD to the simulated card.
+// The time is the modelled SPI transfer time (see sdcard_sim.h), and not
+// the processing time of the host.
+/////////////////////////////////////////////////////////////////////////////
+static s32 BENCHMARK_SDCardConnect(benchmark_result_t *result)
+{
+  SDCARD_SIM_Init(0);
+  MIOS32_SDCARD_Init(0);
+
+  if( MIOS32_SDCARD_CheckAvailable(0) < 1 || disk_initialize(0) != 0 ) {
+    result->failed = 1;
+    return -1; // card not detected
+  }
+
+  int i;
+  for(i=0; i<sizeof(sdcard_data); ++i)
+    sdcard_data[i] = BENCHMARK_Random(256);
+
+  return 0; // no error
+}
+
+static s32 BENCHMARK_SDCardRead(benchmark_result_t *result, u8 num_sectors)
+{
+  if( BENCHMARK_SDCardConnect(result) < 0 )
+    return -1; // card not detected
+
+  memcpy(SDCARD_SIM_ImageGet(), sdcard_data, sizeof(sdcard_data));
+
+  unsigned long long start_ns = SDCARD_SIM_TimeNsGet();
+  u32 sector;
+  for(sector=0; sector<SDCARD_NUM_SECTORS; sector+=num_sectors) {
+    unsigned long long call_ns = SDCARD_SIM_TimeNsGet();
+
+    if( disk_read(0, sdcard_buffer, sector, num_sectors) != RES_OK )
+      result->failed = 1;
+
+    unsigned long long delta = SDCARD_SIM_TimeNsGet() - call_ns;
+    if( delta > result->max_call_ns )
+      result->max_call_ns = delta;
+
+    if( memcmp(sdcard_buffer, &sdcard_data[sector*512], num_sectors*512) != 0 )
+      result->failed = 1;
+  }
+
+  result->time_ns = SDCARD_SIM_TimeNsGet() - start_ns;
+  result->num_events = SDCARD_NUM_SECTORS;
+
+  if( SDCARD_SIM_ErrorsGet() )
+    result->failed = 1;
+
+  return 0; // no error
+}
+
+static s32 BENCHMARK_SDCardWrite(benchmark_result_t *result, u8 num_sectors)
+{
+  if( BENCHMARK_SDCardConnect(result) < 0 )
+    return -1; // card not detected
+
+  unsigned long long start_ns = SDCARD_SIM_TimeNsGet();
+  u32 sector;
+  for(sector=0; sector<SDCARD_NUM_SECTORS; sector+=num_sectors) {
+    unsigned long long call_ns = SDCARD_SIM_TimeNsGet();
+
+    if( disk_write(0, &sdcard_data[sector*512], sector, num_sectors) != RES_OK )
+      result->failed = 1;
+
+    unsigned long long delta = SDCARD_SIM_TimeNsGet() - call_ns;
+    if( delta > result->max_call_ns )
+      result->max_call_ns = delta;
+  }
+
+  // write back the cached sectors (like f_sync/f_close)
+  if( disk_ioctl(0, CTRL_SYNC, NULL) != RES_OK )
+    result->failed = 1;
+
+  result->time_ns = SDCARD_SIM_TimeNsGet() - start_ns;
+  result->num_events = SDCARD_NUM_SECTORS;
+
+  if( SDCARD_SIM_ErrorsGet() || memcmp(SDCARD_SIM_ImageGet(), sdcard_data, sizeof(sdcard_data)) != 0 )
+    result->failed = 1;
+
+  return 0; // no error
+}
+
+static s32 BENCHMARK_SDCardRead1(benchmark_result_t *result)
+{
+  result->name = "SD Card read 1 sector/call";
+  return BENCHMARK_SDCardRead(result, 1);
+}
+
+static s32 BENCHMARK_SDCardRead8(benchmark_result_t *result)
+{
+  result->name = "SD Card read 8 sectors/call";
+  return BENCHMARK_SDCardRead(result, 8);
+}
+
+static s32 BENCHMARK_SDCardWrite1(benchmark_result_t *result)
+{
+  result->name = "SD Card write 1 sector/call";
+  return BENCHMARK_SDCardWrite(result, 1);
+}
+
+static s32 BENCHMARK_SDCardWrite8(benchmark_result_t *result)
+{
+  result->name = "SD Card write 8 sectors/call";
+  return BENCHMARK_SDCardWrite(result, 8);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Access pattern of FatFs while a file is read sector by sector through its
+// window: the FAT sector is re-read whenever the next cluster is followed
+// (4 sectors per cluster) and the directory sector is re-read before each
+// 16 sectors, like FILE_ReadReOpen for each pattern of a bank
+/////////////////////////////////////////////////////////////////////////////
+static s32 BENCHMARK_SDCardFatPattern(benchmark_result_t *result)
+{
+  result->name = "SD Card FAT+dir+data pattern";
+
+  if( BENCHMARK_SDCardConnect(result) < 0 )
+    return -1; // card not detected
+
+  memcpy(SDCARD_SIM_ImageGet(), sdcard_data, sizeof(sdcard_data));
+
+  const u32 dir_sector = 16;
+  const u32 fat_sector = 32;
+  const u32 first_data_sector = 64;
+
+  unsigned long long start_ns = SDCARD_SIM_TimeNsGet();
+  u32 sector;
+  for(sector=first_data_sector; sector<SDCARD_NUM_SECTORS; ++sector) {
+    unsigned long long call_ns = SDCARD_SIM_TimeNsGet();
+    u32 offset = sector - first_data_sector;
+
+    if( (offset % 16) == 0 ) {
+      if( disk_read(0, sdcard_buffer, dir_sector, 1) != RES_OK ||
+	  memcmp(sdcard_buffer, &sdcard_data[dir_sector*512], 512) != 0 )
+	result->failed = 1;
+      ++result->num_events;
+    }
+
+    if( (offset % 4) == 0 ) {
+      u32 fat = fat_sector + offset / (4*128);
+      if( disk_read(0, sdcard_buffer, fat, 1) != RES_OK ||
+	  memcmp(sdcard_buffer, &sdcard_data[fat*512], 512) != 0 )
+	result->failed = 1;
+      ++result->num_events;
+    }
+
+    if( disk_read(0, sdcard_buffer, sector, 1) != RES_OK ||
+	memcmp(sdcard_buffer, &sdcard_data[sector*512], 512) != 0 )
+      result->failed = 1;
+    ++result->num_events;
+
+    unsigned long long delta = SDCARD_SIM_TimeNsGet() - call_ns;
+    if( delta > result->max_call_ns )
+      result->max_call_ns = delta;
+  }
+
+  result->time_ns = SDCARD_SIM_TimeNsGet() - start_ns;
+
+  if( SDCARD_SIM_ErrorsGet() )
+    result->failed = 1;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// FILE handle workload: the card is formatted, and files are written with
+// interleaved clusters, so that they are fragmented:
+//   CONT.BIN: contiguous (1 fragment)
+//   FRAG.BIN: 6 fragments (cluster map of the handle)
+//   MANY.BIN: 24 fragments, more than FILE_HANDLE_MAX_FRAGMENTS (FatFs follows the FAT chain)
+//   GAP.BIN:  the clusters between the fragments
+// The files are opened with FILE_HandleOpen() and with f_open(). Random seeks
+// (cluster and sector boundaries, end of file and beyond) and reads are
+// executed on both, the positions and the read data have to be identical,
+// and have to match the written content.
+// The time is the modelled SPI transfer time of the FILE_Handle* calls.
+/////////////////////////////////////////////////////////////////////////////
+static s32 BENCHMARK_FileWrite(FIL *fp, u8 f, u32 len)
+{
+  UINT bw;
+
+  if( f_write(fp, &file_data[f][file_size[f]], len, &bw) != FR_OK || bw != len )
+    return -1; // write error
+
+  file_size[f] += len;
+
+  return 0; // no error
+}
+
+static s32 BENCHMARK_FileHandles(benchmark_result_t *result)
+{
+  static char *file_name[FILE_NUM_FILES] = { "CONT.BIN", "FRAG.BIN", "MANY.BIN" };
+  static const char *dir_order[4] = { "CONT.BIN", "FRAG.BIN", "GAP.BIN", "MANY.BIN" };
+  s32 handle[FILE_NUM_FILES];
+  FIL fil[3];
+  int i;
+
+  result->name = "FILE handles seek+read";
+
+  if( BENCHMARK_SDCardConnect(result) < 0 )
+    return -1; // card not detected
+
+  for(i=0; i<FILE_NUM_FILES; ++i) {
+    file_size[i] = 0;
+    int j;
+    for(j=0; j<FILE_MAX_SIZE; ++j)
+      file_data[i][j] = BENCHMARK_Random(256);
+  }
+
+  // format the card and write the files
+  if( f_mount(0, &file_mkfs_fs) != FR_OK || f_mkfs(0, 0, FILE_CLUSTER_SIZE) != FR_OK ) {
+    result->failed = 1;
+    return -1; // format failed
+  }
+
+  u8 write_error = 0;
+  if( f_open(&fil[0], "CONT.BIN", FA_CREATE_ALWAYS | FA_WRITE) != FR_OK ||
+      BENCHMARK_FileWrite(&fil[0], 0, 20*FILE_CLUSTER_SIZE + 300) < 0 ||
+      f_close(&fil[0]) != FR_OK )
+    write_error = 1;
+
+  if( f_open(&fil[0], "FRAG.BIN", FA_CREATE_ALWAYS | FA_WRITE) != FR_OK ||
+      f_open(&fil[1], "MANY.BIN", FA_CREATE_ALWAYS | FA_WRITE) != FR_OK ||
+      f_open(&fil[2], "GAP.BIN", FA_CREATE_ALWAYS | FA_WRITE) != FR_OK )
+    write_error = 1;
+
+  for(i=0; i<24 && !write_error; ++i) {
+    UINT bw;
+    if( (i < 6 && BENCHMARK_FileWrite(&fil[0], 1, 3*FILE_CLUSTER_SIZE + ((i == 5) ? 517 : 0)) < 0) ||
+	BENCHMARK_FileWrite(&fil[1], 2, FILE_CLUSTER_SIZE + ((i == 23) ? 100 : 0)) < 0 ||
+	f_write(&fil[2], sdcard_buffer, FILE_CLUSTER_SIZE, &bw) != FR_OK )
+      write_error = 1;
+  }
+
+  for(i=0; i<3; ++i)
+    if( f_close(&fil[i]) != FR_OK )
+      write_error = 1;
+
+  // mount the card via the FILE module, and open the files twice
+  FILE_Init(0);
+  if( write_error || FILE_CheckSDCard() != 1 ) {
+    result->failed = 1;
+    return -1; // card not accessible
+  }
+
+  for(i=0; i<FILE_NUM_FILES; ++i) {
+    handle[i] = FILE_HandleOpen(file_name[i]);
+    if( handle[i] < 0 || FILE_HandleGetSize(handle[i]) != file_size[i] ||
+	f_open(&file_ref[i], file_name[i], FA_OPEN_EXISTING | FA_READ) != FR_OK ) {
+      result->failed = 1;
+      return -1; // open failed
+    }
+  }
+
+  // the directory cache has to list the files sorted by name
+  file_dir_entry_t *entries;
+  if( FILE_DirCacheGet("/", &entries) != 4 )
+    result->failed = 1;
+  else {
+    for(i=0; i<4; ++i)
+      if( strcmp(entries[i].fname, dir_order[i]) != 0 )
+	result->failed = 1;
+  }
+
+  u32 op;
+  for(op=0; op<FILE_NUM_OPS; ++op) {
+    u8 f = BENCHMARK_Random(FILE_NUM_FILES);
+    u32 size = file_size[f];
+    FIL *ref = &file_ref[f];
+    unsigned long long call_ns;
+    unsigned long long delta;
+
+    // 3 of 4 reads are preceded by a seek, otherwise the file is read sequentially
+    if( BENCHMARK_Random(4) ) {
+      u32 offset;
+      switch( BENCHMARK_Random(5) ) {
+      case 0: offset = BENCHMARK_Random(size+1); break;
+      case 1: offset = BENCHMARK_Random(size/FILE_CLUSTER_SIZE + 1) * FILE_CLUSTER_SIZE; break;
+      case 2: offset = BENCHMARK_Random(size/512 + 1) * 512 + BENCHMARK_Random(3); if( offset ) --offset; break;
+      case 3: offset = size + BENCHMARK_Random(1000); break;
+      default: offset = 0;
+      }
+
+      call_ns = SDCARD_SIM_TimeNsGet();
+      s32 status = FILE_HandleSeek(handle[f], offset);
+      delta = SDCARD_SIM_TimeNsGet() - call_ns;
+      result->time_ns += delta;
+      if( delta > result->max_call_ns )
+	result->max_call_ns = delta;
+      ++result->num_events;
+
+      FRESULT res = f_lseek(ref, offset);
+      if( (status < 0) != (res != FR_OK) || FILE_HandleGetPosition(handle[f]) != ref->fptr )
+	result->failed = 1;
+    }
+
+    u32 pos = ref->fptr;
+    u32 len = BENCHMARK_Random(sizeof(file_buffer[0]));
+
+    call_ns = SDCARD_SIM_TimeNsGet();
+    s32 count = FILE_HandleReadBufferUnknownLen(handle[f], file_buffer[0], len);
+    delta = SDCARD_SIM_TimeNsGet() - call_ns;
+    result->time_ns += delta;
+    if( delta > result->max_call_ns )
+      result->max_call_ns = delta;
+    ++result->num_events;
+
+    UINT ref_count;
+    if( f_read(ref, file_buffer[1], len, &ref_count) != FR_OK ||
+	count != ref_count ||
+	FILE_HandleGetPosition(handle[f]) != ref->fptr ||
+	memcmp(file_buffer[0], file_buffer[1], ref_count) != 0 ||
+	memcmp(file_buffer[0], &file_data[f][pos], ref_count) != 0 )
+      result->failed = 1;
+  }
+
+  for(i=0; i<FILE_NUM_FILES; ++i)
+    FILE_HandleClose(handle[i]);
+
+  if( SDCARD_SIM_ErrorsGet() )
+    result->failed = 1;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// SID workloads: a register trace is replayed into modules/sid, the register
+// transfers are recorded via SID_UPDATE_REG_HOOK (see mios32_config.h).
+// The reference model is the original SID_Update() loop, which compares
+// all registers of all SIDs in the original update order. It gets the same
+// trace, and the dirty bitmap variant has to transfer exactly the same
+// register sequence.
+/////////////////////////////////////////////////////////////////////////////
+// log entry: 16bit CS mask, 5bit address, 8bit data, reset flag
+#define SID_LOG_ENTRY(cs, addr, data, reset) (((u32)(cs) << 16) | ((u32)((addr) & 0x1f) << 9) | ((u32)(data) << 1) | ((reset) ? 1 : 0))
+
+void BENCHMARK_SidUpdateRegHook(u16 cs, u8 addr, u8 data, u8 reset)
+{
+  if( sid_log_num < SID_LOG_SIZE )
+    sid_log[sid_log_num++] = SID_LOG_ENTRY(cs, addr, data, reset);
+}
+
+static void BENCHMARK_SidRefUpdateReg(u16 cs, u8 addr, u8 data, u8 reset)
+{
+  if( sid_ref_log_num < SID_LOG_SIZE )
+    sid_ref_log[sid_ref_log_num++] = SID_LOG_ENTRY(cs, addr, data, reset);
+}
+
+static void BENCHMARK_SidRefUpdate(u32 mode)
+{
+  static const u8 update_order[SID_REGS_NUM] = {
+     0,  1,  2,  3,  5,  6, // voice 1 w/o osc control register
+     7,  8,  9, 10, 12, 13, // voice 2 w/o osc control register
+    14, 15, 16, 17, 19, 20, // voice 3 w/o osc control register
+     4, 11, 18,             // voice 1/2/3 control registers
+    21, 22, 23, 24,         // remaining SID registers
+    25, 26, 27, 28, 29, 30, 31 // SwinSID registers
+  };
+  int sid, reg, i;
+
+  if( mode >= 1 ) {
+    for(sid=0; sid<SID_NUM; ++sid)
+      for(reg=0; reg<SID_REGS_NUM; ++reg)
+	sid_ref_regs_shadow[sid].ALL[reg] = ~sid_ref_regs[sid].ALL[reg];
+  }
+
+  for(sid=0; sid<SID_NUM; sid+=2) {
+    u8 *sidl = sid_ref_regs[sid+0].ALL;
+    u8 *sidl_shadow = sid_ref_regs_shadow[sid+0].ALL;
+    u8 *sidr = sid_ref_regs[sid+1].ALL;
+    u8 *sidr_shadow = sid_ref_regs_shadow[sid+1].ALL;
+    u16 cs_both = (3 << (2*sid));
+    u16 cs_l_only = (1 << (2*sid));
+    u16 cs_r_only = (2 << (2*sid));
+
+    for(i=0; i<SID_REGS_NUM; ++i) {
+      u8 data;
+      reg = update_order[i];
+
+      if( (data=sidl[reg]) != sidl_shadow[reg] ) {
+	if( data == sidr[reg] ) {
+	  BENCHMARK_SidRefUpdateReg(cs_both, reg, data, 0);
+	  sidl_shadow[reg] = data;
+	  sidr_shadow[reg] = data;
+	} else {
+	  BENCHMARK_SidRefUpdateReg(cs_l_only, reg, data, 0);
+	  sidl_shadow[reg] = data;
+
+	  if( (data=sidr[reg]) != sidr_shadow[reg] ) {
+	    BENCHMARK_SidRefUpdateReg(cs_r_only, reg, data, 0);
+	    sidr_shadow[reg] = data;
+	  }
+	}
+      } else if( (data=sidr[reg]) != sidr_shadow[reg] ) {
+	BENCHMARK_SidRefUpdateReg(cs_r_only, reg, data, 0);
+	sidr_shadow[reg] = data;
+      }
+    }
+  }
+}
+
+// writes a register into modules/sid and into the reference model
+static void BENCHMARK_SidRegSet(u8 sid, u8 reg, u8 value)
+{
+  SID_RegSet(sid, reg, value);
+  sid_ref_regs[sid].ALL[reg] = value;
+}
+
+// generates the register changes before the next update
+// returns the SID_Update() mode
+static u32 BENCHMARK_SidTraceStep(void)
+{
+  u32 r = BENCHMARK_Random(100);
+
+  if( r < 60 ) { // a few register changes, sometimes with identical values for both SIDs of a pair
+    int n = 1 + BENCHMARK_Random(3);
+    while( n-- ) {
+      u8 sid = BENCHMARK_Random(SID_NUM);
+      u8 reg = BENCHMARK_Random(SID_REGS_NUM);
+      u8 value = BENCHMARK_Random(256);
+      BENCHMARK_SidRegSet(sid, reg, value);
+      if( BENCHMARK_Random(4) == 0 )
+	BENCHMARK_SidRegSet(sid ^ 1, reg, value);
+    }
+  } else if( r < 70 ) { // value is changed and restored before the update
+    u8 sid = BENCHMARK_Random(SID_NUM);
+    u8 reg = BENCHMARK_Random(SID_REGS_NUM);
+    u8 value = sid_regs[sid].ALL[reg];
+    BENCHMARK_SidRegSet(sid, reg, value ^ (1 + BENCHMARK_Random(255)));
+    BENCHMARK_SidRegSet(sid, reg, value);
+  } else if( r < 80 ) { // voice of a SID pair is changed via the register structure
+    u8 sid = BENCHMARK_Random(SID_NUM) & ~1;
+    u8 voice = BENCHMARK_Random(3);
+    int i;
+    for(i=0; i<7; ++i) {
+      u8 value = BENCHMARK_Random(256);
+      sid_regs[sid+0].v[voice][i] = value;
+      sid_regs[sid+1].v[voice][i] = value;
+      sid_ref_regs[sid+0].v[voice][i] = value;
+      sid_ref_regs[sid+1].v[voice][i] = value;
+    }
+    SID_RegDirtySet(sid+0, SID_REGS_MASK_VOICE(voice));
+    SID_RegDirtySet(sid+1, SID_REGS_MASK_VOICE(voice));
+  } else if( r >= 95 ) {
+    return 1; // forced update of all registers
+  }
+
+  return 0; // only changes
+}
+
+static s32 BENCHMARK_Sid(benchmark_result_t *result, u8 reference)
+{
+  SID_Init(0);
+  memset(sid_ref_regs, 0, sizeof(sid_ref_regs));
+  memset(sid_ref_regs_shadow, 0, sizeof(sid_ref_regs_shadow));
+
+  u32 update;
+  for(update=0; update<SID_NUM_UPDATES; ++update) {
+    u32 mode = BENCHMARK_SidTraceStep();
+
+    sid_log_num = 0;
+    sid_ref_log_num = 0;
+    unsigned long long start_ns = HAL_STUB_TimeNsGet();
+
+    if( reference )
+      BENCHMARK_SidRefUpdate(mode);
+    else
+      SID_Update(mode);
+
+    unsigned long long delta = HAL_STUB_TimeNsGet() - start_ns;
+    result->time_ns += delta;
+    if( delta > result->max_call_ns )
+      result->max_call_ns = delta;
+
+    if( !reference ) {
+      BENCHMARK_SidRefUpdate(mode);
+
+      if( sid_log_num != sid_ref_log_num || memcmp(sid_log, sid_ref_log, sid_log_num*sizeof(u32)) != 0 )
+	result->failed = 1;
+    }
+  }
+
+  result->num_events = SID_NUM_UPDATES;
+
+  return 0; // no error
+}
+
+static s32 BENCHMARK_SidCompareAll(benchmark_result_t *result)
+{
+  result->name = "SID update compare all";
+  return BENCHMARK_Sid(result, 1);
+}
+
+static s32 BENCHMARK_SidDirtyBitmap(benchmark_result_t *result)
+{
+  result->name = "SID update dirty bitmap";
+  return BENCHMARK_Sid(result, 0);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// GLCD workloads
+/////////////////////////////////////////////////////////////////////////////
+
+// checksum over the display RAM of all simulated displays
+static u32 BENCHMARK_GlcdChecksum(void)
+{
+  u32 checksum = 2166136261U; // FNV-1a
+  int num, i;
+  for(num=0; num<GLCD_SIM_NUM_DISPLAYS; ++num) {
+    u8 *ram = GLCD_SIM_RamGet(num);
+    for(i=0; i<GLCD_SIM_PAGES*GLCD_SIM_WIDTH; ++i) {
+      checksum ^= ram[i];
+      checksum *= 16777619U;
+    }
+  }
+
+  return checksum;
+}
+
+// redraws the screens like a display task of a controller application:
+// 4 knobs (28x24) with labels, 4 horizontal meters (28x8) with values
+static void BENCHMARK_GlcdRedraw(void)
+{
+  int num, i;
+  for(num=0; num<GLCD_SIM_NUM_DISPLAYS; ++num) {
+    MIOS32_LCD_DeviceSet(num);
+
+    MIOS32_LCD_FontInit((u8 *)GLCD_FONT_KNOB_ICONS);
+    for(i=0; i<GLCD_NUM_ICONS; ++i) {
+      MIOS32_LCD_GCursorSet(i*32, 0);
+      MIOS32_LCD_PrintChar(glcd_knob[num][i]);
+    }
+
+    MIOS32_LCD_FontInit((u8 *)GLCD_FONT_NORMAL);
+    MIOS32_LCD_CursorSet(0, 3);
+    MIOS32_LCD_PrintFormattedString(" Cut  Res  Env  Dec%d", num+1);
+
+    MIOS32_LCD_FontInit((u8 *)GLCD_FONT_METER_ICONS_H);
+    for(i=0; i<GLCD_NUM_ICONS; ++i) {
+      MIOS32_LCD_GCursorSet(i*32, 5*8);
+      MIOS32_LCD_PrintChar(glcd_meter[num][i]);
+    }
+
+    MIOS32_LCD_FontInit((u8 *)GLCD_FONT_NORMAL);
+    MIOS32_LCD_CursorSet(0, 7);
+    for(i=0; i<GLCD_NUM_ICONS; ++i)
+      MIOS32_LCD_PrintFormattedString("%3d  ", glcd_meter[num][i]*10);
+  }
+}
+
+static s32 BENCHMARK_Glcd(benchmark_result_t *result, u8 framebuffer)
+{
+  // two SSD1306 displays at J15, accessed like MIDIbox NG does it
+  mios32_lcd_parameters_t lcd_parameters = {
+    .lcd_type = MIOS32_LCD_TYPE_GLCD_SSD1306,
+    .num_x = GLCD_SIM_NUM_DISPLAYS,
+    .num_y = 1,
+    .width = GLCD_SIM_WIDTH,
+    .height = GLCD_SIM_PAGES*8,
+    .colour_depth = 1,
+  };
+  MIOS32_LCD_ParametersSet(lcd_parameters);
+
+  GLCD_SIM_Init(0);
+  APP_LCD_FrameBufferEnable(framebuffer);
+
+  int num;
+  for(num=0; num<GLCD_SIM_NUM_DISPLAYS; ++num) {
+    MIOS32_LCD_DeviceSet(num);
+    APP_LCD_Init(0);
+  }
+  MIOS32_LCD_DeviceSet(0);
+  MIOS32_LCD_Clear();
+
+  memset(glcd_knob, 0, sizeof(glcd_knob));
+  memset(glcd_meter, 0, sizeof(glcd_meter));
+
+  unsigned long long start_bus_ns = GLCD_SIM_TimeNsGet();
+
+  u32 frame;
+  for(frame=0; frame<GLCD_NUM_FRAMES; ++frame) {
+    // knobs are turned rarely, meters change with each frame
+    for(num=0; num<GLCD_SIM_NUM_DISPLAYS; ++num) {
+      int i;
+      for(i=0; i<GLCD_NUM_ICONS; ++i) {
+	if( BENCHMARK_Random(8) == 0 )
+	  glcd_knob[num][i] = BENCHMARK_Random(12);
+	if( BENCHMARK_Random(2) == 0 )
+	  glcd_meter[num][i] = BENCHMARK_Random(14);
+      }
+    }
+
+    unsigned long long frame_start_ns = GLCD_SIM_TimeNsGet();
+
+    BENCHMARK_GlcdRedraw();
+    if( framebuffer )
+      APP_LCD_FrameBufferFlush(0);
+
+    unsigned long long delta = GLCD_SIM_TimeNsGet() - frame_start_ns;
+    if( delta > result->max_call_ns )
+      result->max_call_ns = delta;
+
+    // the screens have to be identical in both variants
+    u32 checksum = BENCHMARK_GlcdChecksum();
+    if( !framebuffer ) {
+      glcd_ref_checksum[frame] = checksum;
+    } else if( glcd_ref_num_frames != GLCD_NUM_FRAMES || glcd_ref_checksum[frame] != checksum ) {
+      result->failed = 1;
+    }
+  }
+
+  if( !framebuffer )
+    glcd_ref_num_frames = GLCD_NUM_FRAMES;
+
+  result->time_ns = GLCD_SIM_TimeNsGet() - start_bus_ns;
+  result->num_events = GLCD_NUM_FRAMES;
+
+  if( frame_dump )
+    GLCD_SIM_PgmWrite(framebuffer ? "glcd_framebuffer.pgm" : "glcd_direct.pgm");
+
+  // following workloads shouldn't be affected
+  APP_LCD_FrameBufferEnable(1);
+
+  return 0; // no error
+}
+
+static s32 BENCHMARK_GlcdDirect(benchmark_result_t *result)
+{
+  result->name = "GLCD direct";
+  return BENCHMARK_Glcd(result, 0);
+}
+
+static s32 BENCHMARK_GlcdFrameBuffer(benchmark_result_t *result)
+{
+  result->name = "GLCD framebuffer";
+  return BENCHMARK_Glcd(result, 1);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// OSC workloads
+/////////////////////////////////////////////////////////////////////////////
+
+// all methods of the control surface: the call is added to the checksum
+static s32 BENCHMARK_OscMethod(mios32_osc_args_t *osc_args, u32 method_arg)
+{
+  u32 value = (osc_args->num_args >= 1) ? MIOS32_OSC_GetWord(osc_args->arg_ptr[0]) : 0;
+
+  u32 words[3] = { method_arg, osc_args->num_path_parts, value };
+  int i;
+  for(i=0; i<3; ++i) {
+    osc_checksum ^= words[i];
+    osc_checksum *= 16777619U;
+  }
+  ++osc_num_calls;
+
+  return 0; // no error
+}
+
+// search tree of a TouchOSC like layout: 4 pages with 16 faders, rotaries, toggles, pushes and a multifader
+// method_arg: [19:16] page, [15:8] control type, [7:0] control number
+#define OSC_NODES16(name, next, type) \
+  { name "1",  next, BENCHMARK_OscMethod, ((type) << 8) | 1 }, \
+  { name "2",  next, BENCHMARK_OscMethod, ((type) << 8) | 2 }, \
+  { name "3",  next, BENCHMARK_OscMethod, ((type) << 8) | 3 }, \
+  { name "4",  next, BENCHMARK_OscMethod, ((type) << 8) | 4 }, \
+  { name "5",  next, BENCHMARK_OscMethod, ((type) << 8) | 5 }, \
+  { name "6",  next, BENCHMARK_OscMethod, ((type) << 8) | 6 }, \
+  { name "7",  next, BENCHMARK_OscMethod, ((type) << 8) | 7 }, \
+  { name "8",  next, BENCHMARK_OscMethod, ((type) << 8) | 8 }, \
+  { name "9",  next, BENCHMARK_OscMethod, ((type) << 8) | 9 }, \
+  { name "10", next, BENCHMARK_OscMethod, ((type) << 8) | 10 }, \
+  { name "11", next, BENCHMARK_OscMethod, ((type) << 8) | 11 }, \
+  { name "12", next, BENCHMARK_OscMethod, ((type) << 8) | 12 }, \
+  { name "13", next, BENCHMARK_OscMethod, ((type) << 8) | 13 }, \
+  { name "14", next, BENCHMARK_OscMethod, ((type) << 8) | 14 }, \
+  { name "15", next, BENCHMARK_OscMethod, ((type) << 8) | 15 }, \
+  { name "16", next, BENCHMARK_OscMethod, ((type) << 8) | 16 }
+
+static const mios32_osc_search_tree_t osc_multifader[] = {
+  OSC_NODES16("", NULL, 5),
+  { NULL, NULL, NULL, 0 } // terminator
+};
+
+static const mios32_osc_search_tree_t osc_page[] = {
+  OSC_NODES16("fader", NULL, 1),
+  OSC_NODES16("rotary", NULL, 2),
+  OSC_NODES16("toggle", NULL, 3),
+  OSC_NODES16("push", NULL, 4),
+  { "multifader1", osc_multifader, NULL, 0x00000000 },
+  { "xy1",         NULL, BENCHMARK_OscMethod, 0x00000600 },
+  { NULL, NULL, NULL, 0 } // terminator
+};
+
+static const mios32_osc_search_tree_t osc_root[] = {
+  { "1",    osc_page, NULL, 0x00010000 },
+  { "2",    osc_page, NULL, 0x00020000 },
+  { "3",    osc_page, NULL, 0x00030000 },
+  { "4",    osc_page, NULL, 0x00040000 },
+  { "ping", NULL, BENCHMARK_OscMethod, 0x00000000 },
+  { NULL, NULL, NULL, 0 } // terminator
+};
+
+// appends a message with a random control change to the packet
+static u8 *BENCHMARK_OscPutMessage(u8 *end_ptr)
+{
+  static const char *controls[] = { "fader", "rotary", "toggle", "push" };
+  char path[40];
+  u32 page = 1 + BENCHMARK_Random(4);
+  u32 kind = BENCHMARK_Random(100);
+
+  if( kind < 80 ) {
+    // moving a control
+    sprintf(path, "/%u/%s%u", (unsigned)page, controls[BENCHMARK_Random(4)], (unsigned)(1 + BENCHMARK_Random(16)));
+  } else if( kind < 90 ) {
+    sprintf(path, "/%u/multifader1/%u", (unsigned)page, (unsigned)(1 + BENCHMARK_Random(16)));
+  } else if( kind < 95 ) {
+    sprintf(path, "/%u/xy1", (unsigned)page);
+  } else if( kind < 98 ) {
+    // e.g. reset of all toggles
+    sprintf(path, "/%u/toggle*", (unsigned)page);
+  } else {
+    // address which isn't part of the layout
+    sprintf(path, "/%u/label%u", (unsigned)page, (unsigned)BENCHMARK_Random(16));
+  }
+
+  end_ptr = MIOS32_OSC_PutString(end_ptr, path);
+  end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
+  end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)BENCHMARK_Random(1000) / 1000.0);
+
+  return end_ptr;
+}
+
+// records the packet stream of a control surface: single messages and bundles
+static u32 BENCHMARK_OscRecordStream(void)
+{
+  u32 num_messages = 0;
+  osc_stream_len = 0;
+
+  // max. packet size: 8 messages with 44 bytes + bundle header
+  while( (osc_stream_len + 4 + 8*(4+44) + 16) <= OSC_STREAM_SIZE ) {
+    u8 *packet = &osc_stream[osc_stream_len + 4];
+    u8 *end_ptr = packet;
+
+    if( BENCHMARK_Random(4) == 0 ) {
+      mios32_osc_timetag_t timetag = { 0, 1 };
+      end_ptr = MIOS32_OSC_PutString(end_ptr, "#bundle");
+      end_ptr = MIOS32_OSC_PutTimetag(end_ptr, timetag);
+
+      u32 num_elements = 2 + BENCHMARK_Random(7);
+      u32 element;
+      for(element=0; element<num_elements; ++element) {
+	u8 *insert_len_ptr = end_ptr;
+	end_ptr = BENCHMARK_OscPutMessage(end_ptr + 4);
+	MIOS32_OSC_PutWord(insert_len_ptr, (u32)(end_ptr-insert_len_ptr-4));
+      }
+      num_messages += num_elements;
+    } else {
+      end_ptr = BENCHMARK_OscPutMessage(end_ptr);
+      ++num_messages;
+    }
+
+    MIOS32_OSC_PutWord(&osc_stream[osc_stream_len], (u32)(end_ptr-packet));
+    osc_stream_len = (u32)(end_ptr - osc_stream);
+  }
+
+  return num_messages;
+}
+
+static s32 BENCHMARK_Osc(benchmark_result_t *result, u8 compiled)
+{
+  u32 num_messages = BENCHMARK_OscRecordStream();
+
+  MIOS32_OSC_Init(0);
+  if( compiled && MIOS32_OSC_DispatchCompile(osc_root) < 0 )
+    result->failed = 1;
+
+  osc_num_calls = 0;
+  osc_checksum = 2166136261U; // FNV-1a
+
+  u32 loop;
+  for(loop=0; loop<OSC_LOOPS; ++loop) {
+    u32 pos = 0;
+    while( pos < osc_stream_len ) {
+      u32 len = MIOS32_OSC_GetWord(&osc_stream[pos]);
+      pos += 4;
+
+      unsigned long long start_ns = HAL_STUB_TimeNsGet();
+      if( MIOS32_OSC_ParsePacket(&osc_stream[pos], len, osc_root) < 0 )
+	result->failed = 1;
+      unsigned long long delta = HAL_STUB_TimeNsGet() - start_ns;
+
+      result->time_ns += delta;
+      if( delta > result->max_call_ns )
+	result->max_call_ns = delta;
+
+      pos += len;
+    }
+  }
+
+  // both variants have to call the same methods with the same arguments
+  if( !compiled ) {
+    osc_ref_num_calls = osc_num_calls;
+    osc_ref_checksum = osc_checksum;
+  } else if( osc_num_calls != osc_ref_num_calls || osc_checksum != osc_ref_checksum ) {
+    result->failed = 1;
+  }
+
+  result->num_events = num_messages * OSC_LOOPS;
+
+  MIOS32_OSC_DispatchClear();
+
+  return 0; // no error
+}
+
+static s32 BENCHMARK_OscLinear(benchmark_result_t *result)
+{
+  result->name = "OSC linear search";
+  return BENCHMARK_Osc(result, 0);
+}
+
+static s32 BENCHMARK_OscCompiled(benchmark_result_t *result)
+{
+  result->name = "OSC compiled dispatch";
+  return BENCHMARK_Osc(result, 1);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// VGM scheduler workload: heads are created, deleted, restarted and stopped
+// at random between the runs of the player interrupt (see vgm_sim.c).
+// The heap, chip queue and pending list of the player are checked after
+// each operation, and the scheduler state of the remaining heads has to be
+// unchanged after a head has been deleted and vgm_heads[] renumbered.
+// The interrupt mostly comes after the delay which was requested by the
+// player (with some latency), sometimes earlier.
+/////////////////////////////////////////////////////////////////////////////
+static s32 BENCHMARK_VgmScheduler(benchmark_result_t *result)
+{
+  u32 delay = 0;
+  u32 op;
+
+  result->name = "VGM scheduler random ops";
+
+  VGM_SIM_Init(BENCHMARK_Random(0x10000));
+
+  for(op=0; op<VGM_NUM_OPS; ++op) {
+    u32 num_heads = VGM_SIM_NumHeadsGet();
+    s32 status = 0;
+
+    switch( BENCHMARK_Random(16) ) {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+      // the number of heads moves around VGM_NUM_HEADS/2
+      if( BENCHMARK_Random(VGM_NUM_HEADS) >= num_heads )
+	status = VGM_SIM_HeadCreate();
+      else
+	status = VGM_SIM_HeadDelete(BENCHMARK_Random(num_heads));
+      break;
+
+    case 4:
+      if( num_heads )
+	status = VGM_SIM_HeadRestart(BENCHMARK_Random(num_heads));
+      break;
+
+    case 5:
+      if( num_heads )
+	status = VGM_SIM_HeadStop(BENCHMARK_Random(num_heads));
+      break;
+
+    default: {
+      u32 hr_ticks = BENCHMARK_Random(8) ? (delay + BENCHMARK_Random(200)) : BENCHMARK_Random(delay + 1);
+      unsigned long long start_ns = HAL_STUB_TimeNsGet();
+      delay = VGM_SIM_Work(hr_ticks);
+      unsigned long long delta = HAL_STUB_TimeNsGet() - start_ns;
+      result->time_ns += delta;
+      if( delta > result->max_call_ns )
+	result->max_call_ns = delta;
+      ++result->num_events;
+    }
+    }
+
+    // stop at the first error, the player could loop endless on corrupted queues
+    if( status < 0 || VGM_SIM_Check() < 0 ) {
+      result->failed = 1;
+      break;
+    }
+
+    if( VGM_SIM_NumHeadsGet() > result->high_water )
+      result->high_water = VGM_SIM_NumHeadsGet();
+  }
+
+  // the heads have to be played
+  if( VGM_SIM_NumChipWritesGet() == 0 )
+    result->failed = 1;
+
+  return 0; // no error
+}
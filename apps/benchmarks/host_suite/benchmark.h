@@ -0,0 +1,58 @@
+// $Id$
+/*
+ * Header file for the host benchmark suite
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+#ifndef _BENCHMARK_H
+#define _BENCHMARK_H
+
+/////////////////////////////////////////////////////////////////////////////
+// Global definitions
+/////////////////////////////////////////////////////////////////////////////
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Global Types
+/////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  const char *name;
+  u32 num_events;                // number of sent or received MIDI packages
+  unsigned long long time_ns;    // overall processing time
+  unsigned long long max_call_ns;// max time of a single handler invocation (latency)
+  u32 high_water;                // max number of queued events
+  u32 dropouts;                  // events which couldn't be queued
+  u8  failed;                    // != 0 if the workload didn't deliver the expected packages
+} benchmark_result_t;
+
+typedef s32 (*benchmark_func_t)(benchmark_result_t *result);
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+extern s32 BENCHMARK_Init(u32 mode);
+
+extern s32 BENCHMARK_FrameDumpSet(u8 enable);
+
+extern s32 BENCHMARK_NumGet(void);
+extern s32 BENCHMARK_Run(u32 num, benchmark_result_t *result);
+
+extern void BENCHMARK_SidUpdateRegHook(u16 cs, u8 addr, u8 data, u8 reset);
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Export global variables
+/////////////////////////////////////////////////////////////////////////////
+
+
+#endif /* _BENCHMARK_H */
@@ -0,0 +1,210 @@
+// $Id$
+/*
+ * Simulated serial GLCDs for the host benchmark suite
+ *
+ * Provides the MIOS32_BOARD_J15 functions which are used by the universal
+ * APP_LCD driver (modules/app_lcd/universal) and decodes the transfers like
+ * SSD1306 displays which are connected to J15 in serial mode:
+ *   - the CS lines are taken from the J15 data port (low-active)
+ *   - RS selects between command (0) and data (1)
+ *   - page addressing mode: column and page commands are decoded, other
+ *     commands (and their arguments) are ignored
+ *   - the transfer time is derived from the number of port accesses, it
+ *     doesn't depend on the host CPU, see glcd_sim.h
+ *
+ * The display RAM can be written into a PGM file, so that the screens can
+ * be checked with an image viewer.
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "glcd_sim.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  u8 ram[GLCD_SIM_PAGES][GLCD_SIM_WIDTH];
+  u8 column;
+  u8 page;
+  u8 skip_args; // arguments of the previous command which have to be ignored
+} glcd_sim_display_t;
+
+static glcd_sim_display_t display[GLCD_SIM_NUM_DISPLAYS];
+
+// port state isn't changed by GLCD_SIM_Init(), since the APP_LCD driver caches the CS lines
+static u8 cs_lines = 0xff;
+static u8 rs_line;
+
+static unsigned long long bus_time_ns;
+static u32 num_data_bytes;
+static u32 num_cmd_bytes;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Initialisation: clears the display RAM and the counters
+/////////////////////////////////////////////////////////////////////////////
+s32 GLCD_SIM_Init(u32 mode)
+{
+  memset(display, 0, sizeof(display));
+
+  bus_time_ns = 0;
+  num_data_bytes = 0;
+  num_cmd_bytes = 0;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the display RAM (GLCD_SIM_PAGES * GLCD_SIM_WIDTH bytes)
+/////////////////////////////////////////////////////////////////////////////
+u8 *GLCD_SIM_RamGet(u8 num)
+{
+  if( num >= GLCD_SIM_NUM_DISPLAYS )
+    return NULL;
+
+  return &display[num].ram[0][0];
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Modelled transfer time and number of transferred bytes
+/////////////////////////////////////////////////////////////////////////////
+unsigned long long GLCD_SIM_TimeNsGet(void)
+{
+  return bus_time_ns;
+}
+
+u32 GLCD_SIM_NumDataBytesGet(void)
+{
+  return num_data_bytes;
+}
+
+u32 GLCD_SIM_NumCmdBytesGet(void)
+{
+  return num_cmd_bytes;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Writes all displays side by side into a binary PGM file
+// returns < 0 if file can't be written
+/////////////////////////////////////////////////////////////////////////////
+s32 GLCD_SIM_PgmWrite(const char *filename)
+{
+  FILE *f = fopen(filename, "wb");
+  if( f == NULL )
+    return -1;
+
+  fprintf(f, "P5\n%d %d\n255\n", GLCD_SIM_NUM_DISPLAYS*GLCD_SIM_WIDTH, GLCD_SIM_PAGES*8);
+
+  int y;
+  for(y=0; y<GLCD_SIM_PAGES*8; ++y) {
+    int num, x;
+    for(num=0; num<GLCD_SIM_NUM_DISPLAYS; ++num) {
+      for(x=0; x<GLCD_SIM_WIDTH; ++x) {
+	u8 pixel = (display[num].ram[y / 8][x] & (1 << (y % 8))) ? 0xff : 0x00;
+	fputc(pixel, f);
+      }
+    }
+  }
+
+  fclose(f);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Decodes a byte for all selected displays
+/////////////////////////////////////////////////////////////////////////////
+static void GLCD_SIM_Receive(u8 data)
+{
+  int num;
+  for(num=0; num<GLCD_SIM_NUM_DISPLAYS; ++num) {
+    if( cs_lines & (1 << num) )
+      continue; // not selected
+
+    glcd_sim_display_t *d = &display[num];
+
+    if( rs_line ) {
+      d->ram[d->page][d->column] = data;
+      if( ++d->column >= GLCD_SIM_WIDTH )
+	d->column = 0; // page addressing mode: the page doesn't change
+    } else if( d->skip_args ) {
+      --d->skip_args;
+    } else if( data <= 0x0f ) {
+      d->column = (d->column & 0xf0) | data;
+    } else if( data <= 0x1f ) {
+      d->column = ((data & 0x07) << 4) | (d->column & 0x0f);
+    } else if( data >= 0xb0 && data <= 0xb7 ) {
+      d->page = data & 0x07;
+    } else {
+      switch( data ) {
+      case 0x20: case 0x81: case 0x8d: case 0xa8: case 0xd3:
+      case 0xd5: case 0xd9: case 0xda: case 0xdb:
+	d->skip_args = 1;
+	break;
+      case 0x21: case 0x22:
+	d->skip_args = 2;
+	break;
+      }
+    }
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// J15 functions which are used by the APP_LCD driver
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J15_PortInit(u32 mode) { return 0; }
+
+s32 MIOS32_BOARD_J15_DataSet(u8 data)
+{
+  cs_lines = data;
+  bus_time_ns += GLCD_SIM_DATASET_NS;
+  return 0; // no error
+}
+
+s32 MIOS32_BOARD_J15_SerDataShift(u8 data)
+{
+  GLCD_SIM_Receive(data);
+
+  if( rs_line )
+    ++num_data_bytes;
+  else
+    ++num_cmd_bytes;
+  bus_time_ns += GLCD_SIM_SERSHIFT_NS;
+
+  return 0; // no error
+}
+
+s32 MIOS32_BOARD_J15_RS_Set(u8 rs)
+{
+  rs_line = rs;
+  bus_time_ns += GLCD_SIM_RS_NS;
+  return 0; // no error
+}
+
+s32 MIOS32_BOARD_J15_RW_Set(u8 rw) { return 0; }
+s32 MIOS32_BOARD_J15_E_Set(u8 lcd, u8 e) { return 0; }
+s32 MIOS32_BOARD_J15_GetD7In(void) { return 0; }
+s32 MIOS32_BOARD_J15_D7InPullUpEnable(u8 enable) { return 0; }
+s32 MIOS32_BOARD_J15_PollUnbusy(u8 lcd, u32 time_out) { return 0; }
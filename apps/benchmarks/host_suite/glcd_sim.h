@@ -0,0 +1,49 @@
+// $Id$
+/*
+ * Header file for the simulated serial GLCDs of the host benchmark suite
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef _GLCD_SIM_H
+#define _GLCD_SIM_H
+
+/////////////////////////////////////////////////////////////////////////////
+// Global definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// number of SSD1306 displays which are connected to J15 (CS lines: J15 data port D0..D7)
+#define GLCD_SIM_NUM_DISPLAYS 2
+
+// display RAM of a SSD1306
+#define GLCD_SIM_WIDTH  128
+#define GLCD_SIM_PAGES  8
+
+// time of the bit-banged J15 transfers of a STM32F103 @ 72 MHz
+#define GLCD_SIM_DATASET_NS  1500 // MIOS32_BOARD_J15_DataSet() (CS lines via 74HC595)
+#define GLCD_SIM_SERSHIFT_NS 1000 // MIOS32_BOARD_J15_SerDataShift()
+#define GLCD_SIM_RS_NS         50 // MIOS32_BOARD_J15_RS_Set() (DC line)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+extern s32 GLCD_SIM_Init(u32 mode);
+
+extern u8 *GLCD_SIM_RamGet(u8 display);
+
+extern unsigned long long GLCD_SIM_TimeNsGet(void);
+extern u32 GLCD_SIM_NumDataBytesGet(void);
+extern u32 GLCD_SIM_NumCmdBytesGet(void);
+
+extern s32 GLCD_SIM_PgmWrite(const char *filename);
+
+
+#endif /* _GLCD_SIM_H */
@@ -0,0 +1,202 @@
+// $Id$
+/*
+ * Stub HAL for the host benchmark suite
+ *
+ * Provides the MIOS32 functions which are required by mios32_midi.c and
+ * the sequencer modules, so that they can be linked into a native Linux
+ * executable:
+ *   - USB/UART/IIC/SPI MIDI drivers: packages sent to any port are only
+ *     counted, UART packages are received from software buffers which are
+ *     filled by the benchmarks
+ *   - IRQ, timer and system functions are dummies
+ *   - the time base is taken from clock_gettime(CLOCK_MONOTONIC)
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+#include <string.h>
+#include <time.h>
+
+#include "hal_stub.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+static u32 tx_counter;
+
+static mios32_midi_package_t rx_buffer[MIOS32_UART_NUM][HAL_STUB_RX_BUFFER_SIZE];
+static u32 rx_buffer_tail[MIOS32_UART_NUM];
+static u32 rx_buffer_head[MIOS32_UART_NUM];
+static u32 rx_buffer_size[MIOS32_UART_NUM];
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Initialisation
+/////////////////////////////////////////////////////////////////////////////
+s32 HAL_STUB_Init(u32 mode)
+{
+  tx_counter = 0;
+
+  int i;
+  for(i=0; i<MIOS32_UART_NUM; ++i) {
+    rx_buffer_tail[i] = rx_buffer_head[i] = rx_buffer_size[i] = 0;
+  }
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns a monotonic time in nS
+/////////////////////////////////////////////////////////////////////////////
+unsigned long long HAL_STUB_TimeNsGet(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Puts a package into the receive buffer of an emulated UART
+// returns -1 if buffer full
+/////////////////////////////////////////////////////////////////////////////
+s32 HAL_STUB_RxPackagePut(u8 uart_port, mios32_midi_package_t package)
+{
+  if( uart_port >= MIOS32_UART_NUM )
+    return -1; // port not available
+
+  if( rx_buffer_size[uart_port] >= HAL_STUB_RX_BUFFER_SIZE )
+    return -1; // buffer full
+
+  rx_buffer[uart_port][rx_buffer_head[uart_port]] = package;
+  if( ++rx_buffer_head[uart_port] >= HAL_STUB_RX_BUFFER_SIZE )
+    rx_buffer_head[uart_port] = 0;
+  ++rx_buffer_size[uart_port];
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the number of free entries in the receive buffer
+/////////////////////////////////////////////////////////////////////////////
+s32 HAL_STUB_RxBufferFree(u8 uart_port)
+{
+  if( uart_port >= MIOS32_UART_NUM )
+    return 0;
+
+  return HAL_STUB_RX_BUFFER_SIZE - rx_buffer_size[uart_port];
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Number of packages which have been sent over any port
+/////////////////////////////////////////////////////////////////////////////
+u32 HAL_STUB_TxCounterGet(void)
+{
+  return tx_counter;
+}
+
+s32 HAL_STUB_TxCounterReset(void)
+{
+  tx_counter = 0;
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// IRQ, Timer and System functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IRQ_Disable(void) { return 0; }
+s32 MIOS32_IRQ_Enable(void) { return 0; }
+s32 MIOS32_IRQ_Install(u8 IRQn, u8 priority) { return 0; }
+
+s32 MIOS32_TIMER_Init(u8 timer, u32 period, void (*_irq_handler)(void), u8 irq_priority) { return 0; }
+s32 MIOS32_TIMER_ReInit(u8 timer, u32 period) { return 0; }
+
+s32 MIOS32_DELAY_Wait_uS(u16 uS) { return 0; }
+
+s32 MIOS32_BOARD_LED_Set(u32 leds, u32 value) { return 0; }
+u32 MIOS32_BOARD_LED_Get(void) { return 0; }
+
+s32 MIOS32_SYS_Reset(void) { return -1; }
+u32 MIOS32_SYS_ChipIDGet(void) { return 0; }
+u32 MIOS32_SYS_FlashSizeGet(void) { return 0; }
+u32 MIOS32_SYS_RAMSizeGet(void) { return 0; }
+s32 MIOS32_SYS_SerialNumberGet(char *str) { strcpy(str, "000000000000000000000000"); return 0; }
+
+
+/////////////////////////////////////////////////////////////////////////////
+// USB MIDI
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_Init(u32 mode) { return 0; }
+s32 MIOS32_USB_MIDI_CheckAvailable(u8 cable) { return 1; }
+s32 MIOS32_USB_MIDI_PackageSend_NonBlocking(mios32_midi_package_t package) { ++tx_counter; return 0; }
+s32 MIOS32_USB_MIDI_PackageSend(mios32_midi_package_t package) { ++tx_counter; return 0; }
+s32 MIOS32_USB_MIDI_PackageReceive(mios32_midi_package_t *package) { return -1; }
+s32 MIOS32_USB_MIDI_Periodic_mS(void) { return 0; }
+
+
+/////////////////////////////////////////////////////////////////////////////
+// UART MIDI
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_UART_MIDI_Init(u32 mode) { return 0; }
+s32 MIOS32_UART_MIDI_CheckAvailable(u8 uart_port) { return uart_port < MIOS32_UART_NUM; }
+s32 MIOS32_UART_MIDI_RS_OptimisationSet(u8 uart_port, u8 enable) { return 0; }
+s32 MIOS32_UART_MIDI_RS_OptimisationGet(u8 uart_port) { return 0; }
+s32 MIOS32_UART_MIDI_RS_Reset(u8 uart_port) { return 0; }
+s32 MIOS32_UART_MIDI_Periodic_mS(void) { return 0; }
+s32 MIOS32_UART_MIDI_PackageSend_NonBlocking(u8 uart_port, mios32_midi_package_t package) { ++tx_counter; return 0; }
+s32 MIOS32_UART_MIDI_PackageSend(u8 uart_port, mios32_midi_package_t package) { ++tx_counter; return 0; }
+
+s32 MIOS32_UART_MIDI_PackageReceive(u8 uart_port, mios32_midi_package_t *package)
+{
+  if( uart_port >= MIOS32_UART_NUM || !rx_buffer_size[uart_port] )
+    return -1; // no package in buffer
+
+  *package = rx_buffer[uart_port][rx_buffer_tail[uart_port]];
+  if( ++rx_buffer_tail[uart_port] >= HAL_STUB_RX_BUFFER_SIZE )
+    rx_buffer_tail[uart_port] = 0;
+  --rx_buffer_size[uart_port];
+
+  return rx_buffer_size[uart_port]; // return number of remaining packages
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// IIC MIDI
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IIC_MIDI_Init(u32 mode) { return 0; }
+s32 MIOS32_IIC_MIDI_CheckAvailable(u8 iic_port) { return 0; }
+s32 MIOS32_IIC_MIDI_RS_OptimisationSet(u8 iic_port, u8 enable) { return 0; }
+s32 MIOS32_IIC_MIDI_RS_OptimisationGet(u8 iic_port) { return 0; }
+s32 MIOS32_IIC_MIDI_RS_Reset(u8 iic_port) { return 0; }
+s32 MIOS32_IIC_MIDI_Periodic_mS(void) { return 0; }
+s32 MIOS32_IIC_MIDI_PackageSend_NonBlocking(u8 iic_port, mios32_midi_package_t package) { return -1; }
+s32 MIOS32_IIC_MIDI_PackageSend(u8 iic_port, mios32_midi_package_t package) { return -1; }
+s32 MIOS32_IIC_MIDI_PackageReceive(u8 iic_port, mios32_midi_package_t *package) { return -1; }
+
+
+/////////////////////////////////////////////////////////////////////////////
+// SPI MIDI
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SPI_MIDI_Init(u32 mode) { return 0; }
+s32 MIOS32_SPI_MIDI_CheckAvailable(u8 spi_midi_port) { return 0; }
+s32 MIOS32_SPI_MIDI_Periodic_mS(void) { return 0; }
+s32 MIOS32_SPI_MIDI_PackageSend_NonBlocking(mios32_midi_package_t package) { return -1; }
+s32 MIOS32_SPI_MIDI_PackageSend(mios32_midi_package_t package) { return -1; }
+s32 MIOS32_SPI_MIDI_PackageReceive(mios32_midi_package_t *package) { return -1; }
@@ -0,0 +1,40 @@
+// $Id$
+/*
+ * Header file for the stub HAL of the host benchmark suite
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+#ifndef _HAL_STUB_H
+#define _HAL_STUB_H
+
+/////////////////////////////////////////////////////////////////////////////
+// Global definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// size of the receive buffer of each emulated UART (number of packages)
+#define HAL_STUB_RX_BUFFER_SIZE 1024
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+extern s32 HAL_STUB_Init(u32 mode);
+
+extern unsigned long long HAL_STUB_TimeNsGet(void);
+
+extern s32 HAL_STUB_RxPackagePut(u8 uart_port, mios32_midi_package_t package);
+extern s32 HAL_STUB_RxBufferFree(u8 uart_port);
+
+extern u32 HAL_STUB_TxCounterGet(void);
+extern s32 HAL_STUB_TxCounterReset(void);
+
+
+#endif /* _HAL_STUB_H */
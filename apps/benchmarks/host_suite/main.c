@@ -0,0 +1,70 @@
+// $Id$
+/*
+ * Host Benchmark Suite
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+#include <string.h>
+
+#include <seq_midi_out.h>
+
+#include "benchmark.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Runs all benchmarks and prints the results
+// returns 1 if any workload failed, so that the suite can be used in scripts
+/////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+  BENCHMARK_Init(0);
+
+  // optional: write the last screen of the GLCD workloads into PGM files
+  if( argc > 1 && strcmp(argv[1], "-pgm") == 0 )
+    BENCHMARK_FrameDumpSet(1);
+
+  printf("====================\n");
+  printf("%s\n", MIOS32_LCD_BOOT_MSG_LINE1);
+  printf("====================\n");
+  printf("\n");
+  printf("Settings:\n");
+  printf("#define SEQ_MIDI_OUT_SCHEDULER %d\n", SEQ_MIDI_OUT_SCHEDULER);
+  printf("#define SEQ_MIDI_OUT_MALLOC_METHOD %d\n", SEQ_MIDI_OUT_MALLOC_METHOD);
+  printf("#define SEQ_MIDI_OUT_MAX_EVENTS %d\n", SEQ_MIDI_OUT_MAX_EVENTS);
+  printf("\n");
+  printf("%-30s %9s %10s %12s %10s %8s\n", "Workload", "Events", "ns/event", "max call ns", "high-water", "dropouts");
+
+  int failed = 0;
+  int num;
+  for(num=0; num<BENCHMARK_NumGet(); ++num) {
+    benchmark_result_t result;
+    BENCHMARK_Run(num, &result);
+
+    printf("%-30s %9u %10.1f %12llu %10u %8u%s\n",
+	   result.name,
+	   (unsigned)result.num_events,
+	   result.num_events ? ((double)result.time_ns / result.num_events) : 0.0,
+	   result.max_call_ns,
+	   (unsigned)result.high_water,
+	   (unsigned)result.dropouts,
+	   result.failed ? "  FAILED" : "");
+
+    if( result.failed )
+      failed = 1;
+  }
+
+  return failed;
+}
@@ -0,0 +1,66 @@
+// $Id$
+/*
+ * Local MIOS32 configuration file
+ *
+ * this file allows to disable (or re-configure) default functions of MIOS32
+ * available switches are listed in $MIOS32_PATH/modules/mios32/MIOS32_CONFIG.txt
+ *
+ */
+
+#ifndef _MIOS32_CONFIG_H
+#define _MIOS32_CONFIG_H
+
+// The boot message which is print during startup and returned on a SysEx query
+#define MIOS32_LCD_BOOT_MSG_LINE1 "Host Benchmark Suite"
+#define MIOS32_LCD_BOOT_MSG_LINE2 "(c) 2026 R.Wanderlof"
+
+// the stub HAL provides 4 UART ports which are polled by MIOS32_MIDI_Receive_Handler
+#define MIOS32_UART_NUM 4
+#define MIOS32_IIC_NUM 0
+#define MIOS32_IIC_MIDI_NUM 0
+
+// the simulated SD Card is accessed at 18 MBit/s like on a STM32F103 (see sdcard_sim.h)
+#define MIOS32_SDCARD_SPI_PRESCALER MIOS32_SPI_PRESCALER_4
+
+// sector cache of the FatFs disk layer (modules/fatfs/src/diskio.c)
+#define DISKIO_CACHE_NUM_SECTORS 8
+#define DISKIO_CACHE_READ_AHEAD  4
+
+// modules/file: read handles with cluster map, directory cache
+#define FILE_NUM_HANDLES 3
+#define FILE_HANDLE_MAX_FRAGMENTS 8
+#define FILE_DIR_CACHE_NUM_ENTRIES 16
+
+// modules/vgm and modules/genesis: 4 boards and the player IRQ priority like MIDIbox Quad Genesis
+#define GENESIS_COUNT 4
+#define MIOS32_IRQ_PRIO_INSANE 3
+
+// 8 SIDs with dirty bitmap, register transfers are recorded by the SID workloads
+#define SID_NUM 8
+#define SID_DIRTY_BITMAP 1
+#define SID_UPDATE_REG_HOOK BENCHMARK_SidUpdateRegHook
+
+// framebuffer of modules/app_lcd/universal for the two simulated SSD1306 displays (see glcd_sim.h)
+#define APP_LCD_FRAMEBUFFER_NUM_DEVICES 2
+
+// dispatch table for the search tree of the OSC workloads
+#define MIOS32_OSC_DISPATCH_HASH_SIZE 256
+
+
+// scheduler backend (can be overruled from the Makefile, which builds both variants)
+#ifndef SEQ_MIDI_OUT_SCHEDULER
+#define SEQ_MIDI_OUT_SCHEDULER 1
+#endif
+
+// memory alloccation method (only relevant for SEQ_MIDI_OUT_SCHEDULER == 0)
+#define SEQ_MIDI_OUT_MALLOC_METHOD 3
+
+// worst case workloads queue much more events than a MBSEQ
+// MAX_EVENTS must be a power of two! (e.g. 64, 128, 256, 512, ...)
+#define SEQ_MIDI_OUT_MAX_EVENTS 4096
+
+// enable seq_midi_out_max_allocated and seq_midi_out_dropouts
+#define SEQ_MIDI_OUT_MALLOC_ANALYSIS 1
+
+
+#endif /* _MIOS32_CONFIG_H */
@@ -0,0 +1,441 @@
+// $Id$
+/*
+ * Simulated SD Card for the host benchmark suite
+ *
+ * Provides the MIOS32_SPI functions which are used by mios32_sdcard.c and
+ * answers them like a SDHC card in SPI mode, so that the SD Card driver and
+ * the FatFs disk layer can be measured and verified on the host:
+ *   - the card content is stored in a RAM image
+ *   - supported commands: CMD0, CMD8, CMD9, CMD12, CMD13, CMD16, CMD17,
+ *     CMD18, CMD24, CMD25, CMD55, CMD58 and ACMD41
+ *   - access and busy times are modelled by a number of 0xff (resp. 0x00)
+ *     bytes which have to be polled by the driver, see sdcard_sim.h
+ *   - the transfer time is derived from the number of transferred bytes and
+ *     the selected SPI prescaler, it doesn't depend on the host CPU
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+#include <string.h>
+
+#include "sdcard_sim.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// bytes which are sent by the card with the next transfers
+#define SDCARD_SIM_QUEUE_SIZE 4096
+
+typedef enum {
+  CARD_STATE_TRAN = 0,
+  CARD_STATE_READ_MULTI,
+  CARD_STATE_WRITE_SINGLE,
+  CARD_STATE_WRITE_MULTI,
+} card_state_t;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+static u8 image[SDCARD_SIM_NUM_SECTORS*512];
+
+static u8 queue[SDCARD_SIM_QUEUE_SIZE];
+static u32 queue_head;
+static u32 queue_tail;
+
+static u8 cmd_buffer[6];
+static u8 cmd_pos;
+
+static u8 write_buffer[512+2];
+static u32 write_pos;
+
+static card_state_t card_state;
+static u8 cs_active;
+static u8 in_idle_state;
+static u8 app_cmd;
+static u8 op_cond_polls;
+static u32 rw_sector;
+
+static mios32_spi_prescaler_t spi_prescaler;
+static unsigned long long spi_cycles;
+static u32 num_cmds;
+static u32 num_errors;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Initialisation: clears the image and puts the card into power-up state
+/////////////////////////////////////////////////////////////////////////////
+s32 SDCARD_SIM_Init(u32 mode)
+{
+  memset(image, 0x00, sizeof(image));
+
+  queue_head = queue_tail = 0;
+  cmd_pos = 0;
+  write_pos = 0;
+  card_state = CARD_STATE_TRAN;
+  cs_active = 0;
+  in_idle_state = 1;
+  app_cmd = 0;
+  op_cond_polls = 0;
+  rw_sector = 0;
+
+  spi_prescaler = MIOS32_SPI_PRESCALER_256;
+  spi_cycles = 0;
+  num_cmds = 0;
+  num_errors = 0;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Access to the card content
+/////////////////////////////////////////////////////////////////////////////
+u8 *SDCARD_SIM_ImageGet(void)
+{
+  return image;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Modelled SPI transfer time since initialisation in nS
+/////////////////////////////////////////////////////////////////////////////
+unsigned long long SDCARD_SIM_TimeNsGet(void)
+{
+  return (spi_cycles * 1000ULL) / (SDCARD_SIM_SPI_BASE_CLOCK / 1000000);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Number of commands received by the card
+/////////////////////////////////////////////////////////////////////////////
+u32 SDCARD_SIM_NumCmdsGet(void)
+{
+  return num_cmds;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Number of protocol errors detected by the card (illegal commands,
+// invalid addresses, queue overruns)
+/////////////////////////////////////////////////////////////////////////////
+u32 SDCARD_SIM_ErrorsGet(void)
+{
+  return num_errors;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Output queue of the card
+/////////////////////////////////////////////////////////////////////////////
+static void SDCARD_SIM_QueueFill(u8 value, u32 num)
+{
+  if( queue_tail + num > SDCARD_SIM_QUEUE_SIZE ) {
+    ++num_errors; // should never happen
+    return;
+  }
+
+  memset(&queue[queue_tail], value, num);
+  queue_tail += num;
+}
+
+static void SDCARD_SIM_QueuePut(u8 value)
+{
+  SDCARD_SIM_QueueFill(value, 1);
+}
+
+static void SDCARD_SIM_QueueClear(void)
+{
+  queue_head = queue_tail = 0;
+}
+
+// queues a data block of the given sector, or an "out of range" error token
+static void SDCARD_SIM_QueueBlock(u32 sector, u32 latency)
+{
+  SDCARD_SIM_QueueFill(0xff, latency);
+
+  if( sector >= SDCARD_SIM_NUM_SECTORS ) {
+    ++num_errors;
+    SDCARD_SIM_QueuePut(0x08); // data error token: out of range
+    return;
+  }
+
+  SDCARD_SIM_QueuePut(0xfe); // start token
+  if( queue_tail + 512 + 2 > SDCARD_SIM_QUEUE_SIZE ) {
+    ++num_errors;
+    return;
+  }
+  memcpy(&queue[queue_tail], &image[sector*512], 512);
+  queue_tail += 512;
+  SDCARD_SIM_QueueFill(0x00, 2); // CRC (not checked by the driver)
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Executes a received command
+/////////////////////////////////////////////////////////////////////////////
+static void SDCARD_SIM_Command(void)
+{
+  u8 cmd = cmd_buffer[0] & 0x3f;
+  u32 arg = (cmd_buffer[1] << 24) | (cmd_buffer[2] << 16) | (cmd_buffer[3] << 8) | cmd_buffer[4];
+  u8 r1 = in_idle_state ? 0x01 : 0x00;
+
+  ++num_cmds;
+
+  // the card answers after one byte (NCR)
+  if( cmd != 12 )
+    SDCARD_SIM_QueuePut(0xff);
+
+  if( app_cmd ) {
+    app_cmd = 0;
+
+    if( cmd == 41 ) { // SEND_OP_COND_SDC: leave idle state after some polls
+      if( ++op_cond_polls >= 3 )
+	in_idle_state = 0;
+      SDCARD_SIM_QueuePut(in_idle_state ? 0x01 : 0x00);
+    } else {
+      SDCARD_SIM_QueuePut(r1 | 0x04); // illegal command
+    }
+    return;
+  }
+
+  // data transfers are only possible after initialisation
+  if( in_idle_state && (cmd == 17 || cmd == 18 || cmd == 24 || cmd == 25) ) {
+    ++num_errors;
+    SDCARD_SIM_QueuePut(r1 | 0x04); // illegal command
+    return;
+  }
+
+  // block addressing: the argument is the sector number
+  if( (cmd == 17 || cmd == 18 || cmd == 24 || cmd == 25) && arg >= SDCARD_SIM_NUM_SECTORS ) {
+    ++num_errors;
+    SDCARD_SIM_QueuePut(0x40); // parameter error
+    return;
+  }
+
+  switch( cmd ) {
+  case 0: // GO_IDLE_STATE
+    in_idle_state = 1;
+    op_cond_polls = 0;
+    card_state = CARD_STATE_TRAN;
+    SDCARD_SIM_QueuePut(0x01);
+    break;
+
+  case 8: // SEND_IF_COND: R7, voltage range and check pattern are echoed
+    SDCARD_SIM_QueuePut(r1);
+    SDCARD_SIM_QueuePut(0x00);
+    SDCARD_SIM_QueuePut(0x00);
+    SDCARD_SIM_QueuePut((arg >> 8) & 0x0f);
+    SDCARD_SIM_QueuePut(arg & 0xff);
+    break;
+
+  case 9: { // SEND_CSD: CSD version 2.0 (SDHC), the capacity is (C_SIZE+1) * 512k
+    // ERASE_BLK_EN and SECTOR_SIZE (byte 10/11) are 0: disk_ioctl(GET_BLOCK_SIZE)
+    // returns 16 << byte 10 for version 2.0, which is used by f_mkfs() to align the data area
+    static const u8 csd[16] = {
+      0x40, 0x0e, 0x00, 0x32, 0x5b, 0x59, 0x00,
+      0x00, ((SDCARD_SIM_NUM_SECTORS/1024 - 1) >> 8) & 0xff, (SDCARD_SIM_NUM_SECTORS/1024 - 1) & 0xff,
+      0x00, 0x7f, 0x0a, 0x40, 0x00, 0x01
+    };
+    SDCARD_SIM_QueuePut(r1);
+    SDCARD_SIM_QueueFill(0xff, 8);
+    SDCARD_SIM_QueuePut(0xfe); // start token
+    int i;
+    for(i=0; i<sizeof(csd); ++i)
+      SDCARD_SIM_QueuePut(csd[i]);
+    SDCARD_SIM_QueueFill(0x00, 2); // CRC (not checked by the driver)
+  } break;
+
+  case 12: // STOP_TRANSMISSION
+    if( card_state == CARD_STATE_READ_MULTI ) {
+      // the stuff byte is the next byte of the aborted data block
+      u8 stuff = (queue_head < queue_tail) ? queue[queue_head] : 0xff;
+      SDCARD_SIM_QueueClear();
+      SDCARD_SIM_QueuePut(stuff);
+      SDCARD_SIM_QueuePut(0x00); // R1
+      SDCARD_SIM_QueueFill(0x00, SDCARD_SIM_READ_STOP_BUSY_BYTES);
+      card_state = CARD_STATE_TRAN;
+    } else {
+      SDCARD_SIM_QueuePut(0xff);
+      SDCARD_SIM_QueuePut(r1);
+    }
+    break;
+
+  case 13: // SEND_STATUS: R2
+    SDCARD_SIM_QueuePut(r1);
+    SDCARD_SIM_QueuePut(0x00);
+    break;
+
+  case 16: // SET_BLOCKLEN
+    SDCARD_SIM_QueuePut(r1);
+    break;
+
+  case 17: // READ_SINGLE_BLOCK
+    SDCARD_SIM_QueuePut(r1);
+    SDCARD_SIM_QueueBlock(arg, SDCARD_SIM_READ_ACCESS_BYTES);
+    break;
+
+  case 18: // READ_MULTIPLE_BLOCK: next blocks are queued on demand
+    SDCARD_SIM_QueuePut(r1);
+    SDCARD_SIM_QueueBlock(arg, SDCARD_SIM_READ_ACCESS_BYTES);
+    rw_sector = arg + 1;
+    card_state = CARD_STATE_READ_MULTI;
+    break;
+
+  case 24: // WRITE_BLOCK
+  case 25: // WRITE_MULTIPLE_BLOCK
+    SDCARD_SIM_QueuePut(r1);
+    rw_sector = arg;
+    write_pos = 0;
+    card_state = (cmd == 24) ? CARD_STATE_WRITE_SINGLE : CARD_STATE_WRITE_MULTI;
+    break;
+
+  case 55: // APP_CMD
+    app_cmd = 1;
+    SDCARD_SIM_QueuePut(r1);
+    break;
+
+  case 58: // READ_OCR: R3, powered up, CCS set (SDHC)
+    SDCARD_SIM_QueuePut(r1);
+    SDCARD_SIM_QueuePut(0xc0);
+    SDCARD_SIM_QueuePut(0xff);
+    SDCARD_SIM_QueuePut(0x80);
+    SDCARD_SIM_QueuePut(0x00);
+    break;
+
+  default:
+    ++num_errors;
+    SDCARD_SIM_QueuePut(r1 | 0x04); // illegal command
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Handles a byte which has been received while a write command is active
+/////////////////////////////////////////////////////////////////////////////
+static void SDCARD_SIM_WriteByte(u8 b)
+{
+  if( write_pos ) {
+    write_buffer[write_pos-1] = b;
+    if( ++write_pos > sizeof(write_buffer) ) {
+      write_pos = 0;
+
+      if( rw_sector >= SDCARD_SIM_NUM_SECTORS ) {
+	++num_errors;
+	SDCARD_SIM_QueuePut(0x0d); // data rejected due to a write error
+	return;
+      }
+
+      memcpy(&image[rw_sector*512], write_buffer, 512);
+      ++rw_sector;
+
+      SDCARD_SIM_QueuePut(0x05); // data accepted
+      if( card_state == CARD_STATE_WRITE_SINGLE ) {
+	SDCARD_SIM_QueueFill(0x00, SDCARD_SIM_WRITE_BUSY_BYTES);
+	card_state = CARD_STATE_TRAN;
+      } else {
+	SDCARD_SIM_QueueFill(0x00, SDCARD_SIM_WRITE_MULTI_BUSY_BYTES);
+      }
+    }
+  } else if( (b == 0xfe && card_state == CARD_STATE_WRITE_SINGLE) ||
+	     (b == 0xfc && card_state == CARD_STATE_WRITE_MULTI) ) {
+    write_pos = 1; // start token
+  } else if( b == 0xfd && card_state == CARD_STATE_WRITE_MULTI ) {
+    // stop token: one byte (NBR), thereafter busy
+    SDCARD_SIM_QueuePut(0xff);
+    SDCARD_SIM_QueueFill(0x00, SDCARD_SIM_WRITE_STOP_BUSY_BYTES);
+    card_state = CARD_STATE_TRAN;
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// SPI functions used by mios32_sdcard.c
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SPI_IO_Init(u8 spi, mios32_spi_pin_driver_t spi_pin_driver)
+{
+  return 0; // no error
+}
+
+s32 MIOS32_SPI_TransferModeInit(u8 spi, mios32_spi_mode_t spi_mode, mios32_spi_prescaler_t prescaler)
+{
+  spi_prescaler = prescaler;
+  return 0; // no error
+}
+
+s32 MIOS32_SPI_RC_PinSet(u8 spi, u8 rc_pin, u8 pin_value)
+{
+  if( pin_value ) {
+    // deselected: abort running transfers (busy times are not continued)
+    SDCARD_SIM_QueueClear();
+    cmd_pos = 0;
+    write_pos = 0;
+    card_state = CARD_STATE_TRAN;
+  }
+  cs_active = pin_value ? 0 : 1;
+
+  return 0; // no error
+}
+
+s32 MIOS32_SPI_TransferByte(u8 spi, u8 b)
+{
+  spi_cycles += 8 * (2 << spi_prescaler);
+
+  if( !cs_active )
+    return 0xff;
+
+  // next byte of a multi block read
+  if( queue_head >= queue_tail && card_state == CARD_STATE_READ_MULTI ) {
+    SDCARD_SIM_QueueClear();
+    SDCARD_SIM_QueueBlock(rw_sector++, SDCARD_SIM_READ_GAP_BYTES);
+  }
+
+  u8 ret = 0xff;
+  if( queue_head < queue_tail ) {
+    ret = queue[queue_head++];
+    if( queue_head >= queue_tail )
+      SDCARD_SIM_QueueClear();
+  }
+
+  if( cmd_pos || (!write_pos && (b & 0xc0) == 0x40) ) {
+    cmd_buffer[cmd_pos++] = b;
+    if( cmd_pos >= sizeof(cmd_buffer) ) {
+      cmd_pos = 0;
+      SDCARD_SIM_Command();
+    }
+  } else if( card_state == CARD_STATE_WRITE_SINGLE || card_state == CARD_STATE_WRITE_MULTI ) {
+    SDCARD_SIM_WriteByte(b);
+  }
+
+  return ret;
+}
+
+s32 MIOS32_SPI_TransferBlock(u8 spi, u8 *send_buffer, u8 *receive_buffer, u16 len, void *callback)
+{
+  int i;
+
+  for(i=0; i<len; ++i) {
+    u8 ret = MIOS32_SPI_TransferByte(spi, send_buffer ? send_buffer[i] : 0xff);
+    if( receive_buffer )
+      receive_buffer[i] = ret;
+  }
+
+  if( callback )
+    ((void (*)(void))callback)();
+
+  return 0; // no error
+}
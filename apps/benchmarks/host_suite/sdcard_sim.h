@@ -0,0 +1,50 @@
+// $Id$
+/*
+ * Header file for the simulated SD Card of the host benchmark suite
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef _SDCARD_SIM_H
+#define _SDCARD_SIM_H
+
+/////////////////////////////////////////////////////////////////////////////
+// Global definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// size of the RAM image (number of 512 byte sectors)
+#define SDCARD_SIM_NUM_SECTORS 4096
+
+// clock of the SPI peripheral before the prescaler (STM32F103: 72 MHz, SD Card prescaler 4 -> 18 MBit/s)
+#define SDCARD_SIM_SPI_BASE_CLOCK 72000000
+
+// latencies of the simulated card, specified in SPI byte times at 18 MBit/s (ca. 0.44 uS)
+// the values are in the range of common SDHC cards, they are not taken from a specific card
+#define SDCARD_SIM_READ_ACCESS_BYTES       500 // until first data token after CMD17/CMD18 (ca. 220 uS)
+#define SDCARD_SIM_READ_GAP_BYTES           20 // until next data token of a multi block read (ca. 9 uS)
+#define SDCARD_SIM_WRITE_BUSY_BYTES       1500 // busy after a single block write (ca. 670 uS)
+#define SDCARD_SIM_WRITE_MULTI_BUSY_BYTES  100 // busy after each block of a multi block write (ca. 44 uS)
+#define SDCARD_SIM_READ_STOP_BUSY_BYTES     20 // busy after CMD12 (ca. 9 uS)
+#define SDCARD_SIM_WRITE_STOP_BUSY_BYTES  1500 // busy after the stop token of a multi block write (ca. 670 uS)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+extern s32 SDCARD_SIM_Init(u32 mode);
+
+extern u8 *SDCARD_SIM_ImageGet(void);
+
+extern unsigned long long SDCARD_SIM_TimeNsGet(void);
+extern u32 SDCARD_SIM_NumCmdsGet(void);
+extern u32 SDCARD_SIM_ErrorsGet(void);
+
+
+#endif /* _SDCARD_SIM_H */
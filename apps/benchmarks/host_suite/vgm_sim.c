@@ -0,0 +1,483 @@
+// $Id$
+/*
+ * Simulated VGM heads for the host benchmark suite
+ *
+ * modules/vgm/vgmplayer.c is included into this file, so that the state of
+ * its head scheduler (heap of waiting heads, chip queues, pending list) can
+ * be verified after each operation. The file provides:
+ *   - the STM32 timers which are read by the player (TIM2: hr time, TIM5:
+ *     VGM time), they are only advanced by VGM_SIM_Work()
+ *   - heads with a synthetic command stream instead of VGM_Head_cmdNext():
+ *     waits (some of them already over), OPN2 and PSG writes to all boards,
+ *     writes which aren't played (unmapped board, unsupported command) and
+ *     the end of the stream
+ *   - Genesis_OPN2Write() and Genesis_PSGWrite(), which count the writes
+ *     and check that a chip isn't written before its busy time has passed
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+#include <string.h>
+
+#include "vgm_sim.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// STM32 peripherals which are accessed by vgmplayer.c
+/////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  volatile u32 CNT;
+  volatile u32 ARR;
+} TIM_TypeDef;
+
+typedef struct {
+  u32 TIM_Period;
+  u16 TIM_Prescaler;
+  u16 TIM_ClockDivision;
+  u16 TIM_CounterMode;
+} TIM_TimeBaseInitTypeDef;
+
+static TIM_TypeDef tim2, tim3, tim5;
+
+#define TIM2 (&tim2)
+#define TIM3 (&tim3)
+#define TIM5 (&tim5)
+
+#define TIM3_IRQn           29
+#define RESET               0
+#define DISABLE             0
+#define ENABLE              1
+#define TIM_IT_Update       0x0001
+#define TIM_CounterMode_Up  0x0000
+#define RCC_APB1Periph_TIM2 0x0001
+#define RCC_APB1Periph_TIM3 0x0002
+#define RCC_APB1Periph_TIM5 0x0008
+
+static void NVIC_DisableIRQ(u8 irq) {}
+static void NVIC_EnableIRQ(u8 irq) {}
+static void RCC_APB1PeriphClockCmd(u32 periph, u8 state) {}
+static void TIM_TimeBaseInit(TIM_TypeDef *tim, TIM_TimeBaseInitTypeDef *init) {}
+static void TIM_ITConfig(TIM_TypeDef *tim, u16 it, u8 state) {}
+static void TIM_ARRPreloadConfig(TIM_TypeDef *tim, u8 state) {}
+static void TIM_Cmd(TIM_TypeDef *tim, u8 state) {}
+static u8 TIM_GetITStatus(TIM_TypeDef *tim, u16 it) { return RESET; }
+static void TIM_ClearITPendingBit(TIM_TypeDef *tim, u16 it) {}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// The VGM player under test (the genesis.h header requires a STM32F4 board)
+/////////////////////////////////////////////////////////////////////////////
+
+#define MIOS32_BOARD_MBHP_CORE_STM32F4
+#include "vgmplayer.c"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+VgmHead* vgm_heads[VGM_HEAD_MAXNUM];
+u32 vgm_numheads;
+
+static VgmHead head_pool[VGM_HEAD_MAXNUM];
+static u8 head_allocated[VGM_HEAD_MAXNUM];
+
+static u32 vgm_time_frac; // hr ticks of the current VGM sample
+static u32 random_seed;
+static u32 num_chip_writes;
+static u32 num_busy_errors;
+
+// last write and busy time of each chip (OPN2 at even, PSG at odd index)
+static u32 chip_last_write[VGMP_NUMCHIPQUEUES];
+static u32 chip_busy_ticks[VGMP_NUMCHIPQUEUES];
+
+// scheduler state of all heads, indexed by the pool position, so that it
+// can be compared before and after vgm_heads[] has been renumbered
+typedef struct {
+  u8 in_heap[VGM_HEAD_MAXNUM];
+  u32 heap_key[VGM_HEAD_MAXNUM];
+  u8 pending[VGM_HEAD_MAXNUM];
+  u8 queue_len[VGMP_NUMCHIPQUEUES];
+  u8 queue[VGMP_NUMCHIPQUEUES][VGM_HEAD_MAXNUM];
+} vgm_sim_snapshot_t;
+
+static vgm_sim_snapshot_t snapshot_before;
+static vgm_sim_snapshot_t snapshot_after;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local functions
+/////////////////////////////////////////////////////////////////////////////
+
+static u32 VGM_SIM_Random(u32 range)
+{
+  random_seed = random_seed * 1103515245 + 12345;
+  return ((random_seed >> 8) & 0xffffff) % range;
+}
+
+// sets the next command of the synthetic stream
+static void VGM_SIM_CmdSet(VgmHead* head, u32 vgm_time)
+{
+  // PSG, OPN2 port 0/1, OPN2 (DAC) are played, 0x1 and 0x5 aren't
+  static const u8 subcmd[6] = { 0x0, 0x2, 0x3, 0x4, 0x1, 0x5 };
+  u32 r = VGM_SIM_Random(16);
+
+  head->iswait = 0;
+  head->iswrite = 0;
+  if( r < 6 ) {
+    head->iswait = 1;
+    head->ticks = vgm_time + VGM_SIM_Random(VGM_SIM_MAX_WAIT) - 2;
+  } else if( r < 15 ) {
+    head->iswrite = 1;
+    head->writecmd.cmd = (VGM_SIM_Random(GENESIS_COUNT+1) << 4) | subcmd[VGM_SIM_Random(6)];
+    head->writecmd.addr = VGM_SIM_Random(0x40); // 0x20..0x2f don't delay
+    head->writecmd.data = VGM_SIM_Random(0x100);
+  } else {
+    head->isdone = 1;
+  }
+}
+
+static void VGM_SIM_ChipWrite(u8 q, u32 busy_ticks)
+{
+  if( (TIM2->CNT - chip_last_write[q]) < chip_busy_ticks[q] )
+    ++num_busy_errors;
+
+  chip_last_write[q] = TIM2->CNT;
+  chip_busy_ticks[q] = busy_ticks;
+  ++num_chip_writes;
+}
+
+static void VGM_SIM_SnapshotTake(vgm_sim_snapshot_t *s)
+{
+  u8 i, q;
+
+  memset(s, 0, sizeof(vgm_sim_snapshot_t));
+
+  for(i=0; i<vgm_numheads; ++i) {
+    u8 pool_ix = vgm_heads[i] - head_pool;
+    if( hsched[i].heappos != VGMP_NOHEAD ) {
+      s->in_heap[pool_ix] = 1;
+      s->heap_key[pool_ix] = sched_key[hsched[i].heappos];
+    }
+    s->pending[pool_ix] = hsched[i].pending;
+  }
+
+  for(q=0; q<VGMP_NUMCHIPQUEUES; ++q) {
+    for(i=sched_first[q]; i != VGMP_NOHEAD && s->queue_len[q] < VGM_HEAD_MAXNUM; i=hsched[i].next)
+      s->queue[q][s->queue_len[q]++] = vgm_heads[i] - head_pool;
+  }
+}
+
+// removes a head from the snapshot, like VGM_Player_DeleteHead() has to do it
+static void VGM_SIM_SnapshotRemove(vgm_sim_snapshot_t *s, u8 pool_ix)
+{
+  u8 q, i, k;
+
+  s->in_heap[pool_ix] = 0;
+  s->heap_key[pool_ix] = 0;
+  s->pending[pool_ix] = 0;
+
+  for(q=0; q<VGMP_NUMCHIPQUEUES; ++q) {
+    for(i=0, k=0; i<s->queue_len[q]; ++i) {
+      if( s->queue[q][i] != pool_ix )
+	s->queue[q][k++] = s->queue[q][i];
+    }
+    for(i=k; i<s->queue_len[q]; ++i)
+      s->queue[q][i] = 0;
+    s->queue_len[q] = k;
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Functions which are called by vgmplayer.c
+/////////////////////////////////////////////////////////////////////////////
+
+void VGM_Head_cmdNext(VgmHead* head, u32 vgm_time)
+{
+  VGM_SIM_CmdSet(head, vgm_time);
+}
+
+void Genesis_OPN2Write(u8 board, u8 addrhi, u8 address, u8 data)
+{
+  u32 busy_ticks = (address >= 0x20 && address < 0x2f && address != 0x28) ? 0 : VGMP_OPN2BUSYDELAY;
+  VGM_SIM_ChipWrite(board << 1, busy_ticks);
+}
+
+void Genesis_PSGWrite(u8 board, u8 data)
+{
+  VGM_SIM_ChipWrite((board << 1) | 1, VGMP_PSGBUSYDELAY);
+}
+
+void Genesis_CaptureOPN2OpStates(u8 board) {}
+void VGM_PerfMon_ClockIn(u8 task) {}
+void VGM_PerfMon_ClockOut(u8 task) {}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Initialisation: removes all heads and starts the timers shortly before
+// they wrap around
+/////////////////////////////////////////////////////////////////////////////
+s32 VGM_SIM_Init(u32 seed)
+{
+  int i;
+
+  random_seed = seed;
+
+  tim2.CNT = 0U - 100*VGMP_HRTICKSPERSAMPLE;
+  tim5.CNT = 0U - 100;
+  vgm_time_frac = 0;
+
+  VGM_Player_Init();
+
+  vgm_numheads = 0;
+  for(i=0; i<VGM_HEAD_MAXNUM; ++i) {
+    vgm_heads[i] = NULL;
+    head_allocated[i] = 0;
+  }
+
+  for(i=0; i<VGMP_NUMCHIPQUEUES; ++i) {
+    chip_last_write[i] = tim2.CNT;
+    chip_busy_ticks[i] = 0;
+  }
+
+  num_chip_writes = 0;
+  num_busy_errors = 0;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the number of heads
+/////////////////////////////////////////////////////////////////////////////
+u32 VGM_SIM_NumHeadsGet(void)
+{
+  return vgm_numheads;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Adds a playing head like VGM_Head_Create() and VGM_Head_Restart()
+// Returns the index of the new head, or -1 if all heads are allocated
+/////////////////////////////////////////////////////////////////////////////
+s32 VGM_SIM_HeadCreate(void)
+{
+  int pool_ix;
+
+  if( vgm_numheads >= VGM_HEAD_MAXNUM )
+    return -1; // no free head
+
+  for(pool_ix=0; head_allocated[pool_ix]; ++pool_ix);
+  head_allocated[pool_ix] = 1;
+
+  VgmHead* head = &head_pool[pool_ix];
+  memset(head, 0, sizeof(VgmHead));
+  head->playing = 1;
+  VGM_SIM_CmdSet(head, TIM5->CNT);
+
+  vgm_heads[vgm_numheads] = head;
+  ++vgm_numheads;
+  VGM_Player_Reschedule(head);
+
+  return vgm_numheads - 1;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Deletes a head like VGM_Head_Delete()
+// The scheduler state of the remaining heads has to be unchanged, otherwise
+// -1 is returned
+/////////////////////////////////////////////////////////////////////////////
+s32 VGM_SIM_HeadDelete(u8 index)
+{
+  if( index >= vgm_numheads )
+    return -2; // invalid head
+
+  u8 pool_ix = vgm_heads[index] - head_pool;
+  VGM_SIM_SnapshotTake(&snapshot_before);
+  VGM_SIM_SnapshotRemove(&snapshot_before, pool_ix);
+
+  VGM_Player_DeleteHead(index);
+  for(; index<vgm_numheads-1; ++index) {
+    vgm_heads[index] = vgm_heads[index+1];
+  }
+  vgm_heads[index] = NULL;
+  --vgm_numheads;
+  head_allocated[pool_ix] = 0;
+
+  if( VGM_SIM_Check() < 0 )
+    return -1; // scheduler structures corrupted
+
+  VGM_SIM_SnapshotTake(&snapshot_after);
+  if( memcmp(&snapshot_before, &snapshot_after, sizeof(vgm_sim_snapshot_t)) != 0 )
+    return -1; // heads have been renumbered wrongly
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Restarts a head at a new command, like the apps do it
+/////////////////////////////////////////////////////////////////////////////
+s32 VGM_SIM_HeadRestart(u8 index)
+{
+  if( index >= vgm_numheads )
+    return -2; // invalid head
+
+  VgmHead* head = vgm_heads[index];
+  head->playing = 1;
+  head->isdone = 0;
+  VGM_SIM_CmdSet(head, TIM5->CNT);
+  VGM_Player_Reschedule(head);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Stops a head without rescheduling it, the player drops it when it comes up
+/////////////////////////////////////////////////////////////////////////////
+s32 VGM_SIM_HeadStop(u8 index)
+{
+  if( index >= vgm_numheads )
+    return -2; // invalid head
+
+  vgm_heads[index]->playing = 0;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Advances the timers by the given number of hr ticks, and calls the
+// work callback of the player like the TIM3 interrupt does
+// Returns the delay which was requested by the player
+/////////////////////////////////////////////////////////////////////////////
+u32 VGM_SIM_Work(u32 hr_ticks)
+{
+  tim2.CNT += hr_ticks;
+  vgm_time_frac += hr_ticks;
+  tim5.CNT += vgm_time_frac / VGMP_HRTICKSPERSAMPLE;
+  vgm_time_frac %= VGMP_HRTICKSPERSAMPLE;
+
+  return VgmPlayer_WorkCallback();
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Checks the scheduler structures:
+//   -1: heap entries don't match the positions of the heads, or heap order violated
+//   -2: unused or out of range entries are scheduled
+//   -3: chip queue links are inconsistent
+//   -4: pending list doesn't match the pending flags
+//   -5: a playing head isn't scheduled for its current command
+//   -6: a chip has been written while it was busy
+/////////////////////////////////////////////////////////////////////////////
+s32 VGM_SIM_Check(void)
+{
+  u8 seen[VGM_HEAD_MAXNUM];
+  u8 i, p, q, prev;
+
+  // heap
+  if( sched_heapsize > vgm_numheads )
+    return -1;
+  for(p=0; p<sched_heapsize; ++p) {
+    i = sched_heap[p];
+    if( i >= vgm_numheads || hsched[i].heappos != p )
+      return -1;
+    if( p > 0 && (s32)(sched_key[p] - sched_key[(p-1) >> 1]) < 0 )
+      return -1;
+  }
+
+  // positions of the heads
+  for(i=0; i<VGM_HEAD_MAXNUM; ++i) {
+    if( i >= vgm_numheads ) {
+      if( hsched[i].heappos != VGMP_NOHEAD || hsched[i].queue != VGMP_NOHEAD || hsched[i].pending )
+	return -2;
+    } else {
+      if( hsched[i].heappos != VGMP_NOHEAD &&
+	  (hsched[i].heappos >= sched_heapsize || sched_heap[hsched[i].heappos] != i) )
+	return -1;
+      if( hsched[i].heappos != VGMP_NOHEAD && hsched[i].queue != VGMP_NOHEAD )
+	return -2;
+      if( hsched[i].queue != VGMP_NOHEAD && hsched[i].queue >= VGMP_NUMCHIPQUEUES )
+	return -2;
+    }
+  }
+
+  // chip queues
+  memset(seen, 0, sizeof(seen));
+  for(q=0; q<VGMP_NUMCHIPQUEUES; ++q) {
+    prev = VGMP_NOHEAD;
+    for(i=sched_first[q]; i != VGMP_NOHEAD; i=hsched[i].next) {
+      if( i >= vgm_numheads || seen[i] )
+	return -3;
+      seen[i] = 1;
+      if( hsched[i].queue != q || hsched[i].prev != prev )
+	return -3;
+      prev = i;
+    }
+    if( sched_last[q] != prev )
+      return -3;
+  }
+  for(i=0; i<vgm_numheads; ++i) {
+    if( (hsched[i].queue != VGMP_NOHEAD) != seen[i] )
+      return -3;
+  }
+
+  // pending list
+  memset(seen, 0, sizeof(seen));
+  for(p=0; p<sched_numpending; ++p) {
+    i = sched_pending[p];
+    if( i >= vgm_numheads || seen[i] || !hsched[i].pending )
+      return -4;
+    seen[i] = 1;
+  }
+  for(i=0; i<vgm_numheads; ++i) {
+    if( hsched[i].pending != seen[i] )
+      return -4;
+  }
+
+  // playing heads which aren't pending wait for their command
+  for(i=0; i<vgm_numheads; ++i) {
+    VgmHead* h = vgm_heads[i];
+    if( !h->playing || h->isdone || hsched[i].pending )
+      continue;
+
+    if( h->iswait ) {
+      if( hsched[i].heappos == VGMP_NOHEAD || sched_key[hsched[i].heappos] != h->ticks )
+	return -5;
+    } else if( h->iswrite ) {
+      q = ChipQueueOf(h->writecmd);
+      if( q == VGMP_NOHEAD || hsched[i].queue != q )
+	return -5;
+    }
+  }
+
+  if( num_busy_errors )
+    return -6;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the number of chip writes since VGM_SIM_Init()
+/////////////////////////////////////////////////////////////////////////////
+u32 VGM_SIM_NumChipWritesGet(void)
+{
+  return num_chip_writes;
+}
@@ -0,0 +1,44 @@
+// $Id$
+/*
+ * Header file for the simulated VGM heads of the host benchmark suite
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef _VGM_SIM_H
+#define _VGM_SIM_H
+
+/////////////////////////////////////////////////////////////////////////////
+// Global definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// max. wait of the synthetic command stream (VGM samples, 44.1 kHz)
+#define VGM_SIM_MAX_WAIT 100
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+extern s32 VGM_SIM_Init(u32 seed);
+
+extern u32 VGM_SIM_NumHeadsGet(void);
+
+extern s32 VGM_SIM_HeadCreate(void);
+extern s32 VGM_SIM_HeadDelete(u8 index);
+extern s32 VGM_SIM_HeadRestart(u8 index);
+extern s32 VGM_SIM_HeadStop(u8 index);
+
+extern u32 VGM_SIM_Work(u32 hr_ticks);
+
+extern s32 VGM_SIM_Check(void);
+extern u32 VGM_SIM_NumChipWritesGet(void);
+
+
+#endif /* _VGM_SIM_H */
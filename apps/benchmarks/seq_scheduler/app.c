@@ -67,6 +67,7 @@ void APP_Init(void)
   MIOS32_MIDI_SendDebugMessage("====================\n");
   MIOS32_MIDI_SendDebugMessage("\n");
   MIOS32_MIDI_SendDebugMessage("Settings:\n");
+  MIOS32_MIDI_SendDebugMessage("#define SEQ_MIDI_OUT_SCHEDULER %d\n", SEQ_MIDI_OUT_SCHEDULER);
   MIOS32_MIDI_SendDebugMessage("#define SEQ_MIDI_OUT_MALLOC_METHOD %d\n", SEQ_MIDI_OUT_MALLOC_METHOD);
   MIOS32_MIDI_SendDebugMessage("#define SEQ_MIDI_OUT_MAX_EVENTS %d\n", SEQ_MIDI_OUT_MAX_EVENTS);
   MIOS32_MIDI_SendDebugMessage("\n");
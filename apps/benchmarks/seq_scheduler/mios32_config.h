@@ -15,6 +15,11 @@
 #define MIOS32_LCD_BOOT_MSG_LINE2 "(c) 2009 T.Klose"
 
 
+// scheduler backend:
+// 0: timestamp sorted linked list
+// 1: binary min-heap over a static slot array (ignores SEQ_MIDI_OUT_MALLOC_METHOD)
+#define SEQ_MIDI_OUT_SCHEDULER 0
+
 // memory alloccation method:
 // 0: internal static allocation with one byte for each flag
 // 1: internal static allocation with 8bit flags
@@ -78,7 +78,7 @@ s32 MBNG_DIO_PortInit(u8 port, mios32_board_pin_mode_t mode)
 
   case 1: {
     int i;
-#if defined(MIOS32_FAMILY_STM32F4xx)
+#if defined(MIOS32_FAMILY_STM32F4xx) || defined(MIOS32_FAMILY_LINUX)
     for(i=8; i<16; ++i)
       MIOS32_BOARD_J10_PinInit(i, mode);
 #elif defined(MIOS32_FAMILY_LPC17xx)
@@ -111,7 +111,7 @@ u8 MBNG_DIO_PortGet(u8 port)
 #else
   switch( port ) {
   case 0: {
-#if defined(MIOS32_FAMILY_STM32F4xx)
+#if defined(MIOS32_FAMILY_STM32F4xx) || defined(MIOS32_FAMILY_LINUX)
     return MIOS32_BOARD_J10A_Get();
 #elif defined(MIOS32_FAMILY_LPC17xx)
     return MIOS32_BOARD_J10_Get();
@@ -121,7 +121,7 @@ u8 MBNG_DIO_PortGet(u8 port)
   } break;
 
   case 1: {
-#if defined(MIOS32_FAMILY_STM32F4xx)
+#if defined(MIOS32_FAMILY_STM32F4xx) || defined(MIOS32_FAMILY_LINUX)
     return MIOS32_BOARD_J10B_Get();
 #elif defined(MIOS32_FAMILY_LPC17xx)
     return MIOS32_BOARD_J28_Get();
@@ -150,7 +150,7 @@ s32 MBNG_DIO_PortSet(u8 port, u8 value)
 #else
   switch( port ) {
   case 0: {
-#if defined(MIOS32_FAMILY_STM32F4xx)
+#if defined(MIOS32_FAMILY_STM32F4xx) || defined(MIOS32_FAMILY_LINUX)
     MIOS32_BOARD_J10A_Set(value);
 #elif defined(MIOS32_FAMILY_LPC17xx)
     MIOS32_BOARD_J10_Set(value);
@@ -160,7 +160,7 @@ s32 MBNG_DIO_PortSet(u8 port, u8 value)
   } break;
 
   case 1: {
-#if defined(MIOS32_FAMILY_STM32F4xx)
+#if defined(MIOS32_FAMILY_STM32F4xx) || defined(MIOS32_FAMILY_LINUX)
     MIOS32_BOARD_J10B_Set(value);
 #elif defined(MIOS32_FAMILY_LPC17xx)
     MIOS32_BOARD_J28_Set(value);
@@ -129,6 +129,36 @@ static u16 event_pool_maps_begin;
 static u16 event_pool_num_items;
 static u16 event_pool_num_maps;
 
+// search index: pool offsets of all items, sorted by id (resp. hw_id, resp. first
+// bytes of the MIDI event stream) and pool position
+// built by MBNG_EVENT_PoolUpdate(), each item allocates 6 bytes
+// if the pool contains more items, the search functions iterate through the pool instead
+#ifndef MBNG_EVENT_INDEX_MAX_ITEMS
+#if defined(MIOS32_FAMILY_STM32F4xx)
+# define MBNG_EVENT_INDEX_MAX_ITEMS 2048
+#else
+# define MBNG_EVENT_INDEX_MAX_ITEMS 512
+#endif
+#endif
+
+#if MBNG_EVENT_INDEX_MAX_ITEMS
+static u16 event_index_id[MBNG_EVENT_INDEX_MAX_ITEMS];
+static u16 event_index_hw_id[MBNG_EVENT_INDEX_MAX_ITEMS];
+static u16 event_index_rx[MBNG_EVENT_INDEX_MAX_ITEMS];
+#endif
+static u16 event_index_num;
+static u16 event_index_rx_num;
+static u8  event_index_valid;
+static u8  event_index_generation;
+
+// index types
+#define MBNG_EVENT_INDEX_ID     0
+#define MBNG_EVENT_INDEX_HW_ID  1
+#define MBNG_EVENT_INDEX_RX     2
+
+// receive index: key for items which don't match on the second byte only
+#define MBNG_EVENT_INDEX_RX_ANY 0x80
+
 // last active event
 mbng_event_item_id_t last_event_item_id;
 
@@ -185,6 +215,8 @@ static u8 lc_meters[LC_METERS_NUM_PORTS][LC_METERS_NUM_ITEMS];
 static s32 MBNG_EVENT_ItemCopy2User(mbng_event_pool_item_t* pool_item, mbng_event_item_t *item);
 static s32 MBNG_EVENT_ItemCopy2Pool(mbng_event_item_t *item, mbng_event_pool_item_t* pool_item);
 
+static s32 MBNG_EVENT_IndexBuild(void);
+
 static s32 MBNG_EVENT_LCMeters_Update(void);
 static s32 MBNG_EVENT_LCMeters_Set(u8 port_ix, u8 lc_meter_value);
 static s32 MBNG_EVENT_LCMeters_Tick(void);
@@ -371,6 +403,10 @@ s32 MBNG_EVENT_PoolClear(void)
   event_pool_num_items = 0;
   event_pool_num_maps = 0;
 
+  event_index_num = 0;
+  event_index_rx_num = 0;
+  event_index_valid = 0;
+
   last_event_item_id = 0;
 
   selected_bank = 1;
@@ -406,10 +442,155 @@ s32 MBNG_EVENT_PoolUpdate(void)
     pool_ptr += pool_item->len;
   }
 
+  // rebuild search index
+  MBNG_EVENT_IndexBuild();
+
   return 0; // no error
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the receive key of a pool item: first byte of the event stream in
+//! the upper byte, second byte in the lower byte if only this value can match,
+//! otherwise MBNG_EVENT_INDEX_RX_ANY (e.g. NRPN, matrices, any key/CC).
+/////////////////////////////////////////////////////////////////////////////
+static u16 MBNG_EVENT_IndexRxKey(mbng_event_pool_item_t *pool_item)
+{
+  u8 *stream = &pool_item->data_begin;
+  u16 key = (u16)stream[0] << 8;
+  u16 hw_id_type = pool_item->hw_id & 0xf000;
+
+  if( ((mbng_event_flags_t)pool_item->flags).type <= MBNG_EVENT_TYPE_CC &&
+      !pool_item->flags.use_any_key_or_cc &&
+      pool_item->len_stream >= 2 && stream[1] < 0x80 &&
+      hw_id_type != MBNG_EVENT_CONTROLLER_BUTTON_MATRIX &&
+      hw_id_type != MBNG_EVENT_CONTROLLER_LED_MATRIX ) {
+    key |= stream[1];
+  } else {
+    key |= MBNG_EVENT_INDEX_RX_ANY;
+  }
+
+  return key;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the sort key of an index entry: id (resp. hw_id or receive key) in
+//! the upper half, pool offset in the lower half, so that items with the same
+//! key are sorted in the order of the pool.
+/////////////////////////////////////////////////////////////////////////////
+static inline u32 MBNG_EVENT_IndexKey(u16 pool_offset, u8 index_type)
+{
+  mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[pool_offset];
+  u16 key;
+
+  switch( index_type ) {
+  case MBNG_EVENT_INDEX_ID:    key = pool_item->id; break;
+  case MBNG_EVENT_INDEX_HW_ID: key = pool_item->hw_id; break;
+  default:                     key = MBNG_EVENT_IndexRxKey(pool_item);
+  }
+
+  return ((u32)key << 16) | pool_offset;
+}
+
+#if MBNG_EVENT_INDEX_MAX_ITEMS
+/////////////////////////////////////////////////////////////////////////////
+//! Sorts an index with heapsort (no recursion, no additional memory)
+/////////////////////////////////////////////////////////////////////////////
+static void MBNG_EVENT_IndexSort(u16 *index, u32 num, u8 index_type)
+{
+  u32 start = num / 2;
+  u32 end = num;
+
+  while( end > 1 ) {
+    if( start > 0 ) {
+      --start; // heapify
+    } else {
+      --end; // move largest entry to the end
+      u16 tmp = index[end];
+      index[end] = index[0];
+      index[0] = tmp;
+    }
+
+    // sift down
+    u32 root = start;
+    u32 child;
+    while( (child=2*root+1) < end ) {
+      if( (child+1) < end && MBNG_EVENT_IndexKey(index[child+1], index_type) > MBNG_EVENT_IndexKey(index[child], index_type) )
+	++child;
+
+      if( MBNG_EVENT_IndexKey(index[child], index_type) <= MBNG_EVENT_IndexKey(index[root], index_type) )
+	break;
+
+      u16 tmp = index[root];
+      index[root] = index[child];
+      index[child] = tmp;
+      root = child;
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! \returns the position of the first index entry with a key >= the given key
+/////////////////////////////////////////////////////////////////////////////
+static u32 MBNG_EVENT_IndexLowerBound(u16 *index, u32 num, u32 key, u8 index_type)
+{
+  u32 low = 0;
+  u32 high = num;
+
+  while( low < high ) {
+    u32 mid = (low + high) / 2;
+    if( MBNG_EVENT_IndexKey(index[mid], index_type) < key )
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  return low;
+}
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+//! (Re-)builds the id, hw_id and receive search index
+//! \returns 0 if index is valid
+//! \returns -1 if the pool contains too many items (the search functions
+//! will iterate through the pool instead)
+/////////////////////////////////////////////////////////////////////////////
+static s32 MBNG_EVENT_IndexBuild(void)
+{
+  event_index_num = 0;
+  event_index_rx_num = 0;
+  event_index_valid = 0;
+  ++event_index_generation;
+
+#if MBNG_EVENT_INDEX_MAX_ITEMS
+  if( event_pool_num_items > MBNG_EVENT_INDEX_MAX_ITEMS )
+    return -1; // index too small
+
+  u8 *pool_ptr = (u8 *)&event_pool[0];
+  u32 i;
+  for(i=0; i<event_pool_num_items; ++i) {
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)pool_ptr;
+    u16 pool_offset = (u32)(pool_ptr - event_pool);
+    event_index_id[i] = pool_offset;
+    event_index_hw_id[i] = pool_offset;
+    if( pool_item->len_stream ) // only items with event stream can receive MIDI
+      event_index_rx[event_index_rx_num++] = pool_offset;
+    pool_ptr += pool_item->len;
+  }
+  event_index_num = event_pool_num_items;
+
+  MBNG_EVENT_IndexSort(event_index_id, event_index_num, MBNG_EVENT_INDEX_ID);
+  MBNG_EVENT_IndexSort(event_index_hw_id, event_index_num, MBNG_EVENT_INDEX_HW_ID);
+  MBNG_EVENT_IndexSort(event_index_rx, event_index_rx_num, MBNG_EVENT_INDEX_RX);
+
+  event_index_valid = 1;
+  return 0; // no error
+#else
+  return -1; // index disabled
+#endif
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Sends the event pool to debug terminal
 /////////////////////////////////////////////////////////////////////////////
@@ -476,17 +657,17 @@ s32 MBNG_EVENT_PoolMapsPrint(void)
 	  u16 value = *(map_values++);
 	  value |= (u16)*(map_values++) << 8;
 	  char sep = (pool_map->map_type == MBNG_EVENT_MAP_TYPE_HWORDI && (j%4) == 2) ? ':' : ' ';
-	  sprintf(value_str, "%s%c%d", value_str, sep, value);
+	  sprintf((char *)(value_str + strlen(value_str)), "%c%d", sep, value);
 	}
       } else {
 	for(j=0; j<len && j < max_values; ++j) {
 	  char sep = (pool_map->map_type == MBNG_EVENT_MAP_TYPE_BYTEI && (j%2) == 1) ? ':' : ' ';
-	  sprintf(value_str, "%s%c%d", value_str, sep, *(map_values++));
+	  sprintf((char *)(value_str + strlen(value_str)), "%c%d", sep, *(map_values++));
 	}
       }
 
       if( len > max_values ) {
-	sprintf(value_str, "%s ...", value_str);
+	sprintf((char *)(value_str + strlen(value_str)), " ...");
       }
       DEBUG_MSG(value_str);
 
@@ -1072,7 +1253,7 @@ static s32 MBNG_EVENT_ItemCopy2User(mbng_event_pool_item_t* pool_item, mbng_even
   // This should be done once the struct definitions are settled - currently it isn't urgent
   // since I haven't noticed significant performnance issues yet (on a LPC17 core...)
   item->id = pool_item->id;
-  u32 pool_address = (u32)pool_item - (u32)event_pool;
+  u32 pool_address = (u32)((u8 *)pool_item - event_pool);
   item->pool_address = (pool_address < MBNG_EVENT_POOL_MAX_SIZE) ? pool_address : 0xffff;
   item->flags.ALL = pool_item->flags.ALL;
   item->custom_flags.ALL = pool_item->custom_flags.ALL;
@@ -1425,6 +1606,10 @@ s32 MBNG_EVENT_ItemAdd(mbng_event_item_t *item)
   ++event_pool_num_items;
   event_pool_maps_begin += pool_item_len;
 
+  // keep search index up-to-date if the item has been added after MBNG_EVENT_PoolUpdate()
+  if( event_index_valid )
+    MBNG_EVENT_IndexBuild();
+
   return 0; // no error
 }
 
@@ -1449,11 +1634,20 @@ s32 MBNG_EVENT_ItemModify(mbng_event_item_t *item)
       if( len_diff >= 0 && (event_pool_size+len_diff) > MBNG_EVENT_POOL_MAX_SIZE )
 	return -2; // out of storage 
 
+      // search index has to be rebuilt if pool offsets, the hw_id or the receive key are changed
+      u8 rebuild_index = event_index_valid &&
+	(len_diff != 0 ||
+	 pool_item->hw_id != item->hw_id ||
+	 ((mbng_event_flags_t)pool_item->flags).type != item->flags.type ||
+	 pool_item->flags.use_any_key_or_cc != item->flags.use_any_key_or_cc ||
+	 pool_item->len_stream != (item->stream ? item->stream_size : 0) ||
+	 (pool_item->len_stream && memcmp(&pool_item->data_begin, item->stream, pool_item->len_stream) != 0));
+
       if( len_diff != 0 ) {
 	// make room
-	u8 *old_next_pool_item = (u8 *)((u32)pool_item + pool_item->len);
-	u8 *new_next_pool_item = (u8 *)((u32)pool_item + pool_item_len);
-	u32 move_size = MBNG_EVENT_POOL_MAX_SIZE - ((u32)new_next_pool_item - (u32)&event_pool);
+	u8 *old_next_pool_item = (u8 *)pool_item + pool_item->len;
+	u8 *new_next_pool_item = (u8 *)pool_item + pool_item_len;
+	u32 move_size = MBNG_EVENT_POOL_MAX_SIZE - (u32)(new_next_pool_item - &event_pool[0]);
 
 	//DEBUG_MSG("New Item changed size by %d bytes. Next Old Addr: 0x%08x, New: 0x%08x, move_size %d\n", len_diff, old_next_pool_item, new_next_pool_item, move_size);
 
@@ -1483,6 +1677,9 @@ s32 MBNG_EVENT_ItemModify(mbng_event_item_t *item)
 	MBNG_EVENT_ItemCopy2Pool(item, pool_item);
       }
 
+      if( rebuild_index )
+	MBNG_EVENT_IndexBuild();
+
       return 0; // operation was successfull
     }
     pool_ptr += pool_item->len;
@@ -1498,6 +1695,31 @@ s32 MBNG_EVENT_ItemModify(mbng_event_item_t *item)
 /////////////////////////////////////////////////////////////////////////////
 s32 MBNG_EVENT_ItemSearchById(mbng_event_item_id_t id, mbng_event_item_t *item, u32 *continue_ix)
 {
+#if MBNG_EVENT_INDEX_MAX_ITEMS
+  if( event_index_valid ) {
+    // continue_ix: position of the next index entry
+    u32 pos = *continue_ix ? *continue_ix : MBNG_EVENT_IndexLowerBound(event_index_id, event_index_num, (u32)id << 16, MBNG_EVENT_INDEX_ID);
+
+    if( pos < event_index_num ) {
+      mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[event_index_id[pos]];
+      if( pool_item->id == id ) {
+	MBNG_EVENT_ItemCopy2User(pool_item, item);
+
+	// continue search only if the next entry has the same id
+	u32 next_pos = pos + 1;
+	if( next_pos < event_index_num && ((mbng_event_pool_item_t *)&event_pool[event_index_id[next_pos]])->id == id )
+	  *continue_ix = next_pos;
+	else
+	  *continue_ix = 0;
+
+	return 0; // item found
+      }
+    }
+
+    return -1; // not found
+  }
+#endif
+
   u8 *pool_ptr = (u8 *)&event_pool[0];
   u32 i = 0;
 
@@ -1515,7 +1737,7 @@ s32 MBNG_EVENT_ItemSearchById(mbng_event_item_id_t id, mbng_event_item_t *item,
 
       // pass pointer offset to pool item + index of pool item in continue_ix for continued search
       // skip this if the new values exceeding the 16bit boundary, or if this is the last pool item
-      u32 next_pool_offset = (u32)pool_ptr - (u32)event_pool + pool_item->len;
+      u32 next_pool_offset = (u32)(pool_ptr - event_pool) + pool_item->len;
       u32 next_pool_i = i + 1;
       if( next_pool_i > 65535 || next_pool_i >= event_pool_num_items || next_pool_offset > 65535 )
 	*continue_ix = 0;
@@ -1539,6 +1761,34 @@ s32 MBNG_EVENT_ItemSearchById(mbng_event_item_id_t id, mbng_event_item_t *item,
 /////////////////////////////////////////////////////////////////////////////
 s32 MBNG_EVENT_ItemSearchByHwId(mbng_event_item_id_t hw_id, mbng_event_item_t *item, u32 *continue_ix)
 {
+#if MBNG_EVENT_INDEX_MAX_ITEMS
+  if( event_index_valid ) {
+    // continue_ix: position of the next index entry
+    u32 pos = *continue_ix ? *continue_ix : MBNG_EVENT_IndexLowerBound(event_index_hw_id, event_index_num, (u32)hw_id << 16, MBNG_EVENT_INDEX_HW_ID);
+
+    for(; pos < event_index_num; ++pos) {
+      mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[event_index_hw_id[pos]];
+      if( pool_item->hw_id != hw_id )
+	break; // no more items with this hw_id
+
+      if( pool_item->flags.active ) {
+	MBNG_EVENT_ItemCopy2User(pool_item, item);
+
+	// continue search only if the next entry has the same hw_id
+	u32 next_pos = pos + 1;
+	if( next_pos < event_index_num && ((mbng_event_pool_item_t *)&event_pool[event_index_hw_id[next_pos]])->hw_id == hw_id )
+	  *continue_ix = next_pos;
+	else
+	  *continue_ix = 0;
+
+	return 0; // item found
+      }
+    }
+
+    return -1; // not found
+  }
+#endif
+
   u8 *pool_ptr = (u8 *)&event_pool[0];
   u32 i = 0;
 
@@ -1557,7 +1807,7 @@ s32 MBNG_EVENT_ItemSearchByHwId(mbng_event_item_id_t hw_id, mbng_event_item_t *i
 
       // pass pointer offset to pool item + index of pool item in continue_ix for continued search
       // skip this if the new values exceeding the 16bit boundary, or if this is the last pool item
-      u32 next_pool_offset = (u32)pool_ptr - (u32)event_pool + pool_item->len;
+      u32 next_pool_offset = (u32)(pool_ptr - event_pool) + pool_item->len;
       u32 next_pool_i = i + 1;
       if( next_pool_i > 65535 || next_pool_i >= event_pool_num_items || next_pool_offset > 65535 )
 	*continue_ix = 0;
@@ -1600,7 +1850,7 @@ s32 MBNG_EVENT_ItemRetrieveValues(mbng_event_item_id_t *id, s16 *value, u8 *seco
 
     // pass pointer offset to pool item + index of pool item in continue_ix for continued search
     // skip this if the new values exceeding the 16bit boundary, or if this is the last pool item
-    u32 next_pool_offset = (u32)pool_ptr - (u32)event_pool + pool_item->len;
+    u32 next_pool_offset = (u32)(pool_ptr - event_pool) + pool_item->len;
     u32 next_pool_i = i + 1;
     if( next_pool_i > 65535 || next_pool_i >= event_pool_num_items || next_pool_offset > 65535 )
       *continue_ix = 0;
@@ -1621,7 +1871,7 @@ s32 MBNG_EVENT_ItemCopyValueToPool(mbng_event_item_t *item)
 {
   // take over in pool item
   if( item->pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + item->pool_address);
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[item->pool_address];
     pool_item->value = item->value;
     if( item->flags.use_key_or_cc ) // only change secondary value if key_or_cc option selected
       pool_item->secondary_value = item->secondary_value;
@@ -1639,7 +1889,7 @@ s32 MBNG_EVENT_ItemSetActive(mbng_event_item_t *item, u8 active)
 {
   // take over in pool item
   if( item->pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + item->pool_address);
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[item->pool_address];
     pool_item->flags.active = active;
     item->flags.active = active;
 
@@ -1668,7 +1918,7 @@ s32 MBNG_EVENT_ItemSetNoDump(mbng_event_item_t *item, u8 no_dump)
 {
   // take over in pool item
   if( item->pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + item->pool_address);
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[item->pool_address];
     pool_item->flags.no_dump = no_dump;
     item->flags.no_dump = no_dump;
   }
@@ -1684,7 +1934,7 @@ s32 MBNG_EVENT_ItemSetLock(mbng_event_item_t *item, u8 lock)
 {
   // take over in pool item
   if( item->pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + item->pool_address);
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[item->pool_address];
     pool_item->flags.write_locked = lock;
   }
 
@@ -1699,7 +1949,7 @@ s32 MBNG_EVENT_ItemSetMapIx(mbng_event_item_t *item, u8 map_ix)
 {
   // take over in pool item
   if( item->pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + item->pool_address);
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[item->pool_address];
     pool_item->map_ix = map_ix;
     item->map_ix = map_ix;
   }
@@ -1865,7 +2115,7 @@ s32 MBNG_EVENT_ItemPrint(mbng_event_item_t *item, u8 all)
 	int j;
 	for(j=0; j<num_bytes; ++j) {
 	  u8 meta_value = item->stream[++i];
-	  sprintf(str, "%s:%d", str, (int)meta_value);
+	  sprintf((char *)(str + strlen(str)), ":%d", (int)meta_value);
 	}
 
 	DEBUG_MSG("  - meta=%s%s", MBNG_EVENT_ItemMetaTypeStrGet(meta_type), str);
@@ -3934,7 +4184,7 @@ s32 MBNG_EVENT_ItemReceive(mbng_event_item_t *item, u16 value, u8 from_midi, u8
 
   // take over in pool item
   if( item->pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + item->pool_address);
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[item->pool_address];
     pool_item->value = item->value;
     if( item->flags.use_key_or_cc ) // only change secondary value if key_or_cc option selected
       pool_item->secondary_value = item->secondary_value;
@@ -3983,7 +4233,7 @@ s32 MBNG_EVENT_ItemReceive(mbng_event_item_t *item, u16 value, u8 from_midi, u8
 
 	// store in pool
 	if( item->pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-	  mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + item->pool_address);
+	  mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[item->pool_address];
 	  pool_item->value = value;
 	}
       }
@@ -4016,7 +4266,7 @@ s32 MBNG_EVENT_ItemReceive(mbng_event_item_t *item, u16 value, u8 from_midi, u8
 
     // store in pool
     if( item->pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-      mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + item->pool_address);
+      mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[item->pool_address];
       pool_item->value = item->value;
     }
 
@@ -4082,7 +4332,7 @@ s32 MBNG_EVENT_ItemReceive(mbng_event_item_t *item, u16 value, u8 from_midi, u8
     }
 
     if( item->flags.fwd_to_lcd && item->pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-      mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + item->pool_address);
+      mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[item->pool_address];
       pool_item->flags.update_lcd = 1;
       last_event_item_id = pool_item->id;
     }
@@ -4198,7 +4448,7 @@ s32 MBNG_EVENT_ItemForwardToRadioGroup(mbng_event_item_t *item, u8 radio_group)
 
       // take over value of item in pool item
       if( fwd_item.pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-	mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + fwd_item.pool_address);
+	mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[fwd_item.pool_address];
 	pool_item->value = fwd_item.value;
 	if( fwd_item.flags.use_key_or_cc ) // only change secondary value if key_or_cc option selected
 	  pool_item->secondary_value = fwd_item.secondary_value;
@@ -4242,7 +4492,7 @@ s32 MBNG_EVENT_NotifySendValue(mbng_event_item_t *item)
   s16 prev_value = 0;
   //s16 prev_secondary_value = 0;
   if( item->pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + item->pool_address);
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[item->pool_address];
     prev_value = pool_item->value;
     //prev_secondary_value = pool_item->secondary_value;
     pool_item->value = item->value;
@@ -4298,7 +4548,7 @@ s32 MBNG_EVENT_NotifySendValue(mbng_event_item_t *item)
 
   // print label
   if( item->pool_address < (MBNG_EVENT_POOL_MAX_SIZE-1) ) {
-    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)((u32)&event_pool[0] + item->pool_address);
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[item->pool_address];
     pool_item->flags.update_lcd = 1;
     last_event_item_id = pool_item->id;
   }
@@ -4430,6 +4680,104 @@ s32 MBNG_EVENT_Dump(void)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! Help function for MBNG_EVENT_MIDI_NotifyPackage: checks if the given pool
+//! item (whose first stream byte matches with evnt0) receives the MIDI package
+/////////////////////////////////////////////////////////////////////////////
+static s32 MBNG_EVENT_MIDI_ReceivePoolItem(mbng_event_pool_item_t *pool_item, u32 port_mask, mios32_midi_package_t midi_package, u16 nrpn_address, u16 nrpn_value, u8 nrpn_msb_only)
+{
+  u8 evnt1 = midi_package.evnt1;
+
+  if( (pool_item->hw_id & 0xf000) == MBNG_EVENT_CONTROLLER_SENDER ) // a sender doesn't receive
+    return 0;
+
+  if( !(pool_item->enabled_ports & port_mask) ) // port not enabled
+    return 0;
+
+  mbng_event_type_t event_type = ((mbng_event_flags_t)pool_item->flags).type;
+  if( event_type <= MBNG_EVENT_TYPE_CC ) {
+    u8 *stream = &pool_item->data_begin;
+    if( pool_item->flags.use_any_key_or_cc || stream[1] == evnt1 ) { // || pool_item->secondary_value >= 128 || evnt1 == pool_item->secondary_value ) {
+      mbng_event_item_t item;
+      MBNG_EVENT_ItemCopy2User(pool_item, &item);
+      if( item.flags.use_key_or_cc ) {
+	item.secondary_value = midi_package.value;
+	MBNG_EVENT_ItemReceive(&item, midi_package.evnt1, 1, 1);
+      } else {
+	item.secondary_value = midi_package.evnt1;
+	MBNG_EVENT_ItemReceive(&item, midi_package.value, 1, 1);
+      }
+    } else {
+      // EXTRA for button/led matrices
+      int matrix = (pool_item->hw_id & 0x0fff) - 1;
+      int num_pins = -1;
+
+      switch( pool_item->hw_id & 0xf000 ) {
+      case MBNG_EVENT_CONTROLLER_BUTTON_MATRIX: {
+	if( matrix >= 0 && matrix < MBNG_PATCH_NUM_MATRIX_DIN ) {
+	  mbng_patch_matrix_din_entry_t *m = (mbng_patch_matrix_din_entry_t *)&mbng_patch_matrix_din[matrix];
+
+	  if( m->sr_din1 ) {
+	    u8 row_size = m->sr_din2 ? 16 : 8;
+	    num_pins = row_size * row_size;
+	  }
+	}
+      } break;
+      case MBNG_EVENT_CONTROLLER_LED_MATRIX: {
+	if( matrix >= 0 && matrix < MBNG_PATCH_NUM_MATRIX_DOUT ) {
+	  mbng_patch_matrix_dout_entry_t *m = (mbng_patch_matrix_dout_entry_t *)&mbng_patch_matrix_dout[matrix];
+
+	  if( m->sr_dout_r1 && !pool_item->flags.led_matrix_pattern ) {
+	    u8 row_size = m->sr_dout_r2 ? 16 : 8; // we assume that the same condition is valid for dout_g2 and dout_b2
+	    num_pins = row_size * row_size;
+	  }
+	}
+      } break;
+      }
+
+      if( num_pins >= 0 ) {
+	int first_evnt1 = stream[1];
+	if( evnt1 >= first_evnt1 && evnt1 < (first_evnt1 + num_pins) ) {
+	  mbng_event_item_t item;
+	  MBNG_EVENT_ItemCopy2User(pool_item, &item);
+	  item.matrix_pin = evnt1 - first_evnt1;
+	  MBNG_EVENT_ItemReceive(&item, midi_package.value, 1, 1);
+	}
+      }
+    }
+  } else if( event_type <= MBNG_EVENT_TYPE_AFTERTOUCH ) {
+    mbng_event_item_t item;
+    MBNG_EVENT_ItemCopy2User(pool_item, &item);
+    MBNG_EVENT_ItemReceive(&item, evnt1, 1, 1);
+  } else if( event_type == MBNG_EVENT_TYPE_PITCHBEND ) {
+    mbng_event_item_t item;
+    MBNG_EVENT_ItemCopy2User(pool_item, &item);
+    MBNG_EVENT_ItemReceive(&item, evnt1 | ((u16)midi_package.value << 7), 1, 1);
+  } else if( event_type == MBNG_EVENT_TYPE_NRPN ) {
+    u8 *stream = &pool_item->data_begin;
+    u16 expected_address = stream[1] | ((u16)stream[2] << 7);
+    mbng_event_nrpn_format_t nrpn_format = stream[3];
+    if( nrpn_address == expected_address &&
+	(!nrpn_msb_only || nrpn_format == MBNG_EVENT_NRPN_FORMAT_MSB_ONLY) ) {
+      mbng_event_item_t item;
+      MBNG_EVENT_ItemCopy2User(pool_item, &item);
+
+      if( nrpn_format == MBNG_EVENT_NRPN_FORMAT_MSB_ONLY )
+	MBNG_EVENT_ItemReceive(&item, nrpn_value / 128, 1, 1);
+      else
+	MBNG_EVENT_ItemReceive(&item, nrpn_value, 1, 1);
+    }
+  } else if( event_type >= MBNG_EVENT_TYPE_CLOCK && event_type <= MBNG_EVENT_TYPE_CONT ) {
+    mbng_event_item_t item;
+    MBNG_EVENT_ItemCopy2User(pool_item, &item);
+    MBNG_EVENT_ItemReceive(&item, 0, 1, 1);
+  } else {
+    // no additional event types yet...
+  }
+
+  return 0; // no error
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //! This function should be called from APP_MIDI_NotifyPackage whenver a new
 //! MIDI event has been received
@@ -4625,104 +4973,53 @@ s32 MBNG_EVENT_MIDI_NotifyPackage(mios32_midi_port_t port, mios32_midi_package_t
 
   // search in pool for matching events
   u8 evnt0 = midi_package.evnt0;
-  u8 evnt1 = midi_package.evnt1;
+
+#if MBNG_EVENT_INDEX_MAX_ITEMS
+  if( event_index_valid ) {
+    u8 evnt1 = midi_package.evnt1;
+
+    // only items with matching first byte are considered:
+    // merge the items which are matching on the second byte with the items which are
+    // matching on any second byte, so that they are processed in the order of the pool
+    u32 pos_exact = event_index_rx_num;
+    u32 end_exact = event_index_rx_num;
+    if( evnt1 < 0x80 ) {
+      u32 key = ((u32)evnt0 << 8) | evnt1;
+      pos_exact = MBNG_EVENT_IndexLowerBound(event_index_rx, event_index_rx_num, key << 16, MBNG_EVENT_INDEX_RX);
+      end_exact = MBNG_EVENT_IndexLowerBound(event_index_rx, event_index_rx_num, (key+1) << 16, MBNG_EVENT_INDEX_RX);
+    }
+
+    u32 key_any = ((u32)evnt0 << 8) | MBNG_EVENT_INDEX_RX_ANY;
+    u32 pos_any = MBNG_EVENT_IndexLowerBound(event_index_rx, event_index_rx_num, key_any << 16, MBNG_EVENT_INDEX_RX);
+    u32 end_any = MBNG_EVENT_IndexLowerBound(event_index_rx, event_index_rx_num, (key_any+1) << 16, MBNG_EVENT_INDEX_RX);
+
+    u8 generation = event_index_generation;
+    while( pos_exact < end_exact || pos_any < end_any ) {
+      u16 pool_offset;
+      if( pos_any >= end_any || (pos_exact < end_exact && event_index_rx[pos_exact] < event_index_rx[pos_any]) )
+	pool_offset = event_index_rx[pos_exact++];
+      else
+	pool_offset = event_index_rx[pos_any++];
+
+      mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[pool_offset];
+      MBNG_EVENT_MIDI_ReceivePoolItem(pool_item, port_mask, midi_package, nrpn_address, nrpn_value, nrpn_msb_only);
+
+      // stop if the pool has been re-arranged by the item (the remaining positions are not valid anymore)
+      if( generation != event_index_generation )
+	break;
+    }
+
+    return 0; // no error
+  }
+#endif
+
   u8 *pool_ptr = (u8 *)&event_pool[0];
   u32 i;
   for(i=0; i<event_pool_num_items; ++i) {
     mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)pool_ptr;
     if( pool_item->data_begin == evnt0 && pool_item->len_stream ) { // timing critical
       // first byte is matching - now we've a bit more time for checking
-      
-      if( (pool_item->hw_id & 0xf000) == MBNG_EVENT_CONTROLLER_SENDER ) { // a sender doesn't receive
-	pool_ptr += pool_item->len;
-	continue;
-      }
-
-      if( !(pool_item->enabled_ports & port_mask) ) { // port not enabled
-	pool_ptr += pool_item->len;
-	continue;
-      }
-
-      mbng_event_type_t event_type = ((mbng_event_flags_t)pool_item->flags).type;
-      if( event_type <= MBNG_EVENT_TYPE_CC ) {
-	u8 *stream = &pool_item->data_begin;
-	if( pool_item->flags.use_any_key_or_cc || stream[1] == evnt1 ) { // || pool_item->secondary_value >= 128 || evnt1 == pool_item->secondary_value ) {
-	  mbng_event_item_t item;
-	  MBNG_EVENT_ItemCopy2User(pool_item, &item);
-	  if( item.flags.use_key_or_cc ) {
-	    item.secondary_value = midi_package.value;
-	    MBNG_EVENT_ItemReceive(&item, midi_package.evnt1, 1, 1);
-	  } else {
-	    item.secondary_value = midi_package.evnt1;
-	    MBNG_EVENT_ItemReceive(&item, midi_package.value, 1, 1);
-	  }
-	} else {
-	  // EXTRA for button/led matrices
-	  int matrix = (pool_item->hw_id & 0x0fff) - 1;
-	  int num_pins = -1;
-
-	  switch( pool_item->hw_id & 0xf000 ) {
-	  case MBNG_EVENT_CONTROLLER_BUTTON_MATRIX: {
-	    if( matrix >= 0 && matrix < MBNG_PATCH_NUM_MATRIX_DIN ) {
-	      mbng_patch_matrix_din_entry_t *m = (mbng_patch_matrix_din_entry_t *)&mbng_patch_matrix_din[matrix];
-
-	      if( m->sr_din1 ) {
-		u8 row_size = m->sr_din2 ? 16 : 8;
-		num_pins = row_size * row_size;
-	      }
-	    }
-	  } break;
-	  case MBNG_EVENT_CONTROLLER_LED_MATRIX: {
-	    if( matrix >= 0 && matrix < MBNG_PATCH_NUM_MATRIX_DOUT ) {
-	      mbng_patch_matrix_dout_entry_t *m = (mbng_patch_matrix_dout_entry_t *)&mbng_patch_matrix_dout[matrix];
-
-	      if( m->sr_dout_r1 && !pool_item->flags.led_matrix_pattern ) {
-		u8 row_size = m->sr_dout_r2 ? 16 : 8; // we assume that the same condition is valid for dout_g2 and dout_b2
-		num_pins = row_size * row_size;
-	      }
-	    }
-	  } break;
-	  }
-
-	  if( num_pins >= 0 ) {
-	    int first_evnt1 = stream[1];
-	    if( evnt1 >= first_evnt1 && evnt1 < (first_evnt1 + num_pins) ) {
-	      mbng_event_item_t item;
-	      MBNG_EVENT_ItemCopy2User(pool_item, &item);
-	      item.matrix_pin = evnt1 - first_evnt1;
-	      MBNG_EVENT_ItemReceive(&item, midi_package.value, 1, 1);
-	    }
-	  }
-	}
-      } else if( event_type <= MBNG_EVENT_TYPE_AFTERTOUCH ) {
-	mbng_event_item_t item;
-	MBNG_EVENT_ItemCopy2User(pool_item, &item);
-	MBNG_EVENT_ItemReceive(&item, evnt1, 1, 1);
-      } else if( event_type == MBNG_EVENT_TYPE_PITCHBEND ) {
-	mbng_event_item_t item;
-	MBNG_EVENT_ItemCopy2User(pool_item, &item);
-	MBNG_EVENT_ItemReceive(&item, evnt1 | ((u16)midi_package.value << 7), 1, 1);
-      } else if( event_type == MBNG_EVENT_TYPE_NRPN ) {
-	u8 *stream = &pool_item->data_begin;
-	u16 expected_address = stream[1] | ((u16)stream[2] << 7);
-	mbng_event_nrpn_format_t nrpn_format = stream[3];
-	if( nrpn_address == expected_address &&
-	    (!nrpn_msb_only || nrpn_format == MBNG_EVENT_NRPN_FORMAT_MSB_ONLY) ) {
-	  mbng_event_item_t item;
-	  MBNG_EVENT_ItemCopy2User(pool_item, &item);
-
-	  if( nrpn_format == MBNG_EVENT_NRPN_FORMAT_MSB_ONLY )
-	    MBNG_EVENT_ItemReceive(&item, nrpn_value / 128, 1, 1);
-	  else
-	    MBNG_EVENT_ItemReceive(&item, nrpn_value, 1, 1);
-	}
-      } else if( event_type >= MBNG_EVENT_TYPE_CLOCK && event_type <= MBNG_EVENT_TYPE_CONT ) {
-	mbng_event_item_t item;
-	MBNG_EVENT_ItemCopy2User(pool_item, &item);
-	MBNG_EVENT_ItemReceive(&item, 0, 1, 1);
-      } else {
-	// no additional event types yet...
-      }
+      MBNG_EVENT_MIDI_ReceivePoolItem(pool_item, port_mask, midi_package, nrpn_address, nrpn_value, nrpn_msb_only);
     }
     pool_ptr += pool_item->len;
   }
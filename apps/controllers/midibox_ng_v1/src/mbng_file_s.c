@@ -467,7 +467,7 @@ s32 MBNG_FILE_S_Write(char *filename, int snapshot)
     if( status >= 0 ) {
       u32 continue_ix = 0;
       do {
-	u16 id;
+	mbng_event_item_id_t id;
 	s16 value;
 	u8 secondary_value;
 
@@ -148,6 +148,10 @@ extern char mbng_patch_max72xx_spi_rc_pin;
 // in this case, multiple strings concurrently sent to the same port won't be merged correctly anymore.
 #define MIDI_ROUTER_SYSEX_BUFFER_SIZE 16
 
+// use a dispatch table instead of scanning all router nodes for each incoming package
+// (MIDI_ROUTER_NodesChanged() is called whenever midi_router_node[] is changed)
+#define MIDI_ROUTER_DISPATCH_TABLE 1
+
 // sequencer
 #define SEQ_MIDI_OUT_MAX_EVENTS    32
 
@@ -189,4 +193,9 @@ extern void APP_J16SemaphoreGive(void);
 #define MIOS32_SPI_MIDI_MUTEX_TAKE { APP_J16SemaphoreTake(); }
 #define MIOS32_SPI_MIDI_MUTEX_GIVE { APP_J16SemaphoreGive(); }
 
+// sector cache of the FatFs disk layer, 512 bytes per sector (see modules/fatfs/src/diskio.c)
+#if defined(MIOS32_FAMILY_STM32F4xx)
+#define DISKIO_CACHE_NUM_SECTORS 8
+#endif
+
 #endif /* _MIOS32_CONFIG_H */
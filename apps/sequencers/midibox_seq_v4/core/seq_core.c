@@ -508,33 +508,7 @@ s32 SEQ_CORE_Handler(void)
 
 	// load new pattern/song step if reference step reached measure
 	// (this code is outside SEQ_CORE_Tick() to save stack space!)
-	if( (bpm_tick % 96) == 20 ) {
-	  if( SEQ_SONG_ActiveGet() ) {
-	    // to handle the case as described under http://midibox.org/forums/topic/19774-question-about-expected-behaviour-in-song-mode/
-	    // seq_core_steps_per_measure was lower than seq_core_steps_per_pattern
-	    u32 song_switch_step = (seq_core_steps_per_measure < seq_core_steps_per_pattern) ? seq_core_steps_per_measure : seq_core_steps_per_pattern;
-	    if( ( seq_song_guide_track && seq_song_guide_track <= SEQ_CORE_NUM_TRACKS &&
-		  seq_core_state.ref_step_song == seq_cc_trk[seq_song_guide_track-1].length) ||
-		(!seq_song_guide_track && seq_core_state.ref_step_song == song_switch_step) ) {
-	      
-	      if( seq_song_guide_track ) {
-		// request synch-to-measure for all tracks
-		SEQ_CORE_ManualSynchToMeasure(0xffff);
-		
-		// corner case: we will load new tracks and the length of the guide track could change
-		// in order to ensure that the reference step jumps back to 0, we've to force this here:
-		seq_core_state.FORCE_REF_STEP_RESET = 1;
-	      }
-	      
-	      SEQ_SONG_NextPos();
-	    }
-	  } else {
-	    if( seq_core_options.SYNCHED_PATTERN_CHANGE &&
-		seq_core_state.ref_step == seq_core_steps_per_pattern ) {
-	      SEQ_PATTERN_Handler();
-	    }
-	  }
-	}
+	SEQ_CORE_PatternSwitchHandler(bpm_tick);
       }
     }
   } while( again && num_loops < 10 );
@@ -543,6 +517,49 @@ s32 SEQ_CORE_Handler(void)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Loads the next song position (song mode) or the requested patterns
+// (phrase mode with synched pattern change) once the reference step
+// reached the end of the measure.
+// Has to be called after each SEQ_CORE_Tick(), it's shared by the realtime
+// handler and the MIDI file exporter so that exported songs switch at
+// exactly the same ticks like during playback.
+/////////////////////////////////////////////////////////////////////////////
+s32 SEQ_CORE_PatternSwitchHandler(u32 bpm_tick)
+{
+  if( (bpm_tick % 96) != 20 )
+    return 0; // no switch point
+
+  if( SEQ_SONG_ActiveGet() ) {
+    // to handle the case as described under http://midibox.org/forums/topic/19774-question-about-expected-behaviour-in-song-mode/
+    // seq_core_steps_per_measure was lower than seq_core_steps_per_pattern
+    u32 song_switch_step = (seq_core_steps_per_measure < seq_core_steps_per_pattern) ? seq_core_steps_per_measure : seq_core_steps_per_pattern;
+    if( ( seq_song_guide_track && seq_song_guide_track <= SEQ_CORE_NUM_TRACKS &&
+	  seq_core_state.ref_step_song == seq_cc_trk[seq_song_guide_track-1].length) ||
+	(!seq_song_guide_track && seq_core_state.ref_step_song == song_switch_step) ) {
+
+      if( seq_song_guide_track ) {
+	// request synch-to-measure for all tracks
+	SEQ_CORE_ManualSynchToMeasure(0xffff);
+
+	// corner case: we will load new tracks and the length of the guide track could change
+	// in order to ensure that the reference step jumps back to 0, we've to force this here:
+	seq_core_state.FORCE_REF_STEP_RESET = 1;
+      }
+
+      SEQ_SONG_NextPos();
+    }
+  } else {
+    if( seq_core_options.SYNCHED_PATTERN_CHANGE &&
+	seq_core_state.ref_step == seq_core_steps_per_pattern ) {
+      SEQ_PATTERN_Handler();
+    }
+  }
+
+  return 0; // no error
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // This function plays all "off" events
 // Should be called on sequencer reset/restart/pause to avoid hanging notes
@@ -229,6 +229,7 @@ extern s32 SEQ_CORE_ScheduleEvent(seq_core_trk_t *t, seq_cc_trk_t *tcc, mios32_m
 extern s32 SEQ_CORE_Reset(u32 bpm_start);
 extern s32 SEQ_CORE_PlayOffEvents(void);
 extern s32 SEQ_CORE_Tick(u32 bpm_tick, s8 export_track, u8 mute_nonloopback_tracks);
+extern s32 SEQ_CORE_PatternSwitchHandler(u32 bpm_tick);
 
 extern s32 SEQ_CORE_Handler(void);
 
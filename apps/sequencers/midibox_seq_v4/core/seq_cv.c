@@ -82,7 +82,7 @@ s32 SEQ_CV_Init(u32 mode)
 #if defined(MIOS32_FAMILY_STM32F10x)
   for(i=8; i<12; ++i)
     MIOS32_BOARD_J5_PinInit(i, MIOS32_BOARD_PIN_MODE_INPUT_PD);
-#elif defined(MIOS32_FAMILY_STM32F4xx)
+#elif defined(MIOS32_FAMILY_STM32F4xx) || defined(MIOS32_FAMILY_LINUX)
   for(i=6; i<7; ++i)
     MIOS32_BOARD_J5_PinInit(i, MIOS32_BOARD_PIN_MODE_INPUT_PD);
   // potential conflict with LCD driver, keep these pins in current state
@@ -444,7 +444,7 @@ s32 SEQ_CV_Update(void)
     if( seq_hwcfg_j5_enabled ) {
 #if defined(MIOS32_FAMILY_STM32F10x)
       MIOS32_BOARD_J5_PinSet(9, start_stop);
-#elif defined(MIOS32_FAMILY_STM32F4xx)
+#elif defined(MIOS32_FAMILY_STM32F4xx) || defined(MIOS32_FAMILY_LINUX)
       MIOS32_BOARD_J10_PinSet(9, start_stop);
 #elif defined(MIOS32_FAMILY_LPC17xx)
       MIOS32_BOARD_J28_PinSet(1, start_stop);
@@ -458,7 +458,7 @@ s32 SEQ_CV_Update(void)
   // DIN Sync Pulse at J5C.A8
 #if defined(MIOS32_FAMILY_STM32F10x)
     MIOS32_BOARD_J5_PinSet(8, (clk_sr_value & 1));
-#elif defined(MIOS32_FAMILY_STM32F4xx)
+#elif defined(MIOS32_FAMILY_STM32F4xx) || defined(MIOS32_FAMILY_LINUX)
     MIOS32_BOARD_J10_PinSet(8, (clk_sr_value & 1));
 #elif defined(MIOS32_FAMILY_LPC17xx)
     MIOS32_BOARD_J28_PinSet(0, (clk_sr_value & 1));
@@ -501,7 +501,7 @@ s32 SEQ_CV_Update(void)
       MIOS32_BOARD_J5_PinSet(10, (new_gates & 0x40) ? 1 : 0);
       MIOS32_BOARD_J5_PinSet(11, (new_gates & 0x80) ? 1 : 0);
 #endif
-#elif defined(MIOS32_FAMILY_STM32F4xx)
+#elif defined(MIOS32_FAMILY_STM32F4xx) || defined(MIOS32_FAMILY_LINUX)
 #ifndef MBSEQV4L
       // no special routing required for STM32F4
       // MBSEQV4L: use shift register gates!
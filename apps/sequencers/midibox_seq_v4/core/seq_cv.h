@@ -97,8 +97,8 @@ extern s32 SEQ_CV_ResetAllChannels(void);
 // Export global variables
 /////////////////////////////////////////////////////////////////////////////
 
-u16 seq_cv_clkout_divider[SEQ_CV_NUM_CLKOUT];
-u8  seq_cv_clkout_pulsewidth[SEQ_CV_NUM_CLKOUT];
+extern u16 seq_cv_clkout_divider[SEQ_CV_NUM_CLKOUT];
+extern u8  seq_cv_clkout_pulsewidth[SEQ_CV_NUM_CLKOUT];
 
 
 #endif /* _SEQ_CV_H */
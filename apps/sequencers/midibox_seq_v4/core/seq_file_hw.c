@@ -1441,7 +1441,7 @@ s32 SEQ_FILE_HW_Read(void)
 	      MIOS32_BOARD_J5_PinInit(i, pin_mode);
 	      MIOS32_BOARD_J5_PinSet(i, 0);
 	    }
-#elif defined(MIOS32_FAMILY_STM32F4xx)
+#elif defined(MIOS32_FAMILY_STM32F4xx) || defined(MIOS32_FAMILY_LINUX)
 	    // pin J5.A6 and J5.A7 used as gates
 	    for(i=6; i<8; ++i) {
 	      MIOS32_BOARD_J5_PinInit(i, pin_mode);
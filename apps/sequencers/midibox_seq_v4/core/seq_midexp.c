@@ -32,6 +32,7 @@
 #include "seq_song.h"
 #include "seq_midi_port.h"
 #include "seq_midi_router.h"
+#include "seq_random.h"
 #include "seq_ui.h"
 
 #include "file.h"
@@ -44,6 +45,22 @@
 #define DEBUG_VERBOSE_LEVEL 0
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// size of the buffer which collects bytes before they are written into the file
+#ifndef SEQ_MIDEXP_WRITE_BUFFER_SIZE
+#define SEQ_MIDEXP_WRITE_BUFFER_SIZE 512
+#endif
+
+// the random generator is re-seeded before each track is rendered,
+// so that repeated exports of the same session result into identical files
+#ifndef SEQ_MIDEXP_RANDOM_SEED
+#define SEQ_MIDEXP_RANDOM_SEED 0xdeadbabe
+#endif
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Local variables
 /////////////////////////////////////////////////////////////////////////////
@@ -54,6 +71,13 @@ static u8 export_steps_per_measure;
 
 static s8 export_track;
 
+static char *write_path; // NULL: render only (benchmark/regression check)
+static s32 write_status;
+static u16 write_buffer_pos;
+static u8 write_buffer[SEQ_MIDEXP_WRITE_BUFFER_SIZE];
+
+static seq_midexp_render_result_t render_result;
+
 /////////////////////////////////////////////////////////////////////////////
 // Initialisation
 /////////////////////////////////////////////////////////////////////////////
@@ -114,6 +138,33 @@ s32 SEQ_MIDEXP_ExportStepsPerMeasureSet(u8 steps_per_measure)
 /////////////////////////////////////////////////////////////////////////////
 // help functions
 /////////////////////////////////////////////////////////////////////////////
+
+// writes the collected bytes into the file
+// the file stays open during the whole rendering
+static s32 SEQ_MIDEXP_WriteFlush(void)
+{
+  if( write_buffer_pos && write_path != NULL )
+    write_status |= FILE_WriteBuffer(write_buffer, write_buffer_pos);
+  write_buffer_pos = 0;
+
+  return (write_status < 0) ? write_status : 0;
+}
+
+// all bytes of the MIDI file are passed through this function
+// the checksum (FNV-1a) allows to compare the output of different runs
+static s32 SEQ_MIDEXP_WriteByte(u8 byte)
+{
+  render_result.checksum = (render_result.checksum ^ byte) * 16777619U;
+  ++render_result.file_size;
+
+  write_buffer[write_buffer_pos++] = byte;
+  if( write_buffer_pos >= SEQ_MIDEXP_WRITE_BUFFER_SIZE )
+    SEQ_MIDEXP_WriteFlush();
+
+  return (write_status < 0) ? write_status : 0;
+}
+
+
 static s32 SEQ_MIDEXP_WriteWord(u32 word, u8 len)
 {
   int i;
@@ -121,7 +172,7 @@ static s32 SEQ_MIDEXP_WriteWord(u32 word, u8 len)
 
   // ensure big endian coding, therefore byte writes
   for(i=0; i<len; ++i)
-    status |= FILE_WriteByte((u8)(word >> (8*(len-1-i))));
+    status |= SEQ_MIDEXP_WriteByte((u8)(word >> (8*(len-1-i))));
 
   return (status < 0) ? status : len;
 }
@@ -142,7 +193,7 @@ static s32 SEQ_MIDEXP_WriteVarLen(u32 value)
   int num_bytes = 0;
   while( 1 ) {
     ++num_bytes;
-    status |= FILE_WriteByte((u8)(buffer & 0xff));
+    status |= SEQ_MIDEXP_WriteByte((u8)(buffer & 0xff));
     if( buffer & 0x80 )
       buffer >>= 8;
     else
@@ -205,6 +256,7 @@ static s32 Hook_MIDI_SendPackage(mios32_midi_port_t port, mios32_midi_package_t
     export_trk_size += SEQ_MIDEXP_WriteVarLen(delta);
     export_trk_size += SEQ_MIDEXP_WriteWord(word, num_bytes);
     export_trk_tick = export_tick;
+    ++render_result.num_events;
   }
 
   return 0; // no error
@@ -229,11 +281,100 @@ static s32 Hook_BPM_Set(float bpm)
 
 
 /////////////////////////////////////////////////////////////////////////////
-// Export to MIDI file based on selected parameters
+// Renders a single track into the MIDI file
+// The sequencer is clocked by the virtual export_tick counter as fast as
+// possible, all events are forwarded to Hook_MIDI_SendPackage()
+// Returns the number of rendered ticks
+/////////////////////////////////////////////////////////////////////////////
+static u32 SEQ_MIDEXP_RenderTrack(u32 number_ticks, u8 write_tempo)
+{
+  u32 ticks_per_step = SEQ_BPM_PPQN_Get() / 4;
+  u8 song_mode = seq_midexp_mode == SEQ_MIDEXP_MODE_Song;
+
+  // reset sequencer and random generator, so that all tracks start at the same conditions
+  SEQ_SONG_Reset(0);
+  SEQ_CORE_Reset(0);
+  SEQ_RANDOM_Gen(SEQ_MIDEXP_RANDOM_SEED);
+
+  // write Track header
+  export_trk_size = 0;
+  export_trk_tick = 0;
+  SEQ_MIDEXP_WriteWord(0x4d54726b, 4); // "MTrk"
+  SEQ_MIDEXP_WriteWord(export_trk_size, 4); // Placeholder
+
+  // add track name as meta event
+  {
+    char buffer[20];
+
+    export_trk_size += SEQ_MIDEXP_WriteVarLen(0);
+    export_trk_size += SEQ_MIDEXP_WriteWord(0xff, 1); // Meta
+    export_trk_size += SEQ_MIDEXP_WriteWord(0x03, 1); // Sequence/Track Name
+    export_trk_size += SEQ_MIDEXP_WriteVarLen(4); // String Length (4 chars)
+    sprintf(buffer, "G%dT%d",
+	    (export_track / SEQ_CORE_NUM_TRACKS_PER_GROUP) + 1,
+	    (export_track % SEQ_CORE_NUM_TRACKS_PER_GROUP) + 1);
+    int i;
+    for(i=0; i<4; ++i)
+      SEQ_MIDEXP_WriteByte(buffer[i]);
+    export_trk_size += 4;
+  }
+
+  // the first track contains the tempo
+  if( write_tempo ) {
+    u32 us_per_quarter = (u32)(60000000.0 / SEQ_BPM_Get());
+
+    export_trk_size += SEQ_MIDEXP_WriteVarLen(0);
+    export_trk_size += SEQ_MIDEXP_WriteWord(0xff, 1); // Meta
+    export_trk_size += SEQ_MIDEXP_WriteWord(0x51, 1); // Set Tempo
+    export_trk_size += SEQ_MIDEXP_WriteVarLen(3);
+    export_trk_size += SEQ_MIDEXP_WriteWord(us_per_quarter, 3);
+  }
+
+  // start export of selected track
+  u32 end_tick = number_ticks;
+  for(export_tick=0; export_tick < end_tick; ++export_tick) {
+    // propagate tick
+    SEQ_CORE_Tick(export_tick, export_track, 0);
+
+    // load new songpos/pattern if reference step reached measure
+    SEQ_CORE_PatternSwitchHandler(export_tick);
+
+    // stop at the end of the current step once the song reached the "End" position
+    if( song_mode && end_tick == number_ticks && SEQ_SONG_FinishedGet() ) {
+      u32 song_end_tick = ((export_tick / ticks_per_step) + 1) * ticks_per_step;
+      if( song_end_tick < end_tick )
+	end_tick = song_end_tick;
+    }
+
+    // forward MIDI events to Hook_MIDI_SendPackage()
+    SEQ_MIDI_OUT_Handler();
+  }
+
+  // play events of the last tick and off events, so that no note will hang
+  export_tick = end_tick;
+  SEQ_MIDI_OUT_Handler();
+  SEQ_CORE_PlayOffEvents();
+
+  // End of Track
+  export_trk_size += SEQ_MIDEXP_WriteVarLen(export_tick - export_trk_tick);
+  export_trk_size += SEQ_MIDEXP_WriteWord(0xff, 1); // Meta
+  export_trk_size += SEQ_MIDEXP_WriteWord(0x2f, 1); // End of Track
+  export_trk_size += SEQ_MIDEXP_WriteVarLen(0);
+
+  return end_tick;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Renders the selected tracks/song (see SEQ_MIDEXP_ModeSet) into a MIDI file
+// If path is NULL, no file will be written. This allows to measure the
+// performance of the sequencer core, and to check for regressions by
+// comparing the checksum of the rendered data.
+// The optional result will contain statistics of the rendering
 // returns 0 on success
 // returns < 0 on misc error (see MIOS terminal)
 /////////////////////////////////////////////////////////////////////////////
-s32 SEQ_MIDEXP_GenerateFile(char *path)
+s32 SEQ_MIDEXP_Render(char *path, seq_midexp_render_result_t *result)
 {
   s32 status = 0;
 
@@ -263,6 +404,13 @@ s32 SEQ_MIDEXP_GenerateFile(char *path)
   MUTEX_SDCARD_TAKE;
   MUTEX_MIDIOUT_TAKE;
 
+  u32 render_start_timestamp = MIOS32_TIMESTAMP_Get();
+  memset(&render_result, 0, sizeof(seq_midexp_render_result_t));
+  render_result.checksum = 2166136261U; // FNV-1a
+  write_path = path;
+  write_status = 0;
+  write_buffer_pos = 0;
+
   // install private hooks for MIDI Scheduler
   SEQ_MIDI_OUT_Callback_MIDI_SendPackage_Set(Hook_MIDI_SendPackage);
   SEQ_MIDI_OUT_Callback_BPM_IsRunning_Set(Hook_BPM_IsRunning);
@@ -270,28 +418,34 @@ s32 SEQ_MIDEXP_GenerateFile(char *path)
   SEQ_MIDI_OUT_Callback_BPM_Set_Set(Hook_BPM_Set);
 
 #if DEBUG_VERBOSE_LEVEL >= 1
-  DEBUG_MSG("[SEQ_MIDEXP_WriteFile] Export to '%s' started\n", path);
+  DEBUG_MSG("[SEQ_MIDEXP_Render] Export to '%s' started\n", path ? path : "<no file>");
 #endif
 
-  if( (status=FILE_WriteOpen(path, 1)) < 0 ) {
+  // song position changes could store the song (SEQ_SONG_ACTION_JmpSong), which
+  // isn't possible while the MIDI file is open -> store it now, so that
+  // nothing is left to be stored during the rendering
+  if( path != NULL )
+    SEQ_SONG_Save(SEQ_SONG_NumGet());
+
+  if( path != NULL && (status=FILE_WriteOpen(path, 1)) < 0 ) {
 #if DEBUG_VERBOSE_LEVEL >= 1
-    DEBUG_MSG("[SEQ_MIDEXP_WriteFile] Failed to open/create %s, status: %d\n", path, status);
+    DEBUG_MSG("[SEQ_MIDEXP_Render] Failed to open/create %s, status: %d\n", path, status);
 #endif
+    write_path = NULL; // nothing to close
     status = -1; // file error
     goto error;
   }
 
   // write file header
   u32 header_size = 6;
-  status |= FILE_WriteBuffer((u8*)"MThd", 4);
-  status |= SEQ_MIDEXP_WriteWord(header_size, 4);
-  status |= SEQ_MIDEXP_WriteWord(1, 2); // MIDI File Format
-  status |= SEQ_MIDEXP_WriteWord(last_track-first_track+1, 2); // Number of Tracks
-  status |= SEQ_MIDEXP_WriteWord(ppqn, 2); // PPQN
-  status |= FILE_WriteClose();
+  SEQ_MIDEXP_WriteWord(0x4d546864, 4); // "MThd"
+  SEQ_MIDEXP_WriteWord(header_size, 4);
+  SEQ_MIDEXP_WriteWord(1, 2); // MIDI File Format
+  SEQ_MIDEXP_WriteWord(last_track-first_track+1, 2); // Number of Tracks
+  SEQ_MIDEXP_WriteWord(ppqn, 2); // PPQN
 
   // check file status
-  if( status < 0 ) {
+  if( SEQ_MIDEXP_WriteFlush() < 0 ) {
     // File Access Error
     status = -2;
     goto error;
@@ -306,6 +460,7 @@ s32 SEQ_MIDEXP_GenerateFile(char *path)
   SEQ_MIDPLY_DisableFile(); // ensure that MIDI file won't be played in parallel... just disable it
 
   // play off events
+  // (the hooks are already installed, only the current track is recorded -> nothing will be written here)
   SEQ_MIDI_ROUTER_SendMIDIClockEvent(0xfc, 0);
   SEQ_CORE_PlayOffEvents();
   SEQ_MIDPLY_PlayOffEvents();
@@ -314,115 +469,65 @@ s32 SEQ_MIDEXP_GenerateFile(char *path)
   SEQ_SONG_ActiveSet(seq_midexp_mode == SEQ_MIDEXP_MODE_Song);
 
   // generate events track by track
+  // Note: the complete file can't be buffered in RAM, therefore each track is rendered in a separate pass.
+  // This doesn't cost much, since SEQ_CORE_Tick() only processes the exported track (+loopback tracks)
   for(export_track=first_track; export_track<=last_track; ++export_track) {
-
-    // print message on screen
-    char str_buffer[21];
-    sprintf(str_buffer, "Exporting G%dT%d to",
-	    (export_track / SEQ_CORE_NUM_TRACKS_PER_GROUP) + 1,
-	    (export_track % SEQ_CORE_NUM_TRACKS_PER_GROUP) + 1);
-
-    SEQ_UI_Msg(SEQ_UI_MSG_USER_R, 2000, str_buffer, path);
-
-#ifndef MIOS32_FAMILY_EMULATION
-    // workaround: give UI some time to update screen!
-    // background: buttons have higher priority than LCD output, especially with MUTEX_MIDI_OUT the priority
-    // will be even higher, so that the LCD update task is starving.
-    // waiting for some mS ensures that the other tasks are serviced.
-    vTaskDelay(100 / portTICK_RATE_MS);
-#endif
-
-    // reset sequencer
-    SEQ_SONG_Reset(0);
-    SEQ_CORE_Reset(0);
-
-    // open file again
-    if( (status=FILE_WriteOpen(path, 0)) < 0 ) {
-#if DEBUG_VERBOSE_LEVEL >= 1
-      DEBUG_MSG("[SEQ_MIDEXP_WriteFile] Failed to open %s again, status: %d\n", path, status);
-#endif
-      status = -3; // file re-open error
-      goto error;
-    }
-
-    // write Track header
-    u32 track_header_filepos = FILE_WriteGetCurrentSize();
-    status |= FILE_WriteSeek(track_header_filepos);
-    export_trk_size = 0;
-    export_trk_tick = 0;
-    status |= FILE_WriteBuffer((u8*)"MTrk", 4);
-    status |= SEQ_MIDEXP_WriteWord(export_trk_size, 4); // Placeholder
-
-    // add track name as meta event
-    {
-      char buffer[20];
-
-      export_trk_size += SEQ_MIDEXP_WriteVarLen(0);
-      buffer[0] = 0xff; // Meta
-      export_trk_size += SEQ_MIDEXP_WriteWord(buffer[0], 1);
-      buffer[0] = 0x03; // Sequence/Track Name
-      export_trk_size += SEQ_MIDEXP_WriteWord(buffer[0], 1);
-      export_trk_size += SEQ_MIDEXP_WriteVarLen(4); // String Length (4 chars)
-      sprintf(buffer, "G%dT%d",
-	      (export_track / SEQ_CORE_NUM_TRACKS_PER_GROUP) + 1,
-	      (export_track % SEQ_CORE_NUM_TRACKS_PER_GROUP) + 1);
-      status |= FILE_WriteBuffer((u8*)buffer, 4);
-      export_trk_size += 4;
-    }
+    u32 track_header_filepos = render_result.file_size;
 
 #if DEBUG_VERBOSE_LEVEL >= 1
     // send debug message
-    DEBUG_MSG("[SEQ_MIDEXP_WriteFile] generating track G%dT%d at filepos %d\n",
+    DEBUG_MSG("[SEQ_MIDEXP_Render] generating track G%dT%d at filepos %d\n",
 	      (export_track / SEQ_CORE_NUM_TRACKS_PER_GROUP) + 1,
 	      (export_track % SEQ_CORE_NUM_TRACKS_PER_GROUP) + 1,
-	      track_header_filepos - 4);
+	      track_header_filepos);
 #endif
 
-    // start export of selected track
-    for(export_tick=0; export_tick < number_ticks; ++export_tick) {
-      // propagate tick
-      SEQ_CORE_Tick(export_tick, export_track, 0);
-
-      // load new songpos/pattern if reference step reached measure
-      if( seq_core_state.ref_step == seq_core_steps_per_pattern && (export_tick % 96) == 20 ) {
-	if( SEQ_SONG_ActiveGet() ) {
-	  SEQ_SONG_NextPos();
-	} else if( seq_core_options.SYNCHED_PATTERN_CHANGE ) {
-	  SEQ_PATTERN_Handler();
-	}
-      }
+    render_result.number_ticks = SEQ_MIDEXP_RenderTrack(number_ticks, export_track == first_track);
 
-      // forward MIDI events to Hook_MIDI_SendPackage()
-      SEQ_MIDI_OUT_Handler();
-    }
+    // track size is known now: include it into the checksum
+    int i;
+    for(i=0; i<4; ++i)
+      render_result.checksum = (render_result.checksum ^ (u8)(export_trk_size >> (8*(3-i)))) * 16777619U;
 
-    // close file
-    status |= FILE_WriteClose();
+    if( SEQ_MIDEXP_WriteFlush() < 0 ) {
+      status = -2; // file access error
+      goto error;
+    }
 
-    if( export_trk_size ) {
+    if( path != NULL ) {
       // switch back to first byte of track and write final track size
-      if( (status=FILE_WriteOpen(path, 0)) < 0 ) {
-#if DEBUG_VERBOSE_LEVEL >= 1
-	DEBUG_MSG("[SEQ_MIDEXP_WriteFile] Failed to open %s again, status: %d\n", path, status);
-#endif
-	status = -3; // file re-open error
+      u8 buffer[4];
+      for(i=0; i<4; ++i)
+	buffer[i] = (u8)(export_trk_size >> (8*(3-i)));
+
+      if( FILE_WriteSeek(track_header_filepos + 4) < 0 ||
+	  FILE_WriteBuffer(buffer, 4) < 0 ||
+	  FILE_WriteSeek(render_result.file_size) < 0 ) {
+	status = -3; // file seek error
 	goto error;
       }
-      status |= FILE_WriteSeek(track_header_filepos + 4);
-      status |= SEQ_MIDEXP_WriteWord(export_trk_size, 4);
-      status |= FILE_WriteClose();
     }
   }
 
 error:
+  if( write_path != NULL && FILE_WriteClose() < 0 && status >= 0 )
+    status = -2; // file access error
+  write_path = NULL;
+
   // MIDI scheduler: restore default MIDI/BPM handlers
   SEQ_MIDI_OUT_Callback_MIDI_SendPackage_Set(NULL);
   SEQ_MIDI_OUT_Callback_BPM_IsRunning_Set(NULL);
   SEQ_MIDI_OUT_Callback_BPM_TickGet_Set(NULL);
   SEQ_MIDI_OUT_Callback_BPM_Set_Set(NULL);
 
+  // bring sequencer back to start position
+  SEQ_SONG_Reset(0);
+  SEQ_CORE_Reset(0);
+
+  render_result.render_time_ms = MIOS32_TIMESTAMP_GetDelay(render_start_timestamp);
+
 #if DEBUG_VERBOSE_LEVEL >= 1
-  DEBUG_MSG("[SEQ_MIDEXP_WriteFile] Export to '%s' finished with status %d\n", path, status);
+  DEBUG_MSG("[SEQ_MIDEXP_Render] Export to '%s' finished with status %d after %d mS\n", path ? path : "<no file>", status, render_result.render_time_ms);
 #endif
 
   // no track exported anymore
@@ -432,5 +537,19 @@ error:
   MUTEX_MIDIOUT_GIVE;
   MUTEX_SDCARD_GIVE;
 
-  return 0; // no error
+  if( result != NULL )
+    *result = render_result;
+
+  return status;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Export to MIDI file based on selected parameters
+// returns 0 on success
+// returns < 0 on misc error (see MIOS terminal)
+/////////////////////////////////////////////////////////////////////////////
+s32 SEQ_MIDEXP_GenerateFile(char *path)
+{
+  return SEQ_MIDEXP_Render(path, NULL);
 }
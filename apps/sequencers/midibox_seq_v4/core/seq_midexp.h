@@ -31,6 +31,14 @@ typedef enum {
 // Global Types
 /////////////////////////////////////////////////////////////////////////////
 
+typedef struct {
+  u32 number_ticks;   // rendered ticks per track
+  u32 num_events;     // number of written MIDI events
+  u32 file_size;      // size of the MIDI file in bytes
+  u32 checksum;       // FNV-1a over the rendered data, allows to detect changes of the sequencer output
+  u32 render_time_ms; // rendering time in mS
+} seq_midexp_render_result_t;
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Prototypes
@@ -45,6 +53,7 @@ extern s32 SEQ_MIDEXP_ExportMeasuresSet(u16 measures);
 extern s32 SEQ_MIDEXP_ExportStepsPerMeasureGet(void);
 extern s32 SEQ_MIDEXP_ExportStepsPerMeasureSet(u8 steps_per_measure);
 
+extern s32 SEQ_MIDEXP_Render(char *path, seq_midexp_render_result_t *result);
 extern s32 SEQ_MIDEXP_GenerateFile(char *path);
 
 
@@ -510,7 +510,7 @@ static s32 SEQ_MIDI_SYSEX_SendAck(mios32_midi_port_t port, u8 ack_code, u8 ack_a
 
   // finally send SysEx stream
   MUTEX_MIDIOUT_TAKE;
-  s32 status = MIOS32_MIDI_SendSysEx(port, (u8 *)sysex_buffer, (u32)sysex_buffer_ptr - ((u32)&sysex_buffer[0]));
+  s32 status = MIOS32_MIDI_SendSysEx(port, (u8 *)sysex_buffer, (u32)(sysex_buffer_ptr - &sysex_buffer[0]));
   MUTEX_MIDIOUT_GIVE;
   return status;
 }
@@ -555,7 +555,7 @@ s32 SEQ_MIDI_SYSEX_REMOTE_SendMode(seq_midi_sysex_remote_mode_t mode)
 
   // finally send SysEx stream
   MUTEX_MIDIOUT_TAKE;
-  s32 status = MIOS32_MIDI_SendSysEx(seq_midi_sysex_remote_port, (u8 *)sysex_buffer, (u32)sysex_buffer_ptr - ((u32)&sysex_buffer[0]));
+  s32 status = MIOS32_MIDI_SendSysEx(seq_midi_sysex_remote_port, (u8 *)sysex_buffer, (u32)(sysex_buffer_ptr - &sysex_buffer[0]));
   MUTEX_MIDIOUT_GIVE;
   return status;
 }
@@ -587,7 +587,7 @@ s32 SEQ_MIDI_SYSEX_REMOTE_SendRefresh(void)
 
   // finally send SysEx stream
   MUTEX_MIDIOUT_TAKE;
-  s32 status = MIOS32_MIDI_SendSysEx(seq_midi_sysex_remote_active_port, (u8 *)sysex_buffer, (u32)sysex_buffer_ptr - ((u32)&sysex_buffer[0]));
+  s32 status = MIOS32_MIDI_SendSysEx(seq_midi_sysex_remote_active_port, (u8 *)sysex_buffer, (u32)(sysex_buffer_ptr - &sysex_buffer[0]));
   MUTEX_MIDIOUT_GIVE;
   return status;
 }
@@ -688,7 +688,7 @@ s32 SEQ_MIDI_SYSEX_REMOTE_Server_SendLCD(u8 x, u8 y, u8 *str, u8 len)
 
   // finally send SysEx stream
   MUTEX_MIDIOUT_TAKE;
-  s32 status = MIOS32_MIDI_SendSysEx(seq_midi_sysex_remote_port, (u8 *)sysex_buffer, (u32)sysex_buffer_ptr - ((u32)&sysex_buffer[0]));
+  s32 status = MIOS32_MIDI_SendSysEx(seq_midi_sysex_remote_port, (u8 *)sysex_buffer, (u32)(sysex_buffer_ptr - &sysex_buffer[0]));
   MUTEX_MIDIOUT_GIVE;
   return status;
 }
@@ -720,7 +720,7 @@ s32 SEQ_MIDI_SYSEX_REMOTE_Server_SendCharset(u8 charset){
 
   // finally send SysEx stream
   MUTEX_MIDIOUT_TAKE;
-  s32 status = MIOS32_MIDI_SendSysEx(seq_midi_sysex_remote_port, (u8 *)sysex_buffer, (u32)sysex_buffer_ptr - ((u32)&sysex_buffer[0]));
+  s32 status = MIOS32_MIDI_SendSysEx(seq_midi_sysex_remote_port, (u8 *)sysex_buffer, (u32)(sysex_buffer_ptr - &sysex_buffer[0]));
   MUTEX_MIDIOUT_GIVE;
   return status;
 }
@@ -761,7 +761,7 @@ s32 SEQ_MIDI_SYSEX_REMOTE_Server_SendLED(u8 first_sr, u8 *led_sr, u8 num_sr)
 
   // finally send SysEx stream
   MUTEX_MIDIOUT_TAKE;
-  s32 status = MIOS32_MIDI_SendSysEx(seq_midi_sysex_remote_port, (u8 *)sysex_buffer, (u32)sysex_buffer_ptr - ((u32)&sysex_buffer[0]));
+  s32 status = MIOS32_MIDI_SendSysEx(seq_midi_sysex_remote_port, (u8 *)sysex_buffer, (u32)(sysex_buffer_ptr - &sysex_buffer[0]));
   MUTEX_MIDIOUT_GIVE;
   return status;
 }
@@ -236,6 +236,16 @@ s32 SEQ_SONG_LoopCtrMaxGet(void)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Returns 1 if the song reached an "End" step (position won't be
+// incremented anymore), otherwise 0
+/////////////////////////////////////////////////////////////////////////////
+s32 SEQ_SONG_FinishedGet(void)
+{
+  return song_finished;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // reset the song sequencer
 /////////////////////////////////////////////////////////////////////////////
@@ -111,6 +111,8 @@ extern s32 SEQ_SONG_PosSet(u32 pos);
 extern s32 SEQ_SONG_LoopCtrGet(void);
 extern s32 SEQ_SONG_LoopCtrMaxGet(void);
 
+extern s32 SEQ_SONG_FinishedGet(void);
+
 extern s32 SEQ_SONG_Reset(u32 bpm_start);
 extern s32 SEQ_SONG_FetchPos(u8 force_immediate_change, u8 dont_dump_mixer_map);
 
@@ -18,6 +18,7 @@
 #include <mios32.h>
 #include <string.h>
 
+#include <seq_bpm.h>
 #include <seq_midi_out.h>
 #include <blm_scalar_master.h>
 #include <ff.h>
@@ -42,6 +43,7 @@
 #include "seq_blm.h"
 #include "seq_song.h"
 #include "seq_mixer.h"
+#include "seq_midexp.h"
 #include "seq_hwcfg.h"
 #include "seq_tpd.h"
 #include "seq_lcd_logo.h"
@@ -327,8 +329,12 @@ s32 SEQ_TERMINAL_ParseLine(char *input, void *_output_function)
 	  if( size > 0x10000 ) {
 	    out("ERROR: it isn't recommended to dump more than 64k at once!");
 	  } else {
+#if defined(MIOS32_FAMILY_LINUX)
+	    out("ERROR: not supported for the LINUX family (no target addresses)");
+#else
 	    u8 *ptr = (u8 *)begin_addr;
 	    MIOS32_MIDI_SendDebugHexDump(ptr, size);
+#endif
 	  }
 	}
       }	else {
@@ -393,6 +399,8 @@ s32 SEQ_TERMINAL_ParseLine(char *input, void *_output_function)
       SEQ_TERMINAL_PrintCurrentSong(out);
     } else if( strcmp(parameter, "grooves") == 0 ) {
       SEQ_TERMINAL_PrintGrooveTemplates(out);
+    } else if( strcmp(parameter, "render") == 0 ) {
+      SEQ_TERMINAL_RenderBenchmark(out);
     } else if( strcmp(parameter, "msd") == 0 ) {
       out("Mass Storage Device Mode not supported by this application!");
     } else if( strcmp(parameter, "tpd") == 0 ) {
@@ -866,6 +874,7 @@ s32 SEQ_TERMINAL_PrintHelp(void *_output_function)
   out("  mixer:          print current mixer map");
   out("  song:           print current song info");
   out("  grooves:        print groove templates");
+  out("  render:         benchmark the MIDI export without writing a file (seq. stopped)");
   out("  bookmarks:      print bookmarks");
   out("  router:         print MIDI router info");
   out("  tpd <string>:   print a scrolled text on the TPD");
@@ -1190,6 +1199,36 @@ s32 SEQ_TERMINAL_PrintGrooveTemplates(void *_output_function)
   return 0; // no error
 }
 
+s32 SEQ_TERMINAL_RenderBenchmark(void *_output_function)
+{
+  void (*out)(char *format, ...) = _output_function;
+  seq_midexp_render_result_t result;
+
+  // rendering resets the sequencer, therefore it isn't allowed during live playback
+  if( SEQ_BPM_IsRunning() ) {
+    out("Please stop the sequencer before rendering!");
+    return -1;
+  }
+
+  out("Rendering MIDI file export (no file will be written)...");
+
+  s32 status = SEQ_MIDEXP_Render(NULL, &result);
+  if( status < 0 ) {
+    out("Rendering failed with status %d!", status);
+    return status;
+  }
+
+  out("Ticks:    %u", result.number_ticks);
+  out("Events:   %u", result.num_events);
+  out("Size:     %u bytes", result.file_size);
+  out("Checksum: 0x%08x", result.checksum);
+  out("Time:     %u mS", result.render_time_ms);
+
+  out("done.");
+
+  return 0; // no error
+}
+
 s32 SEQ_TERMINAL_PrintMemoryInfo(void *_output_function)
 {
 #if defined(MIOS32_FAMILY_EMULATION)
@@ -43,6 +43,7 @@ extern s32 SEQ_TERMINAL_PrintTrack(void *_output_function, u8 track);
 extern s32 SEQ_TERMINAL_PrintCurrentMixerMap(void *_output_function);
 extern s32 SEQ_TERMINAL_PrintCurrentSong(void *_output_function);
 extern s32 SEQ_TERMINAL_PrintGrooveTemplates(void *_output_function);
+extern s32 SEQ_TERMINAL_RenderBenchmark(void *_output_function);
 extern s32 SEQ_TERMINAL_PrintMemoryInfo(void *_output_function);
 extern s32 SEQ_TERMINAL_PrintSdCardInfo(void *_output_function);
 extern s32 SEQ_TERMINAL_PrintRouterInfo(void *_output_function);
@@ -1650,7 +1650,7 @@ static s32 LCD_Handler(u8 high_prio)
     ///////////////////////////////////////////////////////////////////////////
     case DIALOG_MF_EXPORT_PROGRESS:
       SEQ_LCD_Clear(); // remove artifacts
-      // (message print by SEQ_MIDEXP_GenerateFile())
+      // (message print by DoMfExport())
       return 0;
 
 
@@ -1817,7 +1817,7 @@ static s32 DoMfExport(u8 force_overwrite)
     return 1;
   }
 
-  // select empty dialog page --- messages are print by SEQ_MIDEXP_GenerateFile()
+  // select empty dialog page --- progress/result messages are print below
   menu_dialog = DIALOG_MF_EXPORT_PROGRESS;
   SEQ_UI_Msg(SEQ_UI_MSG_USER_R, 2000, "Exporting", path);
 
@@ -240,7 +240,9 @@ static s32 Encoder_Handler(seq_ui_encoder_t encoder, s32 incrementer)
 	if( incrementer == 0 ) // button
 	  incrementer = (encoder == SEQ_UI_ENCODER_GP9) ? -1 : 1;
 
-	if( SEQ_UI_Var8_Inc(&seq_ui_edit_datawheel_mode, 0, SEQ_UI_EDIT_DATAWHEEL_MODE_NUM-1, incrementer) >= 1 ) {
+	u8 value = seq_ui_edit_datawheel_mode; // enum could be wider than u8
+	if( SEQ_UI_Var8_Inc(&value, 0, SEQ_UI_EDIT_DATAWHEEL_MODE_NUM-1, incrementer) >= 1 ) {
+	  seq_ui_edit_datawheel_mode = value;
 	  ui_store_file_required = 1;
 	  return 1;
 	} else
@@ -111,6 +111,18 @@ extern void APP_SendDebugMessage(char *format, ...);
 // support delays
 #define SEQ_MIDI_OUT_SUPPORT_DELAY 1
 
+// read-ahead buffer of the MIDI file parser, shared between all tracks
+#if defined(MIOS32_FAMILY_STM32F10x)
+#define MID_PARSER_READ_BUFFER_SIZE 512
+#else
+#define MID_PARSER_READ_BUFFER_SIZE 2048
+#endif
+
+// song position index of the MIDI file parser (12 bytes per entry)
+#if !defined(MIOS32_FAMILY_STM32F10x)
+#define MID_PARSER_INDEX_SIZE 256
+#endif
+
 
 #if defined(MIOS32_FAMILY_STM32F10x)
 // enable third UART
@@ -222,4 +234,14 @@ extern void TASKS_J16SemaphoreGive(void);
 #define MIOS32_ENC28J60_MUTEX_TAKE { TASKS_J16SemaphoreTake(); }
 #define MIOS32_ENC28J60_MUTEX_GIVE { TASKS_J16SemaphoreGive(); }
 
+// sector cache of the FatFs disk layer, 512 bytes per sector (see modules/fatfs/src/diskio.c)
+#if defined(MIOS32_FAMILY_STM32F4xx)
+#define DISKIO_CACHE_NUM_SECTORS 8
+#endif
+
+// sorted directory listing cache of the FILE module, 24 bytes per entry (see modules/file/file.h)
+#if defined(MIOS32_FAMILY_STM32F4xx)
+#define FILE_DIR_CACHE_NUM_ENTRIES 256
+#endif
+
 #endif /* _MIOS32_CONFIG_H */
@@ -42,6 +42,7 @@ void APP_Init(void){
     qsource = VGM_SourceQueue_Create();
     qhead = VGM_Head_Create(qsource);
     qhead->playing = 1;
+    VGM_Player_Reschedule(qhead);
     
     //Send test patch to initialize voice 1
     VGM_HeadQueue_Enqueue(qhead, (VgmChipWriteCmd){.cmd=2, .addr=0x30, .data=0x71 }, 0);
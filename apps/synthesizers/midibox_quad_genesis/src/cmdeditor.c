@@ -789,10 +789,10 @@ u8 EditState(VgmSource* vgs, VgmHead* head, u8 encoder, s32 incrementer, u8 butt
     VgmChipWriteCmd cmd, modcmd;
     u32 a = head->srcaddr;
     while(1){
-        cmd = vsr->cmds[a];
+        cmd = VGM_SourceRAM_Cmd(vsr, a);
         modcmd = EditCmd(cmd, encoder, incrementer, button, state, voice, op);
         if(modcmd.all != cmd.all){
-            vsr->cmds[a] = modcmd;
+            VGM_SourceRAM_Cmd(vsr, a) = modcmd;
             if(modcmd.cmd == 0x50){
                 modcmd.cmd = 0;
             }else if((modcmd.cmd & 0xFE) == 0x52){
@@ -53,4 +53,7 @@
 // Miscellaneous
 #define PRINT_SUPPORT_BINARY 1
 
+// sorted directory listing cache for the file browser (24 bytes per entry)
+#define FILE_DIR_CACHE_NUM_ENTRIES 128
+
 #endif /* _MIOS32_CONFIG_H */
@@ -26,6 +26,7 @@ synprogram_t* selprogram;
 static u8 submode;
 static u8 cursor;
 static VgmUsageBits newvgmusage;
+static u8 savetokens; //Load/save token files (.VGT) instead of VGMs
 
 
 static void DrawMenu(){
@@ -46,6 +47,8 @@ static void DrawMenu(){
             MIOS32_LCD_PrintString("Name");
             MIOS32_LCD_CursorSet(16,1);
             MIOS32_LCD_PrintFormattedString("%d", selprogram->rootnote);
+            MIOS32_LCD_CursorSet(21,1);
+            MIOS32_LCD_PrintString(savetokens ? "VGT" : "VGM");
             MIOS32_LCD_CursorSet(25,1);
             MIOS32_LCD_PrintString(selprogram->initsource != NULL ? " [#] " : " --- ");
             MIOS32_LCD_CursorSet(30,1);
@@ -163,7 +166,7 @@ static void FilebrowserDoneSaving(char* filename){
         DrawMenu();
         return;
     }
-    s32 res = VGM_File_SaveRAM(*ss, filename);
+    s32 res = savetokens ? VGM_File_SaveTokens(*ss, filename) : VGM_File_SaveRAM(*ss, filename);
     DrawMenu();
     MIOS32_LCD_CursorSet(0,0);
     if(res < 0){
@@ -227,6 +230,9 @@ void Mode_Prog_BtnSoftkey(u8 softkey, u8 state){
                 DrawMenu();
             }else if(softkey == 0){
                 NameEditor_Start(selprogram->name, 12, "Program", &DrawMenu);
+            }else if(softkey == 4){
+                savetokens = !savetokens;
+                DrawMenu();
             }
             break;
     }
@@ -268,7 +274,7 @@ void Mode_Prog_BtnSystem(u8 button, u8 state){
                             return;
                         }
                         FrontPanel_LEDSet(FP_LED_LOAD, 1);
-                        Filebrowser_Start(NULL, "VGM", 0, &FilebrowserDoneLoading);
+                        Filebrowser_Start(NULL, savetokens ? "VGT" : "VGM", 0, &FilebrowserDoneLoading);
                     }
                     break;
                 case FP_B_SAVE:
@@ -286,7 +292,7 @@ void Mode_Prog_BtnSystem(u8 button, u8 state){
                             return;
                         }
                         FrontPanel_LEDSet(FP_LED_SAVE, 1);
-                        Filebrowser_Start(NULL, "VGM", 1, &FilebrowserDoneSaving);
+                        Filebrowser_Start(NULL, savetokens ? "VGT" : "VGM", 1, &FilebrowserDoneSaving);
                     }
                     break;
                 case FP_B_NEW:
@@ -377,7 +377,7 @@ void Mode_Vgm_Background(){
             if(a < 0 || a >= vsr->numcmds){
                 FrontPanel_VGMMatrixRow(r, 0);
             }else{
-                DrawCmdLine(vsr->cmds[a], r, (a == selvgm->markstart || a == selvgm->markend));
+                DrawCmdLine(VGM_SourceRAM_Cmd(vsr, a), r, (a == selvgm->markstart || a == selvgm->markend));
             }
             ++a;
         }
@@ -425,7 +425,7 @@ void Mode_Vgm_Background(){
             FrontPanel_LEDSet(FP_LED_TIME_R, 0);
             lastcmddrawn.all = 0;
         }else{
-            VgmChipWriteCmd newcmd = vsr->cmds[a];
+            VgmChipWriteCmd newcmd = VGM_SourceRAM_Cmd(vsr, a);
             if(newcmd.all != lastcmddrawn.all){
                 MIOS32_IRQ_Disable();
                 if(lastcmddrawn.all != 0){
@@ -505,7 +505,7 @@ void Mode_Vgm_BtnSoftkey(u8 softkey, u8 state){
                 VgmSourceRAM* vsr = (VgmSourceRAM*)selvgm->data;
                 s32 a = head->srcaddr;
                 if(a < 0 || a >= vsr->numcmds) return;
-                vsr->cmds[a] = EditCmd(vsr->cmds[a], 0xFF, 0, FP_B_ALG, softkey, 0xFF, 0xFF);
+                VGM_SourceRAM_Cmd(vsr, a) = EditCmd(VGM_SourceRAM_Cmd(vsr, a), 0xFF, 0, FP_B_ALG, softkey, 0xFF, 0xFF);
             }
             break;
         case 5:
@@ -518,7 +518,7 @@ void Mode_Vgm_BtnSoftkey(u8 softkey, u8 state){
                 VgmSourceRAM* vsr = (VgmSourceRAM*)selvgm->data;
                 s32 a = head->srcaddr;
                 if(a < 0 || a >= vsr->numcmds) return;
-                vsr->cmds[a] = EditCmd(vsr->cmds[a], 0xFF, 0, FP_B_KON, (1 << softkey), 0xFF, 0xFF);
+                VGM_SourceRAM_Cmd(vsr, a) = EditCmd(VGM_SourceRAM_Cmd(vsr, a), 0xFF, 0, FP_B_KON, (1 << softkey), 0xFF, 0xFF);
             }
             break;
     }
@@ -556,6 +556,7 @@ void Mode_Vgm_BtnSystem(u8 button, u8 state){
                 synproginstance_t* pi = &proginstances[vgmpreviewpi];
                 pi->head->ticks = VGM_Player_GetVGMTime();
                 pi->head->playing = 1;
+                VGM_Player_Reschedule(pi->head);
                 playing = 1;
             }
             return;
@@ -857,7 +858,7 @@ void Mode_Vgm_BtnEdit(u8 button, u8 state){
                 VgmSourceRAM* vsr = (VgmSourceRAM*)selvgm->data;
                 s32 a = head->srcaddr;
                 if(a < 0 || a >= vsr->numcmds) return;
-                vsr->cmds[a] = EditCmd(vsr->cmds[a], 0xFF, 0, button, state, 0xFF, 0xFF);
+                VGM_SourceRAM_Cmd(vsr, a) = EditCmd(VGM_SourceRAM_Cmd(vsr, a), 0xFF, 0, button, state, 0xFF, 0xFF);
             }
         }
     }
@@ -877,7 +878,7 @@ void Mode_Vgm_EncDatawheel(s32 incrementer){
             VgmSourceRAM* vsr = (VgmSourceRAM*)selvgm->data;
             s32 a = head->srcaddr;
             if(a < 0 || a >= vsr->numcmds) return;
-            vsr->cmds[a] = EditCmd(vsr->cmds[a], FP_E_DATAWHEEL, incrementer, 0xFF, 0, 0xFF, 0xFF);
+            VGM_SourceRAM_Cmd(vsr, a) = EditCmd(VGM_SourceRAM_Cmd(vsr, a), FP_E_DATAWHEEL, incrementer, 0xFF, 0, 0xFF, 0xFF);
         }
     }
 }
@@ -979,7 +980,7 @@ void Mode_Vgm_EncEdit(u8 encoder, s32 incrementer){
             VgmSourceRAM* vsr = (VgmSourceRAM*)selvgm->data;
             s32 a = head->srcaddr;
             if(a < 0 || a >= vsr->numcmds) return;
-            vsr->cmds[a] = EditCmd(vsr->cmds[a], encoder, incrementer, 0xFF, 0, 0xFF, 0xFF);
+            VGM_SourceRAM_Cmd(vsr, a) = EditCmd(VGM_SourceRAM_Cmd(vsr, a), encoder, incrementer, 0xFF, 0, 0xFF, 0xFF);
         }
     }
 }
@@ -116,6 +116,7 @@ static void VoiceReset(u8 g, u8 v){
             //Start playing
             VGM_Head_Restart(head, VGM_Player_GetVGMTime());
             head->playing = 1;
+            VGM_Player_Reschedule(head);
         }else{
             VGM_ResetChipVoiceAsync(g, v);
         }
@@ -843,6 +844,7 @@ void SyEng_PlayVGMOnPI(synproginstance_t* pi, VgmSource* source, u8 rootnote, u8
     VGM_Head_Restart(pi->head, vgmtime);
     //DBG("PlayVGMOnPi after restart, iswait %d iswrite %d isdone %d firstoftwo %d, cmd %08X", pi->head->iswait, pi->head->iswrite, pi->head->isdone, pi->head->firstoftwo, pi->head->writecmd.all);
     pi->head->playing = startplaying;
+    VGM_Player_Reschedule(pi->head);
     pi->recency = vgmtime;
 }
 
@@ -41,6 +41,15 @@
 // nice for first checks of the emulation w/o MIDI input
 #define RESID_PLAY_TESTTONE 0
 
+// max. number of samples which are rendered by a single reSID clock() call
+// all SIDs are advanced in lock-step chunks between two MBSID updates
+// 0: render sample by sample (old method, CPU hungry)
+#define RESID_RENDER_BLOCK_SIZE 256
+
+#if RESID_RENDER_THREADS && !RESID_RENDER_BLOCK_SIZE
+# error "RESID_RENDER_THREADS requires RESID_RENDER_BLOCK_SIZE > 0"
+#endif
+
 
 
 // these global variables are used by ReSID
@@ -79,6 +88,16 @@ MidiboxSidAudioProcessor::MidiboxSidAudioProcessor()
             reSidEnabled = 0;
         }
     }
+
+    renderNumChunks = 0;
+    renderNumSids = 0;
+    renderBuffer = NULL;
+#if RESID_RENDER_THREADS
+    for(int i=0; i<RESID_RENDER_THREADS; ++i) {
+        renderThread[i] = new SidRenderThread(this, i+1);
+        renderThread[i]->startThread(9);
+    }
+#endif
 #else
     reSidEnabled = 0;
 #if DEBUG_VERBOSE_LEVEL >= 1
@@ -111,6 +130,12 @@ MidiboxSidAudioProcessor::MidiboxSidAudioProcessor()
 MidiboxSidAudioProcessor::~MidiboxSidAudioProcessor()
 {
 #if SID_NUM
+#if RESID_RENDER_THREADS
+    for(int i=0; i<RESID_RENDER_THREADS; ++i) {
+        delete renderThread[i];
+    }
+#endif
+
     for(int i=0; i<SID_NUM; ++i) {
         delete reSID[i];
     }
@@ -309,6 +334,66 @@ void MidiboxSidAudioProcessor::releaseResources()
     // spare memory, etc.
 }
 
+//==============================================================================
+// Renders the buffered chunks into the output buffer
+// each worker takes over every (RESID_RENDER_THREADS+1)th SID, worker 0 is the audio thread
+#if SID_NUM && RESID_RENDER_BLOCK_SIZE
+void MidiboxSidAudioProcessor::renderSids(int worker)
+{
+    for(int sid=worker; sid<renderNumSids; sid += RESID_RENDER_THREADS+1) {
+        for(int c=0; c<renderNumChunks; ++c) {
+            render_chunk_t *chunk = &renderChunks[c];
+
+            if( chunk->update )
+                RESID_UpdateSid(sid, &chunk->regs[sid], 0);
+
+            short sample_buf[RESID_RENDER_BLOCK_SIZE];
+            int numRendered = 0;
+            while( numRendered < chunk->size ) {
+                // delta_t only limits the number of cycles, clock() returns once chunk->size samples are available
+                cycle_count delta_t = (cycle_count)(chunk->size - numRendered) * (RESID_FREQUENCY / 1000) + 1000;
+                numRendered += reSID[sid]->clock(delta_t, &sample_buf[numRendered], chunk->size - numRendered);
+            }
+
+            float *out = renderBuffer->getSampleData(sid, chunk->offset);
+            for(int j=0; j<chunk->size; ++j)
+                out[j] = (float)sample_buf[j] / 32768.0;
+        }
+    }
+}
+#endif
+
+#if SID_NUM && RESID_RENDER_THREADS
+//==============================================================================
+SidRenderThread::SidRenderThread(MidiboxSidAudioProcessor *_processor, int _worker)
+    : Thread("SID Renderer")
+    , processor(_processor)
+    , worker(_worker)
+{
+}
+
+SidRenderThread::~SidRenderThread()
+{
+    signalThreadShouldExit();
+    startEvent.signal();
+    stopThread(1000);
+}
+
+void SidRenderThread::run()
+{
+    while( !threadShouldExit() ) {
+        if( !startEvent.wait(100) )
+            continue;
+
+        if( threadShouldExit() )
+            break;
+
+        processor->renderSids(worker);
+        doneEvent.signal();
+    }
+}
+#endif
+
 void MidiboxSidAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& midiMessages)
 {
     // poll for new MIDI events
@@ -359,6 +444,60 @@ void MidiboxSidAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuff
         int numSamples = buffer.getNumSamples();
     
         // add SID sound(s) to output(s)
+#if RESID_RENDER_BLOCK_SIZE
+        // all SIDs are rendered in chunks which end at the next sound engine update,
+        // so that they stay in lock-step, and register changes are taken over at the same
+        // sample position like with the old per-sample method
+        // The sound engine runs first, and the register values of each update are stored,
+        // thereafter each SID renders all chunks on its own (optionally in parallel)
+        renderBuffer = &buffer;
+        renderNumSids = (numChannels < SID_NUM) ? numChannels : SID_NUM;
+
+        double updateInc = (double)MBSID_UPDATE_FRQ / reSidSampleRate;
+        for(int i=0; i<numSamples; ) {
+            renderNumChunks = 0;
+            while( i < numSamples && renderNumChunks < RESID_RENDER_MAX_CHUNKS ) {
+                render_chunk_t *chunk = &renderChunks[renderNumChunks++];
+
+                // update sound engine
+                chunk->update = 0;
+                mbSidUpdateCounter += updateInc;
+                if( mbSidUpdateCounter >= 1.0 ) {
+                    mbSidUpdateCounter -= 1.0;
+#if RESID_PLAY_TESTTONE == 0
+                    mbSidEnvironment.tick();
+                    memcpy(chunk->regs, sidRegs, sizeof(chunk->regs));
+                    chunk->update = 1;
+#endif
+                }
+
+                // determine number of samples until the next update
+                int chunkSize = 1;
+                while( (i+chunkSize) < numSamples && chunkSize < RESID_RENDER_BLOCK_SIZE &&
+                       (mbSidUpdateCounter + updateInc) < 1.0 ) {
+                    mbSidUpdateCounter += updateInc;
+                    ++chunkSize;
+                }
+
+                chunk->offset = i;
+                chunk->size = chunkSize;
+                i += chunkSize;
+            }
+
+#if RESID_RENDER_THREADS
+            for(int worker=0; worker<RESID_RENDER_THREADS; ++worker)
+                renderThread[worker]->startEvent.signal();
+#endif
+
+            renderSids(0);
+
+#if RESID_RENDER_THREADS
+            // join: all SIDs have to be rendered before the buffer is processed
+            for(int worker=0; worker<RESID_RENDER_THREADS; ++worker)
+                renderThread[worker]->doneEvent.wait(-1);
+#endif
+        }
+#else
         // TK: this nested loop isn't optimal for CPU load, but we have to ensure that all SIDs are in lock-step
         for(int i=0; i<numSamples; ++i) {
             // update sound engine
@@ -383,6 +522,7 @@ void MidiboxSidAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuff
                 *buffer.getSampleData(channel, i) = currentSample;
             }
         }
+#endif
     }
 #endif
 
@@ -518,23 +658,35 @@ static const u8 update_order[] = {
 };
 
 s32 MidiboxSidAudioProcessor::RESID_Update(u32 mode)
+{
+    for(int sid=0; sid<SID_NUM; ++sid)
+        RESID_UpdateSid(sid, &sidRegs[sid], mode);
+
+  return 0; // no error
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Updates the RESID registers of a single SID
+// Each SID only accesses its own reSID instance and shadow registers,
+// therefore this function can be called by the render threads
+// IN: <sid>: the SID number
+//     <regs>: the register values which should be taken over
+//     <mode>: see RESID_Update
+// OUT: returns < 0 if update failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MidiboxSidAudioProcessor::RESID_UpdateSid(int sid, sid_regs_t *regs, u32 mode)
 {
     // trigger reset?
-    if( mode == 2 ) {
-        for(int i=0; i<SID_NUM; ++i)
-            reSID[i]->reset();
-    }
+    if( mode == 2 )
+        reSID[sid]->reset();
 
     // check for updates
     for(int i=0; i<(int)sizeof(update_order); ++i) {
         u8 reg = update_order[i];
-
-        for(int sid=0; sid<SID_NUM; ++sid) {
-            u8 data;
-            if( (data=sidRegs[sid].ALL[reg]) != sidRegsShadow[sid].ALL[reg] || mode >= 1 ) {
-                sidRegsShadow[sid].ALL[reg] = data;
-                reSID[sid]->write(reg, data);
-            }
+        u8 data;
+        if( (data=regs->ALL[reg]) != sidRegsShadow[sid].ALL[reg] || mode >= 1 ) {
+            sidRegsShadow[sid].ALL[reg] = data;
+            reSID[sid]->write(reg, data);
         }
     }
 
@@ -23,6 +23,41 @@
 // if 0: emulation disabled
 #define SID_NUM 2
 
+// number of additional threads which render the SIDs in parallel to the audio thread
+// each thread takes over every (RESID_RENDER_THREADS+1)th SID
+// if 0: all SIDs are rendered by the audio thread
+#define RESID_RENDER_THREADS 0
+
+// max. number of MBSID updates which are buffered before the SIDs are rendered
+#define RESID_RENDER_MAX_CHUNKS 64
+
+
+class MidiboxSidAudioProcessor;
+
+#if SID_NUM && RESID_RENDER_THREADS
+//==============================================================================
+/**
+   Renders a subset of the SIDs whenever startEvent is signalled,
+   and signals doneEvent thereafter
+*/
+class SidRenderThread
+    : public Thread
+{
+public:
+    SidRenderThread(MidiboxSidAudioProcessor *_processor, int _worker);
+    ~SidRenderThread();
+
+    void run();
+
+    WaitableEvent startEvent;
+    WaitableEvent doneEvent;
+
+private:
+    MidiboxSidAudioProcessor *processor;
+    int worker;
+};
+#endif
+
 
 //==============================================================================
 /**
@@ -123,6 +158,27 @@ public:
     sid_regs_t sidRegs[SID_NUM];
     sid_regs_t sidRegsShadow[SID_NUM];
     s32 RESID_Update(u32 mode);
+    s32 RESID_UpdateSid(int sid, sid_regs_t *regs, u32 mode);
+
+#if SID_NUM
+    // sound engine updates which are rendered by renderSids()
+    typedef struct {
+        int offset;
+        int size;
+        int update;
+        sid_regs_t regs[SID_NUM];
+    } render_chunk_t;
+
+    render_chunk_t renderChunks[RESID_RENDER_MAX_CHUNKS];
+    int renderNumChunks;
+    int renderNumSids;
+    AudioSampleBuffer *renderBuffer;
+    void renderSids(int worker);
+
+#if RESID_RENDER_THREADS
+    SidRenderThread *renderThread[RESID_RENDER_THREADS];
+#endif
+#endif
 
 private:
     //==============================================================================
@@ -57,6 +57,8 @@ void APP_Background(void)
     sid_regs[sid].v1.decay = 0;
     sid_regs[sid].v1.sustain = 15;
     sid_regs[sid].v1.release = 0;
+
+    SID_RegDirtySet(sid, SID_REGS_MASK_VOICE(0) | SID_REGS_MASK_FILTER);
   }
 
   // update SID registers
@@ -65,6 +67,7 @@ void APP_Background(void)
   // set gate
   for(sid=0; sid<SID_NUM; ++sid) {
     sid_regs[sid].v1.gate = 1;
+    SID_RegDirtySet(sid, SID_REGS_MASK_VOICE(0));
   }
 
   // update SID registers again
@@ -10,5 +10,7 @@
 #ifndef _MIOS32_CONFIG_H
 #define _MIOS32_CONFIG_H
 
+// all register changes are marked with SID_RegDirtySet()
+#define SID_DIRTY_BITMAP 1
 
 #endif /* _MIOS32_CONFIG_H */
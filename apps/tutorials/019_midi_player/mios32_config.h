@@ -14,5 +14,11 @@
 #define MIOS32_LCD_BOOT_MSG_LINE1 "Tutorial #019"
 #define MIOS32_LCD_BOOT_MSG_LINE2 "(C) 2009 T.Klose"
 
+// read-ahead buffer of the MIDI file parser, shared between all tracks
+#define MID_PARSER_READ_BUFFER_SIZE 1024
+
+// song position index of the MIDI file parser (12 bytes per entry)
+#define MID_PARSER_INDEX_SIZE 256
+
 
 #endif /* _MIOS32_CONFIG_H */
@@ -243,9 +243,11 @@ static s32 SEQ_SongPos(u16 new_song_pos)
   seq_pause = 0;
 
   if( new_song_pos > 1 ) {
-    // (silently) fast forward to requested position
+    // (silently) fast forward to requested position,
+    // starting at the nearest checkpoint of the song position index
     ffwd_silent_mode = 1;
-    MID_PARSER_FetchEvents(0, new_tick-1);
+    u32 ffwd_tick = MID_PARSER_IndexSeek(new_tick-1);
+    MID_PARSER_FetchEvents(ffwd_tick, new_tick-1-ffwd_tick);
     ffwd_silent_mode = 0;
   }
 
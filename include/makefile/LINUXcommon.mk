@@ -0,0 +1,121 @@
+# $Id$
+#
+# Build rules for the LINUX family, included from common.mk
+# Creates a native executable for the host, see also $(MIOS32_PATH)/mios32/LINUX/README.txt
+#
+# following variables should be set before including this file:
+#   - PROCESSOR e.g.: HOST
+#   - FAMILY    e.g.: LINUX
+#   - BOARD     e.g.: MBHP_CORE_STM32F4 (the emulated board)
+#   - LCD       e.g.: universal
+#   - PROJECT   e.g.: project   # (the executable will be located in $(PROJECT_OUT))
+#   - THUMB_SOURCE e.g.: main.c (.c only)
+#   - THUMB_CPP_SOURCE e.g.: main.cp (.cpp only)
+#   - C_INCLUDE     e.g.: -I./ui  # (more include pathes will be added by .mk files)
+#   - DIST      e.g.: ./
+#
+# Assembly and ARM sources are ignored.
+#
+
+# select GCC tools of the host
+# can be optionally overruled via environment variable
+MIOS32_HOST_CC  ?= gcc
+MIOS32_HOST_CPP ?= g++
+
+CC      = $(MIOS32_HOST_CC)
+CPP     = $(MIOS32_HOST_CPP)
+SIZE    = size
+
+# where should the output files be located
+PROJECT_OUT ?= $(PROJECT)_build
+
+# default linker flags
+LDFLAGS += -Wl,--gc-sections -pthread -lstdc++ -lm
+
+# define C flags
+# (u32/s32 are mapped to int, since long is 64bit on the host)
+CFLAGS += -DMIOS32_DATATYPES_INT32=int
+# (GNU extensions like strcasestr() are available in newlib as well)
+CFLAGS += -D_GNU_SOURCE
+CFLAGS += $(C_DEFINES) $(C_INCLUDE) -Wall -Wno-format -Wno-switch -Wno-strict-aliasing
+CFLAGS += -pthread -ffunction-sections -fdata-sections
+
+# define CPP flags
+CPPFLAGS += $(CFLAGS) -fno-rtti -fno-exceptions -Wno-write-strings
+
+# convert .c -> .o
+THUMB_OBJS = $(THUMB_SOURCE:.c=.o)
+THUMB_CPP_OBJS = $(THUMB_CPP_SOURCE:.cpp=.o)
+
+# list of all objects
+ALL_OBJS = $(addprefix $(PROJECT_OUT)/, $(THUMB_OBJS) $(THUMB_CPP_OBJS))
+
+# list of all dependency files
+ALL_DFILES = $(ALL_OBJS:.o=.d)
+
+# which directories contain source files?
+DIRS = $(dir $(THUMB_OBJS) $(THUMB_CPP_OBJS))
+
+# add files for distribution
+DIST += $(MIOS32_PATH)/include/makefile/common.mk $(MIOS32_PATH)/include/makefile/LINUXcommon.mk $(MIOS32_PATH)/include/c
+
+# default rule
+all: dirs $(PROJECT_OUT)/$(PROJECT) projectinfo
+
+# define debug/release target for easier use in codeblocks
+debug: all
+Debug: all
+release: all
+Release: all
+
+# create the output directories
+dirs:
+	@-if [ ! -e $(PROJECT_OUT) ]; then mkdir $(PROJECT_OUT); fi;
+	@-$(foreach DIR,$(DIRS), if [ ! -e $(PROJECT_OUT)/$(DIR) ]; \
+	 then mkdir -p $(PROJECT_OUT)/$(DIR); fi; )
+
+# rule to create the executable
+$(PROJECT_OUT)/$(PROJECT): $(ALL_OBJS)
+	@$(CC) $(CFLAGS) $(ALL_OBJS) $(LIBS) $(LDFLAGS) -o$@
+
+
+# rule to output project informations
+projectinfo:
+	@echo "-------------------------------------------------------------------------------"
+	@echo "Application successfully built for:"
+	@echo "Processor: $(PROCESSOR)"
+	@echo "Family:    $(FAMILY)"
+	@echo "Board:     $(BOARD)"
+	@echo "LCD:       $(LCD)"
+	@echo "Executable: $(PROJECT_OUT)/$(PROJECT)"
+	@echo "-------------------------------------------------------------------------------"
+	$(SIZE) $(PROJECT_OUT)/$(PROJECT)
+
+# default rule for compiling .c programs
+# see common.mk
+$(PROJECT_OUT)/%.o: %.c
+	@echo Creating object file for $(notdir $<)
+	@$(CC) -Wp,-MMD,$(PROJECT_OUT)/$*.dd $(CFLAGS) -c $< -o $@
+	@sed -e '1s/^\(.*\)$$/$(subst /,\/,$(dir $@))\1/' $(PROJECT_OUT)/$*.dd > $(PROJECT_OUT)/$*.d
+	@rm -f $(PROJECT_OUT)/$*.dd
+
+$(PROJECT_OUT)/%.o: %.cpp
+	@echo Creating object file for $(notdir $<)
+	@$(CPP) -Wp,-MMD,$(PROJECT_OUT)/$*.dd $(CPPFLAGS) -c $< -o $@
+	@sed -e '1s/^\(.*\)$$/$(subst /,\/,$(dir $@))\1/' $(PROJECT_OUT)/$*.dd > $(PROJECT_OUT)/$*.d
+	@rm -f $(PROJECT_OUT)/$*.dd
+
+# Includes the .d files so it knows the exact dependencies for every
+# source.
+-include $(ALL_DFILES)
+
+
+# clean temporary files
+clean:
+	rm -rf $(PROJECT_OUT)
+
+# clean project image
+cleanhex:
+
+# clean temporary files + project image
+cleanall: clean cleanhex
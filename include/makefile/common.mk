@@ -20,6 +20,11 @@
 # Modules can be added by including .mk files from $MIOS32_PATH/modules/*/*.mk
 #
 
+# the LINUX family creates a native executable for the host
+ifeq ($(FAMILY),LINUX)
+include $(MIOS32_PATH)/include/makefile/LINUXcommon.mk
+else
+
 # if MIOS32_SHELL environment variable hasn't been set by the user, set it here
 # Ubuntu users should set it to /bin/bash from external (-> "export MIOS32_SHELL /bin/bash")
 MIOS32_SHELL ?= sh
@@ -238,3 +243,5 @@ callgraph_all: callgraph callgraph_convert
 
 callgraph_clean: 
 	@rm -fR egypt
+
+endif
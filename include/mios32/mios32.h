@@ -43,6 +43,8 @@ extern "C" {
 # include <mios32_datatypes.h>
 #elif defined(MIOS32_FAMILY_MIOSJUCE)
 # include <mios32_datatypes.h>
+#elif defined(MIOS32_FAMILY_LINUX)
+# include <mios32_datatypes.h>
 #else
 # include <mios32_datatypes.h>
 # warning "Unsupported MIOS32_FAMILY selected!"
@@ -96,6 +98,7 @@ extern "C" {
 #include <mios32_timer.h>
 #include <mios32_stopwatch.h>
 #include <mios32_timestamp.h>
+#include <mios32_input.h>
 #include <mios32_delay.h>
 #include <mios32_sdcard.h>
 #include <mios32_enc28j60.h>
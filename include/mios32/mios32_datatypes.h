@@ -18,35 +18,41 @@
 // following check to ensure that typedefs won't be declared again from stm32f10x.h
 #if !defined(__STM32F10x_H) && !defined(__STM32F4xx_H)
 
-typedef signed long  s32;
+// long is 64bit on 64bit hosts - native host builds (e.g. host based benchmarks)
+// can define MIOS32_DATATYPES_INT32=int to ensure that 32bit types behave like on the target
+#ifndef MIOS32_DATATYPES_INT32
+# define MIOS32_DATATYPES_INT32 long
+#endif
+
+typedef signed MIOS32_DATATYPES_INT32  s32;
 typedef signed short s16;
 typedef signed char  s8;
 
-typedef signed long  const sc32;  /* Read Only */
+typedef signed MIOS32_DATATYPES_INT32  const sc32;  /* Read Only */
 typedef signed short const sc16;  /* Read Only */
 typedef signed char  const sc8;   /* Read Only */
 
-typedef volatile signed long  vs32;
+typedef volatile signed MIOS32_DATATYPES_INT32  vs32;
 typedef volatile signed short vs16;
 typedef volatile signed char  vs8;
 
-typedef volatile signed long  const vsc32;  /* Read Only */
+typedef volatile signed MIOS32_DATATYPES_INT32  const vsc32;  /* Read Only */
 typedef volatile signed short const vsc16;  /* Read Only */
 typedef volatile signed char  const vsc8;   /* Read Only */
 
-typedef unsigned long  u32;
+typedef unsigned MIOS32_DATATYPES_INT32  u32;
 typedef unsigned short u16;
 typedef unsigned char  u8;
 
-typedef unsigned long  const uc32;  /* Read Only */
+typedef unsigned MIOS32_DATATYPES_INT32  const uc32;  /* Read Only */
 typedef unsigned short const uc16;  /* Read Only */
 typedef unsigned char  const uc8;   /* Read Only */
 
-typedef volatile unsigned long  vu32;
+typedef volatile unsigned MIOS32_DATATYPES_INT32  vu32;
 typedef volatile unsigned short vu16;
 typedef volatile unsigned char  vu8;
 
-typedef volatile unsigned long  const vuc32;  /* Read Only */
+typedef volatile unsigned MIOS32_DATATYPES_INT32  const vuc32;  /* Read Only */
 typedef volatile unsigned short const vuc16;  /* Read Only */
 typedef volatile unsigned char  const vuc8;   /* Read Only */
 
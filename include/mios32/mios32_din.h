@@ -18,6 +18,8 @@
 // Global definitions
 /////////////////////////////////////////////////////////////////////////////
 
+// number of 32bit words which are passed to the MIOS32_DIN_HandlerBatch() callback
+#define MIOS32_DIN_NUM_WORDS ((MIOS32_SRIO_NUM_SR+3)/4)
 
 /////////////////////////////////////////////////////////////////////////////
 // Global Types
@@ -34,6 +36,7 @@ extern s32 MIOS32_DIN_PinGet(u32 pin);
 extern s32 MIOS32_DIN_SRGet(u32 sr);
 extern u8 MIOS32_DIN_SRChangedGetAndClear(u32 sr, u8 mask);
 extern s32 MIOS32_DIN_Handler(void *callback);
+extern s32 MIOS32_DIN_HandlerBatch(void *callback);
 
 
 /////////////////////////////////////////////////////////////////////////////
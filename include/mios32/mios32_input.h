@@ -0,0 +1,67 @@
+// $Id$
+/*
+ * Header file for the Input Event Journal
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef _MIOS32_INPUT_H
+#define _MIOS32_INPUT_H
+
+/////////////////////////////////////////////////////////////////////////////
+// Global definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// number of events which can be stored in the journal (must be a power of two)
+// each event allocates 12 bytes
+// 0 disables the journal
+#ifndef MIOS32_INPUT_JOURNAL_SIZE
+#define MIOS32_INPUT_JOURNAL_SIZE 0
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Global Types
+/////////////////////////////////////////////////////////////////////////////
+
+typedef enum {
+  MIOS32_INPUT_EVENT_DIN = 0,
+  MIOS32_INPUT_EVENT_ENC = 1,
+  MIOS32_INPUT_EVENT_AIN = 2
+} mios32_input_event_type_t;
+
+typedef struct {
+  u32 timestamp; // in uS, see MIOS32_TIMESTAMP_Get_uS()
+  u16 pin;       // DIN pin, encoder number or AIN pin
+  u8  type;      // mios32_input_event_type_t
+  u8  reserved;
+  s32 value;     // DIN: pin value, ENC: incrementer, AIN: conversion value
+} mios32_input_event_t;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+extern s32 MIOS32_INPUT_Init(u32 mode);
+
+extern s32 MIOS32_INPUT_EventPush(mios32_input_event_type_t type, u32 pin, s32 value);
+
+extern s32 MIOS32_INPUT_NumEventsGet(void);
+extern s32 MIOS32_INPUT_EventsGet(mios32_input_event_t *events, u32 max_events);
+extern s32 MIOS32_INPUT_Handler(void *callback);
+extern u32 MIOS32_INPUT_OverrunsGet(void);
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Export global variables
+/////////////////////////////////////////////////////////////////////////////
+
+
+#endif /* _MIOS32_INPUT_H */
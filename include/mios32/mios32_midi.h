@@ -30,6 +30,18 @@
 #endif
 
 
+// optional receive rings for UART based MIDI ports:
+// incoming bytes are parsed at ISR time, complete packages are stored
+// together with their timestamp in a lock-free single-producer/single-consumer
+// ring for each port, which is drained in bulk by MIOS32_MIDI_Receive_Handler()
+// or MIOS32_MIDI_ReceivePackagesBatch()
+// each ring entry allocates 8 bytes
+// the size has to be a power of two (e.g. 32, 64, 128, ...), 0 disables the rings
+#ifndef MIOS32_MIDI_RX_RING_SIZE
+#define MIOS32_MIDI_RX_RING_SIZE 0
+#endif
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Uses by MIOS32 SysEx parser
 /////////////////////////////////////////////////////////////////////////////
@@ -246,6 +258,10 @@ extern s32 MIOS32_MIDI_SendDebugHexDump(const u8 *src, u32 len);
 extern s32 MIOS32_MIDI_ReceivePackage(mios32_midi_port_t port, mios32_midi_package_t package, void *_callback_package);
 extern s32 MIOS32_MIDI_Receive_Handler(void *callback_event);
 
+extern s32 MIOS32_MIDI_RxRingPut(mios32_midi_port_t port, mios32_midi_package_t package);
+extern s32 MIOS32_MIDI_ReceivePackagesBatch(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 *timestamps, u32 max_num);
+extern s32 MIOS32_MIDI_RxRingOverflowCtrGet(mios32_midi_port_t port);
+
 extern s32 MIOS32_MIDI_Periodic_mS(void);
 
 extern s32 MIOS32_MIDI_DirectTxCallback_Init(s32 (*callback_tx)(mios32_midi_port_t port, mios32_midi_package_t package));
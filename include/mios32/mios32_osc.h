@@ -29,6 +29,14 @@
 #define MIOS32_OSC_MAX_ARGS 8
 #endif
 
+// OSC: number of entries of the dispatch table (must be a power of two)
+// MIOS32_OSC_DispatchCompile() allocates one entry for each node and for each level of the search tree
+// each entry allocates 12 bytes
+// 0 disables the dispatch table
+#ifndef MIOS32_OSC_DISPATCH_HASH_SIZE
+#define MIOS32_OSC_DISPATCH_HASH_SIZE 0
+#endif
+
 // the output function which is used to print debug messages
 // could be replaced by printf (e.g. for emulations)
 #ifndef MIOS32_OSC_DEBUG_MSG
@@ -105,6 +113,9 @@ extern u8 *MIOS32_OSC_PutMIDI(u8 *buffer, mios32_midi_package_t p);
 
 extern s32 MIOS32_OSC_ParsePacket(u8 *packet, u32 len, const mios32_osc_search_tree_t *search_tree);
 
+extern s32 MIOS32_OSC_DispatchCompile(const mios32_osc_search_tree_t *search_tree);
+extern s32 MIOS32_OSC_DispatchClear(void);
+
 extern s32 MIOS32_OSC_SendDebugMessage(mios32_osc_args_t *osc_args, u32 method_arg);
 
 
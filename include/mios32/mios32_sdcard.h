@@ -106,6 +106,8 @@ extern s32 MIOS32_SDCARD_CheckAvailable(u8 was_available);
 extern s32 MIOS32_SDCARD_SendSDCCmd(u8 cmd, u32 addr, u8 crc);
 extern s32 MIOS32_SDCARD_SectorRead(u32 sector, u8 *buffer);
 extern s32 MIOS32_SDCARD_SectorWrite(u32 sector, u8 *buffer);
+extern s32 MIOS32_SDCARD_SectorReadMultiple(u32 sector, u8 *buffer, u32 num_sectors);
+extern s32 MIOS32_SDCARD_SectorWriteMultiple(u32 sector, u8 *buffer, u32 num_sectors);
 
 extern s32 MIOS32_SDCARD_CIDRead(mios32_sdcard_cid_t *cid);
 extern s32 MIOS32_SDCARD_CSDRead(mios32_sdcard_csd_t *csd);
@@ -32,6 +32,7 @@ extern s32 MIOS32_TIMESTAMP_Init(u32 mode);
 
 extern s32 MIOS32_TIMESTAMP_Inc(void);
 extern s32 MIOS32_TIMESTAMP_Get(void);
+extern u32 MIOS32_TIMESTAMP_Get_uS(void);
 extern s32 MIOS32_TIMESTAMP_GetDelay(u32 captured_timestamp);
 
 
@@ -0,0 +1,86 @@
+// $Id$
+/*
+ * FreeRTOS API emulation for the LINUX family
+ *
+ * Provides the subset of the FreeRTOS V9 API which is used by MIOS32
+ * applications. Tasks are running as POSIX threads, queues and semaphores
+ * are based on pthread mutexes and condition variables.
+ * See also mios32/LINUX/README.txt
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// application specific configuration options
+#include "FreeRTOSConfig.h"
+
+// definitions specific to the port
+#include "portable.h"
+
+// basic FreeRTOS definitions
+#include "projdefs.h"
+
+
+#ifndef configUSE_MALLOC_FAILED_HOOK
+#define configUSE_MALLOC_FAILED_HOOK 0
+#endif
+
+#ifndef configGENERATE_RUN_TIME_STATS
+#define configGENERATE_RUN_TIME_STATS 0
+#endif
+
+#ifndef configASSERT
+#define configASSERT( x )
+#endif
+
+#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#endif
+
+
+// dummy structures for statically allocated objects, only the size is relevant
+typedef struct xSTATIC_TCB {
+  void *pxDummy[24];
+} StaticTask_t;
+
+typedef struct xSTATIC_QUEUE {
+  void *pvDummy[16];
+} StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+
+
+// MIOS32 applications are still using the FreeRTOS V7 names
+#if configENABLE_BACKWARD_COMPATIBILITY == 1
+	#define eTaskStateGet eTaskGetState
+	#define portTickType TickType_t
+	#define xTaskHandle TaskHandle_t
+	#define xQueueHandle QueueHandle_t
+	#define xSemaphoreHandle SemaphoreHandle_t
+	#define xQueueSetHandle QueueSetHandle_t
+	#define xQueueSetMemberHandle QueueSetMemberHandle_t
+	#define xTimeOutType TimeOut_t
+	#define xMemoryRegion MemoryRegion_t
+	#define xTaskParameters TaskParameters_t
+	#define xTaskStatusType	TaskStatus_t
+	#define xTimerHandle TimerHandle_t
+	#define xCoRoutineHandle CoRoutineHandle_t
+	#define pdTASK_HOOK_CODE TaskHookFunction_t
+	#define tmrTIMER_CALLBACK TimerCallbackFunction_t
+	#define pdTASK_CODE TaskFunction_t
+	#define xListItem ListItem_t
+	#define xList List_t
+	#define portTICK_RATE_MS portTICK_PERIOD_MS
+#endif
+
+#endif /* INC_FREERTOS_H */
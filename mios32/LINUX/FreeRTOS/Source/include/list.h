@@ -0,0 +1,20 @@
+// $Id$
+/*
+ * FreeRTOS API emulation for the LINUX family
+ *
+ * The list implementation isn't required by the emulation, this header
+ * only exists for applications which include it.
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef LIST_H
+#define LIST_H
+
+#endif /* LIST_H */
@@ -0,0 +1,40 @@
+// $Id$
+/*
+ * FreeRTOS API emulation for the LINUX family - portable layer API
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef PORTABLE_H
+#define PORTABLE_H
+
+#include "portmacro.h"
+
+#if portBYTE_ALIGNMENT == 8
+#define portBYTE_ALIGNMENT_MASK ( 0x0007 )
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// heap management, see portable/GCC/LINUX/port.c
+void *pvPortMalloc( size_t xSize );
+void *pvPortRealloc( void *pv, size_t xSize );
+void vPortFree( void *pv );
+void vPortInitialiseBlocks( void );
+size_t xPortGetFreeHeapSize( void );
+size_t xPortGetMinimumEverFreeHeapSize( void );
+void vPortMallocDebugInfo( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTABLE_H */
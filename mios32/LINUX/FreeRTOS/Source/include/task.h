@@ -0,0 +1,88 @@
+// $Id$
+/*
+ * FreeRTOS API emulation for the LINUX family - task API
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include task.h"
+#endif
+
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#include "list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define tskKERNEL_VERSION_NUMBER "V9.0.0 (LINUX emulation)"
+
+#define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
+
+#define taskYIELD()					portYIELD()
+#define taskENTER_CRITICAL()		portENTER_CRITICAL()
+#define taskEXIT_CRITICAL()			portEXIT_CRITICAL()
+#define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#define taskEXIT_CRITICAL_FROM_ISR( x ) portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#define taskDISABLE_INTERRUPTS()	portDISABLE_INTERRUPTS()
+#define taskENABLE_INTERRUPTS()		portENABLE_INTERRUPTS()
+
+#define taskSCHEDULER_SUSPENDED		( ( BaseType_t ) 0 )
+#define taskSCHEDULER_NOT_STARTED	( ( BaseType_t ) 1 )
+#define taskSCHEDULER_RUNNING		( ( BaseType_t ) 2 )
+
+typedef struct tskTaskControlBlock *TaskHandle_t;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+BaseType_t xTaskCreate( TaskFunction_t pxTaskCode, const char * const pcName, const uint16_t usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask );
+void vTaskDelete( TaskHandle_t xTaskToDelete );
+
+void vTaskDelay( const TickType_t xTicksToDelay );
+void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement );
+
+UBaseType_t uxTaskPriorityGet( TaskHandle_t xTask );
+void vTaskPrioritySet( TaskHandle_t xTask, UBaseType_t uxNewPriority );
+
+void vTaskSuspend( TaskHandle_t xTaskToSuspend );
+void vTaskResume( TaskHandle_t xTaskToResume );
+BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume );
+
+void vTaskStartScheduler( void );
+void vTaskEndScheduler( void );
+void vTaskSuspendAll( void );
+BaseType_t xTaskResumeAll( void );
+BaseType_t xTaskGetSchedulerState( void );
+
+TickType_t xTaskGetTickCount( void );
+TickType_t xTaskGetTickCountFromISR( void );
+UBaseType_t uxTaskGetNumberOfTasks( void );
+char *pcTaskGetName( TaskHandle_t xTaskToQuery );
+TaskHandle_t xTaskGetCurrentTaskHandle( void );
+UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask );
+
+void vTaskList( char * pcWriteBuffer );
+void vTaskGetRunTimeStats( char *pcWriteBuffer );
+
+// application hooks (see programming_models/traditional/main.c)
+extern void vApplicationTickHook( void );
+extern void vApplicationIdleHook( void );
+extern void vApplicationMallocFailedHook( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TASK_H */
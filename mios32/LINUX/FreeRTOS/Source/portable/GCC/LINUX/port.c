@@ -0,0 +1,137 @@
+// $Id$
+/*
+ * FreeRTOS API emulation for the LINUX family - port layer
+ *
+ * Critical sections are mapped to MIOS32_IRQ_Disable/Enable, which lock
+ * the threads emulating interrupts (timers, tick hook, I/O receivers).
+ *
+ * Memory is allocated from the host heap. The usage is accounted against
+ * configTOTAL_HEAP_SIZE so that vPortMallocDebugInfo() reports numbers
+ * which are comparable to heap_4 on the target, but the limit isn't
+ * enforced.
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#include <stdlib.h>
+#include <malloc.h>
+#include <sched.h>
+
+#include <mios32.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+static size_t heap_used;
+static size_t heap_max_used;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Scheduler/critical section hooks
+/////////////////////////////////////////////////////////////////////////////
+
+void vPortYield( void )
+{
+  sched_yield();
+}
+
+void vPortEnterCritical( void )
+{
+  MIOS32_IRQ_Disable();
+}
+
+void vPortExitCritical( void )
+{
+  MIOS32_IRQ_Enable();
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Heap management
+/////////////////////////////////////////////////////////////////////////////
+
+static void prvAccount( void *pv, int add )
+{
+  if( pv == NULL )
+    return;
+
+  size_t size = malloc_usable_size(pv);
+  MIOS32_IRQ_Disable();
+  if( add ) {
+    heap_used += size;
+    if( heap_used > heap_max_used )
+      heap_max_used = heap_used;
+  } else {
+    heap_used -= size;
+  }
+  MIOS32_IRQ_Enable();
+}
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+  void *pvReturn = malloc(xWantedSize);
+  prvAccount(pvReturn, 1);
+
+#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+  if( pvReturn == NULL )
+    vApplicationMallocFailedHook();
+#endif
+
+  return pvReturn;
+}
+
+void *pvPortRealloc( void *pv, size_t xWantedSize )
+{
+  prvAccount(pv, 0);
+  void *pvReturn = realloc(pv, xWantedSize);
+  prvAccount(pvReturn ? pvReturn : pv, 1);
+
+#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+  if( pvReturn == NULL && xWantedSize )
+    vApplicationMallocFailedHook();
+#endif
+
+  return pvReturn;
+}
+
+void vPortFree( void *pv )
+{
+  prvAccount(pv, 0);
+  free(pv);
+}
+
+void vPortInitialiseBlocks( void )
+{
+  // nothing to do
+}
+
+size_t xPortGetFreeHeapSize( void )
+{
+  return (heap_used < configTOTAL_HEAP_SIZE) ? (configTOTAL_HEAP_SIZE - heap_used) : 0;
+}
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+  return (heap_max_used < configTOTAL_HEAP_SIZE) ? (configTOTAL_HEAP_SIZE - heap_max_used) : 0;
+}
+
+void vPortMallocDebugInfo( void )
+{
+  s32 heap_size = configTOTAL_HEAP_SIZE;
+  s32 free_heap = xPortGetFreeHeapSize();
+  s32 ever_free_heap = xPortGetMinimumEverFreeHeapSize();
+  s32 used_heap = heap_size - free_heap;
+
+  MIOS32_MIDI_SendDebugMessage("Heap: %d of %d bytes used (%d%%), %d bytes free, %d bytes minimum ever free", used_heap, heap_size, (used_heap*100)/heap_size, free_heap, ever_free_heap);
+}
@@ -0,0 +1,348 @@
+// $Id$
+/*
+ * FreeRTOS API emulation for the LINUX family - queues and semaphores
+ *
+ * Like in FreeRTOS, semaphores and mutexes are queues with an item size
+ * of 0 bytes. Each queue is protected by its own pthread mutex, blocked
+ * tasks are waiting on condition variables.
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+typedef struct QueueDefinition {
+  pthread_mutex_t mutex;
+  pthread_cond_t  not_empty;
+  pthread_cond_t  not_full;
+
+  uint8_t *storage;
+  UBaseType_t length;
+  UBaseType_t item_size;
+  UBaseType_t messages_waiting;
+  UBaseType_t read_pos; // index of the oldest item
+
+  uint8_t type;
+
+  // only used by mutexes
+  TaskHandle_t mutex_holder;
+  UBaseType_t recursive_call_count;
+} xQUEUE;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local Functions
+/////////////////////////////////////////////////////////////////////////////
+
+// waits for the given condition with timeout in ticks (portMAX_DELAY waits endless)
+// returns pdFALSE on timeout
+// note: has to be called with the queue mutex taken
+static BaseType_t prvWait(xQUEUE *q, pthread_cond_t *cond, const struct timespec *abstime)
+{
+  if( abstime == NULL )
+    return pthread_cond_wait(cond, &q->mutex) == 0;
+
+  return pthread_cond_timedwait(cond, &q->mutex, abstime) == 0;
+}
+
+static struct timespec *prvTimeout(struct timespec *ts, TickType_t xTicksToWait)
+{
+  if( xTicksToWait == portMAX_DELAY )
+    return NULL;
+
+  clock_gettime(CLOCK_MONOTONIC, ts);
+  ts->tv_sec += xTicksToWait / configTICK_RATE_HZ;
+  ts->tv_nsec += (long)(xTicksToWait % configTICK_RATE_HZ) * (1000000000L / configTICK_RATE_HZ);
+  if( ts->tv_nsec >= 1000000000L ) {
+    ts->tv_nsec -= 1000000000L;
+    ++ts->tv_sec;
+  }
+  return ts;
+}
+
+// note: has to be called with the queue mutex taken
+static void prvCopyDataToQueue(xQUEUE *q, const void *pvItemToQueue, const BaseType_t xPosition)
+{
+  if( q->item_size ) {
+    UBaseType_t pos;
+    if( xPosition == queueSEND_TO_FRONT ) {
+      q->read_pos = q->read_pos ? (q->read_pos - 1) : (q->length - 1);
+      pos = q->read_pos;
+    } else {
+      pos = (q->read_pos + q->messages_waiting) % q->length;
+    }
+    memcpy(&q->storage[pos * q->item_size], pvItemToQueue, q->item_size);
+  } else if( q->type == queueQUEUE_TYPE_MUTEX || q->type == queueQUEUE_TYPE_RECURSIVE_MUTEX ) {
+    q->mutex_holder = NULL;
+  }
+
+  ++q->messages_waiting;
+  pthread_cond_broadcast(&q->not_empty);
+}
+
+// note: has to be called with the queue mutex taken
+static void prvCopyDataFromQueue(xQUEUE *q, void *pvBuffer, const BaseType_t xJustPeek)
+{
+  if( q->item_size && pvBuffer )
+    memcpy(pvBuffer, &q->storage[q->read_pos * q->item_size], q->item_size);
+
+  if( !xJustPeek ) {
+    if( q->item_size )
+      q->read_pos = (q->read_pos + 1) % q->length;
+    --q->messages_waiting;
+
+    if( q->type == queueQUEUE_TYPE_MUTEX || q->type == queueQUEUE_TYPE_RECURSIVE_MUTEX )
+      q->mutex_holder = xTaskGetCurrentTaskHandle();
+
+    pthread_cond_broadcast(&q->not_full);
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Queue creation/deletion
+/////////////////////////////////////////////////////////////////////////////
+
+QueueHandle_t xQueueGenericCreate( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, const uint8_t ucQueueType )
+{
+  if( uxQueueLength == 0 )
+    return NULL;
+
+  xQUEUE *q = (xQUEUE *)pvPortMalloc(sizeof(xQUEUE));
+  if( q == NULL )
+    return NULL;
+
+  memset(q, 0, sizeof(xQUEUE));
+  if( uxItemSize ) {
+    q->storage = (uint8_t *)pvPortMalloc(uxQueueLength * uxItemSize);
+    if( q->storage == NULL ) {
+      vPortFree(q);
+      return NULL;
+    }
+  }
+
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_mutex_init(&q->mutex, NULL);
+  pthread_cond_init(&q->not_empty, &attr);
+  pthread_cond_init(&q->not_full, &attr);
+  pthread_condattr_destroy(&attr);
+
+  q->length = uxQueueLength;
+  q->item_size = uxItemSize;
+  q->type = ucQueueType;
+
+  return q;
+}
+
+BaseType_t xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue )
+{
+  xQUEUE *q = xQueue;
+
+  pthread_mutex_lock(&q->mutex);
+  q->messages_waiting = 0;
+  q->read_pos = 0;
+  pthread_cond_broadcast(&q->not_full);
+  pthread_mutex_unlock(&q->mutex);
+
+  return pdPASS;
+}
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+  xQUEUE *q = xQueue;
+
+  pthread_mutex_destroy(&q->mutex);
+  pthread_cond_destroy(&q->not_empty);
+  pthread_cond_destroy(&q->not_full);
+  if( q->storage )
+    vPortFree(q->storage);
+  vPortFree(q);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Send/Receive
+/////////////////////////////////////////////////////////////////////////////
+
+BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition )
+{
+  xQUEUE *q = xQueue;
+  struct timespec ts;
+  struct timespec *abstime = prvTimeout(&ts, xTicksToWait);
+
+  pthread_mutex_lock(&q->mutex);
+
+  if( xCopyPosition == queueOVERWRITE && q->messages_waiting ) {
+    // only allowed for queues with a length of 1
+    q->messages_waiting = 0;
+    q->read_pos = 0;
+  }
+
+  while( q->messages_waiting >= q->length ) {
+    if( xTicksToWait == 0 || !prvWait(q, &q->not_full, abstime) ) {
+      if( q->messages_waiting >= q->length ) {
+	pthread_mutex_unlock(&q->mutex);
+	return errQUEUE_FULL;
+      }
+    }
+  }
+
+  prvCopyDataToQueue(q, pvItemToQueue, xCopyPosition);
+  pthread_mutex_unlock(&q->mutex);
+
+  return pdPASS;
+}
+
+BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition )
+{
+  if( pxHigherPriorityTaskWoken )
+    *pxHigherPriorityTaskWoken = pdFALSE;
+
+  return xQueueGenericSend(xQueue, pvItemToQueue, 0, xCopyPosition);
+}
+
+BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+  return xQueueGenericSendFromISR(xQueue, NULL, pxHigherPriorityTaskWoken, queueSEND_TO_BACK);
+}
+
+BaseType_t xQueueGenericReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait, const BaseType_t xJustPeek )
+{
+  xQUEUE *q = xQueue;
+  struct timespec ts;
+  struct timespec *abstime = prvTimeout(&ts, xTicksToWait);
+
+  pthread_mutex_lock(&q->mutex);
+
+  while( q->messages_waiting == 0 ) {
+    if( xTicksToWait == 0 || !prvWait(q, &q->not_empty, abstime) ) {
+      if( q->messages_waiting == 0 ) {
+	pthread_mutex_unlock(&q->mutex);
+	return errQUEUE_EMPTY;
+      }
+    }
+  }
+
+  prvCopyDataFromQueue(q, pvBuffer, xJustPeek);
+  pthread_mutex_unlock(&q->mutex);
+
+  return pdPASS;
+}
+
+BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+  if( pxHigherPriorityTaskWoken )
+    *pxHigherPriorityTaskWoken = pdFALSE;
+
+  return xQueueGenericReceive(xQueue, pvBuffer, 0, pdFALSE);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Queue status
+/////////////////////////////////////////////////////////////////////////////
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+  return ((xQUEUE *)xQueue)->messages_waiting;
+}
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+  xQUEUE *q = xQueue;
+  return q->length - q->messages_waiting;
+}
+
+BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
+{
+  return uxQueueMessagesWaiting(xQueue) == 0 ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
+{
+  return uxQueueSpacesAvailable(xQueue) == 0 ? pdTRUE : pdFALSE;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Semaphores and Mutexes
+/////////////////////////////////////////////////////////////////////////////
+
+QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType )
+{
+  QueueHandle_t xNewQueue = xQueueGenericCreate(1, 0, ucQueueType);
+
+  // a mutex is available after creation
+  if( xNewQueue != NULL )
+    xQueueGenericSend(xNewQueue, NULL, 0, queueSEND_TO_BACK);
+
+  return xNewQueue;
+}
+
+QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount )
+{
+  if( uxInitialCount > uxMaxCount )
+    return NULL;
+
+  QueueHandle_t xHandle = xQueueGenericCreate(uxMaxCount, 0, queueQUEUE_TYPE_COUNTING_SEMAPHORE);
+  if( xHandle != NULL )
+    ((xQUEUE *)xHandle)->messages_waiting = uxInitialCount;
+
+  return xHandle;
+}
+
+void *xQueueGetMutexHolder( QueueHandle_t xSemaphore )
+{
+  return ((xQUEUE *)xSemaphore)->mutex_holder;
+}
+
+BaseType_t xQueueTakeMutexRecursive( QueueHandle_t xMutex, TickType_t xTicksToWait )
+{
+  xQUEUE *q = xMutex;
+
+  // note: the holder can only be the calling task if it already owns the mutex, no lock required
+  if( q->mutex_holder != NULL && q->mutex_holder == xTaskGetCurrentTaskHandle() ) {
+    ++q->recursive_call_count;
+    return pdPASS;
+  }
+
+  BaseType_t xReturn = xQueueGenericReceive(xMutex, NULL, xTicksToWait, pdFALSE);
+  if( xReturn == pdPASS )
+    ++q->recursive_call_count;
+
+  return xReturn;
+}
+
+BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex )
+{
+  xQUEUE *q = xMutex;
+
+  if( q->mutex_holder != xTaskGetCurrentTaskHandle() )
+    return pdFAIL; // not the owner
+
+  if( --q->recursive_call_count == 0 )
+    xQueueGenericSend(xMutex, NULL, 0, queueSEND_TO_BACK);
+
+  return pdPASS;
+}
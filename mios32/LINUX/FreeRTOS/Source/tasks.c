@@ -0,0 +1,512 @@
+// $Id$
+/*
+ * FreeRTOS API emulation for the LINUX family - tasks
+ *
+ * Each task is running as a POSIX thread. The scheduler isn't emulated:
+ * tasks are running in parallel, the priority is only stored. Like on the
+ * target, code which accesses data shared with other tasks has to be
+ * protected with mutexes or critical sections.
+ *
+ * The tick is generated by a separate thread which calls
+ * vApplicationTickHook() each mS with the MIOS32_IRQ lock taken (just like
+ * the SysTick interrupt would do). vTaskDelay() and vTaskDelayUntil() are
+ * synchronized to this tick, so that periodic tasks are running with the
+ * same timing like on the target.
+ *
+ * The thread which calls vTaskStartScheduler() becomes the idle task, it
+ * calls vApplicationIdleHook() until vTaskEndScheduler() has been called.
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include <mios32.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// the idle hook (usually APP_Background()) is called continuously like on
+// the target, which keeps one CPU core busy. With a value > 0 it's called
+// only once per given number of mS
+#ifndef MIOS32_LINUX_IDLE_HOOK_PERIOD_MS
+#define MIOS32_LINUX_IDLE_HOOK_PERIOD_MS 0
+#endif
+
+// if this environment variable is set, the scheduler will be stopped
+// after the given number of mS (vTaskStartScheduler() returns)
+#define RUN_TIME_ENV "MIOS32_LINUX_RUN_MS"
+
+// many applications never return from their idle hook (e.g. a background loop
+// which polls the timestamp). If the scheduler didn't stop within this number
+// of ticks after the run time, the process exits from the tick thread
+#define RUN_TIME_EXIT_TICKS 100
+
+#define NS_PER_TICK (1000000000L / configTICK_RATE_HZ)
+
+typedef struct tskTaskControlBlock {
+  pthread_t thread;
+  TaskFunction_t code;
+  void *parameters;
+  UBaseType_t priority;
+  uint16_t stack_depth;
+  UBaseType_t number;
+  char name[configMAX_TASK_NAME_LEN];
+  volatile char state; // 'R' (running/ready), 'B' (blocked by delay), 'S' (suspended)
+  volatile u8 suspended;
+  volatile u8 deleted;
+  struct tskTaskControlBlock *next;
+} tskTCB;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+// protects the task list, task states and tick count
+static pthread_mutex_t kernel_mutex = PTHREAD_MUTEX_INITIALIZER;
+// signalled on each tick, on scheduler start and on task resume
+static pthread_cond_t kernel_cond = PTHREAD_COND_INITIALIZER;
+
+static tskTCB *task_list;
+static UBaseType_t num_tasks;
+static UBaseType_t task_number;
+
+static tskTCB idle_task = { .name = "IDLE", .priority = tskIDLE_PRIORITY, .state = 'R' };
+
+static __thread tskTCB *current_task;
+
+static volatile TickType_t tick_count;
+static volatile u8 scheduler_running;
+static volatile u8 scheduler_end_request;
+
+static pthread_t tick_thread;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local Functions
+/////////////////////////////////////////////////////////////////////////////
+
+static void prvTimespecAddNs(struct timespec *ts, long ns)
+{
+  ts->tv_nsec += ns;
+  while( ts->tv_nsec >= 1000000000L ) {
+    ts->tv_nsec -= 1000000000L;
+    ++ts->tv_sec;
+  }
+}
+
+// waits until the tick count reached the given wake time, and while the task is suspended
+// note: has to be called with kernel_mutex taken
+static void prvWaitTick(tskTCB *tcb, TickType_t xWakeTime)
+{
+  if( tcb ) tcb->state = 'B';
+  while( !tcb || !tcb->deleted ) {
+    if( tcb && tcb->suspended )
+      tcb->state = 'S';
+    else if( (int32_t)(tick_count - xWakeTime) >= 0 )
+      break;
+    pthread_cond_wait(&kernel_cond, &kernel_mutex);
+  }
+  if( tcb ) tcb->state = 'R';
+}
+
+// delays before the scheduler has been started (the tick isn't running yet)
+static void prvSleepTicks(TickType_t xTicks)
+{
+  struct timespec ts;
+  ts.tv_sec = xTicks / configTICK_RATE_HZ;
+  ts.tv_nsec = (xTicks % configTICK_RATE_HZ) * NS_PER_TICK;
+  while( clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, &ts) != 0 );
+}
+
+static void prvRemoveTask(tskTCB *tcb)
+{
+  tskTCB **link;
+  for(link=&task_list; *link != NULL; link=&(*link)->next) {
+    if( *link == tcb ) {
+      *link = tcb->next;
+      --num_tasks;
+      break;
+    }
+  }
+}
+
+// exits the thread of a deleted task
+// note: has to be called with kernel_mutex taken
+static void prvCheckDeleted(tskTCB *tcb)
+{
+  if( tcb && tcb != &idle_task && tcb->deleted ) {
+    prvRemoveTask(tcb);
+    pthread_mutex_unlock(&kernel_mutex);
+    free(tcb);
+    pthread_exit(NULL);
+  }
+}
+
+static void *prvTaskThread(void *arg)
+{
+  tskTCB *tcb = (tskTCB *)arg;
+  current_task = tcb;
+
+  // like on the target, tasks are not started before the scheduler is running
+  pthread_mutex_lock(&kernel_mutex);
+  while( !scheduler_running )
+    pthread_cond_wait(&kernel_cond, &kernel_mutex);
+  pthread_mutex_unlock(&kernel_mutex);
+
+  tcb->code(tcb->parameters);
+
+  // a task function should never return - delete the task in this case
+  vTaskDelete(NULL);
+  return NULL;
+}
+
+static void *prvTickThread(void *arg)
+{
+  struct timespec next;
+  clock_gettime(CLOCK_MONOTONIC, &next);
+
+  TickType_t run_ticks = 0;
+  const char *run_time = getenv(RUN_TIME_ENV);
+  if( run_time != NULL )
+    run_ticks = (TickType_t)strtoul(run_time, NULL, 0) / portTICK_PERIOD_MS;
+
+  while( 1 ) {
+    prvTimespecAddNs(&next, NS_PER_TICK);
+    while( clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) != 0 );
+
+    // the tick hook is executed like an interrupt handler
+    MIOS32_IRQ_Disable();
+#if configUSE_TICK_HOOK
+    vApplicationTickHook();
+#endif
+    MIOS32_IRQ_Enable();
+
+    pthread_mutex_lock(&kernel_mutex);
+    ++tick_count;
+    pthread_cond_broadcast(&kernel_cond);
+    pthread_mutex_unlock(&kernel_mutex);
+
+    if( run_ticks && tick_count >= run_ticks ) {
+      vTaskEndScheduler();
+
+      if( tick_count >= (run_ticks + RUN_TIME_EXIT_TICKS) ) {
+	fflush(stdout);
+	exit(0);
+      }
+    }
+  }
+
+  return NULL;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Task creation/deletion
+/////////////////////////////////////////////////////////////////////////////
+
+BaseType_t xTaskCreate( TaskFunction_t pxTaskCode, const char * const pcName, const uint16_t usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask )
+{
+  tskTCB *tcb = (tskTCB *)calloc(1, sizeof(tskTCB));
+  if( tcb == NULL )
+    return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+
+  tcb->code = pxTaskCode;
+  tcb->parameters = pvParameters;
+  tcb->priority = uxPriority;
+  tcb->stack_depth = usStackDepth;
+  tcb->state = 'R';
+  strncpy(tcb->name, pcName ? pcName : "", configMAX_TASK_NAME_LEN-1);
+
+  pthread_mutex_lock(&kernel_mutex);
+  tcb->number = ++task_number;
+  tcb->next = task_list;
+  task_list = tcb;
+  ++num_tasks;
+
+  // note: the stack depth of the target isn't taken over, 64bit code needs more stack
+  if( pthread_create(&tcb->thread, NULL, prvTaskThread, tcb) != 0 ) {
+    prvRemoveTask(tcb);
+    pthread_mutex_unlock(&kernel_mutex);
+    free(tcb);
+    return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+  }
+  pthread_detach(tcb->thread);
+  pthread_mutex_unlock(&kernel_mutex);
+
+  if( pxCreatedTask )
+    *pxCreatedTask = tcb;
+
+  return pdPASS;
+}
+
+void vTaskDelete( TaskHandle_t xTaskToDelete )
+{
+  tskTCB *tcb = xTaskToDelete ? xTaskToDelete : current_task;
+  if( tcb == NULL || tcb == &idle_task )
+    return;
+
+  pthread_mutex_lock(&kernel_mutex);
+  tcb->deleted = 1;
+  if( tcb == current_task )
+    prvCheckDeleted(tcb); // doesn't return
+
+  // another task will exit once it's waiting for a delay
+  pthread_cond_broadcast(&kernel_cond);
+  pthread_mutex_unlock(&kernel_mutex);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Delays
+/////////////////////////////////////////////////////////////////////////////
+
+void vTaskDelay( const TickType_t xTicksToDelay )
+{
+  if( xTicksToDelay == 0 ) {
+    sched_yield();
+    return;
+  }
+
+  if( !scheduler_running ) {
+    prvSleepTicks(xTicksToDelay);
+    return;
+  }
+
+  pthread_mutex_lock(&kernel_mutex);
+  prvWaitTick(current_task, tick_count + xTicksToDelay);
+  prvCheckDeleted(current_task);
+  pthread_mutex_unlock(&kernel_mutex);
+}
+
+void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement )
+{
+  if( !scheduler_running ) {
+    prvSleepTicks(xTimeIncrement);
+    return;
+  }
+
+  pthread_mutex_lock(&kernel_mutex);
+  *pxPreviousWakeTime += xTimeIncrement;
+  prvWaitTick(current_task, *pxPreviousWakeTime);
+  prvCheckDeleted(current_task);
+  pthread_mutex_unlock(&kernel_mutex);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Task control
+/////////////////////////////////////////////////////////////////////////////
+
+UBaseType_t uxTaskPriorityGet( TaskHandle_t xTask )
+{
+  tskTCB *tcb = xTask ? xTask : current_task;
+  return tcb ? tcb->priority : tskIDLE_PRIORITY;
+}
+
+void vTaskPrioritySet( TaskHandle_t xTask, UBaseType_t uxNewPriority )
+{
+  tskTCB *tcb = xTask ? xTask : current_task;
+  if( tcb )
+    tcb->priority = uxNewPriority;
+}
+
+void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+{
+  tskTCB *tcb = xTaskToSuspend ? xTaskToSuspend : current_task;
+  if( tcb == NULL || tcb == &idle_task )
+    return;
+
+  pthread_mutex_lock(&kernel_mutex);
+  tcb->suspended = 1;
+  if( tcb == current_task ) {
+    prvWaitTick(tcb, tick_count);
+    prvCheckDeleted(tcb);
+  }
+  // another task is suspended once it's waiting for a delay
+  pthread_mutex_unlock(&kernel_mutex);
+}
+
+void vTaskResume( TaskHandle_t xTaskToResume )
+{
+  tskTCB *tcb = xTaskToResume;
+  if( tcb == NULL )
+    return;
+
+  pthread_mutex_lock(&kernel_mutex);
+  tcb->suspended = 0;
+  pthread_cond_broadcast(&kernel_cond);
+  pthread_mutex_unlock(&kernel_mutex);
+}
+
+BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
+{
+  vTaskResume(xTaskToResume);
+  return pdFALSE;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Scheduler control
+/////////////////////////////////////////////////////////////////////////////
+
+void vTaskStartScheduler( void )
+{
+  current_task = &idle_task;
+
+  pthread_mutex_lock(&kernel_mutex);
+  scheduler_running = 1;
+  pthread_cond_broadcast(&kernel_cond);
+  pthread_mutex_unlock(&kernel_mutex);
+
+  portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+
+  if( pthread_create(&tick_thread, NULL, prvTickThread, NULL) != 0 ) {
+    fprintf(stderr, "FATAL: tick thread couldn't be created\n");
+    return;
+  }
+  pthread_detach(tick_thread);
+
+  // the idle task
+  TickType_t xLastExecutionTime = xTaskGetTickCount();
+  while( !scheduler_end_request ) {
+#if configUSE_IDLE_HOOK
+    vApplicationIdleHook();
+#endif
+
+#if MIOS32_LINUX_IDLE_HOOK_PERIOD_MS > 0
+    vTaskDelayUntil(&xLastExecutionTime, MIOS32_LINUX_IDLE_HOOK_PERIOD_MS / portTICK_PERIOD_MS);
+
+    // skip delay gap if the hook took longer than the period
+    TickType_t xCurrentTickCount = xTaskGetTickCount();
+    if( (int32_t)(xCurrentTickCount - xLastExecutionTime) > 5 )
+      xLastExecutionTime = xCurrentTickCount;
+#else
+    (void)xLastExecutionTime;
+    sched_yield();
+#endif
+  }
+
+  // tasks won't be stopped, the application is expected to exit now
+  scheduler_running = 0;
+}
+
+void vTaskEndScheduler( void )
+{
+  scheduler_end_request = 1;
+}
+
+void vTaskSuspendAll( void )
+{
+  // there is no scheduler which could be suspended, take the global lock instead
+  MIOS32_IRQ_Disable();
+}
+
+BaseType_t xTaskResumeAll( void )
+{
+  MIOS32_IRQ_Enable();
+  return pdFALSE; // no yield
+}
+
+BaseType_t xTaskGetSchedulerState( void )
+{
+  return scheduler_running ? taskSCHEDULER_RUNNING : taskSCHEDULER_NOT_STARTED;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Task utilities
+/////////////////////////////////////////////////////////////////////////////
+
+TickType_t xTaskGetTickCount( void )
+{
+  return tick_count;
+}
+
+TickType_t xTaskGetTickCountFromISR( void )
+{
+  return tick_count;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks( void )
+{
+  return num_tasks + 1; // + idle task
+}
+
+char *pcTaskGetName( TaskHandle_t xTaskToQuery )
+{
+  tskTCB *tcb = xTaskToQuery ? xTaskToQuery : current_task;
+  return tcb ? tcb->name : NULL;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle( void )
+{
+  return current_task;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+{
+  // stack usage isn't tracked, return the allocated stack depth of the target
+  tskTCB *tcb = xTask ? xTask : current_task;
+  return tcb ? tcb->stack_depth : 0;
+}
+
+void vTaskList( char * pcWriteBuffer )
+{
+  tskTCB *tcb;
+
+  *pcWriteBuffer = 0;
+  pthread_mutex_lock(&kernel_mutex);
+  for(tcb=task_list; tcb != NULL; tcb=tcb->next) {
+    pcWriteBuffer += sprintf(pcWriteBuffer, "%-*s\t%c\t%u\t%u\t%u\r\n",
+			     configMAX_TASK_NAME_LEN-1, tcb->name, tcb->state,
+			     (unsigned)tcb->priority, (unsigned)tcb->stack_depth, (unsigned)tcb->number);
+  }
+  pthread_mutex_unlock(&kernel_mutex);
+}
+
+void vTaskGetRunTimeStats( char *pcWriteBuffer )
+{
+  // the run time is taken from the CPU time clocks of the threads (in uS)
+  tskTCB *tcb;
+  struct timespec ts;
+  clockid_t cid;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  unsigned long long total = (unsigned long long)ts.tv_sec*1000000 + ts.tv_nsec/1000;
+  if( total == 0 )
+    total = 1;
+
+  *pcWriteBuffer = 0;
+  pthread_mutex_lock(&kernel_mutex);
+  for(tcb=task_list; tcb != NULL; tcb=tcb->next) {
+    unsigned long long run_time = 0;
+    if( pthread_getcpuclockid(tcb->thread, &cid) == 0 && clock_gettime(cid, &ts) == 0 )
+      run_time = (unsigned long long)ts.tv_sec*1000000 + ts.tv_nsec/1000;
+
+    pcWriteBuffer += sprintf(pcWriteBuffer, "%-*s\t%llu\t\t%llu%%\r\n",
+			     configMAX_TASK_NAME_LEN-1, tcb->name, run_time, (run_time*100)/total);
+  }
+  pthread_mutex_unlock(&kernel_mutex);
+}
@@ -0,0 +1,111 @@
+// $Id$
+//! \defgroup MIOS32_AIN
+//!
+//! AIN functions for the LINUX family
+//!
+//! There are no analog inputs on the host, pins are reported like for a
+//! configuration without enabled AIN channels.
+//!
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+
+// this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
+#if !defined(MIOS32_DONT_USE_AIN)
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes AIN driver
+//! \param[in] mode currently only mode 0 supported
+//! \return < 0 if initialisation failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_AIN_Init(u32 mode)
+{
+  // currently only mode 0 supported
+  if( mode != 0 )
+    return -1; // unsupported mode
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Installs an optional "Service Prepare" callback function (ignored)
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_AIN_ServicePrepareCallback_Init(void *_service_prepare_callback)
+{
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns value of an AIN Pin
+//! \param[in] pin number
+//! \return -1 (no analog input available)
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_AIN_PinGet(u32 pin)
+{
+  return -1; // no analog input selected
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! \return the deadband which is used to notify changes
+//! \return < 0 on error
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_AIN_DeadbandGet(void)
+{
+  return -1; // no analog input selected
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Sets the deadband
+//! \return < 0 on error
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_AIN_DeadbandSet(u16 deadband)
+{
+  return -1; // no analog input selected
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Checks for pin changes (never for the LINUX family)
+//! \param[in] _callback pointer to callback function
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_AIN_Handler(void *_callback)
+{
+  // no callback function?
+  if( _callback == NULL )
+    return -1;
+
+  return -1; // no analog input selected
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Starts an ADC conversion
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_AIN_StartConversions(void)
+{
+  return -1; // no analog input selected
+}
+
+//! \}
+
+#endif /* MIOS32_DONT_USE_AIN */
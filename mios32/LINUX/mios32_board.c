@@ -0,0 +1,457 @@
+// $Id$
+//! \defgroup MIOS32_BOARD
+//!
+//! Development Board specific functions for the LINUX family
+//!
+//! There are no GPIOs on the host: J5 and J10 are emulated with pin latches,
+//! so that outputs can be read back and inputs with pull-up are read as 1.
+//! J15 (LCD port) and J28 are not available, accordingly the LCD drivers
+//! will flag the displays as not connected.
+//!
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+
+// this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
+#if !defined(MIOS32_DONT_USE_BOARD)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// same number of LEDs like on the MBHP_CORE_STM32F4 module
+#define NUM_LEDS 4
+
+#define J5_NUM_PINS  12
+#define J10_NUM_PINS 16
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+static u32 led_state;
+
+typedef struct {
+  u16 enable_mask;
+  u16 output_mask;
+  u16 pullup_mask;
+  u16 latch;
+} board_port_t;
+
+static board_port_t j5_port;
+static board_port_t j10_port;
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes MIOS32_BOARD driver
+//! \param[in] mode currently only mode 0 supported
+//! \return < 0 if initialisation failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_Init(u32 mode)
+{
+  // currently only mode 0 supported
+  if( mode != 0 )
+    return -1; // unsupported mode
+
+  led_state = 0;
+  j5_port.enable_mask = 0;
+  j10_port.enable_mask = 0;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Internally used help functions to access the emulated ports
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_BOARD_PinInitHlp(board_port_t *port, u8 num_pins, u8 pin, mios32_board_pin_mode_t mode)
+{
+  if( pin >= num_pins )
+    return -1; // pin not supported
+
+  u16 mask = 1 << pin;
+
+  if( mode == MIOS32_BOARD_PIN_MODE_IGNORE ) {
+    // don't touch
+    port->enable_mask &= ~mask;
+    return 0;
+  }
+
+  if( mode > MIOS32_BOARD_PIN_MODE_OUTPUT_OD )
+    return -2; // invalid pin mode
+
+  port->enable_mask |= mask;
+
+  if( mode == MIOS32_BOARD_PIN_MODE_OUTPUT_PP || mode == MIOS32_BOARD_PIN_MODE_OUTPUT_OD )
+    port->output_mask |= mask;
+  else
+    port->output_mask &= ~mask;
+
+  if( mode == MIOS32_BOARD_PIN_MODE_INPUT_PU || mode == MIOS32_BOARD_PIN_MODE_OUTPUT_OD )
+    port->pullup_mask |= mask;
+  else
+    port->pullup_mask &= ~mask;
+
+  return 0; // no error
+}
+
+static u16 MIOS32_BOARD_PortGetHlp(board_port_t *port)
+{
+  // outputs are read back, inputs are only pulled up (if enabled)
+  u16 value = (port->latch & port->output_mask) | (port->pullup_mask & ~port->output_mask);
+
+  // open drain outputs are only pulled up if not driven to 0
+  return value & port->enable_mask;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes LEDs of the board
+//! \param[in] leds mask contains a flag for each LED which should be initialized<BR>
+//! The LINUX family emulates 4 LEDs like MBHP_CORE_STM32F4
+//! \return 0 if initialisation passed
+//! \return -2 if one or more LEDs not available on board
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_LED_Init(u32 leds)
+{
+  if( leds & ~((1 << NUM_LEDS)-1) )
+    return -2; // LED doesn't exist
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Sets one or more LEDs to the given value(s)
+//! \param[in] leds mask contains a flag for each LED which should be changed
+//! \param[in] value contains the value for each LED which should be changed
+//! \return 0 if initialisation passed
+//! \return -2 if one or more LEDs not available on board
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_LED_Set(u32 leds, u32 value)
+{
+  u32 mask = leds & ((1 << NUM_LEDS)-1);
+  led_state = (led_state & ~mask) | (value & mask);
+
+  if( leds & ~((1 << NUM_LEDS)-1) )
+    return -2; // LED doesn't exist
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the status of all LEDs
+//! \return status of all LEDs
+/////////////////////////////////////////////////////////////////////////////
+u32 MIOS32_BOARD_LED_Get(void)
+{
+  return led_state;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes a J5 pin
+//! \param[in] pin the pin number (0..11)
+//! \param[in] mode the pin mode (see mios32_board_pin_mode_t)
+//! \return < 0 if initialisation failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J5_PinInit(u8 pin, mios32_board_pin_mode_t mode)
+{
+  return MIOS32_BOARD_PinInitHlp(&j5_port, J5_NUM_PINS, pin, mode);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function sets all pins of J5 at once
+//! \param[in] value 12 bits which are forwarded to J5A/B/C
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J5_Set(u16 value)
+{
+  j5_port.latch = (j5_port.latch & ~j5_port.enable_mask) | (value & j5_port.enable_mask);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function sets a single pin of J5
+//! \param[in] pin the pin number (0..11)
+//! \param[in] value the pin value (0 or 1)
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J5_PinSet(u8 pin, u8 value)
+{
+  if( pin >= J5_NUM_PINS )
+    return -1; // pin not supported
+
+  if( !(j5_port.enable_mask & (1 << pin)) )
+    return -2; // pin disabled
+
+  if( value )
+    j5_port.latch |= (1 << pin);
+  else
+    j5_port.latch &= ~(1 << pin);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function returns the state of all pins of J5
+//! \return 12 bits which are forwarded from J5A/B/C
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J5_Get(void)
+{
+  return MIOS32_BOARD_PortGetHlp(&j5_port);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function returns the state of a single pin of J5
+//! \param[in] pin the pin number (0..11)
+//! \return < 0 if pin not available
+//! \return >= 0: input state of pin
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J5_PinGet(u8 pin)
+{
+  if( pin >= J5_NUM_PINS )
+    return -1; // pin not supported
+
+  if( !(j5_port.enable_mask & (1 << pin)) )
+    return -2; // pin disabled
+
+  return (MIOS32_BOARD_PortGetHlp(&j5_port) >> pin) & 1;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes a J10 pin
+//! \param[in] pin the pin number (0..15)
+//! \param[in] mode the pin mode (see mios32_board_pin_mode_t)
+//! \return < 0 if initialisation failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J10_PinInit(u8 pin, mios32_board_pin_mode_t mode)
+{
+  return MIOS32_BOARD_PinInitHlp(&j10_port, J10_NUM_PINS, pin, mode);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function sets all pins of J10 at once
+//! \param[in] value 16 bits which are forwarded to J10
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J10_Set(u16 value)
+{
+  j10_port.latch = (j10_port.latch & ~j10_port.enable_mask) | (value & j10_port.enable_mask);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function sets a single pin of J10
+//! \param[in] pin the pin number (0..15)
+//! \param[in] value the pin value (0 or 1)
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J10_PinSet(u8 pin, u8 value)
+{
+  if( pin >= J10_NUM_PINS )
+    return -1; // pin not supported
+
+  if( !(j10_port.enable_mask & (1 << pin)) )
+    return -2; // pin disabled
+
+  if( value )
+    j10_port.latch |= (1 << pin);
+  else
+    j10_port.latch &= ~(1 << pin);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function returns the state of all pins of J10
+//! \return 16 bits which are forwarded from J10
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J10_Get(void)
+{
+  return MIOS32_BOARD_PortGetHlp(&j10_port);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function returns the state of a single pin of J10
+//! \param[in] pin the pin number (0..15)
+//! \return < 0 if pin not available
+//! \return >= 0: input state of pin
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J10_PinGet(u8 pin)
+{
+  if( pin >= J10_NUM_PINS )
+    return -1; // pin not supported
+
+  if( !(j10_port.enable_mask & (1 << pin)) )
+    return -2; // pin disabled
+
+  return (MIOS32_BOARD_PortGetHlp(&j10_port) >> pin) & 1;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function returns the state of all pins of J10A (J10[7:0])
+//! \return 8 bits which are forwarded from J10A
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J10A_Get(void)
+{
+  return MIOS32_BOARD_PortGetHlp(&j10_port) & 0xff;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function sets all pins of J10A (J10[7:0]) at once
+//! \param[in] value 8 bits which are forwarded to J10A
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J10A_Set(u8 value)
+{
+  return MIOS32_BOARD_J10_Set((j10_port.latch & 0xff00) | value);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function returns the state of all pins of J10B (J10[15:8])
+//! \return 8 bits which are forwarded from J10B
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J10B_Get(void)
+{
+  return MIOS32_BOARD_PortGetHlp(&j10_port) >> 8;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function sets all pins of J10B (J10[15:8]) at once
+//! \param[in] value 8 bits which are forwarded to J10B
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J10B_Set(u8 value)
+{
+  return MIOS32_BOARD_J10_Set((j10_port.latch & 0x00ff) | ((u16)value << 8));
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! J28 is not available for the LINUX family (same like for STM32F4)
+//! \return -1
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J28_PinInit(u8 pin, mios32_board_pin_mode_t mode)
+{
+  return -1; // MIOS32_BOARD_J28 not supported
+}
+
+s32 MIOS32_BOARD_J28_Set(u16 value)
+{
+  return -1; // MIOS32_BOARD_J28 not supported
+}
+
+s32 MIOS32_BOARD_J28_PinSet(u8 pin, u8 value)
+{
+  return -1; // MIOS32_BOARD_J28 not supported
+}
+
+s32 MIOS32_BOARD_J28_Get(void)
+{
+  return -1; // MIOS32_BOARD_J28 not supported
+}
+
+s32 MIOS32_BOARD_J28_PinGet(u8 pin)
+{
+  return -1; // MIOS32_BOARD_J28 not supported
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! The J15 LCD port is not available for the LINUX family
+//! \return -1 (LCD port not available)
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_J15_PortInit(u32 mode)
+{
+  return -1; // LCD port not available
+}
+
+s32 MIOS32_BOARD_J15_DataSet(u8 data)
+{
+  return -1; // LCD port not available
+}
+
+s32 MIOS32_BOARD_J15_SerDataShift(u8 data)
+{
+  return -1; // LCD port not available
+}
+
+s32 MIOS32_BOARD_J15_RS_Set(u8 rs)
+{
+  return -1; // LCD port not available
+}
+
+s32 MIOS32_BOARD_J15_RW_Set(u8 rw)
+{
+  return -1; // LCD port not available
+}
+
+s32 MIOS32_BOARD_J15_E_Set(u8 lcd, u8 e)
+{
+  return -1; // LCD port not available
+}
+
+s32 MIOS32_BOARD_J15_GetD7In(void)
+{
+  return -1; // LCD port not available
+}
+
+s32 MIOS32_BOARD_J15_D7InPullUpEnable(u8 enable)
+{
+  return -1; // LCD port not available
+}
+
+s32 MIOS32_BOARD_J15_PollUnbusy(u8 lcd, u32 time_out)
+{
+  return -1; // LCD port not available
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! The DAC is not available for the LINUX family
+//! \return -1 (channel not supported)
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_BOARD_DAC_PinInit(u8 chn, u8 enable)
+{
+  return -1; // channel not supported
+}
+
+s32 MIOS32_BOARD_DAC_PinSet(u8 chn, u16 value)
+{
+  return -1; // channel not supported
+}
+
+//! \}
+
+#endif /* MIOS32_DONT_USE_BOARD */
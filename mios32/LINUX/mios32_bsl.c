@@ -0,0 +1,20 @@
+// $Id$
+//
+// There is no bootloader for the LINUX family.
+// This file only exists so that the module list in mios32.mk doesn't
+// have to be changed for this family.
+//
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
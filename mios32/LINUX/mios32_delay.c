@@ -0,0 +1,62 @@
+// $Id$
+//! \defgroup MIOS32_DELAY
+//!
+//! Delay functions for the LINUX family
+//!
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <time.h>
+
+#include <mios32.h>
+
+// this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
+#if !defined(MIOS32_DONT_USE_DELAY)
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes the MIOS32_DELAY functions<BR>
+//! Nothing to do for the LINUX family, but the mode is checked like on the target
+//! \param[in] mode currently only mode 0 supported
+//! \return < 0 if initialisation failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_DELAY_Init(u32 mode)
+{
+  // currently only mode 0 supported
+  if( mode != 0 )
+    return -1; // unsupported mode
+
+  return 0; // no error
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Waits for a specific number of uS<BR>
+//! The host scheduler could delay the return for a longer time, it
+//! isn't guaranteed that the function returns exactly after the given time.
+//! \param[in] uS delay (1..65535 microseconds)
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_DELAY_Wait_uS(u16 uS)
+{
+  struct timespec ts;
+  ts.tv_sec = 0;
+  ts.tv_nsec = (long)uS * 1000;
+  clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, NULL);
+
+  return 0; // no error
+}
+
+//! \}
+
+#endif /* MIOS32_DONT_USE_DELAY */
@@ -0,0 +1,14 @@
+# $Id$
+# defines additional rules for MIOS32 family
+
+# enhance include path
+C_INCLUDE +=	-I $(MIOS32_PATH)/mios32/$(FAMILY)
+
+# the C library of the host provides printf & co.
+# (printf-stdarg.c doesn't work with 64bit pointers)
+THUMB_SOURCE := $(filter-out %/printf-stdarg.c,$(THUMB_SOURCE))
+
+THUMB_AS_SOURCE += 
+
+# directories and files that should be part of the distribution (release) package
+DIST += $(MIOS32_PATH)/mios32/$(FAMILY)
@@ -0,0 +1,60 @@
+// $Id$
+//! \defgroup MIOS32_I2S
+//!
+//! I2S audio functions for the LINUX family
+//!
+//! Audio output isn't supported, all functions return an error.
+//!
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+
+// this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
+#if !defined(MIOS32_DONT_USE_I2S)
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes I2S interface
+//! \param[in] mode currently only mode 0 supported
+//! \return < 0 if initialisation failed (always for the LINUX family)
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_I2S_Init(u32 mode)
+{
+  return -1; // I2S not supported
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Starts DMA driven I2S transfers
+//! \return < 0 if I2S not supported
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_I2S_Start(u32 *buffer, u16 len, void *_callback)
+{
+  return -1; // I2S not supported
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Stops DMA driven I2S transfers
+//! \return < 0 if I2S not supported
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_I2S_Stop(void)
+{
+  return -1; // I2S not supported
+}
+
+//! \}
+
+#endif /* MIOS32_DONT_USE_I2S */
@@ -0,0 +1,213 @@
+// $Id$
+//! \defgroup MIOS32_IIC
+//!
+//! IIC driver for the LINUX family
+//!
+//! No IIC devices are connected to the host. The semaphore handling is
+//! the same like on the target, but each transfer fails with
+//! MIOS32_IIC_ERROR_SLAVE_NOT_CONNECTED.
+//!
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+
+// this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
+#if !defined(MIOS32_DONT_USE_IIC)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local types
+/////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  volatile u8 iic_semaphore;
+  volatile s32 transfer_error;
+  volatile s32 last_transfer_error;
+} iic_rec_t;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+static iic_rec_t iic_rec[MIOS32_IIC_NUM];
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes IIC driver
+//! \param[in] mode currently only mode 0 supported
+//! \return < 0 if initialisation failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IIC_Init(u32 mode)
+{
+  int i;
+
+  // currently only mode 0 supported
+  if( mode != 0 )
+    return -1; // unsupported mode
+
+  for(i=0; i<MIOS32_IIC_NUM; ++i) {
+    iic_rec[i].iic_semaphore = 0;
+    iic_rec[i].transfer_error = 0;
+    iic_rec[i].last_transfer_error = 0;
+  }
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Semaphore handling: requests the IIC interface
+//! \param[in] iic_port the IIC port (0..MIOS32_IIC_NUM-1)
+//! \param[in] semaphore_type is either IIC_Blocking or IIC_Non_Blocking
+//! \return Non_Blocking: returns -1 to request a retry
+//! \return 0 if IIC interface free
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IIC_TransferBegin(u8 iic_port, mios32_iic_semaphore_t semaphore_type)
+{
+  s32 status = -1;
+
+  if( iic_port >= MIOS32_IIC_NUM )
+    return MIOS32_IIC_ERROR_INVALID_PORT;
+
+  iic_rec_t *iicx = &iic_rec[iic_port];// simplify addressing of record
+
+  do {
+    MIOS32_IRQ_Disable();
+    if( !iicx->iic_semaphore ) {
+      iicx->iic_semaphore = 1;
+      status = 0;
+    }
+    MIOS32_IRQ_Enable();
+  } while( semaphore_type == IIC_Blocking && status != 0 );
+
+  // clear transfer errors of last transmission
+  iicx->last_transfer_error = 0;
+  iicx->transfer_error = 0;
+
+  return status;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Semaphore handling: releases the IIC interface for other tasks
+//! \param[in] iic_port the IIC port (0..MIOS32_IIC_NUM-1)
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IIC_TransferFinished(u8 iic_port)
+{
+  if( iic_port >= MIOS32_IIC_NUM )
+    return MIOS32_IIC_ERROR_INVALID_PORT;
+
+  iic_rec[iic_port].iic_semaphore = 0;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the last transfer error<BR>
+//! Will be updated by MIOS32_IIC_TransferCheck(), so that the error status
+//! doesn't get lost (the check function will return 0 when called again)
+//! \param[in] iic_port the IIC port (0..MIOS32_IIC_NUM-1)
+//! \return last error status
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IIC_LastErrorGet(u8 iic_port)
+{
+  if( iic_port >= MIOS32_IIC_NUM )
+    return MIOS32_IIC_ERROR_INVALID_PORT;
+
+  return iic_rec[iic_port].last_transfer_error;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Checks if transfer is finished
+//! \param[in] iic_port the IIC port (0..MIOS32_IIC_NUM-1)
+//! \return 0 if no ongoing transfer
+//! \return < 0 if previous transfer failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IIC_TransferCheck(u8 iic_port)
+{
+  if( iic_port >= MIOS32_IIC_NUM )
+    return MIOS32_IIC_ERROR_INVALID_PORT;
+
+  iic_rec_t *iicx = &iic_rec[iic_port];// simplify addressing of record
+
+  // error during transfer?
+  if( iicx->transfer_error ) {
+    // store error status for MIOS32_IIC_LastErrorGet() function
+    iicx->last_transfer_error = iicx->transfer_error;
+    // clear current error status
+    iicx->transfer_error = 0;
+    // release semaphore for easier programming at user level
+    iicx->iic_semaphore = 0;
+    // and exit
+    return iicx->last_transfer_error;
+  }
+
+  // no transfer
+  return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Waits until transfer is finished
+//! \param[in] iic_port the IIC port (0..MIOS32_IIC_NUM-1)
+//! \return 0 if no ongoing transfer
+//! \return < 0 if previous transfer failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IIC_TransferWait(u8 iic_port)
+{
+  // transfers are never ongoing
+  return MIOS32_IIC_TransferCheck(iic_port);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Starts a new transfer. The slave is never connected on the host, the
+//! error will be returned by MIOS32_IIC_TransferCheck()/MIOS32_IIC_TransferWait()
+//! \param[in] iic_port the IIC port (0..MIOS32_IIC_NUM-1)
+//! \param[in] transfer type (see mios32_iic_transfer_t)
+//! \param[in] address of slave device
+//! \param[in] *buffer pointer to transmit/receive buffer
+//! \param[in] len number of bytes which should be transmitted/received
+//! \return 0 if transfer has been started
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IIC_Transfer(u8 iic_port, mios32_iic_transfer_t transfer, u8 address, u8 *buffer, u16 len)
+{
+  if( iic_port >= MIOS32_IIC_NUM )
+    return MIOS32_IIC_ERROR_INVALID_PORT;
+
+  // check type of transfer
+  switch( transfer ) {
+  case IIC_Read:
+  case IIC_Read_AbortIfFirstByteIs0:
+  case IIC_Write:
+  case IIC_Write_WithoutStop:
+    break;
+  default:
+    return MIOS32_IIC_ERROR_UNSUPPORTED_TRANSFER_TYPE;
+  }
+
+  iic_rec[iic_port].transfer_error = MIOS32_IIC_ERROR_SLAVE_NOT_CONNECTED;
+
+  return 0; // no error
+}
+
+//! \}
+
+#endif /* MIOS32_DONT_USE_IIC */
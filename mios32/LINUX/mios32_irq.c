@@ -0,0 +1,106 @@
+// $Id$
+//! \defgroup MIOS32_IRQ
+//!
+//! System Specific IRQ Enable/Disable routines for the LINUX family
+//!
+//! There are no interrupts on the host: timers and I/O receivers are
+//! running in separate threads which take a global recursive lock before
+//! they call the handlers. MIOS32_IRQ_Disable() takes the same lock, so
+//! that code protected by it can't be interrupted by an emulated ISR.
+//! 
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // for PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP
+#endif
+#include <pthread.h>
+
+#include <mios32.h>
+
+// this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
+#if !defined(MIOS32_DONT_USE_IRQ)
+
+
+// the global lock which replaces the interrupt mask
+static pthread_mutex_t irq_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+// the nesting counter is maintained per thread, it allows to detect nesting errors
+static __thread u32 nested_ctr;
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function disables all interrupts (nested)
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IRQ_Disable(void)
+{
+  pthread_mutex_lock(&irq_mutex);
+
+  ++nested_ctr;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function enables all interrupts (nested)
+//! \return < 0 on errors
+//! \return -1 on nesting errors (MIOS32_IRQ_Disable() hasn't been called before)
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IRQ_Enable(void)
+{
+  // check for nesting error
+  if( nested_ctr == 0 )
+    return -1; // nesting error
+
+  // decrease nesting level
+  --nested_ctr;
+
+  pthread_mutex_unlock(&irq_mutex);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function installs an interrupt service.
+//! Not relevant for the LINUX family, only the priority is checked.
+//! \param[in] IRQn the interrupt number
+//! \param[in] priority the priority from 0..15
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IRQ_Install(u8 IRQn, u8 priority)
+{
+  if( priority >= 16 )
+    return -1; // invalid priority
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function deinstalls an interrupt service.
+//! Not relevant for the LINUX family.
+//! \param[in] IRQn the interrupt number
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_IRQ_DeInstall(u8 IRQn)
+{
+  return 0; // no error
+}
+
+//! \}
+
+#endif /* MIOS32_DONT_USE_IRQ */
@@ -0,0 +1,316 @@
+// $Id$
+//! \defgroup MIOS32_SPI
+//!
+//! Hardware Abstraction Layer for SPI ports of the LINUX family
+//!
+//! No SPI devices are connected to the host. Received bytes are 0xff (like
+//! an open MISO line with pull-up), so that an SRIO scan reads all DIN pins
+//! in passive state (buttons depressed).
+//!
+//! Block transfers with a callback are emulated like DMA transfers: each
+//! port has a thread which waits for the transfer time (derived from the
+//! prescaler) and calls the callback with "interrupts" disabled, after
+//! MIOS32_SPI_TransferBlock() has returned. Applications which retrigger
+//! a transfer from the callback (e.g. a continuous SRIO scan) work like
+//! on the target.
+//!
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <mios32.h>
+
+// this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
+#if !defined(MIOS32_DONT_USE_SPI)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+#define NUM_SPI 3
+
+// peripheral clock of the emulated STM32F4 (APB2), used to calculate the transfer time
+#define SPI_PERIPHERAL_CLOCK 84000000
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  pthread_t thread;
+  u8 thread_running;
+  u8 prescaler;
+
+  // pending transfer, protected by spi_mutex
+  u32 seq; // incremented with each transfer, a new transfer replaces the pending one
+  u8 pending;
+  struct timespec done_time;
+  u8 *receive_buffer;
+  u16 len;
+  void (*callback)(void);
+} spi_port_t;
+
+static spi_port_t spi_port[NUM_SPI] = {
+  { .prescaler = MIOS32_SPI_PRESCALER_128 },
+  { .prescaler = MIOS32_SPI_PRESCALER_128 },
+  { .prescaler = MIOS32_SPI_PRESCALER_128 },
+};
+
+static pthread_mutex_t spi_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t spi_cond = PTHREAD_COND_INITIALIZER;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local functions
+/////////////////////////////////////////////////////////////////////////////
+
+static s32 MIOS32_SPI_PortCheck(u8 spi)
+{
+  switch( spi ) {
+    case 0:
+#ifdef MIOS32_DONT_USE_SPI0
+      return -1; // disabled SPI port
+#else
+      return 0;
+#endif
+    case 1:
+#ifdef MIOS32_DONT_USE_SPI1
+      return -1; // disabled SPI port
+#else
+      return 0;
+#endif
+    case 2:
+#ifdef MIOS32_DONT_USE_SPI2
+      return -1; // disabled SPI port
+#else
+      return 0;
+#endif
+  }
+
+  return -2; // unsupported SPI port
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// DMA thread: completes the transfers of a SPI port
+/////////////////////////////////////////////////////////////////////////////
+static void *MIOS32_SPI_DMA_Thread(void *arg)
+{
+  spi_port_t *port = &spi_port[(size_t)arg];
+
+  pthread_mutex_lock(&spi_mutex);
+  while( 1 ) {
+    while( !port->pending )
+      pthread_cond_wait(&spi_cond, &spi_mutex);
+
+    u32 seq = port->seq;
+    struct timespec done_time = port->done_time;
+    pthread_mutex_unlock(&spi_mutex);
+
+    while( clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &done_time, NULL) != 0 );
+
+    pthread_mutex_lock(&spi_mutex);
+    if( port->pending && port->seq == seq ) {
+      u8 *receive_buffer = port->receive_buffer;
+      u16 len = port->len;
+      void (*callback)(void) = port->callback;
+      port->pending = 0;
+
+      // the callback can start the next transfer
+      pthread_mutex_unlock(&spi_mutex);
+
+      if( receive_buffer != NULL )
+	memset(receive_buffer, 0xff, len);
+
+      // the callback is executed like an interrupt handler
+      MIOS32_IRQ_Disable();
+      callback();
+      MIOS32_IRQ_Enable();
+
+      pthread_mutex_lock(&spi_mutex);
+    }
+  }
+
+  return NULL;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes SPI pins
+//! \param[in] mode currently only mode 0 supported
+//! \return < 0 if initialisation failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SPI_Init(u32 mode)
+{
+  // currently only mode 0 supported
+  if( mode != 0 )
+    return -1; // unsupported mode
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! (Re-)initializes SPI IO Pins
+//! \param[in] spi SPI number (0, 1 or 2)
+//! \param[in] spi_pin_driver pin driver mode (ignored by the LINUX family)
+//! \return 0 if no error
+//! \return -1 if disabled SPI port selected
+//! \return -2 if unsupported SPI port selected
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SPI_IO_Init(u8 spi, mios32_spi_pin_driver_t spi_pin_driver)
+{
+  return MIOS32_SPI_PortCheck(spi);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! (Re-)initializes SPI peripheral transfer mode
+//! \param[in] spi SPI number (0, 1 or 2)
+//! \param[in] spi_mode configures clock and capture phase (ignored by the LINUX family)
+//! \param[in] spi_prescaler configures the SPI speed (only used to emulate the transfer time of blocks)
+//! \return 0 if no error
+//! \return -1 if disabled SPI port selected
+//! \return -2 if unsupported SPI port selected
+//! \return -3 if invalid spi_prescaler selected
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SPI_TransferModeInit(u8 spi, mios32_spi_mode_t spi_mode, mios32_spi_prescaler_t spi_prescaler)
+{
+  s32 status = MIOS32_SPI_PortCheck(spi);
+  if( status < 0 )
+    return status;
+
+  if( spi_prescaler >= 8 )
+    return -3; // invalid prescaler
+
+  spi_port[spi].prescaler = spi_prescaler;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Controls the RC (Register Clock alias Chip Select) pin of a SPI port
+//! \param[in] spi SPI number (0, 1 or 2)
+//! \param[in] rc_pin RCx pin (0 or 1)
+//! \param[in] pin_value 0 or 1
+//! \return 0 if no error
+//! \return -1 if disabled SPI port selected
+//! \return -2 if unsupported SPI port selected
+//! \return -3 if unsupported RCx pin selected
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SPI_RC_PinSet(u8 spi, u8 rc_pin, u8 pin_value)
+{
+  s32 status = MIOS32_SPI_PortCheck(spi);
+  if( status < 0 )
+    return status;
+
+  if( rc_pin >= 2 )
+    return -3; // unsupported RC pin
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Transfers a byte to SPI output and reads back the value from SPI input
+//! \param[in] spi SPI number (0, 1 or 2)
+//! \param[in] b the byte which should be transfered
+//! \return >= 0: the read byte (always 0xff)
+//! \return -1 if disabled SPI port selected
+//! \return -2 if unsupported SPI port selected
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SPI_TransferByte(u8 spi, u8 b)
+{
+  s32 status = MIOS32_SPI_PortCheck(spi);
+  if( status < 0 )
+    return status;
+
+  return 0xff;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Transfers a block of bytes
+//!
+//! Without callback the transfer is finished immediately. Otherwise the
+//! callback is called from the DMA thread of the port once the transfer time
+//! has passed. A new transfer replaces a pending transfer of the same port.
+//! \param[in] spi SPI number (0, 1 or 2)
+//! \param[in] send_buffer pointer to buffer which should be sent (ignored)
+//! \param[in] receive_buffer pointer to buffer for received bytes (filled with 0xff)<BR>
+//! If NULL: received bytes will be discarded.
+//! \param[in] len number of bytes which should be transfered
+//! \param[in] callback pointer to callback function which will be executed
+//! when block has been transfered. If NULL: function will block until
+//! transfer is completed.
+//! \return >= 0 if no error during transfer
+//! \return -1 if disabled SPI port selected
+//! \return -2 if unsupported SPI port selected
+//! \return -3 if the DMA thread can't be started
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SPI_TransferBlock(u8 spi, u8 *send_buffer, u8 *receive_buffer, u16 len, void *callback)
+{
+  s32 status = MIOS32_SPI_PortCheck(spi);
+  if( status < 0 )
+    return status;
+
+  spi_port_t *port = &spi_port[spi];
+
+  if( callback == NULL ) {
+    if( receive_buffer != NULL )
+      memset(receive_buffer, 0xff, len);
+    return 0; // no error
+  }
+
+  pthread_mutex_lock(&spi_mutex);
+
+  if( !port->thread_running ) {
+    if( pthread_create(&port->thread, NULL, MIOS32_SPI_DMA_Thread, (void *)(size_t)spi) != 0 ) {
+      pthread_mutex_unlock(&spi_mutex);
+      return -3; // thread can't be started
+    }
+    port->thread_running = 1;
+  }
+
+  // transfer time: 8 bits per byte, the SPI clock is the peripheral clock divided by 2^(prescaler+1)
+  unsigned long long ns = ((unsigned long long)len * 8 * (2 << port->prescaler) * 1000000000ULL) / SPI_PERIPHERAL_CLOCK;
+  clock_gettime(CLOCK_MONOTONIC, &port->done_time);
+  port->done_time.tv_sec += ns / 1000000000ULL;
+  port->done_time.tv_nsec += ns % 1000000000ULL;
+  if( port->done_time.tv_nsec >= 1000000000L ) {
+    port->done_time.tv_nsec -= 1000000000L;
+    ++port->done_time.tv_sec;
+  }
+
+  ++port->seq;
+  port->pending = 1;
+  port->receive_buffer = receive_buffer;
+  port->len = len;
+  port->callback = (void (*)(void))callback;
+
+  pthread_cond_broadcast(&spi_cond);
+  pthread_mutex_unlock(&spi_mutex);
+
+  return 0; // no error
+}
+
+//! \}
+
+#endif /* MIOS32_DONT_USE_SPI */
@@ -0,0 +1,185 @@
+// $Id$
+//! \defgroup MIOS32_SYS
+//!
+//! System Initialisation for the LINUX family
+//! 
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <mios32.h>
+
+// this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
+#if !defined(MIOS32_DONT_USE_SYS)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// reported memory sizes (same like MBHP_CORE_STM32F4, so that applications
+// which check them take the same decisions)
+#define SYS_FLASH_SIZE (1024*1024)
+#define SYS_RAM_SIZE   (192*1024)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+// monotonic time which corresponds to system time 0
+static struct timespec sys_time_base;
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes the System for MIOS32:<BR>
+//! For the LINUX family only the system realtime clock is reset.
+//! \param[in] mode currently only mode 0 supported
+//! \return < 0 if initialisation failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SYS_Init(u32 mode)
+{
+  // currently only mode 0 supported
+  if( mode != 0 )
+    return -1; // unsupported mode
+
+  // initialize system clock
+  mios32_sys_time_t t = { .seconds=0, .fraction_ms=0 };
+  MIOS32_SYS_TimeSet(t);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Shutdown MIOS32 and "reset the microcontroller":<BR>
+//! The LINUX family terminates the process, a wrapper script can restart
+//! it if a reset should be emulated.
+//! \return < 0 if reset failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SYS_Reset(void)
+{
+  // turn off all board LEDs
+  MIOS32_BOARD_LED_Set(0xffffffff, 0x00000000);
+
+  exit(0);
+
+  return -1; // we will never reach this point
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the Chip ID of the core
+//! \return the chip ID (always 0 for the LINUX family)
+/////////////////////////////////////////////////////////////////////////////
+u32 MIOS32_SYS_ChipIDGet(void)
+{
+  return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the Flash size of the core
+//! \return the Flash size in bytes
+/////////////////////////////////////////////////////////////////////////////
+u32 MIOS32_SYS_FlashSizeGet(void)
+{
+  return SYS_FLASH_SIZE;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the (data) RAM size of the core
+//! \return the RAM size in bytes
+/////////////////////////////////////////////////////////////////////////////
+u32 MIOS32_SYS_RAMSizeGet(void)
+{
+  return SYS_RAM_SIZE;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the serial number as a string
+//! \param[out] str pointer to a string which can store at least 32 digits + zero terminator!
+//! (24 digits returned like for STM32, all zero for the LINUX family)
+//! \return < 0 if feature not supported
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SYS_SerialNumberGet(char *str)
+{
+  int i;
+
+  for(i=0; i<24; ++i)
+    str[i] = '0';
+  str[i] = 0;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes/Resets the System Real Time Clock
+//!
+//! The LINUX family derives the time from CLOCK_MONOTONIC, it starts with
+//! 0 after MIOS32_SYS_Init()
+//!
+//! \param[in] t the time in seconds + fraction part (mS)
+//! \return < 0 if initialisation failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SYS_TimeSet(mios32_sys_time_t t)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  long long now_ms = (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+  long long base_ms = now_ms - ((long long)t.seconds * 1000 + t.fraction_ms);
+
+  sys_time_base.tv_sec = base_ms / 1000;
+  sys_time_base.tv_nsec = (base_ms % 1000) * 1000000;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the System Real Time (with mS accuracy)
+//! \return the system time in a mios32_sys_time_t structure
+/////////////////////////////////////////////////////////////////////////////
+mios32_sys_time_t MIOS32_SYS_TimeGet(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  long long delta_ms = ((long long)now.tv_sec - sys_time_base.tv_sec) * 1000 + (now.tv_nsec - sys_time_base.tv_nsec) / 1000000;
+
+  mios32_sys_time_t t = {
+    .seconds = (u32)(delta_ms / 1000),
+    .fraction_ms = (u32)(delta_ms % 1000)
+  };
+
+  return t;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Installs a DMA callback function which is invoked on DMA interrupts\n
+//! Not available for the LINUX family
+//! \return -1 if function not implemented for this MIOS32_PROCESSOR
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SYS_DMA_CallbackSet(u8 dma, u8 chn, void *callback)
+{
+  return -1; // function not implemented for this MIOS32_PROCESSOR
+}
+
+//! \}
+
+#endif /* MIOS32_DONT_USE_SYS */
@@ -0,0 +1,174 @@
+// $Id$
+//! \defgroup MIOS32_TIMER
+//!
+//! Timer functions for the LINUX family
+//!
+//! Each timer is emulated by a thread which sleeps until the next absolute
+//! period boundary, so that the average period doesn't drift. The handler
+//! is called with "interrupts" disabled (see MIOS32_IRQ_Disable()).
+//!
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <pthread.h>
+#include <time.h>
+
+#include <mios32.h>
+
+// this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
+#if !defined(MIOS32_DONT_USE_TIMER)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+#define NUM_TIMERS 3
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+static void (*timer_callback[NUM_TIMERS])(void);
+static volatile u32 timer_period[NUM_TIMERS]; // in uS, 0: timer disabled
+static pthread_t timer_thread[NUM_TIMERS];
+static u8 timer_thread_running[NUM_TIMERS];
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Timer thread
+/////////////////////////////////////////////////////////////////////////////
+static void *TIMER_Thread(void *arg)
+{
+  u8 timer = (u8)(size_t)arg;
+  struct timespec next;
+
+  clock_gettime(CLOCK_MONOTONIC, &next);
+
+  while( 1 ) {
+    u32 period = timer_period[timer];
+    if( !period )
+      break; // timer has been disabled
+
+    next.tv_nsec += (long)period * 1000;
+    while( next.tv_nsec >= 1000000000L ) {
+      next.tv_nsec -= 1000000000L;
+      ++next.tv_sec;
+    }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+    if( timer_period[timer] && timer_callback[timer] ) {
+      MIOS32_IRQ_Disable();
+      timer_callback[timer]();
+      MIOS32_IRQ_Enable();
+    }
+  }
+
+  return NULL;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initialize a timer
+//! \param[in] timer (0..2)
+//! \param[in] period in uS accuracy (1..65536)
+//! \param[in] _irq_handler (function name)
+//! \param[in] irq_priority: ignored by the LINUX family
+//! \return 0 if initialisation passed
+//! \return -1 if invalid timer number
+//! \return -2 if invalid period
+//! \return -3 if the timer thread can't be started
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_TIMER_Init(u8 timer, u32 period, void (*_irq_handler)(void), u8 irq_priority)
+{
+  // check if valid timer
+  if( timer >= NUM_TIMERS )
+    return -1; // invalid timer selected
+
+  // check if valid period
+  if( period < 1 || period >= 65537 )
+    return -2;
+
+  // stop thread of previous configuration
+  MIOS32_TIMER_DeInit(timer);
+
+  // copy callback function
+  timer_callback[timer] = _irq_handler;
+  timer_period[timer] = period;
+
+  if( pthread_create(&timer_thread[timer], NULL, TIMER_Thread, (void *)(size_t)timer) != 0 ) {
+    timer_period[timer] = 0;
+    return -3; // thread can't be started
+  }
+  timer_thread_running[timer] = 1;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Re-Initialize a timer with given period
+//! \param[in] timer (0..2)
+//! \param[in] period in uS accuracy (1..65536)
+//! \return 0 if initialisation passed
+//! \return -1 if invalid timer number
+//! \return -2 if invalid period
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_TIMER_ReInit(u8 timer, u32 period)
+{
+  // check if valid timer
+  if( timer >= NUM_TIMERS )
+    return -1; // invalid timer selected
+
+  // check if valid period
+  if( period < 1 || period >= 65537 )
+    return -2;
+
+  // takes effect with the next period
+  timer_period[timer] = period;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! De-Initialize a timer
+//! \param[in] timer (0..2)
+//! \return 0 if timer has been disabled
+//! \return -1 if invalid timer number
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_TIMER_DeInit(u8 timer)
+{
+  // check if valid timer
+  if( timer >= NUM_TIMERS )
+    return -1; // invalid timer selected
+
+  timer_period[timer] = 0;
+
+  if( timer_thread_running[timer] ) {
+    timer_thread_running[timer] = 0;
+    // the handler itself could deinitialize the timer
+    if( pthread_equal(timer_thread[timer], pthread_self()) )
+      pthread_detach(timer_thread[timer]);
+    else
+      pthread_join(timer_thread[timer], NULL);
+  }
+
+  return 0; // no error
+}
+
+//! \}
+
+#endif /* MIOS32_DONT_USE_TIMER */
@@ -0,0 +1,77 @@
+// $Id$
+//! \defgroup MIOS32_USB
+//!
+//! USB driver for the LINUX family
+//!
+//! There is no USB device on the host, the USB MIDI ports are emulated by
+//! MIOS32_USB_MIDI (see there).
+//!
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+
+// this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
+#if !defined(MIOS32_DONT_USE_USB)
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes USB interface
+//! \param[in] mode 0..2 (see STM32F4xx implementation)
+//! \return < 0 if initialisation failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_Init(u32 mode)
+{
+  // currently only mode 0..2 supported
+  if( mode >= 3 )
+    return -1; // unsupported mode
+
+#ifndef MIOS32_DONT_USE_USB_MIDI
+  MIOS32_USB_MIDI_ChangeConnectionState(1);
+#endif
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Allows to query, if the USB interface has already been initialized.
+//! \return 1 (always initialized for the LINUX family)
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_IsInitialized(void)
+{
+  return 1;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! \returns != 0 if a single USB port has been forced (never for the LINUX family)
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_ForceSingleUSB(void)
+{
+  return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! \returns != 0 if device mode is enforced (always for the LINUX family)
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_ForceDeviceMode(void)
+{
+  return 1;
+}
+
+//! \}
+
+#endif /* MIOS32_DONT_USE_USB */
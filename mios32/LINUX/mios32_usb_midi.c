@@ -0,0 +1,440 @@
+// $Id$
+//! \defgroup MIOS32_USB_MIDI
+//!
+//! USB MIDI layer for the LINUX family
+//!
+//! Each USB MIDI cable can be connected to a file which carries 4 byte
+//! USB MIDI packages (cable number in the upper nibble of the first byte,
+//! the number is overwritten by the cable of the port):
+//! \code
+//!   MIOS32_LINUX_USB0=/tmp/usb0.fifo ./project
+//! \endcode
+//! Received packages are forwarded by a reader thread which emulates the
+//! OUT endpoint interrupt, packages which should be transmitted are written
+//! to the file immediately.
+//!
+//! If no file has been selected for USB0, the port acts like the MIOS Terminal:
+//! debug messages (SysEx command 0x0d/0x40) are printed to stdout, and each
+//! line which is entered via stdin is sent to the debug command handler
+//! (SysEx command 0x0d/0x00). All other packages sent to USB0 are dropped.
+//!
+//! Applications shouldn't call these functions directly, instead please use \ref MIOS32_MIDI layer functions
+//! 
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <mios32.h>
+
+// this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
+#if !defined(MIOS32_DONT_USE_USB_MIDI)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// max. length of a debug message which is printed in terminal mode
+#define TERMINAL_SYSEX_BUFFER_SIZE 1024
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local Variables
+/////////////////////////////////////////////////////////////////////////////
+
+// Rx buffer
+static u32 rx_buffer[MIOS32_USB_MIDI_RX_BUFFER_SIZE];
+static volatile u16 rx_buffer_tail;
+static volatile u16 rx_buffer_head;
+static volatile u16 rx_buffer_size;
+
+// transfer possible?
+static u8 transfer_possible = 0;
+
+// file descriptors of the connected files (-1 if not connected)
+static int cable_fd[MIOS32_USB_MIDI_NUM_PORTS] = { [0 ... MIOS32_USB_MIDI_NUM_PORTS-1] = -1 };
+static pthread_t cable_rx_thread[MIOS32_USB_MIDI_NUM_PORTS];
+
+// terminal mode of USB0
+static u8 terminal_mode;
+static pthread_t terminal_rx_thread;
+static u8 terminal_sysex_buffer[TERMINAL_SYSEX_BUFFER_SIZE];
+static u16 terminal_sysex_len;
+
+static const u8 debug_sysex_header[] = { 0xf0, 0x00, 0x00, 0x7e, 0x32 };
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Puts a received package into the Rx buffer, emulates the OUT endpoint handler
+// IRQs have to be disabled by the caller
+/////////////////////////////////////////////////////////////////////////////
+static void MIOS32_USB_MIDI_RxPackage(mios32_midi_package_t package)
+{
+  // ignore packages which are received while the interface is disconnected
+  if( !transfer_possible )
+    return;
+
+  // forward package to callback (if installed), otherwise put it into the buffer
+  if( MIOS32_MIDI_SendPackageToRxCallback(USB0 + package.cable, package) == 0 ) {
+    if( rx_buffer_size < MIOS32_USB_MIDI_RX_BUFFER_SIZE ) {
+      rx_buffer[rx_buffer_head] = package.ALL;
+      if( ++rx_buffer_head >= MIOS32_USB_MIDI_RX_BUFFER_SIZE )
+	rx_buffer_head = 0;
+      ++rx_buffer_size;
+    }
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Receive thread of a connected file
+/////////////////////////////////////////////////////////////////////////////
+static void *MIOS32_USB_MIDI_CableRxThread(void *arg)
+{
+  u8 cable = (u8)(size_t)arg;
+  u8 buffer[4];
+  int pos = 0;
+  ssize_t len;
+
+  while( (len=read(cable_fd[cable], &buffer[pos], 4-pos)) > 0 ) {
+    pos += len;
+    if( pos < 4 )
+      continue; // incomplete package
+
+    mios32_midi_package_t package;
+    package.ALL = buffer[0] | (buffer[1] << 8) | (buffer[2] << 16) | (buffer[3] << 24);
+    package.cable = cable;
+    pos = 0;
+
+    MIOS32_IRQ_Disable();
+    MIOS32_USB_MIDI_RxPackage(package);
+    MIOS32_IRQ_Enable();
+  }
+
+  return NULL;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Terminal mode: sends each line from stdin as debug command
+/////////////////////////////////////////////////////////////////////////////
+static void *MIOS32_USB_MIDI_TerminalRxThread(void *arg)
+{
+  char line[256];
+
+  while( fgets(line, sizeof(line), stdin) != NULL ) {
+    u8 sysex[sizeof(line) + 9];
+    int len = 0;
+    int i;
+
+    memcpy(sysex, debug_sysex_header, sizeof(debug_sysex_header));
+    len = sizeof(debug_sysex_header);
+    sysex[len++] = MIOS32_MIDI_DeviceIDGet();
+    sysex[len++] = 0x0d; // debug command
+    sysex[len++] = 0x00; // input string
+    for(i=0; line[i]; ++i)
+      sysex[len++] = line[i] & 0x7f;
+    sysex[len++] = 0xf7;
+
+    // split into USB MIDI packages
+    MIOS32_IRQ_Disable();
+    for(i=0; i<len; i+=3) {
+      int remaining = len - i;
+      mios32_midi_package_t package;
+
+      package.ALL = 0;
+      package.cable = 0;
+      package.evnt0 = sysex[i];
+      if( remaining > 3 ) {
+	package.cin = 0x4; // SysEx starts or continues
+	package.evnt1 = sysex[i+1];
+	package.evnt2 = sysex[i+2];
+      } else {
+	package.cin = 0x4 + remaining; // SysEx ends with 1, 2 or 3 bytes
+	if( remaining >= 2 ) package.evnt1 = sysex[i+1];
+	if( remaining >= 3 ) package.evnt2 = sysex[i+2];
+      }
+
+      MIOS32_USB_MIDI_RxPackage(package);
+    }
+    MIOS32_IRQ_Enable();
+  }
+
+  return NULL;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Terminal mode: collects SysEx streams and prints debug messages
+/////////////////////////////////////////////////////////////////////////////
+static void MIOS32_USB_MIDI_TerminalTx(mios32_midi_package_t package)
+{
+  int num_bytes;
+
+  switch( package.cin ) {
+  case 0x4: num_bytes = 3; break; // SysEx starts or continues
+  case 0x5: num_bytes = 1; break; // SysEx ends with 1 byte
+  case 0x6: num_bytes = 2; break; // SysEx ends with 2 bytes
+  case 0x7: num_bytes = 3; break; // SysEx ends with 3 bytes
+  default:
+    return; // no SysEx
+  }
+
+  u8 bytes[3] = { package.evnt0, package.evnt1, package.evnt2 };
+  int i;
+  for(i=0; i<num_bytes; ++i) {
+    u8 b = bytes[i];
+
+    if( b == 0xf0 )
+      terminal_sysex_len = 0;
+
+    if( b != 0xf7 ) {
+      if( terminal_sysex_len < TERMINAL_SYSEX_BUFFER_SIZE )
+	terminal_sysex_buffer[terminal_sysex_len++] = b;
+      continue;
+    }
+
+    // F7: check for debug message (F0 00 00 7E 32 <device-id> 0D 40 <string> F7)
+    int header_len = sizeof(debug_sysex_header) + 3;
+    if( terminal_sysex_len >= header_len &&
+	memcmp(terminal_sysex_buffer, debug_sysex_header, sizeof(debug_sysex_header)) == 0 &&
+	terminal_sysex_buffer[header_len-2] == 0x0d &&
+	terminal_sysex_buffer[header_len-1] == 0x40 ) {
+      // like in the MIOS Terminal each message is printed in a separate line
+      u8 last_char = 0;
+      int pos;
+      for(pos=header_len; pos<terminal_sysex_len; ++pos) {
+	if( terminal_sysex_buffer[pos] ) { // an empty string is sent as 0x00
+	  last_char = terminal_sysex_buffer[pos];
+	  fputc(last_char, stdout);
+	}
+      }
+      if( last_char != '\n' )
+	fputc('\n', stdout);
+      fflush(stdout);
+    }
+    terminal_sysex_len = 0;
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Opens the files selected by MIOS32_LINUX_USB<n> and starts the receive
+// threads once the interface is connected the first time
+/////////////////////////////////////////////////////////////////////////////
+static void MIOS32_USB_MIDI_Connect(void)
+{
+  static u8 files_connected = 0;
+  u8 cable;
+
+  if( files_connected )
+    return;
+  files_connected = 1;
+
+  for(cable=0; cable<MIOS32_USB_MIDI_NUM_PORTS; ++cable) {
+    char env_name[24];
+    sprintf(env_name, "MIOS32_LINUX_USB%d", cable);
+
+    char *path = getenv(env_name);
+    if( path == NULL || !path[0] )
+      continue; // not selected
+
+    // note: O_RDWR ensures that opening a named pipe doesn't block
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if( fd < 0 ) {
+      perror(path);
+      continue;
+    }
+
+    cable_fd[cable] = fd;
+    if( pthread_create(&cable_rx_thread[cable], NULL, MIOS32_USB_MIDI_CableRxThread, (void *)(size_t)cable) == 0 )
+      pthread_detach(cable_rx_thread[cable]);
+  }
+
+  // USB0 acts as terminal if no file has been selected
+  if( cable_fd[0] < 0 ) {
+    terminal_mode = 1;
+    if( pthread_create(&terminal_rx_thread, NULL, MIOS32_USB_MIDI_TerminalRxThread, NULL) == 0 )
+      pthread_detach(terminal_rx_thread);
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Initializes USB MIDI layer
+//! \param[in] mode currently only mode 0 supported
+//! \return < 0 if initialisation failed
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_Init(u32 mode)
+{
+  // currently only mode 0 supported
+  if( mode != 0 )
+    return -1; // unsupported mode
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function is called by the USB driver on cable connection/disconnection
+//! \param[in] connected status (1 if connected)
+//! \return < 0 on errors
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_ChangeConnectionState(u8 connected)
+{
+  // in all cases: re-initialize USB MIDI driver
+  // clear buffer counters (e.g., so that no invalid data will be sent out)
+  MIOS32_IRQ_Disable();
+  rx_buffer_tail = rx_buffer_head = rx_buffer_size = 0;
+  terminal_sysex_len = 0;
+  transfer_possible = connected ? 1 : 0;
+  MIOS32_IRQ_Enable();
+
+  if( connected )
+    MIOS32_USB_MIDI_Connect();
+
+  return 0; // no error
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function returns the connection status of the USB MIDI interface
+//! \param[in] cable number
+//! \return 1: interface available
+//! \return 0: interface not available
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_CheckAvailable(u8 cable)
+{
+  if( cable >= MIOS32_USB_MIDI_NUM_PORTS )
+    return 0;
+
+  return transfer_possible ? 1 : 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function sends a new MIDI package
+//! The package is written to the connected file immediately, accordingly
+//! the buffer can never be full.
+//! \param[in] package MIDI package
+//! \return 0: no error
+//! \return -1: USB not connected
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_PackageSend_NonBlocking(mios32_midi_package_t package)
+{
+  // device available?
+  if( !transfer_possible || package.cable >= MIOS32_USB_MIDI_NUM_PORTS )
+    return -1;
+
+  // this operation should be atomic!
+  MIOS32_IRQ_Disable();
+  int fd = cable_fd[package.cable];
+  if( fd >= 0 ) {
+    u8 buffer[4] = { package.ALL & 0xff, (package.ALL >> 8) & 0xff, (package.ALL >> 16) & 0xff, (package.ALL >> 24) & 0xff };
+    if( write(fd, buffer, 4) != 4 ) {
+      // here we could add some error handling
+    }
+  } else if( package.cable == 0 && terminal_mode ) {
+    MIOS32_USB_MIDI_TerminalTx(package);
+  }
+  MIOS32_IRQ_Enable();
+
+  return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function sends a new MIDI package
+//! (blocking function)
+//! \param[in] package MIDI package
+//! \return 0: no error
+//! \return -1: USB not connected
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_PackageSend(mios32_midi_package_t package)
+{
+  // the package is never buffered, no need to poll
+  return MIOS32_USB_MIDI_PackageSend_NonBlocking(package);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function checks for a new package
+//! \param[out] package pointer to MIDI package (received package will be put into the given variable)
+//! \return -1 if no package in buffer
+//! \return >= 0: number of packages which are still in the buffer
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_PackageReceive(mios32_midi_package_t *package)
+{
+  // package received?
+  if( !rx_buffer_size )
+    return -1;
+
+  // get package - this operation should be atomic!
+  MIOS32_IRQ_Disable();
+  package->ALL = rx_buffer[rx_buffer_tail];
+  if( ++rx_buffer_tail >= MIOS32_USB_MIDI_RX_BUFFER_SIZE )
+    rx_buffer_tail = 0;
+  --rx_buffer_size;
+  MIOS32_IRQ_Enable();
+
+  return rx_buffer_size;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function should be called periodically each mS to handle timeout
+//! and expire counters.
+//!
+//! Nothing to do for the LINUX family: packages are received by threads
+//! and transmitted immediately.
+//!
+//! Not for use in an application - this function is called from
+//! MIOS32_MIDI_Periodic_mS(), which is called by a task in the programming
+//! model!
+//! 
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_Periodic_mS(void)
+{
+  return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Not used by the LINUX family, only available for API compatibility
+/////////////////////////////////////////////////////////////////////////////
+void MIOS32_USB_MIDI_EP1_IN_Callback(u8 bEP, u8 bEPStatus)
+{
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Not used by the LINUX family, only available for API compatibility
+/////////////////////////////////////////////////////////////////////////////
+void MIOS32_USB_MIDI_EP2_OUT_Callback(u8 bEP, u8 bEPStatus)
+{
+}
+
+//! \}
+
+#endif /* MIOS32_DONT_USE_USB_MIDI */
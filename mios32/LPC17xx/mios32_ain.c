@@ -433,6 +433,9 @@ void ADC_IRQHandler(void)
     u8 word_offset = pin_offset >> 5;
     u16 *src_ptr = (u16 *)adc_conversion_values;
     u16 *dst_ptr = (u16 *)&ain_pin_values[pin_offset];
+#if MIOS32_INPUT_JOURNAL_SIZE
+    u32 journal_mask = 0;
+#endif
 
 #if MIOS32_AIN_DEADBAND_IDLE
     u16 *idle_ctr_ptr = (u16 *)&ain_pin_idle_ctr[pin_offset];
@@ -469,6 +472,9 @@ void ADC_IRQHandler(void)
 #endif
 	  *dst_ptr = *src_ptr;
 	  ain_pin_changed[word_offset] |= (1 << bit_offset);
+#if MIOS32_INPUT_JOURNAL_SIZE
+	  journal_mask |= (1 << i);
+#endif
 #if MIOS32_AIN_DEADBAND_IDLE
 	  *idle_ctr_ptr = MIOS32_AIN_IDLE_CTR;
 #endif
@@ -507,6 +513,18 @@ void ADC_IRQHandler(void)
     // do an AND operation on all "changed" flags (MF driver takes control over these flags)
     ain_pin_changed[0] &= 0xffff0000 | change_flag_mask;
 #endif
+
+#if MIOS32_INPUT_JOURNAL_SIZE
+    // store the new conversion values in the input journal
+    // (pins which are controlled by the motorfader driver are only journaled if the MF driver kept the "changed" flag)
+    while( journal_mask ) {
+      u32 pin = pin_offset + __builtin_ctz(journal_mask);
+      journal_mask &= journal_mask - 1;
+      if( ain_pin_changed[pin >> 5] & (1 << (pin & 0x1f)) ) {
+	MIOS32_INPUT_EventPush(MIOS32_INPUT_EVENT_AIN, pin, ain_pin_values[pin]);
+      }
+    }
+#endif
   }
 
 #if MIOS32_AIN_MUX_PINS >= 1
@@ -792,7 +792,7 @@ MIOS32_UART1_IRQHANDLER_FUNC
     if( (MIOS32_UART1->LSR & LSR_RDR) ) { 
       u8 b = MIOS32_UART1->RBR;
 
-      s32 status = MIOS32_UART_IsAssignedToMIDI(1) ? MIOS32_MIDI_SendByteToRxCallback(UART0, b) : 0;
+      s32 status = MIOS32_UART_IsAssignedToMIDI(1) ? MIOS32_MIDI_SendByteToRxCallback(UART1, b) : 0;
 
       // read byte from FIFO and put into SW based ringbuffer
       if( status == 0 && MIOS32_UART_RxBufferPut(1, b) < 0 ) {
@@ -826,7 +826,7 @@ MIOS32_UART2_IRQHANDLER_FUNC
     if( (MIOS32_UART2->LSR & LSR_RDR) ) { 
       u8 b = MIOS32_UART2->RBR;
 
-      s32 status = MIOS32_UART_IsAssignedToMIDI(2) ? MIOS32_MIDI_SendByteToRxCallback(UART0, b) : 0;
+      s32 status = MIOS32_UART_IsAssignedToMIDI(2) ? MIOS32_MIDI_SendByteToRxCallback(UART2, b) : 0;
 
       // read byte from FIFO and put into SW based ringbuffer
       if( status == 0 && MIOS32_UART_RxBufferPut(2, b) < 0 ) {
@@ -860,7 +860,7 @@ MIOS32_UART3_IRQHANDLER_FUNC
     if( (MIOS32_UART3->LSR & LSR_RDR) ) { 
       u8 b = MIOS32_UART3->RBR;
 
-      s32 status = MIOS32_UART_IsAssignedToMIDI(3) ? MIOS32_MIDI_SendByteToRxCallback(UART0, b) : 0;
+      s32 status = MIOS32_UART_IsAssignedToMIDI(3) ? MIOS32_MIDI_SendByteToRxCallback(UART3, b) : 0;
 
       // read byte from FIFO and put into SW based ringbuffer
       if( status == 0 && MIOS32_UART_RxBufferPut(3, b) < 0 ) {
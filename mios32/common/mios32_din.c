@@ -22,6 +22,13 @@
 // this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
 #if !defined(MIOS32_DONT_USE_DIN)
 
+/////////////////////////////////////////////////////////////////////////////
+// Local prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+static s32 MIOS32_DIN_ChangedGetAndClearAll(u32 *changed, u32 *values);
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Initializes DIN driver
 //! \param[in] mode currently only mode 0 supported
@@ -128,6 +135,58 @@ u8 MIOS32_DIN_SRChangedGetAndClear(u32 sr, u8 mask)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Takes the change flags and DIN values of all shift registers with a
+// single atomic operation, and clears the change flags.
+// 4 SRs are handled at once: bit n of word w belongs to pin 32*w+n
+// (SR 4*w+n/8, since the SRs are stored in little endian order)
+// Returns the number of words, or 0 if no pin has been toggled
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_DIN_ChangedGetAndClearAll(u32 *changed, u32 *values)
+{
+  u8 num_sr = MIOS32_SRIO_ScanNumGet();
+  int num_words = num_sr / 4;
+  u32 any_change = 0;
+  int i;
+
+  MIOS32_IRQ_Disable();
+#if MIOS32_SRIO_NUM_SR >= 4
+  volatile u32 *changed32 = (volatile u32 *)&mios32_srio_din_changed[0];
+  volatile u32 *din32 = (volatile u32 *)&mios32_srio_din[0];
+  for(i=0; i<num_words; ++i) {
+    u32 c = changed32[i];
+    if( c ) {
+      changed32[i] = 0;
+      any_change |= c;
+    }
+    changed[i] = c;
+    values[i] = din32[i];
+  }
+#else
+  i = 0;
+#endif
+
+  // remaining SRs (if the number of SRs isn't dividable by 4)
+  if( num_sr & 3 ) {
+    u32 c = 0;
+    u32 v = 0;
+    int sr;
+    for(sr=4*num_words; sr<num_sr; ++sr) {
+      c |= (u32)mios32_srio_din_changed[sr] << (8*(sr & 3));
+      v |= (u32)mios32_srio_din[sr] << (8*(sr & 3));
+      mios32_srio_din_changed[sr] = 0;
+    }
+    any_change |= c;
+    changed[i] = c;
+    values[i] = v;
+    ++i;
+  }
+  MIOS32_IRQ_Enable();
+
+  return any_change ? i : 0;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Checks for pin changes, and calls given callback function with following parameters:
 //! \code
@@ -138,16 +197,71 @@ u8 MIOS32_DIN_SRChangedGetAndClear(u32 sr, u8 mask)
 /////////////////////////////////////////////////////////////////////////////
 s32 MIOS32_DIN_Handler(void *_callback)
 {
-  s32 sr;
-  s32 sr_pin;
-  u8 changed;
   void (*callback)(u32 pin, u32 value) = _callback;
   u8 num_sr = MIOS32_SRIO_ScanNumGet();
 
   // no SRIOs?
 #if MIOS32_SRIO_NUM_SR == 0
   return -1;
+#else
+
+  if( num_sr == 0 )
+    return -1;
+
+  // no callback function?
+  if( _callback == NULL )
+    return -1;
+
+  // take the pin changes of all shift registers
+  u32 changed[MIOS32_DIN_NUM_WORDS];
+  u32 values[MIOS32_DIN_NUM_WORDS];
+  s32 num_words = MIOS32_DIN_ChangedGetAndClearAll(changed, values);
+
+  // notify the toggled pins in ascending order
+  int i;
+  for(i=0; i<num_words; ++i) {
+    u32 mask = changed[i];
+    while( mask ) {
+      u32 bit = __builtin_ctz(mask);
+      mask &= mask - 1;
+
+      // call the notification function
+      callback(32*i + bit, (values[i] >> bit) & 1);
+
+      // start debouncing (if enabled in SRIO driver)
+      MIOS32_SRIO_DebounceStart();
+    }
+  }
+
+  return 0;
 #endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Checks for pin changes, and calls given callback function once with all
+//! changes of the last scan(s):
+//! \code
+//!   void DIN_NotifyBatch(u32 num_words, u32 *changed, u32 *values)
+//! \endcode
+//! Each word contains the change flags resp. values of 32 pins, bit n of
+//! word w belongs to pin 32*w+n. The callback isn't called if no pin has
+//! been toggled.<BR>
+//! This is an alternative to MIOS32_DIN_Handler() for applications which
+//! process many DINs (e.g. button matrices), since they can handle
+//! the changes word by word.
+//! \param[in] _callback pointer to callback function
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_DIN_HandlerBatch(void *_callback)
+{
+  void (*callback)(u32 num_words, u32 *changed, u32 *values) = _callback;
+  u8 num_sr = MIOS32_SRIO_ScanNumGet();
+
+  // no SRIOs?
+#if MIOS32_SRIO_NUM_SR == 0
+  return -1;
+#else
 
   if( num_sr == 0 )
     return -1;
@@ -156,28 +270,19 @@ s32 MIOS32_DIN_Handler(void *_callback)
   if( _callback == NULL )
     return -1;
 
-  // check all shift registers for DIN pin changes
-  for(sr=0; sr<num_sr; ++sr) {
-    
-    // check if there are pin changes (mask all pins)
-    changed = MIOS32_DIN_SRChangedGetAndClear(sr, 0xff);
-
-    // any pin change at this SR?
-    if( !changed )
-      continue;
-
-    // check all 8 pins of the SR
-    for(sr_pin=0; sr_pin<8; ++sr_pin)
-      if( changed & (1 << sr_pin) ) {
-	// call the notification function
-	callback(8*sr+sr_pin, (mios32_srio_din[sr] & (1 << sr_pin)) ? 1 : 0);
-
-	// start debouncing (if enabled in SRIO driver)
-	MIOS32_SRIO_DebounceStart();
-      }
+  u32 changed[MIOS32_DIN_NUM_WORDS];
+  u32 values[MIOS32_DIN_NUM_WORDS];
+  s32 num_words = MIOS32_DIN_ChangedGetAndClearAll(changed, values);
+
+  if( num_words ) {
+    callback(num_words, changed, values);
+
+    // start debouncing (if enabled in SRIO driver)
+    MIOS32_SRIO_DebounceStart();
   }
 
   return 0;
+#endif
 }
 
 //! \}
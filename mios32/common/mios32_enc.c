@@ -233,6 +233,9 @@ s32 MIOS32_ENC_UpdateStates(void)
       mios32_enc_type_t enc_type = enc_config_ptr->cfg.type;
       s32 predivider;
       s32 acc;
+#if MIOS32_INPUT_JOURNAL_SIZE
+      s32 prev_incrementer = enc_state_ptr->incrementer;
+#endif
 
       // State Machine (own Design from 1999)
       // changed 2000-1-5: special "analyse" state which corrects the ENC direction
@@ -357,6 +360,12 @@ s32 MIOS32_ENC_UpdateStates(void)
 	  enc_state_ptr->prev_state_inc = enc_state_ptr->state;
 	}
       }
+
+#if MIOS32_INPUT_JOURNAL_SIZE
+      // store the increment of this step in the input journal
+      if( enc_state_ptr->incrementer != prev_incrementer )
+	MIOS32_INPUT_EventPush(MIOS32_INPUT_EVENT_ENC, enc, enc_state_ptr->incrementer - prev_incrementer);
+#endif
     }
   }
   return 0; // no error
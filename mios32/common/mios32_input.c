@@ -0,0 +1,239 @@
+// $Id$
+//! \defgroup MIOS32_INPUT
+//!
+//! Timestamped Input Event Journal for MIOS32
+//!
+//! DIN, ENC and AIN changes are stored with uS timestamp from the SRIO DMA
+//! callback and the AIN conversion interrupt, so that an application can
+//! process them in batches without losing the timing of the events, even
+//! if the task which consumes the journal is busy for some mS.
+//!
+//! The journal is enabled with
+//! \code
+//!   #define MIOS32_INPUT_JOURNAL_SIZE 64
+//! \endcode
+//! in mios32_config.h (must be a power of two)
+//!
+//! The journal is written by the interrupt handlers and read by a single
+//! task. The consumer side doesn't need to disable interrupts, events are
+//! never overwritten before they have been consumed. If the journal is full,
+//! new events are dropped and counted, see MIOS32_INPUT_OverrunsGet().
+//!
+//! Note that MIOS32_DIN_Handler(), MIOS32_ENC_Handler() and MIOS32_AIN_Handler()
+//! are still working in parallel, the journal is only an additional source.
+//!
+//! \{
+/* ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+
+
+#if MIOS32_INPUT_JOURNAL_SIZE & (MIOS32_INPUT_JOURNAL_SIZE-1)
+# error "MIOS32_INPUT_JOURNAL_SIZE must be a power of two!"
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+#if MIOS32_INPUT_JOURNAL_SIZE
+static mios32_input_event_t journal[MIOS32_INPUT_JOURNAL_SIZE];
+
+// free running indices, only written by producers (head) resp. consumer (tail)
+static volatile u32 journal_head;
+static volatile u32 journal_tail;
+
+static u32 journal_overruns;
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Clears the journal
+//! \param[in] mode currently only mode 0 supported
+//! \return < 0 if initialisation failed
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_INPUT_Init(u32 mode)
+{
+  // currently only mode 0 supported
+  if( mode != 0 )
+    return -1; // unsupported mode
+
+#if !MIOS32_INPUT_JOURNAL_SIZE
+  return -1; // journal disabled
+#else
+  MIOS32_IRQ_Disable();
+  journal_tail = journal_head;
+  journal_overruns = 0;
+  MIOS32_IRQ_Enable();
+
+  return 0; // no error
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Stores an event in the journal
+//!
+//! \note this function is called from MIOS32_SRIO_DMA_Callback(),
+//! MIOS32_ENC_UpdateStates() and the AIN conversion interrupt.
+//! It can also be used by an application to journal events of own drivers.
+//! \param[in] type MIOS32_INPUT_EVENT_DIN, MIOS32_INPUT_EVENT_ENC or MIOS32_INPUT_EVENT_AIN
+//! \param[in] pin the DIN pin, encoder number or AIN pin
+//! \param[in] value the DIN pin value, incrementer or conversion value
+//! \return 0 if event has been stored
+//! \return -1 if journal disabled
+//! \return -2 if journal full (event dropped)
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_INPUT_EventPush(mios32_input_event_type_t type, u32 pin, s32 value)
+{
+#if !MIOS32_INPUT_JOURNAL_SIZE
+  return -1; // journal disabled
+#else
+  // the journal is written from interrupts with different priorities:
+  // reserve the slot and take the timestamp atomically, so that events are stored in chronological order
+  MIOS32_IRQ_Disable();
+
+  u32 head = journal_head;
+  if( (head - journal_tail) >= MIOS32_INPUT_JOURNAL_SIZE ) {
+    ++journal_overruns;
+    MIOS32_IRQ_Enable();
+    return -2; // journal full
+  }
+
+  mios32_input_event_t *e = &journal[head & (MIOS32_INPUT_JOURNAL_SIZE-1)];
+#if !defined(MIOS32_DONT_USE_TIMESTAMP)
+  e->timestamp = MIOS32_TIMESTAMP_Get_uS();
+#else
+  e->timestamp = 0;
+#endif
+  e->pin = pin;
+  e->type = type;
+  e->reserved = 0;
+  e->value = value;
+
+  // publish the event to the consumer
+  journal_head = head + 1;
+
+  MIOS32_IRQ_Enable();
+
+  return 0; // no error
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! \return the number of events which are waiting in the journal
+//! \return -1 if journal disabled
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_INPUT_NumEventsGet(void)
+{
+#if !MIOS32_INPUT_JOURNAL_SIZE
+  return -1; // journal disabled
+#else
+  return journal_head - journal_tail;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Copies the oldest events of the journal into the given array and removes
+//! them from the journal.
+//! \param[out] events array of at least max_events entries
+//! \param[in] max_events maximum number of events which should be copied
+//! \return number of copied events
+//! \return -1 if journal disabled
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_INPUT_EventsGet(mios32_input_event_t *events, u32 max_events)
+{
+#if !MIOS32_INPUT_JOURNAL_SIZE
+  return -1; // journal disabled
+#else
+  u32 tail = journal_tail;
+  u32 num_events = journal_head - tail;
+
+  if( num_events > max_events )
+    num_events = max_events;
+
+  int i;
+  for(i=0; i<num_events; ++i)
+    *events++ = journal[(tail + i) & (MIOS32_INPUT_JOURNAL_SIZE-1)];
+
+  // release the slots for the producers
+  journal_tail = tail + num_events;
+
+  return num_events;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Passes all events which are waiting in the journal to the given callback
+//! function, and removes them from the journal:
+//! \code
+//!   void INPUT_NotifyEvents(u32 num_events, mios32_input_event_t *events)
+//! \endcode
+//! The events are passed without copying them. Since the journal is a ring
+//! buffer, the callback can be called twice (the second time with the events
+//! which have been wrapped around).
+//! \param[in] _callback pointer to callback function
+//! \return number of processed events
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_INPUT_Handler(void *_callback)
+{
+  // no callback function?
+  if( _callback == NULL )
+    return -1;
+
+#if !MIOS32_INPUT_JOURNAL_SIZE
+  return -1; // journal disabled
+#else
+  void (*callback)(u32 num_events, mios32_input_event_t *events) = _callback;
+  u32 tail = journal_tail;
+  u32 head = journal_head; // events which are added while the callback is running will be handled with the next call
+  u32 num_processed = head - tail;
+
+  while( tail != head ) {
+    u32 pos = tail & (MIOS32_INPUT_JOURNAL_SIZE-1);
+    u32 num_events = head - tail;
+    if( num_events > (MIOS32_INPUT_JOURNAL_SIZE - pos) )
+      num_events = MIOS32_INPUT_JOURNAL_SIZE - pos;
+
+    callback(num_events, &journal[pos]);
+
+    // release the slots for the producers
+    tail += num_events;
+    journal_tail = tail;
+  }
+
+  return num_processed;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! \return the number of events which have been dropped since the journal
+//! was full (reset by MIOS32_INPUT_Init())
+/////////////////////////////////////////////////////////////////////////////
+u32 MIOS32_INPUT_OverrunsGet(void)
+{
+#if !MIOS32_INPUT_JOURNAL_SIZE
+  return 0;
+#else
+  return journal_overruns;
+#endif
+}
+
+//! \}
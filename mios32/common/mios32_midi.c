@@ -91,10 +91,47 @@ const u8 mios32_midi_expected_bytes_system[16] = {
 const u8 mios32_midi_sysex_header[5] = { 0xf0, 0x00, 0x00, 0x7e, 0x32 };
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// receive rings are available for UART based MIDI ports
+#if MIOS32_MIDI_RX_RING_SIZE && !defined(MIOS32_DONT_USE_UART) && !defined(MIOS32_DONT_USE_UART_MIDI) && MIOS32_UART_NUM > 0
+#define RX_RING_NUM MIOS32_UART_NUM
+#else
+#define RX_RING_NUM 0
+#endif
+
+#if RX_RING_NUM
+#if (MIOS32_MIDI_RX_RING_SIZE & (MIOS32_MIDI_RX_RING_SIZE-1)) || MIOS32_MIDI_RX_RING_SIZE > 32768
+# error "MIOS32_MIDI_RX_RING_SIZE must be a power of two (max. 32768)"
+#endif
+
+// number of packages which are drained at once by MIOS32_MIDI_Receive_Handler()
+#define RX_RING_BATCH_SIZE 16
+
+// ensures that the compiler doesn't reorder ring accesses across the head/tail update
+#define RX_RING_BARRIER() __asm__ volatile ("" ::: "memory")
+#endif
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Local types
 /////////////////////////////////////////////////////////////////////////////
 
+#if RX_RING_NUM
+// lock-free single-producer (ISR) / single-consumer (task) ring
+// head and tail are free running counters, they are only written by
+// the producer respectively the consumer
+typedef struct {
+  mios32_midi_package_t package[MIOS32_MIDI_RX_RING_SIZE];
+  u32 timestamp[MIOS32_MIDI_RX_RING_SIZE];
+  volatile u16 head;
+  volatile u16 tail;
+  volatile u32 overflow_ctr;
+} rx_ring_t;
+#endif
+
 typedef union {
   struct {
     unsigned ALL:8;
@@ -165,6 +202,10 @@ static mios32_midi_port_t last_sysex_port = DEFAULT;
 static u16 sysex_timeout_ctr;
 static sysex_timeout_ctr_flags_t sysex_timeout_ctr_flags;
 
+#if RX_RING_NUM
+static rx_ring_t rx_ring[RX_RING_NUM];
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Local prototypes
@@ -206,6 +247,11 @@ s32 MIOS32_MIDI_Init(u32 mode)
   debug_command_callback_func = NULL;
   filebrowser_command_callback_func = NULL;
 
+#if RX_RING_NUM
+  // clear receive rings
+  memset(rx_ring, 0, sizeof(rx_ring));
+#endif
+
   // initialize interfaces
 #if !defined(MIOS32_DONT_USE_USB) && !defined(MIOS32_DONT_USE_USB_MIDI)
   if( MIOS32_USB_MIDI_Init(0) < 0 )
@@ -1235,6 +1281,28 @@ s32 MIOS32_MIDI_Receive_Handler(void *_callback_package)
   }
 #endif
 
+#if RX_RING_NUM
+  // handle all UART based MIDI packages which have been parsed at ISR time
+  // the rings are drained in bulk, but not more than the ring size per port, so
+  // that a continuous stream can't starve the remaining interfaces
+  {
+    int ring;
+    for(ring=0; ring<RX_RING_NUM; ++ring) {
+      mios32_midi_port_t port = UART0 + ring;
+      mios32_midi_package_t packages[RX_RING_BATCH_SIZE];
+      s32 num;
+      u32 num_total = 0;
+      while( num_total < MIOS32_MIDI_RX_RING_SIZE &&
+	     (num=MIOS32_MIDI_ReceivePackagesBatch(port, packages, NULL, RX_RING_BATCH_SIZE)) > 0 ) {
+	int i;
+	for(i=0; i<num; ++i)
+	  MIOS32_MIDI_ReceivePackage(port, packages[i], _callback_package);
+	num_total += num;
+      }
+    }
+  }
+#endif
+
   // handle all IIC and UART based MIDI packages (round robin, max 10 packages because of possible timeouts)
   {
     typedef struct {
@@ -1372,6 +1440,130 @@ s32 MIOS32_MIDI_Receive_Handler(void *_callback_package)
 }
 
 
+#if RX_RING_NUM
+/////////////////////////////////////////////////////////////////////////////
+// Help function: returns the receive ring of a port, NULL if not available
+/////////////////////////////////////////////////////////////////////////////
+static inline rx_ring_t *MIOS32_MIDI_RxRingGet(mios32_midi_port_t port)
+{
+  if( (port & 0xf0) == UART0 && (port & 0x0f) < RX_RING_NUM )
+    return &rx_ring[port & 0x0f];
+
+  return NULL;
+}
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Puts a received package into the receive ring of the given port.
+//!
+//! Used at ISR time by MIOS32 internal functions if MIOS32_MIDI_RX_RING_SIZE
+//! is enabled. The package is timestamped with MIOS32_TIMESTAMP_Get().
+//!
+//! Only a single producer is allowed for each port!
+//! \param[in] port MIDI port (UART0..UART3)
+//! \param[in] package MIDI package
+//! \return 0 on success
+//! \return -1 if no ring available for this port
+//! \return -2 if ring is full (the overflow counter has been incremented)
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_RxRingPut(mios32_midi_port_t port, mios32_midi_package_t package)
+{
+#if RX_RING_NUM
+  rx_ring_t *ring = MIOS32_MIDI_RxRingGet(port);
+  if( ring == NULL )
+    return -1; // no ring available
+
+  u16 head = ring->head;
+  if( (u16)(head - ring->tail) >= MIOS32_MIDI_RX_RING_SIZE ) {
+    ++ring->overflow_ctr;
+    return -2; // ring full
+  }
+
+  u16 ix = head & (MIOS32_MIDI_RX_RING_SIZE-1);
+  ring->package[ix] = package;
+  ring->timestamp[ix] = MIOS32_TIMESTAMP_Get();
+
+  // publish the entry
+  RX_RING_BARRIER();
+  ring->head = head + 1;
+
+  return 0; // no error
+#else
+  return -1; // no ring available
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Takes up to max_num packages from the receive ring of the given port.
+//!
+//! Called by MIOS32_MIDI_Receive_Handler(), so that it's normally not
+//! required to use this function in an application.
+//!
+//! Only a single consumer is allowed for each port!
+//! \param[in] port MIDI port (UART0..UART3)
+//! \param[out] packages array which will get the packages
+//! \param[out] timestamps array which will get the timestamps of the packages (can be NULL)
+//! \param[in] max_num max. number of packages which should be taken
+//! \return number of packages which have been taken
+//! \return -1 if no ring available for this port
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_ReceivePackagesBatch(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 *timestamps, u32 max_num)
+{
+#if RX_RING_NUM
+  rx_ring_t *ring = MIOS32_MIDI_RxRingGet(port);
+  if( ring == NULL )
+    return -1; // no ring available
+
+  u16 tail = ring->tail;
+  u32 num = (u16)(ring->head - tail);
+  if( num > max_num )
+    num = max_num;
+
+  // read the entries after the head
+  RX_RING_BARRIER();
+
+  u32 i;
+  for(i=0; i<num; ++i) {
+    u16 ix = (tail + i) & (MIOS32_MIDI_RX_RING_SIZE-1);
+    packages[i] = ring->package[ix];
+    if( timestamps != NULL )
+      timestamps[i] = ring->timestamp[ix];
+  }
+
+  // release the entries
+  RX_RING_BARRIER();
+  ring->tail = tail + num;
+
+  return num;
+#else
+  return -1; // no ring available
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the number of packages which have been dropped since the receive
+//! ring of the given port was full.
+//! \param[in] port MIDI port (UART0..UART3)
+//! \return number of dropped packages
+//! \return -1 if no ring available for this port
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_RxRingOverflowCtrGet(mios32_midi_port_t port)
+{
+#if RX_RING_NUM
+  rx_ring_t *ring = MIOS32_MIDI_RxRingGet(port);
+  if( ring == NULL )
+    return -1; // no ring available
+
+  return ring->overflow_ctr;
+#else
+  return -1; // no ring available
+#endif
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! This function should be called periodically each mS to handle timeout
 //! and expire counters.
@@ -1490,13 +1682,28 @@ s32 MIOS32_MIDI_DirectRxCallback_Init(s32 (*callback_rx)(mios32_midi_port_t port
 //! \param[in] port MIDI port (DEFAULT, USB0..USB7, UART0..UART3, IIC0..IIC7, SPIM0..SPIM7)
 //! \param[in] midi_byte received MIDI byte
 //! \return < 0 on errors
+//! \return 1 if the byte has been parsed into the receive ring of a UART port (see MIOS32_MIDI_RX_RING_SIZE)
 /////////////////////////////////////////////////////////////////////////////
 s32 MIOS32_MIDI_SendByteToRxCallback(mios32_midi_port_t port, u8 midi_byte)
 {
+  s32 status = 0;
+
   // note: here we could filter the user hook execution on special situations
   if( direct_rx_callback_func != NULL )
-    return direct_rx_callback_func(port, midi_byte);
-  return 0; // no error
+    status = direct_rx_callback_func(port, midi_byte);
+
+#if RX_RING_NUM
+  // UART: parse the byte at ISR time and forward complete packages to the receive ring
+  if( status == 0 && MIOS32_MIDI_RxRingGet(port) != NULL ) {
+    mios32_midi_package_t package;
+    if( MIOS32_UART_MIDI_PackageParse(port & 0x0f, midi_byte, &package) > 0 )
+      MIOS32_MIDI_RxRingPut(port, package);
+
+    return 1; // byte has been handled, don't put it into the UART receive buffer
+  }
+#endif
+
+  return status;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -1964,7 +2171,7 @@ static s32 MIOS32_MIDI_SYSEX_SendAck(mios32_midi_port_t port, u8 ack_code, u8 ac
   *sysex_buffer_ptr++ = 0xf7;
 
   // finally send SysEx stream
-  return MIOS32_MIDI_SendSysEx(port, (u8 *)sysex_buffer, (u32)sysex_buffer_ptr - ((u32)&sysex_buffer[0]));
+  return MIOS32_MIDI_SendSysEx(port, (u8 *)sysex_buffer, (u32)(sysex_buffer_ptr - &sysex_buffer[0]));
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -1993,7 +2200,7 @@ static s32 MIOS32_MIDI_SYSEX_SendAckStr(mios32_midi_port_t port, char *str)
   *sysex_buffer_ptr++ = 0xf7;
 
   // finally send SysEx stream
-  return MIOS32_MIDI_SendSysEx(port, (u8 *)sysex_buffer, (u32)sysex_buffer_ptr - ((u32)&sysex_buffer[0]));
+  return MIOS32_MIDI_SendSysEx(port, (u8 *)sysex_buffer, (u32)(sysex_buffer_ptr - &sysex_buffer[0]));
 }
 
 
@@ -82,6 +82,16 @@
 //! An example for a search tree construction and OSC method handling can be found
 //! under $MIOS32_PATH/apps/examples/ethernet/osc
 //!
+//! Optionally the search tree can be compiled into a hash table with
+//! MIOS32_OSC_DispatchCompile(), so that address parts without wildcards
+//! are found with a single lookup instead of comparing them against each
+//! node. The table is located in RAM, it's enabled with
+//! \code
+//!   #define MIOS32_OSC_DISPATCH_HASH_SIZE 128
+//! \endcode
+//! in mios32_config.h (must be a power of two, one entry for each node
+//! plus one entry for each tree level)
+//!
 //!
 //! Client Part (sending OSC packets):
 //!
@@ -150,10 +160,39 @@
 
 static s32 MIOS32_OSC_SearchElement(u8 *buffer, u32 len, mios32_osc_args_t *osc_args, const mios32_osc_search_tree_t *search_tree);
 static s32 MIOS32_OSC_SearchPath(char *path, mios32_osc_args_t *osc_args, u32 method_arg, const mios32_osc_search_tree_t *search_tree);
+static s32 MIOS32_OSC_SearchMatch(char *path, size_t sep_pos, mios32_osc_args_t *osc_args, u32 method_arg, const mios32_osc_search_tree_t *node);
+#if MIOS32_OSC_DISPATCH_HASH_SIZE
+static s32 MIOS32_OSC_DispatchLookup(char *path, const mios32_osc_search_tree_t *level, const mios32_osc_search_tree_t **node);
+#endif
 
 static size_t my_strnlen(char *str, size_t max_len);
 
 
+#if MIOS32_OSC_DISPATCH_HASH_SIZE & (MIOS32_OSC_DISPATCH_HASH_SIZE-1)
+# error "MIOS32_OSC_DISPATCH_HASH_SIZE must be a power of two!"
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+#if MIOS32_OSC_DISPATCH_HASH_SIZE
+// Each node of a compiled tree level is stored with the hash of its address.
+// In addition, each level gets an entry with node == NULL, which notifies if
+// the level can be dispatched via the table (hash == 1), or if it has to be
+// searched linear since it contains wildcards or duplicate addresses (hash == 0)
+typedef struct {
+  const mios32_osc_search_tree_t *level;
+  const mios32_osc_search_tree_t *node;
+  u32 hash;
+} mios32_osc_dispatch_entry_t;
+
+static mios32_osc_dispatch_entry_t dispatch_table[MIOS32_OSC_DISPATCH_HASH_SIZE];
+static u32 dispatch_num_entries;
+#endif
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Initializes OSC layer
 //! \param[in] mode currently only mode 0 supported
@@ -164,6 +203,10 @@ s32 MIOS32_OSC_Init(u32 mode)
   if( mode > 0 )
     return -1; // only mode 0 supported yet
 
+#if MIOS32_OSC_DISPATCH_HASH_SIZE
+  MIOS32_OSC_DispatchClear();
+#endif
+
   return 0; // no error
 }
 
@@ -691,6 +734,19 @@ static s32 MIOS32_OSC_SearchPath(char *path, mios32_osc_args_t *osc_args, u32 me
   if( osc_args->num_path_parts >= MIOS32_OSC_MAX_PATH_PARTS )
     return -4; // maximum number of path parts exceeded
 
+#if MIOS32_OSC_DISPATCH_HASH_SIZE
+  // compiled level: an address part without wildcards can only match a single node
+  const mios32_osc_search_tree_t *node;
+  s32 part_len = MIOS32_OSC_DispatchLookup(path, search_tree, &node);
+  if( part_len >= 0 ) {
+    if( node == NULL )
+      return 0; // no matching node
+
+    return MIOS32_OSC_SearchMatch(path, part_len, osc_args, method_arg, node);
+  }
+  // otherwise: linear search
+#endif
+
   while( search_tree->address != NULL ) {
     // compare OSC address with name of tree item
     u8 match = 1;
@@ -725,35 +781,237 @@ static s32 MIOS32_OSC_SearchPath(char *path, mios32_osc_args_t *osc_args, u32 me
       match = 0;
 
     if( match ) {
-      // store number of path parts in local variable, since content of osc_args is changed recursively
-      // we don't want to copy the whole structure to save (a lot of...) memory
-      u8 num_path_parts = osc_args->num_path_parts;
-      // add pointer to path part
-      osc_args->path_part[num_path_parts] = (char *)search_tree->address;
-      osc_args->num_path_parts = num_path_parts + 1;
-
-      // OR method args of current node to the args to propagate optional parameters
-      u32 combined_method_arg = method_arg | search_tree->method_arg;
-
-      if( search_tree->osc_method ) {
-	s32 (*osc_method)(mios32_osc_args_t *osc_args, u32 method_arg) = search_tree->osc_method;
-	osc_method(osc_args, combined_method_arg);
-      } else if( search_tree->next ) {
-
-	// continue search in next hierarchy level
-	s32 status = MIOS32_OSC_SearchPath((char *)&path[sep_pos+1], osc_args, combined_method_arg, search_tree->next);
-	if( status < 0 )
-	  return status;
+      s32 status = MIOS32_OSC_SearchMatch(path, sep_pos, osc_args, method_arg, search_tree);
+      if( status < 0 )
+	return status;
+    }
+
+    ++search_tree;
+  }
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Internal function:
+// calls the method of a matching node, or continues the search in the next level
+// returns -4 if MIOS32_OSC_MAX_PATH_PARTS has been exceeded
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_OSC_SearchMatch(char *path, size_t sep_pos, mios32_osc_args_t *osc_args, u32 method_arg, const mios32_osc_search_tree_t *node)
+{
+  // store number of path parts in local variable, since content of osc_args is changed recursively
+  // we don't want to copy the whole structure to save (a lot of...) memory
+  u8 num_path_parts = osc_args->num_path_parts;
+  // add pointer to path part
+  osc_args->path_part[num_path_parts] = (char *)node->address;
+  osc_args->num_path_parts = num_path_parts + 1;
+
+  // OR method args of current node to the args to propagate optional parameters
+  u32 combined_method_arg = method_arg | node->method_arg;
+
+  if( node->osc_method ) {
+    s32 (*osc_method)(mios32_osc_args_t *osc_args, u32 method_arg) = node->osc_method;
+    osc_method(osc_args, combined_method_arg);
+  } else if( node->next ) {
+
+    // continue search in next hierarchy level
+    s32 status = MIOS32_OSC_SearchPath((char *)&path[sep_pos+1], osc_args, combined_method_arg, node->next);
+    if( status < 0 )
+      return status;
+  }
+
+  // restore number of path parts (which has been changed recursively)
+  osc_args->num_path_parts = num_path_parts;
+
+  return 0; // no error
+}
+
+
+#if MIOS32_OSC_DISPATCH_HASH_SIZE
+/////////////////////////////////////////////////////////////////////////////
+// Internal functions for the dispatch table
+/////////////////////////////////////////////////////////////////////////////
+
+// hash of an address part (FNV-1a), terminated by '/' or \0
+static u32 MIOS32_OSC_DispatchHash(const char *str)
+{
+  u32 hash = 2166136261U;
+
+  while( *str != 0 && *str != '/' ) {
+    hash ^= (u8)*str++;
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+// first table position of an entry
+static u32 MIOS32_OSC_DispatchSlot(const mios32_osc_search_tree_t *level, u32 hash)
+{
+  return (hash ^ ((u32)(size_t)level * 2654435761U)) & (MIOS32_OSC_DISPATCH_HASH_SIZE-1);
+}
+
+// returns the level entry, or NULL if the level hasn't been compiled
+static mios32_osc_dispatch_entry_t *MIOS32_OSC_DispatchLevelGet(const mios32_osc_search_tree_t *level)
+{
+  u32 slot = MIOS32_OSC_DispatchSlot(level, 0);
+
+  while( dispatch_table[slot].level != NULL ) {
+    if( dispatch_table[slot].level == level && dispatch_table[slot].node == NULL )
+      return &dispatch_table[slot];
+    slot = (slot + 1) & (MIOS32_OSC_DISPATCH_HASH_SIZE-1);
+  }
+
+  return NULL;
+}
+
+// stores an entry, returns -2 if table full
+static s32 MIOS32_OSC_DispatchInsert(const mios32_osc_search_tree_t *level, const mios32_osc_search_tree_t *node, u32 hash)
+{
+  // at least one entry has to stay free, so that the search loops terminate
+  if( dispatch_num_entries >= (MIOS32_OSC_DISPATCH_HASH_SIZE-1) )
+    return -2; // table full
+
+  u32 slot = MIOS32_OSC_DispatchSlot(level, node ? hash : 0);
+  while( dispatch_table[slot].level != NULL )
+    slot = (slot + 1) & (MIOS32_OSC_DISPATCH_HASH_SIZE-1);
+
+  dispatch_table[slot].level = level;
+  dispatch_table[slot].node = node;
+  dispatch_table[slot].hash = hash;
+  ++dispatch_num_entries;
+
+  return 0; // no error
+}
+
+// compiles a tree level and all levels below
+static s32 MIOS32_OSC_DispatchCompileLevel(const mios32_osc_search_tree_t *level)
+{
+  if( MIOS32_OSC_DispatchLevelGet(level) != NULL )
+    return 0; // level already compiled (levels can be linked from multiple nodes)
+
+  // the table can only be used if an address part matches a single node
+  u8 hashable = 1;
+  const mios32_osc_search_tree_t *node;
+  for(node=level; node->address != NULL && hashable; ++node) {
+    if( strchr(node->address, '*') || strchr(node->address, '?') ) {
+      hashable = 0;
+    } else {
+      const mios32_osc_search_tree_t *prev_node;
+      for(prev_node=level; prev_node != node; ++prev_node) {
+	if( strcmp(prev_node->address, node->address) == 0 ) {
+	  hashable = 0;
+	  break;
+	}
       }
+    }
+  }
+
+  s32 status;
+  if( (status=MIOS32_OSC_DispatchInsert(level, NULL, hashable)) < 0 )
+    return status;
+
+  for(node=level; node->address != NULL; ++node) {
+    if( hashable && (status=MIOS32_OSC_DispatchInsert(level, node, MIOS32_OSC_DispatchHash(node->address))) < 0 )
+      return status;
+
+    // methods are called instead of searching in the next level
+    if( !node->osc_method && node->next && (status=MIOS32_OSC_DispatchCompileLevel(node->next)) < 0 )
+      return status;
+  }
+
+  return 0; // no error
+}
 
-      // restore number of path parts (which has been changed recursively)
-      osc_args->num_path_parts = num_path_parts;
+// searches the address part in a compiled level
+// returns the length of the address part, and the matching node (or NULL)
+// returns -1 if the level has to be searched linear
+static s32 MIOS32_OSC_DispatchLookup(char *path, const mios32_osc_search_tree_t *level, const mios32_osc_search_tree_t **node)
+{
+  // wildcards could match multiple nodes
+  u32 hash = 2166136261U;
+  s32 part_len = 0;
+  char *str;
+  for(str=path; *str != 0 && *str != '/'; ++str, ++part_len) {
+    if( *str == '*' || *str == '?' )
+      return -1; // linear search
+
+    hash ^= (u8)*str;
+    hash *= 16777619U;
+  }
+
+  u32 slot = MIOS32_OSC_DispatchSlot(level, hash);
+  while( dispatch_table[slot].level != NULL ) {
+    mios32_osc_dispatch_entry_t *e = &dispatch_table[slot];
+    if( e->level == level && e->hash == hash && e->node != NULL &&
+	strncmp(e->node->address, path, part_len) == 0 && e->node->address[part_len] == 0 ) {
+      *node = e->node;
+      return part_len;
     }
+    slot = (slot + 1) & (MIOS32_OSC_DISPATCH_HASH_SIZE-1);
+  }
 
-    ++search_tree;
+  // no matching node: only valid if the level has been compiled
+  mios32_osc_dispatch_entry_t *level_entry = MIOS32_OSC_DispatchLevelGet(level);
+  if( level_entry == NULL || !level_entry->hash )
+    return -1; // linear search
+
+  *node = NULL;
+  return part_len;
+}
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Compiles a search tree into the dispatch table, so that
+//! MIOS32_OSC_ParsePacket() finds address parts without wildcards with a
+//! single lookup.
+//!
+//! The function should be called once during initialisation for each tree
+//! which is passed to MIOS32_OSC_ParsePacket(). Trees which haven't been
+//! compiled are still searched linear. Since the table stores pointers to
+//! the nodes, the tree must not be changed after it has been compiled.
+//!
+//! Levels which contain wildcards ('*' and '?') or the same address
+//! multiple times are always searched linear, so that the methods are called
+//! in the same order like without the dispatch table.
+//! \param[in] search_tree the tree which should be compiled
+//! \return number of used table entries
+//! \return -1 if dispatch table disabled (MIOS32_OSC_DISPATCH_HASH_SIZE == 0)
+//! \return -2 if the table is too small (all trees will be searched linear)
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_OSC_DispatchCompile(const mios32_osc_search_tree_t *search_tree)
+{
+#if !MIOS32_OSC_DISPATCH_HASH_SIZE
+  return -1; // dispatch table disabled
+#else
+  s32 status = MIOS32_OSC_DispatchCompileLevel(search_tree);
+  if( status < 0 ) {
+    // incomplete entries would ignore nodes
+    MIOS32_OSC_DispatchClear();
+    return status;
   }
 
+  return dispatch_num_entries;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Removes all compiled trees from the dispatch table
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_OSC_DispatchClear(void)
+{
+#if !MIOS32_OSC_DISPATCH_HASH_SIZE
+  return -1; // dispatch table disabled
+#else
+  memset(dispatch_table, 0, sizeof(dispatch_table));
+  dispatch_num_entries = 0;
+
   return 0; // no error
+#endif
 }
 
 
@@ -18,6 +18,10 @@
 //!
 //! MIOS32_SDCARD_SectorRead/SectorWrite allow to read/write a 512 byte sector.
 //!
+//! MIOS32_SDCARD_SectorReadMultiple/SectorWriteMultiple transfer consecutive
+//! sectors with a single command (CMD18/CMD25), so that the command, response
+//! and busy overhead is only spent once per transfer instead of once per sector.
+//!
 //! If such an access returns an error, it can be assumed that the SD Card has
 //! been disconnected during the transfer.
 //!
@@ -108,6 +112,15 @@
 #define SDCMD_WRITE_SINGLE_BLOCK (0x40+24)
 #define SDCMD_WRITE_SINGLE_BLOCK_CRC 0xff
 
+#define SDCMD_READ_MULTIPLE_BLOCK (0x40+18)
+#define SDCMD_READ_MULTIPLE_BLOCK_CRC 0xff
+
+#define SDCMD_WRITE_MULTIPLE_BLOCK (0x40+25)
+#define SDCMD_WRITE_MULTIPLE_BLOCK_CRC 0xff
+
+#define SDCMD_STOP_TRANSMISSION	(0x40+12)
+#define SDCMD_STOP_TRANSMISSION_CRC 0xff
+
 
 /* Card type flags (CardType) */
 #define CT_MMC				0x01
@@ -365,6 +378,10 @@ s32 MIOS32_SDCARD_SendSDCCmd(u8 cmd, u32 addr, u8 crc)
   MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, (addr >>  0) & 0xff);
   MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, crc);
 
+  // the byte which follows CMD12 has to be skipped (could be a remaining data byte of a multi block read)
+  if( cmd == SDCMD_STOP_TRANSMISSION )
+    MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+
   u8 timeout = 0;
 
   if( cmd == SDCMD_SEND_STATUS ) {
@@ -579,6 +596,201 @@ error:
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! Reads consecutive sectors with a single READ_MULTIPLE_BLOCK command
+//! \param[in] sector 32bit number of the first sector
+//! \param[in] *buffer pointer to buffer which can store num_sectors * 512 bytes
+//! \param[in] num_sectors number of sectors which should be read
+//! \return 0 if all sectors have been successfully read
+//! \return -error if error occured during read operation (see \ref MIOS32_SDCARD_SectorRead)
+//! \return -256 if timeout during command has been sent
+//! \return -257 if timeout while waiting for start token
+//! \return -258 if timeout while waiting for the end of the transmission
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SDCARD_SectorReadMultiple(u32 sector, u8 *buffer, u32 num_sectors)
+{
+  s32 status = 0;
+  int i;
+  u32 block;
+
+  if( num_sectors == 0 )
+    return 0; // nothing to do
+
+  // single sector: CMD17 is faster since no STOP_TRANSMISSION is required
+  if( num_sectors == 1 )
+    return MIOS32_SDCARD_SectorRead(sector, buffer);
+
+  if (!(CardType & CT_BLOCK)) 
+	sector *= 512;
+
+  MIOS32_SDCARD_MUTEX_TAKE;
+
+  // init SPI port for fast frequency access (ca. 18 MBit/s)
+  // this is required for the case that the SPI port is shared with other devices
+  MIOS32_SPI_TransferModeInit(MIOS32_SDCARD_SPI, MIOS32_SPI_MODE_CLK1_PHASE1, MIOS32_SDCARD_SPI_PRESCALER);
+
+  if( (status=MIOS32_SDCARD_SendSDCCmd(SDCMD_READ_MULTIPLE_BLOCK, sector, SDCMD_READ_MULTIPLE_BLOCK_CRC)) ) {
+    status=(status < 0) ? -256 : status; // return timeout indicator or error flags
+    goto error;
+  }
+
+  for(block=0; block<num_sectors; ++block) {
+    // wait for start token of the data block
+    u8 ret = 0xff;
+    for(i=0; i<65536; ++i) { // TODO: check if sufficient
+      ret = MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+      if( ret != 0xff )
+	break;
+    }
+    if( ret != 0xfe ) { // timeout or error token
+      status= -257;
+      break;
+    }
+
+    // read 512 bytes via DMA
+#ifdef MIOS32_SDCARD_TASK_SUSPEND_HOOK
+    MIOS32_SPI_TransferBlock(MIOS32_SDCARD_SPI, NULL, buffer + block*512, 512, MIOS32_SDCARD_TASK_RESUME_HOOK);
+    MIOS32_SDCARD_TASK_SUSPEND_HOOK();
+#else
+    MIOS32_SPI_TransferBlock(MIOS32_SDCARD_SPI, NULL, buffer + block*512, 512, NULL);
+#endif
+
+    // read (and ignore) CRC
+    MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+    MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+  }
+
+  // stop transmission (also on errors, so that the card returns into transfer state)
+  if( MIOS32_SDCARD_SendSDCCmd(SDCMD_STOP_TRANSMISSION, 0, SDCMD_STOP_TRANSMISSION_CRC) < 0 ) {
+    if( !status )
+      status = -256;
+    goto error;
+  }
+
+  // wait until card is not busy anymore
+  for(i=0; i<32*65536; ++i) { // TODO: check if sufficient
+    u8 ret = MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+    if( ret != 0x00 )
+      break;
+  }
+  if( i == 32*65536 && !status )
+    status= -258;
+
+  // required for clocking (see spec)
+  MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+
+error:
+  // deactivate chip select
+  MIOS32_SPI_RC_PinSet(MIOS32_SDCARD_SPI, MIOS32_SDCARD_SPI_RC_PIN, 1); // spi, rc_pin, pin_value
+
+  // Send dummy byte once deactivated to drop cards DO
+  MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+  MIOS32_SDCARD_MUTEX_GIVE;
+  return status; 
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Writes consecutive sectors with a single WRITE_MULTIPLE_BLOCK command
+//! \param[in] sector 32bit number of the first sector
+//! \param[in] *buffer pointer to buffer which contains num_sectors * 512 bytes
+//! \param[in] num_sectors number of sectors which should be written
+//! \return 0 if all sectors have been successfully written
+//! \return -error if error occured during write operation (see \ref MIOS32_SDCARD_SectorWrite)
+//! \return -256 if timeout during command has been sent
+//! \return -257 if write operation not accepted
+//! \return -258 if timeout during write operation
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SDCARD_SectorWriteMultiple(u32 sector, u8 *buffer, u32 num_sectors)
+{
+  s32 status = 0;
+  int i;
+  u32 block;
+
+  if( num_sectors == 0 )
+    return 0; // nothing to do
+
+  // single sector: CMD24 is faster since no stop token is required
+  if( num_sectors == 1 )
+    return MIOS32_SDCARD_SectorWrite(sector, buffer);
+
+  MIOS32_SDCARD_MUTEX_TAKE;
+
+  if (!(CardType & CT_BLOCK))
+	sector *= 512;
+
+  // init SPI port for fast frequency access (ca. 18 MBit/s)
+  // this is required for the case that the SPI port is shared with other devices
+  MIOS32_SPI_TransferModeInit(MIOS32_SDCARD_SPI, MIOS32_SPI_MODE_CLK1_PHASE1, MIOS32_SDCARD_SPI_PRESCALER);
+
+  if( (status=MIOS32_SDCARD_SendSDCCmd(SDCMD_WRITE_MULTIPLE_BLOCK, sector, SDCMD_WRITE_MULTIPLE_BLOCK_CRC)) ) {
+    status=(status < 0) ? -256 : status; // return timeout indicator or error flags
+    goto error;
+  }  
+
+  for(block=0; block<num_sectors; ++block) {
+    // send start token
+    MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xfc);
+
+    // send 512 bytes of data via DMA
+#ifdef MIOS32_SDCARD_TASK_SUSPEND_HOOK
+    MIOS32_SPI_TransferBlock(MIOS32_SDCARD_SPI, buffer + block*512, NULL, 512, MIOS32_SDCARD_TASK_RESUME_HOOK);
+    MIOS32_SDCARD_TASK_SUSPEND_HOOK();
+#else
+    MIOS32_SPI_TransferBlock(MIOS32_SDCARD_SPI, buffer + block*512, NULL, 512, NULL);
+#endif
+
+    // send CRC
+    MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+    MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+
+    // read response
+    u8 response = MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+    if( (response & 0x0f) != 0x5 ) {
+      status= -257;
+      break;
+    }
+
+    // wait for write completion
+    for(i=0; i<32*65536; ++i) { // TODO: check if sufficient
+      u8 ret = MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+      if( ret != 0x00 )
+	break;
+    }
+    if( i == 32*65536 ) {
+      status= -258;
+      goto error;
+    }
+  }
+
+  // send stop token (also if a block hasn't been accepted)
+  MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xfd);
+
+  // skip one byte, thereafter wait until card is not busy anymore
+  MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+  for(i=0; i<32*65536; ++i) { // TODO: check if sufficient
+    u8 ret = MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+    if( ret != 0x00 )
+      break;
+  }
+  if( i == 32*65536 && !status )
+    status= -258;
+
+  // required for clocking (see spec)
+  MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+
+error:
+  // deactivate chip select
+  MIOS32_SPI_RC_PinSet(MIOS32_SDCARD_SPI, MIOS32_SDCARD_SPI_RC_PIN, 1); // spi, rc_pin, pin_value
+  // Send dummy byte once deactivated to drop cards DO
+  MIOS32_SPI_TransferByte(MIOS32_SDCARD_SPI, 0xff);
+
+  MIOS32_SDCARD_MUTEX_GIVE;
+
+  return status;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Reads the CID informations from SD Card
 //! \param[in] *cid pointer to buffer which holds the CID informations
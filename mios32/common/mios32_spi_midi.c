@@ -126,6 +126,8 @@ s32 MIOS32_SPI_MIDI_Enabled(void)
 {
 #if MIOS32_SPI_MIDI_NUM_PORTS == 0
   return 0; // SPI MIDI interface not explicitely enabled in mios32_config.h
+#elif !defined(MIOS32_SYS_ADDR_BSL_INFO_BEGIN)
+  return 0; // no bootloader info range (e.g. LINUX family)
 #else
   u8 *spi_midi_confirm = (u8 *)MIOS32_SYS_ADDR_SPI_MIDI_CONFIRM;
   u8 *spi_midi = (u8 *)MIOS32_SYS_ADDR_SPI_MIDI;
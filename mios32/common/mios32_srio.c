@@ -38,7 +38,8 @@ extern void MIOS32_SRIO_CALLBACK_BEFORE_DIN_COMPARE(void);
 volatile u8 mios32_srio_dout[MIOS32_SRIO_NUM_DOUT_PAGES][MIOS32_SRIO_NUM_SR];
 
 // DIN values of last scan
-volatile u8 mios32_srio_din[MIOS32_SRIO_NUM_SR];
+// DIN values and change flags are word aligned, so that MIOS32_DIN_Handler() can read 4 SRs at once
+volatile u8 mios32_srio_din[MIOS32_SRIO_NUM_SR] __attribute__((aligned(4)));
 
 // DIN values of ongoing scan
 // Note: during SRIO scan it is required to copy new DIN values into a temporary buffer
@@ -47,7 +48,7 @@ volatile u8 mios32_srio_din[MIOS32_SRIO_NUM_SR];
 volatile u8 mios32_srio_din_buffer[MIOS32_SRIO_NUM_SR];
 
 // change notification flags
-volatile u8 mios32_srio_din_changed[MIOS32_SRIO_NUM_SR];
+volatile u8 mios32_srio_din_changed[MIOS32_SRIO_NUM_SR] __attribute__((aligned(4)));
 
 // the current DOUT page
 #if MIOS32_SRIO_NUM_DOUT_PAGES > 1
@@ -349,10 +350,16 @@ static void MIOS32_SRIO_DMA_Callback(void)
 
   // copy/or buffered DIN values/changed flags
   int i;
+#if MIOS32_INPUT_JOURNAL_SIZE && !defined(MIOS32_DONT_USE_DIN)
+  u8 journal_mask[MIOS32_SRIO_NUM_SR];
+#endif
   for(i=0; i<num_sr; ++i) {
     u8 change_mask = mios32_srio_din[i] ^ mios32_srio_din_buffer[i]; // these are the changed pins
     mios32_srio_din_changed[i] |= change_mask;
     mios32_srio_din[i] = mios32_srio_din_buffer[i];
+#if MIOS32_INPUT_JOURNAL_SIZE && !defined(MIOS32_DONT_USE_DIN)
+    journal_mask[i] = change_mask;
+#endif
   }
 
   // call user specific hook if requested
@@ -362,6 +369,24 @@ static void MIOS32_SRIO_DMA_Callback(void)
   if( srio_scan_finished_hook != NULL )
     srio_scan_finished_hook();
 
+#if MIOS32_INPUT_JOURNAL_SIZE && !defined(MIOS32_DONT_USE_DIN)
+  // store the new DIN changes in the input journal
+  // pins which have been taken over by the encoder driver are already cleared in the "changed" flags,
+  // and changes during the debounce delay are ignored like in MIOS32_DIN_Handler()
+  u8 journal_debounce_start = 0;
+  if( !debounce_time || !debounce_ctr ) {
+    for(i=0; i<num_sr; ++i) {
+      u8 mask = journal_mask[i] & mios32_srio_din_changed[i];
+      while( mask ) {
+	u32 bit = __builtin_ctz(mask);
+	mask &= mask - 1;
+	MIOS32_INPUT_EventPush(MIOS32_INPUT_EVENT_DIN, 8*i + bit, (mios32_srio_din[i] >> bit) & 1);
+	journal_debounce_start = 1;
+      }
+    }
+  }
+#endif
+
   // As long as debounce counter is != 0, clear all "changed" flags to ignore button movements 
   // at this time. In order to ensure, that a new final state of a button won't get lost, 
   // the DIN values are XORed with the "changed" flags (yes, this idea is ill, but it works! :)
@@ -377,6 +402,12 @@ static void MIOS32_SRIO_DMA_Callback(void)
     }
   }
 
+#if MIOS32_INPUT_JOURNAL_SIZE && !defined(MIOS32_DONT_USE_DIN)
+  // journaled button movements start the debounce delay immediately (and not only when MIOS32_DIN_Handler() is called)
+  if( journal_debounce_start )
+    debounce_ctr = debounce_time;
+#endif
+
   // next transfer has to be started with MIOS32_SRIO_ScanStart
 }
 
@@ -26,7 +26,7 @@
 // Local variables
 /////////////////////////////////////////////////////////////////////////////
 
-static u32 timestamp;
+static volatile u32 timestamp;
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -73,6 +73,46 @@ s32 MIOS32_TIMESTAMP_Get(void)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the current timestamp in uS resolution, e.g. to timestamp
+//! events from interrupt handlers (see also MIOS32_INPUT_EventPush())
+//!
+//! The fraction of the current mS is derived from the SysTick counter which
+//! drives the FreeRTOS clock. If the SysTick interrupt is pending (e.g. because
+//! this function is called from an interrupt with higher priority), the
+//! outstanding mS is taken into account.
+//!
+//! On other platforms the mS timestamp is multiplied by 1000.
+//!
+//! \note the value rolls over after ca. 71 minutes, use the difference
+//! between two timestamps only.
+//! \return the current timestamp in uS
+/////////////////////////////////////////////////////////////////////////////
+u32 MIOS32_TIMESTAMP_Get_uS(void)
+{
+#if defined(MIOS32_FAMILY_STM32F10x) || defined(MIOS32_FAMILY_STM32F4xx) || defined(MIOS32_FAMILY_LPC17xx)
+  u32 ms, ticks, pending;
+  u32 reload = SysTick->LOAD;
+
+  do {
+    ms = timestamp;
+    ticks = SysTick->VAL;
+    pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+    if( pending )
+      ticks = SysTick->VAL; // ensure that the counter value was taken after the reload
+  } while( ms != timestamp ); // retry if the timestamp has been incremented meanwhile
+
+  if( pending )
+    ++ms;
+
+  // SysTick is counting down from reload to 0
+  return ms*1000 + ((reload - ticks) * 1000) / (reload + 1);
+#else
+  return timestamp * 1000;
+#endif
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Use this function to get the delay which has passed between a given and
 //! and current timestamp.
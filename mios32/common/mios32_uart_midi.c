@@ -334,6 +334,153 @@ s32 MIOS32_UART_MIDI_PackageSend(u8 uart_port, mios32_midi_package_t package)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! This function parses an incoming byte
+//!
+//! Used by MIOS32_UART_MIDI_PackageReceive(), and at ISR time by
+//! MIOS32_MIDI_SendByteToRxCallback() if MIOS32_MIDI_RX_RING_SIZE is enabled
+//! \param[in] uart_port UART_MIDI module number (0..2)
+//! \param[in] byte the received byte
+//! \param[out] package pointer to MIDI package (completed package will be put into the given variable)
+//! \return 1: package complete
+//! \return 0: package not complete yet
+//! \return -1: UART_MIDI device not available
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_UART_MIDI_PackageParse(u8 uart_port, u8 byte, mios32_midi_package_t *package)
+{
+#if MIOS32_UART_NUM == 0
+  return -1; // all UARTs explicitely disabled
+#else
+  midi_rec_t *midix = &midi_rec[uart_port];// simplify addressing of midi record
+  u8 package_complete = 0;
+
+  if( byte & 0x80 ) { // new MIDI status
+    if( byte >= 0xf8 ) { // events >= 0xf8 don't change the running status and can just be forwarded
+      // Realtime messages don't change the running status and can be sent immediately
+      // They also don't touch the timeout counter!
+      package->cin = 0xf; // F: single byte
+      package->evnt0 = byte;
+      package->evnt1 = 0x00;
+      package->evnt2 = 0x00;
+      package_complete = 1;
+    } else {
+      midix->running_status = byte;
+      midix->expected_bytes = mios32_midi_expected_bytes_common[(byte >> 4) & 0x7];
+
+      if( !midix->expected_bytes ) { // System Message, take number of bytes from expected_bytes_system[] array
+	midix->expected_bytes = mios32_midi_expected_bytes_system[byte & 0xf];
+
+	if( byte == 0xf0 ) {
+	  midix->package.evnt0 = 0xf0; // midix->package.evnt0 only used by SysEx handler for continuous data streams!
+	  midix->sysex_ctr = 0x01;
+	} else if( byte == 0xf7 ) {
+	  switch( midix->sysex_ctr ) {
+	    case 0:
+	      midix->package.cin = 5; // 5: SysEx ends with single byte
+	      midix->package.evnt0 = 0xf7;
+	      midix->package.evnt1 = 0x00;
+	      midix->package.evnt2 = 0x00;
+	      break;
+	    case 1:
+	      midix->package.cin = 6; // 6: SysEx ends with two bytes
+	      // midix->package.evnt0 = // already stored
+	      midix->package.evnt1 = 0xf7;
+	      midix->package.evnt2 = 0x00;
+	      break;
+	    default:
+	      midix->package.cin = 7; // 7: SysEx ends with three bytes
+	      // midix->package.evnt0 = // already stored
+	      // midix->package.evnt1 = // already stored
+	      midix->package.evnt2 = 0xf7;
+	      break;
+	  }
+	  *package = midix->package;
+	  package_complete = 1; // -> forward to caller
+	  midix->sysex_ctr = 0x00; // ensure that next F7 will just send F7
+	} else if( !midix->expected_bytes ) {
+	  // e.g. tune request (with no additional byte)
+	  midix->package.cin = 5; // 5: SysEx ends with single byte
+	  midix->package.evnt0 = byte;
+	  midix->package.evnt1 = 0x00;
+	  midix->package.evnt2 = 0x00;
+	  *package = midix->package;
+	  package_complete = 1; // -> forward to caller
+	}
+      }
+
+      midix->wait_bytes = midix->expected_bytes;
+      midix->timeout_ctr = 0; // reset timeout counter
+    }
+  } else {
+    if( midix->running_status == 0xf0 ) {
+      switch( ++midix->sysex_ctr ) {
+	case 1:
+	  midix->package.evnt0 = byte; 
+	  break;
+	case 2: 
+	  midix->package.evnt1 = byte; 
+	  break;
+	default: // 3
+	  midix->package.evnt2 = byte;
+
+	  // Send three-byte event
+	  midix->package.cin = 4;  // 4: SysEx starts or continues
+	  *package = midix->package;
+	  package_complete = 1; // -> forward to caller
+	  midix->sysex_ctr = 0x00; // reset and prepare for next packet
+	  midix->timeout_ctr = 0; // reset timeout counter
+      }
+    } else { // Common MIDI message or 0xf1 >= status >= 0xf7
+      if( !midix->wait_bytes ) {
+	// received new MIDI event with running status
+	midix->wait_bytes = midix->expected_bytes - 1;
+	midix->timeout_ctr = 0; // reset timeout counter
+      } else {
+	--midix->wait_bytes;
+      }
+
+      if( midix->expected_bytes == 1 ) {
+	midix->package.evnt1 = byte;
+	midix->package.evnt2 = 0x00;
+      } else {
+	if( midix->wait_bytes )
+	  midix->package.evnt1 = byte;
+	else
+	  midix->package.evnt2 = byte;
+      }
+
+      if( !midix->wait_bytes ) {
+	if( (midix->running_status & 0xf0) != 0xf0 ) {
+	  midix->package.cin = midix->running_status >> 4; // common MIDI message
+	} else {
+	  switch( midix->expected_bytes ) { // MEMO: == 0 comparison was a bug in original MBHP_USB code
+	    case 0: 
+	      midix->package.cin = 5; // 5: SysEx common with one byte
+	      break;
+	    case 1: 
+	      midix->package.cin = 2; // 2: SysEx common with two bytes
+	      break;
+	    default: 
+	      midix->package.cin = 3; // 3: SysEx common with three bytes
+	      break;
+	  }
+	}
+
+	midix->package.evnt0 = midix->running_status;
+	// midix->package.evnt1 = // already stored
+	// midix->package.evnt2 = // already stored
+	*package = midix->package;
+	package_complete = 1; // -> forward to caller
+      }
+    }
+  }
+
+  return package_complete;
+#endif
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! This function checks for a new package
 //! \param[in] uart_port UART_MIDI module number (0..2)
@@ -358,134 +505,15 @@ s32 MIOS32_UART_MIDI_PackageReceive(u8 uart_port, mios32_midi_package_t *package
   u8 package_complete = 0;
   s32 status;
   while( !package_complete && (status=MIOS32_UART_RxBufferGet(uart_port)) >= 0 ) {
-    u8 byte = (u8)status;
-
-    if( byte & 0x80 ) { // new MIDI status
-      if( byte >= 0xf8 ) { // events >= 0xf8 don't change the running status and can just be forwarded
-	// Realtime messages don't change the running status and can be sent immediately
-	// They also don't touch the timeout counter!
-	package->cin = 0xf; // F: single byte
-	package->evnt0 = byte;
-	package->evnt1 = 0x00;
-	package->evnt2 = 0x00;
-	package_complete = 1;
-      } else {
-	midix->running_status = byte;
-	midix->expected_bytes = mios32_midi_expected_bytes_common[(byte >> 4) & 0x7];
-
-	if( !midix->expected_bytes ) { // System Message, take number of bytes from expected_bytes_system[] array
-	  midix->expected_bytes = mios32_midi_expected_bytes_system[byte & 0xf];
-
-	  if( byte == 0xf0 ) {
-	    midix->package.evnt0 = 0xf0; // midix->package.evnt0 only used by SysEx handler for continuous data streams!
-	    midix->sysex_ctr = 0x01;
-	  } else if( byte == 0xf7 ) {
-	    switch( midix->sysex_ctr ) {
- 	      case 0:
-		midix->package.cin = 5; // 5: SysEx ends with single byte
-		midix->package.evnt0 = 0xf7;
-		midix->package.evnt1 = 0x00;
-		midix->package.evnt2 = 0x00;
-		break;
-	      case 1:
-		midix->package.cin = 6; // 6: SysEx ends with two bytes
-		// midix->package.evnt0 = // already stored
-		midix->package.evnt1 = 0xf7;
-		midix->package.evnt2 = 0x00;
-		break;
-	      default:
-		midix->package.cin = 7; // 7: SysEx ends with three bytes
-		// midix->package.evnt0 = // already stored
-		// midix->package.evnt1 = // already stored
-		midix->package.evnt2 = 0xf7;
-		break;
-	    }
-	    *package = midix->package;
-	    package_complete = 1; // -> forward to caller
-	    midix->sysex_ctr = 0x00; // ensure that next F7 will just send F7
-	  } else if( !midix->expected_bytes ) {
-	    // e.g. tune request (with no additional byte)
-	    midix->package.cin = 5; // 5: SysEx ends with single byte
-	    midix->package.evnt0 = byte;
-	    midix->package.evnt1 = 0x00;
-	    midix->package.evnt2 = 0x00;
-	    *package = midix->package;
-	    package_complete = 1; // -> forward to caller
-	  }
-	}
-
-	midix->wait_bytes = midix->expected_bytes;
-	midix->timeout_ctr = 0; // reset timeout counter
-      }
-    } else {
-      if( midix->running_status == 0xf0 ) {
-	switch( ++midix->sysex_ctr ) {
-  	  case 1:
-	    midix->package.evnt0 = byte; 
-	    break;
-	  case 2: 
-	    midix->package.evnt1 = byte; 
-	    break;
-	  default: // 3
-	    midix->package.evnt2 = byte;
-
-	    // Send three-byte event
-	    midix->package.cin = 4;  // 4: SysEx starts or continues
-	    *package = midix->package;
-	    package_complete = 1; // -> forward to caller
-	    midix->sysex_ctr = 0x00; // reset and prepare for next packet
-	    midix->timeout_ctr = 0; // reset timeout counter
-	}
-      } else { // Common MIDI message or 0xf1 >= status >= 0xf7
-	if( !midix->wait_bytes ) {
-	  // received new MIDI event with running status
-	  midix->wait_bytes = midix->expected_bytes - 1;
-	  midix->timeout_ctr = 0; // reset timeout counter
-	} else {
-	  --midix->wait_bytes;
-	}
-
-	if( midix->expected_bytes == 1 ) {
-	  midix->package.evnt1 = byte;
-	  midix->package.evnt2 = 0x00;
-	} else {
-	  if( midix->wait_bytes )
-	    midix->package.evnt1 = byte;
-	  else
-	    midix->package.evnt2 = byte;
-	}
-	
-	if( !midix->wait_bytes ) {
-	  if( (midix->running_status & 0xf0) != 0xf0 ) {
-	    midix->package.cin = midix->running_status >> 4; // common MIDI message
-	  } else {
-	    switch( midix->expected_bytes ) { // MEMO: == 0 comparison was a bug in original MBHP_USB code
-  	      case 0: 
-		midix->package.cin = 5; // 5: SysEx common with one byte
-		break;
-  	      case 1: 
-		midix->package.cin = 2; // 2: SysEx common with two bytes
-		break;
-  	      default: 
-		midix->package.cin = 3; // 3: SysEx common with three bytes
-		break;
-	    }
-	  }
-
-	  midix->package.evnt0 = midix->running_status;
-	  // midix->package.evnt1 = // already stored
-	  // midix->package.evnt2 = // already stored
-	  *package = midix->package;
-	  package_complete = 1; // -> forward to caller
-	}
-      }
-    }
+    package_complete = MIOS32_UART_MIDI_PackageParse(uart_port, (u8)status, package);
   }
 
   // incoming MIDI package timed out (incomplete package received)
   if( midix->wait_bytes && midix->timeout_ctr > 1000 ) { // 1000 mS = 1 second
     // stop waiting
+    MIOS32_IRQ_Disable(); // the record is also accessed at ISR time if MIOS32_MIDI_RX_RING_SIZE is enabled
     MIOS32_UART_MIDI_RecordReset(uart_port);
+    MIOS32_IRQ_Enable();
     // notify that incomplete package has been received
     return -10;
   }
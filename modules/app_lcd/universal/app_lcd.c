@@ -16,6 +16,8 @@
  *
  * Please only add drivers which are not resource hungry (e.g. they shouldn't
  * allocate RAM for buffering) - otherwise all applications would be affected!
+ * (the optional GLCD framebuffer is disabled by default, it has to be enabled
+ * with APP_LCD_FRAMEBUFFER_NUM_DEVICES in mios32_config.h)
  *
  * ==========================================================================
  *
@@ -60,6 +62,15 @@ static u8 lcd_testmode = 0;
 static u8 lcd_alt_pinning = 0; // alternative LCD pinning (e.g. for MIDIbox CV which accesses a CLCD at J15, and SSD1306 displays at J5/J28 (STM32F4: J5/J10B))
 static u8 prev_glcd_selection = 0xfe; // 0..MAX_LCDS-1: the previous mios32_lcd_device, 0xff: all CS were activated, 0xfe: will force the update
 
+#if APP_LCD_FRAMEBUFFER_NUM_DEVICES
+static u8 framebuffer[APP_LCD_FRAMEBUFFER_NUM_DEVICES][APP_LCD_FRAMEBUFFER_DEVICE_SIZE];
+// range of changed bytes for each page (begin >= end: nothing changed)
+static u16 framebuffer_dirty_begin[APP_LCD_FRAMEBUFFER_NUM_DEVICES][APP_LCD_FRAMEBUFFER_MAX_PAGES];
+static u16 framebuffer_dirty_end[APP_LCD_FRAMEBUFFER_NUM_DEVICES][APP_LCD_FRAMEBUFFER_MAX_PAGES];
+static u8 framebuffer_enabled = 1;
+static u8 framebuffer_bypass = 0; // set while the framebuffer is transfered to the displays
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Derivative dependent IO access functions for CS lines
@@ -72,6 +83,8 @@ static u8 prev_glcd_selection = 0xfe; // 0..MAX_LCDS-1: the previous mios32_lcd_
 # define APP_LCD_NUM_EXT_PINS 8 // at J10B
 #elif defined(MIOS32_FAMILY_LPC17xx)
 # define APP_LCD_NUM_EXT_PINS 4 // at J28
+#elif defined(MIOS32_FAMILY_EMULATION) || defined(MIOS32_FAMILY_LINUX)
+# define APP_LCD_NUM_EXT_PINS 0 // no extension port
 #else
 # warning "APP_LCD_NUM_EXT_PINS not adapted for this MIOS32_FAMILY"
 # define APP_LCD_NUM_EXT_PINS 0
@@ -97,6 +110,8 @@ inline static s32 APP_LCD_ExtPort_Init(void) {
     MIOS32_BOARD_J28_PinInit(pin, MIOS32_BOARD_PIN_MODE_OUTPUT_PP);
   }
   return 0; // no error
+#elif defined(MIOS32_FAMILY_EMULATION) || defined(MIOS32_FAMILY_LINUX)
+  return -1; // no extension port
 #else
 # warning "APP_LCD_ExtPort_Init not adapted for this MIOS32_FAMILY"
   return -1;
@@ -123,6 +138,8 @@ inline static s32 APP_LCD_ExtPort_AltInit(void) {
     MIOS32_BOARD_J5_PinInit(pin, MIOS32_BOARD_PIN_MODE_OUTPUT_PP);
   }
   return 0; // no error
+#elif defined(MIOS32_FAMILY_EMULATION) || defined(MIOS32_FAMILY_LINUX)
+  return -1; // no extension port
 #else
 # warning "APP_LCD_ExtPort_Init not adapted for this MIOS32_FAMILY"
   return -1;
@@ -137,6 +154,8 @@ inline static s32 APP_LCD_ExtPort_PinSet(u8 pin, u8 value) {
   return MIOS32_BOARD_J10_PinSet(pin + 8, value);
 #elif defined(MIOS32_FAMILY_LPC17xx)
   return MIOS32_BOARD_J28_PinSet(pin, value);
+#elif defined(MIOS32_FAMILY_EMULATION) || defined(MIOS32_FAMILY_LINUX)
+  return -1; // no extension port
 #else
 # warning "APP_LCD_ExtPort_PinSet not adapted for this MIOS32_FAMILY"
   return -1;
@@ -151,6 +170,8 @@ inline static s32 APP_LCD_ExtPort_AltPinCsSet(u8 pin, u8 value) {
   return MIOS32_BOARD_J10_PinSet(pin + 12, value); // J10B.D12..D15
 #elif defined(MIOS32_FAMILY_LPC17xx)
   return MIOS32_BOARD_J5_PinSet(pin + 0, value); // J5A.A0..A3
+#elif defined(MIOS32_FAMILY_EMULATION) || defined(MIOS32_FAMILY_LINUX)
+  return -1; // no extension port
 #else
 # warning "APP_LCD_ExtPort_PinSet not adapted for this MIOS32_FAMILY"
   return -1;
@@ -231,6 +252,8 @@ inline static s32 APP_LCD_ExtPort_SerDataShift(u8 data, u8 lsb_first) {
     }
   }
   return 0; // no error
+#elif defined(MIOS32_FAMILY_EMULATION) || defined(MIOS32_FAMILY_LINUX)
+  return -1; // no extension port
 #else
 # warning "APP_LCD_ExtPort_SerDataShift not adapted for this MIOS32_FAMILY"
   return -1;
@@ -253,6 +276,8 @@ inline static s32 APP_LCD_ExtPort_UpdateSRs(void) {
   APP_LCD_ExtPort_PinSet(2, 1); // J28.WS
   APP_LCD_ExtPort_PinSet(3, 1); // J28.MCLK
   return 0; // no error
+#elif defined(MIOS32_FAMILY_EMULATION) || defined(MIOS32_FAMILY_LINUX)
+  return -1; // no extension port
 #else
 # warning "APP_LCD_ExtPort_UpdateSRs not adapted for this MIOS32_FAMILY"
   return -1;
@@ -503,6 +528,141 @@ static s32 APP_LCD_PollUnbusy(u32 time_out)
 }
 
 
+#if APP_LCD_FRAMEBUFFER_NUM_DEVICES
+/////////////////////////////////////////////////////////////////////////////
+// Returns the framebuffer of the current display, or NULL if the display
+// has to be accessed directly
+/////////////////////////////////////////////////////////////////////////////
+static u8 *APP_LCD_FrameBufferPtr(void)
+{
+  if( !framebuffer_enabled || framebuffer_bypass || mios32_lcd_device >= APP_LCD_FRAMEBUFFER_NUM_DEVICES )
+    return NULL;
+
+  switch( mios32_lcd_parameters.lcd_type ) {
+  case MIOS32_LCD_TYPE_GLCD_KS0108:
+  case MIOS32_LCD_TYPE_GLCD_KS0108_INVCS:
+  case MIOS32_LCD_TYPE_GLCD_SED1520:
+  case MIOS32_LCD_TYPE_GLCD_DOG:
+  case MIOS32_LCD_TYPE_GLCD_SSD1306:
+  case MIOS32_LCD_TYPE_GLCD_SSD1306_ROTATED: {
+    u32 num_pages = mios32_lcd_parameters.height / 8;
+    if( num_pages > APP_LCD_FRAMEBUFFER_MAX_PAGES ||
+	(mios32_lcd_parameters.width * num_pages) > APP_LCD_FRAMEBUFFER_DEVICE_SIZE )
+      return NULL; // display doesn't fit into framebuffer
+
+    return framebuffer[mios32_lcd_device];
+  }
+
+  default:
+    return NULL; // CLCD
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Marks a range of bytes of a page as changed
+/////////////////////////////////////////////////////////////////////////////
+static void APP_LCD_FrameBufferDirtyMark(u8 device, u8 page, u16 begin, u16 end)
+{
+  u16 *dirty_begin = &framebuffer_dirty_begin[device][page];
+  u16 *dirty_end = &framebuffer_dirty_end[device][page];
+
+  if( *dirty_begin >= *dirty_end ) {
+    *dirty_begin = begin;
+    *dirty_end = end;
+  } else {
+    if( begin < *dirty_begin )
+      *dirty_begin = begin;
+    if( end > *dirty_end )
+      *dirty_end = end;
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Writes a data byte into the framebuffer at the graphical cursor position,
+// and increments the cursor like the display controller
+/////////////////////////////////////////////////////////////////////////////
+static s32 APP_LCD_FrameBufferData(u8 *fb, u8 data)
+{
+  u16 width = mios32_lcd_parameters.width;
+  u8 page = mios32_lcd_y / 8;
+  u16 x = mios32_lcd_x;
+
+  if( page >= (mios32_lcd_parameters.height / 8) )
+    return -1;
+
+  if( mios32_lcd_parameters.lcd_type == MIOS32_LCD_TYPE_GLCD_DOG ||
+      mios32_lcd_parameters.lcd_type == MIOS32_LCD_TYPE_GLCD_SSD1306 ||
+      mios32_lcd_parameters.lcd_type == MIOS32_LCD_TYPE_GLCD_SSD1306_ROTATED ) {
+    // the column wraps at the end of the display, the page stays the same
+    x %= width;
+  } else {
+    // abort if max. width reached
+    if( x >= width )
+      return -1;
+  }
+
+  u8 *ptr = &fb[page*width + x];
+  if( *ptr != data ) {
+    *ptr = data;
+    APP_LCD_FrameBufferDirtyMark(mios32_lcd_device, page, x, x+1);
+  }
+
+  ++mios32_lcd_x;
+
+  return 0; // no error
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Clears all framebuffers after the displays have been cleared directly
+/////////////////////////////////////////////////////////////////////////////
+static void APP_LCD_FrameBufferClearAll(void)
+{
+  memset(framebuffer, 0x00, sizeof(framebuffer));
+  memset(framebuffer_dirty_begin, 0x00, sizeof(framebuffer_dirty_begin));
+  memset(framebuffer_dirty_end, 0x00, sizeof(framebuffer_dirty_end));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Transfers a range of a framebuffer page to the display
+// The graphical cursor has to be set before
+/////////////////////////////////////////////////////////////////////////////
+static s32 APP_LCD_FrameBufferTransfer(u8 *data, u16 len)
+{
+  switch( mios32_lcd_parameters.lcd_type ) {
+  case MIOS32_LCD_TYPE_GLCD_DOG:
+  case MIOS32_LCD_TYPE_GLCD_SSD1306:
+  case MIOS32_LCD_TYPE_GLCD_SSD1306_ROTATED: {
+    // the page is sent as a single block: CS and DC only have to be set once
+    if( !(display_available & (1ULL << mios32_lcd_device)) )
+      return -1;
+
+    APP_LCD_SERGLCD_CS_Set(1, 0);
+
+    if( lcd_alt_pinning && mios32_lcd_parameters.lcd_type != MIOS32_LCD_TYPE_GLCD_DOG ) {
+      APP_LCD_ExtPort_PinSet(2, 1); // DC
+      while( len-- )
+	APP_LCD_ExtPort_SerDataShift(*data++, 0);
+    } else {
+      MIOS32_BOARD_J15_RS_Set(1); // RS pin used to control DC (resp. A0)
+      while( len-- )
+	MIOS32_BOARD_J15_SerDataShift(*data++);
+    }
+  } break;
+
+  default: {
+    // parallel GLCDs: chip select depends on X position, and busy flag has to be polled
+    s32 status = 0;
+    while( len-- )
+      status |= APP_LCD_Data(*data++);
+    return status;
+  }
+  }
+
+  return 0; // no error
+}
+#endif
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Initializes application specific LCD driver
 // IN: <mode>: optional configuration
@@ -769,6 +929,16 @@ s32 APP_LCD_Init(u32 mode)
   }
   }
 
+#if APP_LCD_FRAMEBUFFER_NUM_DEVICES
+  if( mios32_lcd_device < APP_LCD_FRAMEBUFFER_NUM_DEVICES ) {
+    // display content is unknown: transfer the complete (empty) framebuffer with the next flush
+    int page;
+    memset(framebuffer[mios32_lcd_device], 0x00, APP_LCD_FRAMEBUFFER_DEVICE_SIZE);
+    for(page=0; page<APP_LCD_FRAMEBUFFER_MAX_PAGES; ++page)
+      APP_LCD_FrameBufferDirtyMark(mios32_lcd_device, page, 0, mios32_lcd_parameters.width);
+  }
+#endif
+
   return (display_available & (1ULL << mios32_lcd_device)) ? 0 : -1; // return -1 if display not available
 }
 
@@ -787,6 +957,13 @@ s32 APP_LCD_Data(u8 data)
   if( !(display_available & (1ULL << mios32_lcd_device)) )
     return -1;
 
+#if APP_LCD_FRAMEBUFFER_NUM_DEVICES
+  // buffered display: data will be transfered with APP_LCD_FrameBufferFlush()
+  u8 *fb = APP_LCD_FrameBufferPtr();
+  if( fb )
+    return APP_LCD_FrameBufferData(fb, data);
+#endif
+
   switch( mios32_lcd_parameters.lcd_type ) {
   case MIOS32_LCD_TYPE_GLCD_KS0108:
   case MIOS32_LCD_TYPE_GLCD_KS0108_INVCS:
@@ -1061,6 +1238,11 @@ s32 APP_LCD_Clear(void)
     // use default font
     MIOS32_LCD_FontInit((u8 *)GLCD_FONT_NORMAL);
 
+#if APP_LCD_FRAMEBUFFER_NUM_DEVICES
+    // all displays are cleared directly
+    framebuffer_bypass = 1;
+#endif
+
     // send data
     for(y=0; y<(mios32_lcd_parameters.height/8); ++y) {
       error |= MIOS32_LCD_CursorSet(0, y);
@@ -1073,6 +1255,11 @@ s32 APP_LCD_Clear(void)
 	MIOS32_BOARD_J15_SerDataShift(0x00);
     }
 
+#if APP_LCD_FRAMEBUFFER_NUM_DEVICES
+    APP_LCD_FrameBufferClearAll();
+    framebuffer_bypass = 0;
+#endif
+
     // set X=0, Y=0
     error |= MIOS32_LCD_CursorSet(0, 0);
 
@@ -1087,6 +1274,11 @@ s32 APP_LCD_Clear(void)
     // use default font
     MIOS32_LCD_FontInit((u8 *)GLCD_FONT_NORMAL);
 
+#if APP_LCD_FRAMEBUFFER_NUM_DEVICES
+    // all displays are cleared directly
+    framebuffer_bypass = 1;
+#endif
+
     // send data
     for(y=0; y<mios32_lcd_parameters.height/8; ++y) {
       error |= MIOS32_LCD_CursorSet(0, y);
@@ -1109,6 +1301,11 @@ s32 APP_LCD_Clear(void)
       }
     }
 
+#if APP_LCD_FRAMEBUFFER_NUM_DEVICES
+    APP_LCD_FrameBufferClearAll();
+    framebuffer_bypass = 0;
+#endif
+
     // set X=0, Y=0
     error |= MIOS32_LCD_CursorSet(0, 0);
 
@@ -1163,6 +1360,12 @@ s32 APP_LCD_GCursorSet(u16 x, u16 y)
   if( lcd_testmode )
     return -1; // direct access disabled in testmode
 
+#if APP_LCD_FRAMEBUFFER_NUM_DEVICES
+  // buffered display: position is taken from mios32_lcd_x/y by APP_LCD_FrameBufferData()
+  if( APP_LCD_FrameBufferPtr() )
+    return 0; // no error
+#endif
+
   switch( mios32_lcd_parameters.lcd_type ) {
   case MIOS32_LCD_TYPE_GLCD_KS0108:
   case MIOS32_LCD_TYPE_GLCD_KS0108_INVCS: {
@@ -1219,6 +1422,9 @@ s32 APP_LCD_GCursorSet(u16 x, u16 y)
 
     return error;
   } break;
+
+  default:
+    break; // CLCDs and custom GLCDs: no graphical cursor
   }
 
   return -3; // not supported
@@ -1371,6 +1577,130 @@ u8 APP_LCD_AltPinningGet(void)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Optional framebuffer for GLCDs (KS0108, SED1520, DOG and SSD1306)
+// If enabled with APP_LCD_FRAMEBUFFER_NUM_DEVICES, all graphical outputs of
+// the first displays only modify the RAM, and APP_LCD_FrameBufferFlush()
+// transfers the changed ranges of each page to the displays.
+// The flush function has to be called periodically by the application, with
+// the same mutex which protects the other LCD accesses.
+// IN: <enable> 0: displays are accessed directly, 1: framebuffer used (default)
+// OUT: returns < 0 if framebuffer not available
+/////////////////////////////////////////////////////////////////////////////
+s32 APP_LCD_FrameBufferEnable(u8 enable)
+{
+#if !APP_LCD_FRAMEBUFFER_NUM_DEVICES
+  return -1; // framebuffer not available
+#else
+  if( enable && !framebuffer_enabled ) {
+    // displays have been accessed directly in between: transfer the complete framebuffer with the next flush
+    int device, page;
+    for(device=0; device<APP_LCD_FRAMEBUFFER_NUM_DEVICES; ++device)
+      for(page=0; page<APP_LCD_FRAMEBUFFER_MAX_PAGES; ++page)
+	APP_LCD_FrameBufferDirtyMark(device, page, 0, mios32_lcd_parameters.width);
+  }
+
+  framebuffer_enabled = enable;
+
+  return 0; // no error
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Transfers the changed ranges of the framebuffers to the displays
+// IN: <force> if 1, the complete framebuffers will be transfered
+// OUT: returns number of transfered data bytes, < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 APP_LCD_FrameBufferFlush(u8 force)
+{
+#if !APP_LCD_FRAMEBUFFER_NUM_DEVICES
+  return -1; // framebuffer not available
+#else
+  if( lcd_testmode )
+    return -1; // direct access disabled in testmode
+
+  u8 prev_device = mios32_lcd_device;
+  u16 prev_x = mios32_lcd_x;
+  u16 prev_y = mios32_lcd_y;
+  s32 num_bytes = 0;
+
+  int num_devices = mios32_lcd_parameters.num_x * mios32_lcd_parameters.num_y;
+  if( num_devices > APP_LCD_FRAMEBUFFER_NUM_DEVICES )
+    num_devices = APP_LCD_FRAMEBUFFER_NUM_DEVICES;
+
+  int device;
+  for(device=0; device<num_devices; ++device) {
+    mios32_lcd_device = device;
+
+    u8 *fb = APP_LCD_FrameBufferPtr();
+    if( fb == NULL )
+      break; // CLCD or display doesn't fit into framebuffer
+
+    // displays are accessed directly while the framebuffer is transfered
+    framebuffer_bypass = 1;
+
+    u16 width = mios32_lcd_parameters.width;
+    int num_pages = mios32_lcd_parameters.height / 8;
+    int page;
+    for(page=0; page<num_pages; ++page) {
+      u16 begin = framebuffer_dirty_begin[device][page];
+      u16 end = framebuffer_dirty_end[device][page];
+
+      if( force ) {
+	begin = 0;
+	end = width;
+      } else if( begin >= end ) {
+	continue; // nothing to transfer
+      }
+
+      if( end > width )
+	end = width;
+
+      framebuffer_dirty_begin[device][page] = 0;
+      framebuffer_dirty_end[device][page] = 0;
+
+      if( !(display_available & (1ULL << device)) )
+	continue; // display has been disabled
+
+      MIOS32_LCD_GCursorSet(begin, page*8);
+      APP_LCD_FrameBufferTransfer(&fb[page*width + begin], end - begin);
+      num_bytes += end - begin;
+    }
+
+    framebuffer_bypass = 0;
+  }
+
+  // restore cursor position (only stored in variables while the framebuffer is active)
+  mios32_lcd_device = prev_device;
+  mios32_lcd_x = prev_x;
+  mios32_lcd_y = prev_y;
+
+  return num_bytes;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns a pointer to the framebuffer of the given display, e.g. for
+// screenshots. The framebuffer should only be read, changes won't be
+// transfered by APP_LCD_FrameBufferFlush()
+// IN: <device> display number
+// OUT: returns NULL if no framebuffer available for this display
+/////////////////////////////////////////////////////////////////////////////
+u8 *APP_LCD_FrameBufferGet(u8 device)
+{
+#if !APP_LCD_FRAMEBUFFER_NUM_DEVICES
+  return NULL; // framebuffer not available
+#else
+  if( device >= APP_LCD_FRAMEBUFFER_NUM_DEVICES )
+    return NULL;
+
+  return framebuffer[device];
+#endif
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
 // Terminal Functions
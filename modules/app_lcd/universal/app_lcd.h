@@ -22,6 +22,24 @@ extern "C" {
 // Global definitions
 /////////////////////////////////////////////////////////////////////////////
 
+// optional RAM framebuffer for GLCDs (KS0108, SED1520, DOG, SSD1306)
+// number of displays (mios32_lcd_device 0..n-1) which are buffered
+// Data is written into the framebuffer, and transfered to the displays with
+// APP_LCD_FrameBufferFlush() - only the changed range of each page is transfered
+// 0 disables the framebuffer (default, since it allocates RAM)
+#ifndef APP_LCD_FRAMEBUFFER_NUM_DEVICES
+#define APP_LCD_FRAMEBUFFER_NUM_DEVICES 0
+#endif
+
+// number of bytes allocated for each display (width * height / 8)
+// displays which don't fit are accessed directly
+#ifndef APP_LCD_FRAMEBUFFER_DEVICE_SIZE
+#define APP_LCD_FRAMEBUFFER_DEVICE_SIZE (128*64/8)
+#endif
+
+// max. number of 8 pixel pages of a buffered display
+#define APP_LCD_FRAMEBUFFER_MAX_PAGES 8
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Global Types
@@ -52,6 +70,10 @@ extern s32 APP_LCD_TerminalPrintConfig(void *_output_function);
 extern s32 APP_LCD_AltPinningSet(u8 alt_pinning);
 extern u8 APP_LCD_AltPinningGet(void);
 
+extern s32 APP_LCD_FrameBufferEnable(u8 enable);
+extern s32 APP_LCD_FrameBufferFlush(u8 force);
+extern u8 *APP_LCD_FrameBufferGet(u8 device);
+
 /////////////////////////////////////////////////////////////////////////////
 // Export global variables
 /////////////////////////////////////////////////////////////////////////////
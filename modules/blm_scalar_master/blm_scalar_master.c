@@ -742,7 +742,7 @@ static s32 BLM_SCALAR_MASTER_SYSEX_SendAck(mios32_midi_port_t port, u8 ack_code,
 
   // finally send SysEx stream
   BLM_SCALAR_MASTER_MUTEX_MIDIOUT_TAKE;
-  s32 status = MIOS32_MIDI_SendSysEx(port, (u8 *)sysex_buffer, (u32)sysex_buffer_ptr - ((u32)&sysex_buffer[0]));
+  s32 status = MIOS32_MIDI_SendSysEx(port, (u8 *)sysex_buffer, (u32)(sysex_buffer_ptr - &sysex_buffer[0]));
   BLM_SCALAR_MASTER_MUTEX_MIDIOUT_GIVE;
   return status;
 }
@@ -775,7 +775,7 @@ s32 BLM_SCALAR_MASTER_SendRequest(u8 blm, u8 req)
 
   // finally send SysEx stream
   BLM_SCALAR_MASTER_MUTEX_MIDIOUT_TAKE;
-  s32 status = MIOS32_MIDI_SendSysEx(blm_midi_port, (u8 *)sysex_buffer, (u32)sysex_buffer_ptr - ((u32)&sysex_buffer[0]));
+  s32 status = MIOS32_MIDI_SendSysEx(blm_midi_port, (u8 *)sysex_buffer, (u32)(sysex_buffer_ptr - &sysex_buffer[0]));
   BLM_SCALAR_MASTER_MUTEX_MIDIOUT_GIVE;
 
   return status;
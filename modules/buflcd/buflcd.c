@@ -13,6 +13,11 @@
 //! transfered to the LCD. This greatly improves performance as well, especially
 //! if a graphical display is connected.
 //!
+//! In addition, the range of changed characters is tracked for each line, so
+//! that BUFLCD_Update() doesn't need to scan unchanged lines, and
+//! BUFLCD_UpdatePartial() allows to limit the number of characters which are
+//! transfered with a single call (e.g. to cap the LCD time of a UI task)
+//!
 //! Another advantage: LCD access works independent from the physical dimension
 //! of the LCDs. E.g. two 2x40 LCDs can be combined to one large 2x80 display,
 //! and BUFLCD_Update() function will take care for switching between the devices
@@ -68,12 +73,25 @@ static u8 buflcd_device_width;
 static u8 buflcd_offset_x;
 static u8 buflcd_offset_y;
 
+// range of changed characters for each line (begin >= end: nothing changed)
+static u16 lcd_dirty_begin[BUFLCD_MAX_LINES];
+static u16 lcd_dirty_end[BUFLCD_MAX_LINES];
+
 #if BUFLCD_SUPPORT_GLCD_FONTS
 // current selected font
 static u8 glcd_font_handling;
 static u8 lcd_current_font;
 #endif
 
+
+/////////////////////////////////////////////////////////////////////////////
+// Local prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+static void BUFLCD_DirtyRangeMark(u32 line, u32 begin, u32 end);
+static void BUFLCD_DirtyAll(u8 mark_chars);
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Display Initialisation
 /////////////////////////////////////////////////////////////////////////////
@@ -109,6 +127,8 @@ s32 BUFLCD_Init(u32 mode)
 
   if( !mode )
     BUFLCD_Clear();
+  else
+    BUFLCD_DirtyAll(0);
 
   return 0; // no error
 }
@@ -137,6 +157,7 @@ s32 BUFLCD_MaxBufferGet(void)
 s32 BUFLCD_DeviceNumXSet(u8 num_x)
 {
   buflcd_device_num_x = num_x;
+  BUFLCD_DirtyAll(0); // line layout changed: scan all lines with next update
   return 0; // no error
 }
 
@@ -155,6 +176,7 @@ s32 BUFLCD_DeviceNumXGet(void)
 s32 BUFLCD_DeviceNumYSet(u8 num_y)
 {
   buflcd_device_num_y = num_y;
+  BUFLCD_DirtyAll(0); // line layout changed: scan all lines with next update
   return 0; // no error
 }
 
@@ -173,6 +195,7 @@ s32 BUFLCD_DeviceNumYGet(void)
 s32 BUFLCD_DeviceWidthSet(u8 width)
 {
   buflcd_device_width = width;
+  BUFLCD_DirtyAll(0); // line layout changed: scan all lines with next update
   return 0; // no error
 }
 
@@ -191,6 +214,7 @@ s32 BUFLCD_DeviceWidthGet(void)
 s32 BUFLCD_DeviceHeightSet(u8 height)
 {
   buflcd_device_height = height;
+  BUFLCD_DirtyAll(0); // line layout changed: scan all lines with next update
   return 0; // no error
 }
 
@@ -222,6 +246,7 @@ s32 BUFLCD_DeviceFontHandlingEnabled(void)
 s32 BUFLCD_OffsetXSet(u8 offset)
 {
   buflcd_offset_x = offset;
+  BUFLCD_DirtyAll(0); // line layout changed: scan all lines with next update
   return 0; // no error
 }
 
@@ -240,6 +265,7 @@ s32 BUFLCD_OffsetXGet(void)
 s32 BUFLCD_OffsetYSet(u8 offset)
 {
   buflcd_offset_y = offset;
+  BUFLCD_DirtyAll(0); // line layout changed: scan all lines with next update
   return 0; // no error
 }
 
@@ -302,6 +328,8 @@ s32 BUFLCD_Clear(void)
   lcd_cursor_x = 0;
   lcd_cursor_y = 0;
 
+  BUFLCD_DirtyAll(0);
+
   return 0; // no error
 }
 
@@ -341,20 +369,27 @@ s32 BUFLCD_PrintChar(char c)
   if( bufpos >= BUFLCD_MaxBufferGet() )
     return -1; // invalid line
 
+  u8 changed = 0;
   u8 *ptr = &lcd_buffer[bufpos];
-  if( (*ptr & 0x7f) != c )
+  if( (*ptr & 0x7f) != c ) {
     *ptr = c;
+    changed = 1;
+  }
 
 #if BUFLCD_SUPPORT_GLCD_FONTS
   if( glcd_font_handling ) {
     u8 *font_ptr = &lcd_buffer[bufpos + (BUFLCD_BUFFER_SIZE/2)];
-    if( *font_ptr != lcd_current_font ) {
+    if( (*font_ptr & 0x7f) != lcd_current_font ) {
       *font_ptr = lcd_current_font;
       *ptr &= 0x7f; // new font: ensure that character will be updated
+      changed = 1;
     }
   }
 #endif
 
+  if( changed )
+    BUFLCD_DirtyRangeMark(lcd_cursor_y, lcd_cursor_x, lcd_cursor_x+1);
+
   ++lcd_cursor_x;
 
   return 0; // no error
@@ -379,37 +414,105 @@ s32 BUFLCD_CursorSet(u16 column, u16 line)
 //! if characters have changed or not
 /////////////////////////////////////////////////////////////////////////////
 s32 BUFLCD_Update(u8 force)
+{
+  BUFLCD_UpdatePartial(force, 0);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! transfers the changed characters of the buffer to LCDs, but not more than
+//! the given number of characters.
+//!
+//! Contiguous changed characters are transfered with a single cursor set.
+//! If the limit is reached, the remaining characters will be transfered with
+//! the next call, so that a UI task can call this function periodically
+//! to cap the time spent for the LCD:
+//! \code
+//!   // transfer max. 16 characters per mS
+//!   BUFLCD_UpdatePartial(0, 16);
+//! \endcode
+//! \param[in] force if != 0, it is ensured that the whole screen will be refreshed, regardless
+//! if characters have changed or not
+//! \param[in] max_chars maximum number of characters which should be transfered (0: no limit)
+//! \return 0 if all changed characters have been transfered
+//! \return 1 if characters are still pending
+/////////////////////////////////////////////////////////////////////////////
+s32 BUFLCD_UpdatePartial(u8 force, u32 max_chars)
 {
   int next_x = -1;
   int next_y = -1;
   int x, y;
+  u32 num_chars = 0;
+#if BUFLCD_SUPPORT_GLCD_FONTS
+  u8 selected_font = 0; // font which has been selected with MIOS32_LCD_FontInit() (0: none)
+  u8 *glcd_font = NULL;
+#endif
+
+  if( force )
+    BUFLCD_DirtyAll(1);
+
+  int line_width = buflcd_device_num_x * buflcd_device_width;
+  if( !line_width )
+    return 0; // no display
+
+  // first device of a line: considers that the offset can start within the previous device
+  int device_offset = (buflcd_offset_x + buflcd_device_width - 1) / buflcd_device_width;
 
   u32 bufpos_len = BUFLCD_MaxBufferGet();
   int phys_y = buflcd_offset_y;
   for(y=0; y<buflcd_device_num_y*buflcd_device_height; ++y, ++phys_y) {
-    u32 bufpos = y * buflcd_device_num_x * buflcd_device_width;
+    u32 bufpos = y * line_width;
     if( bufpos >= bufpos_len )
       break;
 
+    // take over the range of changed characters
+    int begin = 0;
+    int end = line_width;
+    if( y < BUFLCD_MAX_LINES ) {
+      MIOS32_IRQ_Disable();
+      begin = lcd_dirty_begin[y];
+      end = lcd_dirty_end[y];
+      lcd_dirty_begin[y] = 0;
+      lcd_dirty_end[y] = 0;
+      MIOS32_IRQ_Enable();
+
+      if( end > line_width )
+	end = line_width;
+      if( begin >= end )
+	continue; // no change in this line
+    }
+
+    bufpos += begin;
     u8 *ptr = (u8 *)&lcd_buffer[bufpos];
 #if BUFLCD_SUPPORT_GLCD_FONTS
     u8 *font_ptr = (u8 *)&lcd_buffer[bufpos + (BUFLCD_BUFFER_SIZE/2)];
 #endif
-    int phys_x = buflcd_offset_x;
-    int device = (buflcd_device_num_x * (phys_y / buflcd_device_height)) - 1;
-    for(x=0; x<(buflcd_device_num_x * buflcd_device_width) && bufpos < bufpos_len; ++x, ++phys_x, ++bufpos) {
-      if( (phys_x % buflcd_device_width) == 0 )
-	++device;
+    int phys_x = buflcd_offset_x + begin;
+    int device_base = (buflcd_device_num_x * (phys_y / buflcd_device_height)) - device_offset;
+    for(x=begin; x<end && bufpos < bufpos_len; ++x, ++phys_x, ++bufpos) {
+      u8 c = *ptr;
+#if BUFLCD_SUPPORT_GLCD_FONTS
+      u8 font = *font_ptr;
+#endif
 
-      if( force || !(*ptr & 0x80)
+      if( !(c & 0x80)
 #if BUFLCD_SUPPORT_GLCD_FONTS
-	  || (glcd_font_handling && !(*font_ptr & 0x80))
+	  || (glcd_font_handling && !(font & 0x80))
 #endif
 	  ) {
+	if( max_chars && num_chars >= max_chars ) {
+	  // limit reached: the remaining characters will be transfered with the next call
+	  if( y < BUFLCD_MAX_LINES )
+	    BUFLCD_DirtyRangeMark(y, x, end);
+	  return 1; // characters pending
+	}
+
 #if BUFLCD_SUPPORT_GLCD_FONTS
-	u8 *glcd_font = NULL;
-	if( glcd_font_handling ) {
-	  switch( *font_ptr & 0x7f ) {
+	if( glcd_font_handling && (font & 0x7f) != selected_font ) {
+	  selected_font = font & 0x7f;
+	  switch( selected_font ) {
 	  case 'n': glcd_font = (u8 *)GLCD_FONT_NORMAL; break;
 	  case 'i': glcd_font = (u8 *)GLCD_FONT_NORMAL_INV; break;
 	  case 'b': glcd_font = (u8 *)GLCD_FONT_BIG; break;
@@ -442,7 +545,7 @@ s32 BUFLCD_Update(u8 force)
 	    MIOS32_LCD_FontInit((u8 *)&pseudo_font);
 	  }
 #endif
-	  MIOS32_LCD_DeviceSet(device);
+	  MIOS32_LCD_DeviceSet(device_base + phys_x / buflcd_device_width);
 	  MIOS32_LCD_CursorSet(phys_x % buflcd_device_width, phys_y % buflcd_device_height);
 #if BUFLCD_SUPPORT_GLCD_FONTS
 	  if( glcd_font_handling ) {
@@ -455,12 +558,17 @@ s32 BUFLCD_Update(u8 force)
 #if BUFLCD_SUPPORT_GLCD_FONTS
 	if( !glcd_font_handling || glcd_font )
 #endif
-	  MIOS32_LCD_PrintChar(*ptr & 0x7f);
-
-	MIOS32_IRQ_Disable(); // must be atomic
-	*ptr |= 0x80;
+	  MIOS32_LCD_PrintChar(c & 0x7f);
+	++num_chars;
+
+	// must be atomic
+	// flags are only set if the character hasn't been changed meanwhile by another task
+	MIOS32_IRQ_Disable();
+	if( *ptr == c )
+	  *ptr = c | 0x80;
 #if BUFLCD_SUPPORT_GLCD_FONTS
-	*font_ptr |= 0x80;
+	if( *font_ptr == font )
+	  *font_ptr = font | 0x80;
 #endif
 	MIOS32_IRQ_Enable();
 
@@ -468,7 +576,7 @@ s32 BUFLCD_Update(u8 force)
 	next_x = x+1;
 
 	// for multiple LCDs: ensure that cursor is set when we reach the next partition
-	if( (next_x % buflcd_device_width) == 0 )
+	if( ((phys_x+1) % buflcd_device_width) == 0 )
 	  next_x = -1;
       }
       ++ptr;
@@ -544,4 +652,66 @@ s32 BUFLCD_PrintStringPadded(char *str, u32 width)
   return 0; // no error
 }
 
+
+/////////////////////////////////////////////////////////////////////////////
+// extends the range of changed characters of a line
+// column can exceed the line width if a string is print beyond the end of line
+/////////////////////////////////////////////////////////////////////////////
+static void BUFLCD_DirtyRangeMark(u32 line, u32 begin, u32 end)
+{
+  u32 line_width = buflcd_device_num_x * buflcd_device_width;
+  if( !line_width )
+    return;
+
+  if( begin >= line_width ) {
+    // wrapped into next line
+    u32 num_lines = begin / line_width;
+    line += num_lines;
+    begin -= num_lines * line_width;
+    end -= num_lines * line_width;
+  }
+
+  if( line >= BUFLCD_MAX_LINES )
+    return; // this line will be scanned completely
+
+  MIOS32_IRQ_Disable();
+  if( lcd_dirty_begin[line] >= lcd_dirty_end[line] ) {
+    lcd_dirty_begin[line] = begin;
+    lcd_dirty_end[line] = end;
+  } else {
+    if( begin < lcd_dirty_begin[line] )
+      lcd_dirty_begin[line] = begin;
+    if( end > lcd_dirty_end[line] )
+      lcd_dirty_end[line] = end;
+  }
+  MIOS32_IRQ_Enable();
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// marks all lines for the next update
+// if mark_chars is set, all characters will be transfered again
+/////////////////////////////////////////////////////////////////////////////
+static void BUFLCD_DirtyAll(u8 mark_chars)
+{
+  int i;
+
+  MIOS32_IRQ_Disable();
+  for(i=0; i<BUFLCD_MAX_LINES; ++i) {
+    lcd_dirty_begin[i] = 0;
+    lcd_dirty_end[i] = 0xffff; // will be limited to the line width by BUFLCD_UpdatePartial()
+  }
+  MIOS32_IRQ_Enable();
+
+  if( mark_chars ) {
+    u8 *ptr = (u8 *)lcd_buffer;
+    u32 len = BUFLCD_MaxBufferGet();
+    for(i=0; i<len; ++i, ++ptr) {
+      MIOS32_IRQ_Disable(); // must be atomic
+      *ptr &= 0x7f;
+      MIOS32_IRQ_Enable();
+    }
+  }
+}
+
 //! \}
@@ -40,6 +40,13 @@ extern "C" {
 # define BUFLCD_SUPPORT_GLCD_FONTS   0
 #endif
 
+// number of lines for which the range of changed characters is tracked
+// BUFLCD_Update() only scans this range instead of the whole line
+// lines above this number are always scanned completely
+#ifndef BUFLCD_MAX_LINES
+# define BUFLCD_MAX_LINES            16
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Global Types
@@ -75,6 +82,7 @@ extern s32 BUFLCD_FontInit(u8 *font);
 extern s32 BUFLCD_PrintChar(char c);
 extern s32 BUFLCD_CursorSet(u16 column, u16 line);
 extern s32 BUFLCD_Update(u8 force);
+extern s32 BUFLCD_UpdatePartial(u8 force, u32 max_chars);
 
 extern s32 BUFLCD_PrintString(char *str);
 extern s32 BUFLCD_PrintFormattedString(char *format, ...);
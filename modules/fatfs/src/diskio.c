@@ -7,6 +7,7 @@
 
 #include "mios32.h" // Needed for mios32_sdcard_csd_t
 #include "diskio.h"
+#include <string.h>
 
 // TK: defined in integer.h as bool - alternative enum here
 //typedef enum { FALSE = 0, TRUE } BOOL;
@@ -21,6 +22,32 @@
 // and useful info messages during backups
 #define DEBUG_VERBOSE_LEVEL 1
 
+// multi sector requests are transferred with a single CMD18/CMD25
+// can be disabled in mios32_config.h if a card doesn't support these commands properly
+#ifndef DISKIO_SDCARD_MULTI_BLOCK
+#define DISKIO_SDCARD_MULTI_BLOCK 1
+#endif
+
+// optional sector cache between FatFs and the SD Card (512 bytes per sector)
+// single sector accesses (FatFs window: FAT, directory and partial file sectors)
+// are cached with LRU replacement, written sectors are only transferred to the
+// card when they are replaced, or on CTRL_SYNC (f_sync, f_close, f_mkdir, ...)
+// 0 disables the cache
+#ifndef DISKIO_CACHE_NUM_SECTORS
+#define DISKIO_CACHE_NUM_SECTORS 0
+#endif
+
+// number of sectors which are read with a single command if the sectors are
+// accessed sequentially. DISKIO_CACHE_NUM_SECTORS must be a multiple of this value
+// 1 disables the read-ahead
+#ifndef DISKIO_CACHE_READ_AHEAD
+#define DISKIO_CACHE_READ_AHEAD 4
+#endif
+
+#if DISKIO_CACHE_NUM_SECTORS && (DISKIO_CACHE_NUM_SECTORS % DISKIO_CACHE_READ_AHEAD)
+# error "DISKIO_CACHE_NUM_SECTORS must be a multiple of DISKIO_CACHE_READ_AHEAD"
+#endif
+
 
 /*-----------------------------------------------------------------------*/
 /* Correspondence between physical drive number and physical drive.      */
@@ -29,6 +56,344 @@
 
 static DWORD sdcard_sector_count;
 
+#if DISKIO_CACHE_NUM_SECTORS
+static BYTE cache_data[DISKIO_CACHE_NUM_SECTORS][512];
+static DWORD cache_sector[DISKIO_CACHE_NUM_SECTORS];
+static DWORD cache_last_use[DISKIO_CACHE_NUM_SECTORS]; // 0: entry not valid
+static BYTE cache_dirty[DISKIO_CACHE_NUM_SECTORS];
+static DWORD cache_use_ctr;
+static DWORD cache_last_read;
+#endif
+static DISK_CACHE_STATS cache_stats;
+
+
+/*-----------------------------------------------------------------------*/
+/* Sector transfers from/to the SD Card                                  */
+
+static DRESULT sdcard_read (BYTE *buff, DWORD sector, BYTE count)
+{
+  int i;
+
+#if DISKIO_SDCARD_MULTI_BLOCK
+  if( count > 1 ) {
+#if DEBUG_VERBOSE_LEVEL >= 2
+    MIOS32_MIDI_SendDebugMessage("[disk_read] sector %d..%d\n", sector, sector+count-1);
+#endif
+    if( MIOS32_SDCARD_SectorReadMultiple(sector, buff, count) < 0 ) {
+#if DEBUG_VERBOSE_LEVEL >= 1
+      MIOS32_MIDI_SendDebugMessage("[disk_read] error while reading sector %d..%d\n", sector, sector+count-1);
+#endif
+      return RES_ERROR;
+    }
+
+    return RES_OK;
+  }
+#endif
+
+  for(i=0; i<count; ++i) {
+#if DEBUG_VERBOSE_LEVEL >= 2
+    MIOS32_MIDI_SendDebugMessage("[disk_read] sector %d (#%d/%d)\n", sector+i, i+1, count);
+#endif
+    if( MIOS32_SDCARD_SectorRead(sector + i, buff + i*512) < 0 ) {
+#if DEBUG_VERBOSE_LEVEL >= 1
+      MIOS32_MIDI_SendDebugMessage("[disk_read] error while reading sector %d\n", sector+i);
+#endif
+      return RES_ERROR;
+    } else {
+#if DEBUG_VERBOSE_LEVEL >= 3
+      MIOS32_MIDI_SendDebugMessage("[disk_read] sector %d (#%d/%d) finished\n", sector+i, i+1, count);
+#endif
+    }
+  }
+
+  return RES_OK;
+}
+
+#if _READONLY == 0
+static DRESULT sdcard_write (const BYTE *buff, DWORD sector, BYTE count)
+{
+  int i;
+
+#if DISKIO_SDCARD_MULTI_BLOCK
+  if( count > 1 ) {
+#if DEBUG_VERBOSE_LEVEL >= 2
+    MIOS32_MIDI_SendDebugMessage("[disk_write] sector %d..%d\n", sector, sector+count-1);
+#endif
+    if( MIOS32_SDCARD_SectorWriteMultiple(sector, (u8 *)buff, count) < 0 ) {
+#if DEBUG_VERBOSE_LEVEL >= 1
+      MIOS32_MIDI_SendDebugMessage("[disk_write] error while writing to sector %d..%d\n", sector, sector+count-1);
+#endif
+      return RES_ERROR;
+    }
+
+    return RES_OK;
+  }
+#endif
+
+  for(i=0; i<count; ++i) {
+#if DEBUG_VERBOSE_LEVEL >= 2
+    MIOS32_MIDI_SendDebugMessage("[disk_write] sector %d (#%d/%d)\n", sector+i, i+1, count);
+#endif
+    if( MIOS32_SDCARD_SectorWrite(sector + i, (u8 *)buff + 512*i) < 0 ) {
+#if DEBUG_VERBOSE_LEVEL >= 1
+      MIOS32_MIDI_SendDebugMessage("[disk_write] error while writing to sector %d\n", sector+i);
+#endif
+      return RES_ERROR;
+    } else {
+#if DEBUG_VERBOSE_LEVEL >= 3
+      MIOS32_MIDI_SendDebugMessage("[disk_write] sector %d (#%d/%d) finished\n", sector+i, i+1, count);
+#endif
+    }
+  }
+
+  return RES_OK;
+}
+#endif /* _READONLY */
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Sector Cache                                                          */
+
+#if DISKIO_CACHE_NUM_SECTORS
+static int cache_find (DWORD sector)
+{
+  int i;
+
+  for(i=0; i<DISKIO_CACHE_NUM_SECTORS; ++i) {
+    if( cache_last_use[i] && cache_sector[i] == sector )
+      return i;
+  }
+
+  return -1; // not cached
+}
+
+static DRESULT cache_write_back (int line)
+{
+#if _READONLY == 0
+  if( cache_dirty[line] ) {
+    if( sdcard_write(cache_data[line], cache_sector[line], 1) != RES_OK )
+      return RES_ERROR;
+
+    cache_dirty[line] = 0;
+    ++cache_stats.write_backs;
+  }
+#endif
+
+  return RES_OK;
+}
+
+// frees the least recently used entry, returns -1 if a dirty sector couldn't be written back
+static int cache_alloc (void)
+{
+  int i;
+  int line = 0;
+
+  for(i=1; i<DISKIO_CACHE_NUM_SECTORS; ++i) {
+    if( cache_last_use[i] < cache_last_use[line] )
+      line = i;
+  }
+
+  if( cache_write_back(line) != RES_OK )
+    return -1;
+
+  cache_last_use[line] = 0;
+  return line;
+}
+
+#if DISKIO_CACHE_READ_AHEAD > 1
+// frees the group of DISKIO_CACHE_READ_AHEAD consecutive entries which hasn't been used for the longest time
+static int cache_alloc_group (void)
+{
+  int i;
+  int group = 0;
+  DWORD group_last_use = 0xffffffff;
+
+  for(i=0; i<DISKIO_CACHE_NUM_SECTORS; i+=DISKIO_CACHE_READ_AHEAD) {
+    DWORD last_use = 0;
+    int j;
+    for(j=0; j<DISKIO_CACHE_READ_AHEAD; ++j) {
+      if( cache_last_use[i+j] > last_use )
+	last_use = cache_last_use[i+j];
+    }
+
+    if( last_use < group_last_use ) {
+      group_last_use = last_use;
+      group = i;
+    }
+  }
+
+  for(i=group; i<group+DISKIO_CACHE_READ_AHEAD; ++i) {
+    if( cache_write_back(i) != RES_OK )
+      return -1;
+    cache_last_use[i] = 0;
+  }
+
+  return group;
+}
+#endif
+
+static DRESULT cache_read (BYTE *buff, DWORD sector, BYTE count)
+{
+  int line;
+  BYTE num;
+
+  if( count > 1 ) {
+    // multi sector transfers of file data bypass the cache
+    // cached sectors are copied over the read data, since they could be dirty
+    if( sdcard_read(buff, sector, count) != RES_OK )
+      return RES_ERROR;
+
+    for(line=0; line<DISKIO_CACHE_NUM_SECTORS; ++line) {
+      if( cache_last_use[line] && (cache_sector[line] - sector) < count )
+	memcpy(buff + 512*(cache_sector[line] - sector), cache_data[line], 512);
+    }
+
+    return RES_OK;
+  }
+
+  if( (line=cache_find(sector)) >= 0 ) {
+    ++cache_stats.hits;
+  } else {
+    ++cache_stats.misses;
+
+    num = 1;
+#if DISKIO_CACHE_READ_AHEAD > 1
+    // sequential access: fetch the following sectors with the same command
+    // (stops at the first sector which is already cached to avoid duplicate entries)
+    if( sector == (cache_last_read + 1) ) {
+      while( num < DISKIO_CACHE_READ_AHEAD && cache_find(sector + num) < 0 )
+	++num;
+    }
+
+    line = (num > 1) ? cache_alloc_group() : cache_alloc();
+#else
+    line = cache_alloc();
+#endif
+    if( line < 0 )
+      return RES_ERROR;
+
+    DRESULT res = sdcard_read(cache_data[line], sector, num);
+    if( res != RES_OK && num > 1 ) {
+      // e.g. read-ahead beyond the last sector: retry with the requested sector only
+      num = 1;
+      res = sdcard_read(cache_data[line], sector, 1);
+    }
+    if( res != RES_OK )
+      return RES_ERROR;
+
+    int i;
+    for(i=num-1; i>=0; --i) { // the requested sector gets the most recent timestamp
+      cache_sector[line+i] = sector + i;
+      cache_dirty[line+i] = 0;
+      cache_last_use[line+i] = ++cache_use_ctr;
+    }
+    cache_stats.prefetched += num - 1;
+  }
+
+  cache_last_use[line] = ++cache_use_ctr;
+  cache_last_read = sector;
+  memcpy(buff, cache_data[line], 512);
+
+  return RES_OK;
+}
+
+#if _READONLY == 0
+static DRESULT cache_write (const BYTE *buff, DWORD sector, BYTE count)
+{
+  int line;
+
+  if( count > 1 ) {
+    // multi sector transfers of file data are written through, cached copies are updated
+    if( sdcard_write(buff, sector, count) != RES_OK )
+      return RES_ERROR;
+
+    for(line=0; line<DISKIO_CACHE_NUM_SECTORS; ++line) {
+      if( cache_last_use[line] && (cache_sector[line] - sector) < count ) {
+	memcpy(cache_data[line], buff + 512*(cache_sector[line] - sector), 512);
+	cache_dirty[line] = 0;
+      }
+    }
+
+    return RES_OK;
+  }
+
+  if( (line=cache_find(sector)) < 0 ) {
+    if( (line=cache_alloc()) < 0 )
+      return RES_ERROR;
+    cache_sector[line] = sector;
+  }
+
+  memcpy(cache_data[line], buff, 512);
+  cache_dirty[line] = 1;
+  cache_last_use[line] = ++cache_use_ctr;
+
+  return RES_OK;
+}
+#endif /* _READONLY */
+#endif /* DISKIO_CACHE_NUM_SECTORS */
+
+
+#if _READONLY == 0
+/* writes all dirty sectors to the disk (in ascending order) */
+DRESULT disk_cache_flush (
+	BYTE drv		/* Physical drive nmuber (0..) */
+)
+{
+  if( drv != SDCARD )
+    return RES_PARERR;
+
+#if DISKIO_CACHE_NUM_SECTORS
+  while( 1 ) {
+    int i;
+    int line = -1;
+    for(i=0; i<DISKIO_CACHE_NUM_SECTORS; ++i) {
+      if( cache_last_use[i] && cache_dirty[i] && (line < 0 || cache_sector[i] < cache_sector[line]) )
+	line = i;
+    }
+
+    if( line < 0 )
+      break; // all sectors written
+
+    if( cache_write_back(line) != RES_OK )
+      return RES_ERROR;
+  }
+#endif
+
+  return RES_OK;
+}
+#endif /* _READONLY */
+
+
+/* drops all cached sectors, e.g. after the disk has been changed */
+/* dirty sectors are not written! */
+void disk_cache_invalidate (
+	BYTE drv		/* Physical drive nmuber (0..) */
+)
+{
+#if DISKIO_CACHE_NUM_SECTORS
+  if( drv == SDCARD ) {
+    int i;
+    for(i=0; i<DISKIO_CACHE_NUM_SECTORS; ++i) {
+      cache_last_use[i] = 0;
+      cache_dirty[i] = 0;
+    }
+    cache_use_ctr = 0;
+    cache_last_read = 0xfffffffe;
+  }
+#endif
+}
+
+
+/* returns the cache statistics */
+void disk_cache_stats (
+	DISK_CACHE_STATS *stats
+)
+{
+  *stats = cache_stats;
+  stats->num_sectors = DISKIO_CACHE_NUM_SECTORS;
+}
+
 
 /*-----------------------------------------------------------------------*/
 /* Inidialize a Drive                                                    */
@@ -40,6 +405,9 @@ DSTATUS disk_initialize (
     // check availability of SD Card
     // we assume that it has been initialized by application
     sdcard_sector_count = 0xffffffff; // TODO
+
+    // the card could have been changed
+    disk_cache_invalidate(drv);
 #if DEBUG_VERBOSE_LEVEL >= 2
     MIOS32_MIDI_SendDebugMessage("[disk_init] size = %u\n", sdcard_sector_count);
 #endif
@@ -89,26 +457,11 @@ DRESULT disk_read (
 )
 {
   if( drv == SDCARD ) {
-    int i;
-
-    for(i=0; i<count; ++i) {
-#if DEBUG_VERBOSE_LEVEL >= 2
-      MIOS32_MIDI_SendDebugMessage("[disk_read] sector %d (#%d/%d)\n", sector+i, i+1, count);
-#endif
-
-      if( MIOS32_SDCARD_SectorRead(sector + i, buff + i*512) < 0 ) {
-#if DEBUG_VERBOSE_LEVEL >= 1
-	MIOS32_MIDI_SendDebugMessage("[disk_read] error while reading sector %d\n", sector+i);
-#endif
-	return RES_ERROR;
-      } else {
-#if DEBUG_VERBOSE_LEVEL >= 3
-	MIOS32_MIDI_SendDebugMessage("[disk_read] sector %d (#%d/%d) finished\n", sector+i, i+1, count);
+#if DISKIO_CACHE_NUM_SECTORS
+    return cache_read(buff, sector, count);
+#else
+    return sdcard_read(buff, sector, count);
 #endif
-      }
-    }
-
-    return RES_OK;
   }
 
   return RES_PARERR;
@@ -128,25 +481,11 @@ DRESULT disk_write (
 )
 {
   if( drv == SDCARD ) {
-    int i;
-
-    for(i=0; i<count; ++i) {
-#if DEBUG_VERBOSE_LEVEL >= 2
-      MIOS32_MIDI_SendDebugMessage("[disk_write] sector %d (#%d/%d)\n", sector+i, i+1, count);
-#endif
-      if( MIOS32_SDCARD_SectorWrite(sector + i, (u8 *)buff + 512*i) < 0 ) {
-#if DEBUG_VERBOSE_LEVEL >= 1
-	MIOS32_MIDI_SendDebugMessage("[disk_write] error while writing to sector %d\n", sector+i);
-#endif
-	return RES_ERROR;
-      } else {
-#if DEBUG_VERBOSE_LEVEL >= 3
-      MIOS32_MIDI_SendDebugMessage("[disk_write] sector %d (#%d/%d) finished\n", sector+i, i+1, count);
+#if DISKIO_CACHE_NUM_SECTORS
+    return cache_write(buff, sector, count);
+#else
+    return sdcard_write(buff, sector, count);
 #endif
-      }
-    }
-
-    return RES_OK;
   }
 
   return RES_PARERR;
@@ -177,7 +516,11 @@ DRESULT disk_ioctl (
       // Make sure that the disk drive has finished pending write process.
       // When the disk I/O module has a write back cache, flush the dirty sector immediately.
       // This command is not required in read-only configuration.
-      res= RES_OK; // nothing to do (yet)
+#if _READONLY == 0
+      res = disk_cache_flush(drv);
+#else
+      res = RES_OK;
+#endif
 	  break;
 
     case GET_SECTOR_COUNT: /* Mandatory for only f_mkfs() */
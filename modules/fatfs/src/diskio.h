@@ -36,6 +36,22 @@ DRESULT disk_write (BYTE, const BYTE*, DWORD, BYTE);
 DRESULT disk_ioctl (BYTE, BYTE, void*);
 
 
+/* Statistics of the sector cache */
+typedef struct {
+	DWORD	num_sectors;	/* size of the cache, 0 if disabled */
+	DWORD	hits;			/* single sector reads served from the cache */
+	DWORD	misses;			/* single sector reads which accessed the disk */
+	DWORD	prefetched;		/* sectors fetched by sequential read-ahead */
+	DWORD	write_backs;	/* dirty sectors written to the disk */
+} DISK_CACHE_STATS;
+
+#if	_READONLY == 0
+DRESULT disk_cache_flush (BYTE);
+#endif
+void disk_cache_invalidate (BYTE);
+void disk_cache_stats (DISK_CACHE_STATS*);
+
+
 
 /* Disk Status Bits (DSTATUS) */
 
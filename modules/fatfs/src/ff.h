@@ -381,6 +381,7 @@ typedef struct _FILINFO_ {
 	WORD	ftime;		/* Last modified time */
 	BYTE	fattrib;	/* Attribute */
 	char	fname[13];	/* Short file name (8.3 format) */
+	DWORD	fclust;		/* MIOS32: first cluster (used by the directory cache of the FILE module) */
 #if _USE_LFN
 	XCHAR*	lfname;		/* Pointer to the LFN buffer */
 	int 	lfsize;		/* Size of LFN buffer [chrs] */
@@ -451,6 +452,11 @@ char* f_gets (char*, int, FIL*);					/* Get a string from the file */
 
 
 
+/* MIOS32: FAT access, used for the cluster maps of the FILE module */
+DWORD get_fat (FATFS*, DWORD);						/* Read value of a FAT entry */
+
+
+
 /*--------------------------------------------------------------*/
 /* User defined functions                                       */
 
@@ -47,6 +47,8 @@
 # include <FreeRTOS.h>
 # include <portmacro.h>
 # include <task.h>
+#else
+# include <unistd.h> // unlink()
 #endif
 
 
@@ -80,6 +82,8 @@ u8 file_copy_percentage;
 /////////////////////////////////////////////////////////////////////////////
 
 static s32 FILE_MountFS(void);
+static s32 FILE_DirCacheBuild(char *path);
+static s32 FILE_HandleCloseAll(void);
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -118,6 +122,36 @@ static u32 browser_write_file_pos;
 
 static s32 (*browser_upload_callback_func)(char *filename);
 
+// directory cache
+#if FILE_DIR_CACHE_NUM_ENTRIES
+static file_dir_entry_t dir_cache[FILE_DIR_CACHE_NUM_ENTRIES];
+static char dir_cache_path[FILE_DIR_CACHE_PATH_LENGTH];
+static s32 dir_cache_num; // < 0: cache not valid
+#endif
+
+// read handles
+#if FILE_NUM_HANDLES
+typedef struct {
+  u32 clust_ix; // index of the first cluster of the fragment within the file
+  u32 clust;    // first cluster of the fragment
+} file_fragment_t;
+
+typedef struct {
+  FIL fil;
+  u8  is_open;
+  u8  num_fragments; // 0: no cluster map, the FAT chain is followed by FatFs
+  file_fragment_t fragment[FILE_HANDLE_MAX_FRAGMENTS];
+} file_handle_t;
+
+static file_handle_t file_handle[FILE_NUM_HANDLES];
+#endif
+
+// directory object which reads from the directory cache if possible
+typedef struct {
+  DIR dir;
+  s32 cache_pos; // < 0: entries are read via f_readdir()
+} file_dir_t;
+
 
 /////////////////////////////////////////////////////////////////////////////
 //! Initialisation
@@ -132,6 +166,9 @@ s32 FILE_Init(u32 mode)
 
   browser_upload_callback_func = NULL;
 
+  FILE_HandleCloseAll();
+  FILE_DirCacheInvalidate();
+
   // init SDCard access
   s32 error = MIOS32_SDCARD_Init(0);
 #if DEBUG_VERBOSE_LEVEL >= 2
@@ -188,6 +225,11 @@ s32 FILE_CheckSDCard(void)
 #endif
     volume_available = 0;
 
+    // sectors in the diskio cache can't be written anymore
+    disk_cache_invalidate(0);
+    FILE_DirCacheInvalidate();
+    FILE_HandleCloseAll();
+
     return 2; // SD card has been disconnected
   }
 
@@ -212,6 +254,9 @@ static s32 FILE_MountFS(void)
   file_read_is_open = 0;
   file_write_is_open = 0;
 
+  FILE_HandleCloseAll();
+  FILE_DirCacheInvalidate();
+
   if( (res=f_mount(0, &fs)) != FR_OK ) {
     DEBUG_MSG("[FILE] Failed to mount SD Card - error status: %d\n", res);
     return -1; // error
@@ -615,6 +660,361 @@ s32 FILE_ReadWord(u32 *word)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Read handles: unlike FILE_ReadOpen() multiple files can be opened at the
+// same time, each handle has its own FatFs object (with sector buffer)
+// and a cluster map, so that switching between files doesn't require a
+// reopen, and seeks don't have to follow the FAT chain from the beginning
+/////////////////////////////////////////////////////////////////////////////
+
+#if FILE_NUM_HANDLES
+/////////////////////////////////////////////////////////////////////////////
+// Returns the handle structure, or NULL if the handle isn't open
+/////////////////////////////////////////////////////////////////////////////
+static file_handle_t *FILE_HandleGet(s32 handle)
+{
+  if( handle < 0 || handle >= FILE_NUM_HANDLES || !file_handle[handle].is_open )
+    return NULL;
+
+  return &file_handle[handle];
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the cluster with the given index within the file from the cluster map
+/////////////////////////////////////////////////////////////////////////////
+static u32 FILE_HandleClusterGet(file_handle_t *h, u32 clust_ix)
+{
+  int i;
+  for(i=h->num_fragments-1; i>0 && h->fragment[i].clust_ix > clust_ix; --i);
+
+  return h->fragment[i].clust + (clust_ix - h->fragment[i].clust_ix);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Creates the cluster map of a handle
+// returns < 0 if the cluster chain is broken
+/////////////////////////////////////////////////////////////////////////////
+static s32 FILE_HandleClusterMapCreate(file_handle_t *h)
+{
+  FIL *fp = &h->fil;
+  u32 bcs = (u32)fs.csize * SECTOR_SIZE;
+  u32 num_clusters = (fp->fsize + bcs - 1) / bcs;
+  u32 clst = fp->org_clust;
+  u32 prev_clst = 0;
+  u32 clust_ix;
+
+  h->num_fragments = 0;
+
+  for(clust_ix=0; clust_ix<num_clusters; ++clust_ix) {
+    if( clst < 2 || clst >= fs.max_clust )
+      return -1; // broken chain
+
+    if( clust_ix == 0 || clst != (prev_clst+1) ) {
+      if( h->num_fragments >= FILE_HANDLE_MAX_FRAGMENTS ) {
+	h->num_fragments = 0; // too many fragments: no cluster map
+	return 0; // no error
+      }
+
+      file_fragment_t *fragment = &h->fragment[h->num_fragments++];
+      fragment->clust_ix = clust_ix;
+      fragment->clust = clst;
+    }
+
+    prev_clst = clst;
+    if( (clust_ix+1) < num_clusters ) {
+      clst = get_fat(&fs, clst);
+    }
+  }
+
+  return 0; // no error
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Closes all handles (called on (un)mount)
+/////////////////////////////////////////////////////////////////////////////
+static s32 FILE_HandleCloseAll(void)
+{
+  int i;
+  for(i=0; i<FILE_NUM_HANDLES; ++i)
+    file_handle[i].is_open = 0;
+
+  return 0; // no error
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Reads from a handle, the clusters are taken from the cluster map if available
+/////////////////////////////////////////////////////////////////////////////
+static FRESULT FILE_HandleRead(file_handle_t *h, u8 *buffer, u32 len, UINT *successcount)
+{
+  FIL *fp = &h->fil;
+  u32 bcs = (u32)fs.csize * SECTOR_SIZE;
+
+  *successcount = 0;
+
+  if( !h->num_fragments ) {
+    return f_read(fp, buffer, len, successcount);
+  }
+
+  // transfer cluster by cluster, so that FatFs never has to follow the FAT chain
+  while( len && fp->fptr < fp->fsize ) {
+    if( fp->fptr > 0 && (fp->fptr % bcs) == 0 && fp->csect >= fs.csize ) {
+      fp->curr_clust = FILE_HandleClusterGet(h, fp->fptr / bcs);
+      fp->csect = 0;
+    }
+
+    u32 chunk = bcs - (fp->fptr % bcs);
+    if( chunk > len )
+      chunk = len;
+
+    UINT count;
+    FRESULT res = f_read(fp, buffer, chunk, &count);
+    *successcount += count;
+    if( res != FR_OK )
+      return res;
+
+    buffer += count;
+    len -= count;
+  }
+
+  return FR_OK;
+}
+#else
+static s32 FILE_HandleCloseAll(void)
+{
+  return 0; // no error
+}
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Opens a file for reading via a handle.\n
+//! Multiple files can be opened this way in parallel to FILE_ReadOpen()
+//! and FILE_WriteOpen(), the number of handles is specified with
+//! FILE_NUM_HANDLES in mios32_config.h\n
+//! The file shouldn't be changed while it's opened.
+//! \param[in] filepath the file which should be opened
+//! \return >= 0: handle which has to be passed to the FILE_Handle* functions
+//! \return < 0 on errors (error codes are documented in file.h)
+/////////////////////////////////////////////////////////////////////////////
+s32 FILE_HandleOpen(char *filepath)
+{
+#if !FILE_NUM_HANDLES
+  return FILE_ERR_NO_HANDLE; // handles disabled
+#else
+  s32 handle;
+  for(handle=0; handle<FILE_NUM_HANDLES; ++handle)
+    if( !file_handle[handle].is_open )
+      break;
+
+  if( handle >= FILE_NUM_HANDLES ) {
+#if DEBUG_VERBOSE_LEVEL >= 1
+    DEBUG_MSG("[FILE_HandleOpen] FAILURE: no free handle to open '%s'!\n", filepath);
+#endif
+    return FILE_ERR_NO_HANDLE;
+  }
+
+  // exit if volume not available
+  if( !volume_available )
+    return FILE_ERR_NO_VOLUME;
+
+  file_handle_t *h = &file_handle[handle];
+  if( (file_dfs_errno=f_open(&h->fil, filepath, FA_OPEN_EXISTING | FA_READ)) != FR_OK ) {
+#if DEBUG_VERBOSE_LEVEL >= 2
+    DEBUG_MSG("[FILE_HandleOpen] failed to open '%s' (FatFs status: %d)\n", filepath, file_dfs_errno);
+#endif
+    return FILE_ERR_OPEN_READ;
+  }
+
+  if( FILE_HandleClusterMapCreate(h) < 0 ) {
+#if DEBUG_VERBOSE_LEVEL >= 1
+    DEBUG_MSG("[FILE_HandleOpen] FAILURE: broken cluster chain in '%s'!\n", filepath);
+#endif
+    return FILE_ERR_OPEN_READ;
+  }
+
+#if DEBUG_VERBOSE_LEVEL >= 2
+  DEBUG_MSG("[FILE_HandleOpen] opened '%s' as handle #%d, length %u, %d fragments\n", filepath, handle, h->fil.fsize, h->num_fragments);
+#endif
+
+  h->is_open = 1;
+
+  return handle;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Closes a handle
+//! \return < 0 on errors (error codes are documented in file.h)
+/////////////////////////////////////////////////////////////////////////////
+s32 FILE_HandleClose(s32 handle)
+{
+#if !FILE_NUM_HANDLES
+  return FILE_ERR_INVALID_HANDLE;
+#else
+  file_handle_t *h = FILE_HandleGet(handle);
+  if( h == NULL )
+    return FILE_ERR_INVALID_HANDLE;
+
+  // f_close() not required for read-only files
+  h->is_open = 0;
+
+  return 0; // no error
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Changes to a new file position of a handle.\n
+//! The position is taken from the cluster map, the FAT chain only has to be
+//! followed if the file has more than FILE_HANDLE_MAX_FRAGMENTS fragments
+//! \return < 0 on errors (error codes are documented in file.h)
+/////////////////////////////////////////////////////////////////////////////
+s32 FILE_HandleSeek(s32 handle, u32 offset)
+{
+#if !FILE_NUM_HANDLES
+  return FILE_ERR_INVALID_HANDLE;
+#else
+  file_handle_t *h = FILE_HandleGet(handle);
+  if( h == NULL )
+    return FILE_ERR_INVALID_HANDLE;
+
+  FIL *fp = &h->fil;
+
+  if( !h->num_fragments ) {
+    if( (file_dfs_errno=f_lseek(fp, offset)) != FR_OK ) {
+#if DEBUG_VERBOSE_LEVEL >= 2
+      DEBUG_MSG("[FILE_HandleSeek] ERROR: seek to offset %u failed (FatFs status: %d)\n", offset, file_dfs_errno);
+#endif
+      return FILE_ERR_SEEK;
+    }
+    return 0; // no error
+  }
+
+  if( offset > fp->fsize )
+    offset = fp->fsize;
+
+  // same file object state like after f_lseek()
+  fp->fptr = offset;
+  if( offset == 0 ) {
+    fp->csect = 255; // first cluster will be taken from org_clust
+    return 0; // no error
+  }
+
+  u32 bcs = (u32)fs.csize * SECTOR_SIZE;
+  u32 clust_ix = (offset-1) / bcs;
+  u32 clust_offset = offset - clust_ix * bcs; // 1..bcs
+  fp->curr_clust = FILE_HandleClusterGet(h, clust_ix);
+  fp->csect = clust_offset / SECTOR_SIZE;
+
+  if( clust_offset % SECTOR_SIZE ) {
+    u32 sect = FILE_VolumeCluster2Sector(fp->curr_clust) + fp->csect;
+    fp->csect++;
+
+    if( sect != fp->dsect ) {
+      if( disk_read(fs.drive, fp->buf, sect, 1) != RES_OK ) {
+	fp->flag |= FA__ERROR;
+	return FILE_ERR_SEEK;
+      }
+      fp->dsect = sect;
+    }
+  }
+
+  return 0; // no error
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the size of the file opened by a handle (0 if handle not open)
+/////////////////////////////////////////////////////////////////////////////
+u32 FILE_HandleGetSize(s32 handle)
+{
+#if !FILE_NUM_HANDLES
+  return 0;
+#else
+  file_handle_t *h = FILE_HandleGet(handle);
+  return h ? h->fil.fsize : 0;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the file pointer of a handle (0 if handle not open)
+/////////////////////////////////////////////////////////////////////////////
+u32 FILE_HandleGetPosition(s32 handle)
+{
+#if !FILE_NUM_HANDLES
+  return 0;
+#else
+  file_handle_t *h = FILE_HandleGet(handle);
+  return h ? h->fil.fptr : 0;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Read from the file of a handle
+//! \return < 0 on errors (error codes are documented in file.h)
+/////////////////////////////////////////////////////////////////////////////
+s32 FILE_HandleReadBuffer(s32 handle, u8 *buffer, u32 len)
+{
+  s32 status = FILE_HandleReadBufferUnknownLen(handle, buffer, len);
+  if( status < 0 )
+    return status;
+
+  if( (u32)status != len ) {
+#if DEBUG_VERBOSE_LEVEL >= 3
+    DEBUG_MSG("[FILE_HandleReadBuffer] Wrong successcount while reading from handle #%d (count: %d)\n", handle, status);
+#endif
+    return FILE_ERR_READCOUNT;
+  }
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Read from the file of a handle with unknown size
+//! \return < 0 on errors (error codes are documented in file.h)
+//! \return >= 0: value contains the actual read bytes
+/////////////////////////////////////////////////////////////////////////////
+s32 FILE_HandleReadBufferUnknownLen(s32 handle, u8 *buffer, u32 len)
+{
+#if !FILE_NUM_HANDLES
+  return FILE_ERR_INVALID_HANDLE;
+#else
+  file_handle_t *h = FILE_HandleGet(handle);
+  if( h == NULL )
+    return FILE_ERR_INVALID_HANDLE;
+
+  // exit if volume not available
+  if( !volume_available )
+    return FILE_ERR_NO_VOLUME;
+
+  UINT successcount;
+  if( (file_dfs_errno=FILE_HandleRead(h, buffer, len, &successcount)) != FR_OK ) {
+#if DEBUG_VERBOSE_LEVEL >= 3
+    DEBUG_MSG("[FILE_HandleRead] Failed to read sector of handle #%d at position 0x%08x, status: %u\n", handle, h->fil.fptr, file_dfs_errno);
+#endif
+    return FILE_ERR_READ;
+  }
+
+  return successcount;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Read a byte from the file of a handle
+//! \return < 0 on errors (error codes are documented in file.h)
+/////////////////////////////////////////////////////////////////////////////
+s32 FILE_HandleReadByte(s32 handle, u8 *byte)
+{
+  return FILE_HandleReadBuffer(handle, byte, 1);
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Opens a file for writing
 //! \return < 0 on errors (error codes are documented in file.h)
@@ -638,6 +1038,9 @@ s32 FILE_WriteOpen(char *filepath, u8 create)
   // remember state
   file_write_is_open = 1;
 
+  // a new file could have been created
+  FILE_DirCacheInvalidate();
+
   return 0; // no error
 }
 
@@ -656,6 +1059,9 @@ s32 FILE_WriteClose(void)
 
   file_write_is_open = 0;
 
+  // file size has been changed
+  FILE_DirCacheInvalidate();
+
   return status;
 }
 
@@ -841,6 +1247,9 @@ s32 FILE_Copy(char *src_file, char *dst_file)
     f_close(&file_write);
   }
 
+  // a new file could have been created
+  FILE_DirCacheInvalidate();
+
   return status;
 }
 
@@ -858,6 +1267,8 @@ s32 FILE_MakeDir(char *path)
     return FILE_ERR_NO_VOLUME;
   }
 
+  FILE_DirCacheInvalidate();
+
   if( (file_dfs_errno=f_mkdir(path)) != FR_OK )
     return FILE_ERR_MKDIR;
 
@@ -878,6 +1289,8 @@ s32 FILE_Remove(char *path)
     return FILE_ERR_NO_VOLUME;
   }
 
+  FILE_DirCacheInvalidate();
+
 #ifdef MIOS32_FAMILY_EMULATION
   if( (file_dfs_errno=unlink(path)) != FR_OK )
     return FILE_ERR_REMOVE;
@@ -934,6 +1347,157 @@ s32 FILE_DirExists(char *path)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Directory access for the listing functions: reads from the directory cache
+// if the directory fits into it, otherwise from FatFs.
+// Usage like f_opendir/f_readdir: the end of the directory is notified with
+// an empty de->fname
+/////////////////////////////////////////////////////////////////////////////
+static FRESULT FILE_DirOpen(file_dir_t *di, char *path)
+{
+#if FILE_DIR_CACHE_NUM_ENTRIES
+  if( FILE_DirCacheBuild(path) >= 0 ) {
+    di->cache_pos = 0;
+    return FR_OK;
+  }
+#endif
+
+  di->cache_pos = -1;
+  return f_opendir(&di->dir, path);
+}
+
+static FRESULT FILE_DirRead(file_dir_t *di, FILINFO *de)
+{
+#if FILE_DIR_CACHE_NUM_ENTRIES
+  if( di->cache_pos >= 0 ) {
+    if( di->cache_pos >= dir_cache_num ) {
+      de->fname[0] = 0; // end of directory
+    } else {
+      file_dir_entry_t *entry = &dir_cache[di->cache_pos++];
+      memcpy(de->fname, entry->fname, 13);
+      de->fattrib = entry->fattrib;
+      de->fsize = entry->fsize;
+      de->fclust = entry->fclust;
+      de->fdate = 0;
+      de->ftime = 0;
+    }
+    return FR_OK;
+  }
+#endif
+
+  return f_readdir(&di->dir, de);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Reads all entries of a directory into the cache and sorts them by name
+// (hidden entries and entries starting with '.' are skipped)
+// Returns the number of entries, or < 0 if the directory doesn't exist or
+// doesn't fit into the cache, or FILE_ERR_READ if the directory couldn't be
+// read completely (the cache stays invalid)
+/////////////////////////////////////////////////////////////////////////////
+static s32 FILE_DirCacheBuild(char *path)
+{
+#if !FILE_DIR_CACHE_NUM_ENTRIES
+  return -1; // cache disabled
+#else
+  DIR di;
+  FILINFO de;
+
+  if( dir_cache_num >= 0 && strcasecmp(dir_cache_path, path) == 0 )
+    return dir_cache_num; // already cached
+
+  dir_cache_num = -1;
+
+  if( strlen(path) >= FILE_DIR_CACHE_PATH_LENGTH )
+    return -1; // path too long
+
+  if( f_opendir(&di, path) != FR_OK )
+    return -1; // directory doesn't exist
+
+  s32 num = 0;
+  FRESULT res;
+  while( (res=f_readdir(&di, &de)) == FR_OK && de.fname[0] != 0 ) {
+    if( de.fname[0] == '.' || (de.fattrib & AM_HID) )
+      continue;
+
+    if( num >= FILE_DIR_CACHE_NUM_ENTRIES ) {
+#if DEBUG_VERBOSE_LEVEL >= 2
+      DEBUG_MSG("[FILE_DirCacheBuild] %s has more than %d entries - not cached\n", path, FILE_DIR_CACHE_NUM_ENTRIES);
+#endif
+      return -1; // doesn't fit
+    }
+
+    // insertion sort
+    int pos;
+    for(pos=num; pos>0 && strcasecmp(dir_cache[pos-1].fname, de.fname) > 0; --pos)
+      dir_cache[pos] = dir_cache[pos-1];
+
+    file_dir_entry_t *entry = &dir_cache[pos];
+    memcpy(entry->fname, de.fname, 13);
+    entry->fattrib = de.fattrib;
+    entry->fsize = de.fsize;
+    entry->fclust = de.fclust;
+    ++num;
+  }
+
+  if( res != FR_OK ) {
+    file_dfs_errno = res;
+#if DEBUG_VERBOSE_LEVEL >= 1
+    DEBUG_MSG("[FILE_DirCacheBuild] failed to read %s (FatFs status: %d)\n", path, res);
+#endif
+    return FILE_ERR_READ; // don't cache a partial listing
+  }
+
+  strcpy(dir_cache_path, path);
+  dir_cache_num = num;
+
+  return num;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the entries of a directory from the directory cache.\n
+//! The directory is read from SD Card if it isn't cached yet. Entries are
+//! sorted by name, hidden entries and entries starting with '.' are not listed.
+//! \param[in] path directory which should be listed
+//! \param[out] entries pointer to the first entry
+//! \return number of entries
+//! \return < 0 if volume or directory doesn't exist, or if the directory
+//! doesn't fit into the cache (or cache disabled)
+//! \return FILE_ERR_READ if the directory couldn't be read
+/////////////////////////////////////////////////////////////////////////////
+s32 FILE_DirCacheGet(char *path, file_dir_entry_t **entries)
+{
+  if( !volume_available )
+    return FILE_ERR_NO_VOLUME;
+
+  s32 num = FILE_DirCacheBuild(path);
+  if( num < 0 )
+    return (num == FILE_ERR_READ) ? num : FILE_ERR_NO_DIR;
+
+#if FILE_DIR_CACHE_NUM_ENTRIES
+  *entries = &dir_cache[0];
+#endif
+  return num;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Invalidates the directory cache.\n
+//! Called by all FILE functions which change a directory. Has to be called
+//! by the application if a directory is changed directly via FatFs.
+/////////////////////////////////////////////////////////////////////////////
+s32 FILE_DirCacheInvalidate(void)
+{
+#if FILE_DIR_CACHE_NUM_ENTRIES
+  dir_cache_num = -1;
+#endif
+  return 0; // no error
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // This function searches for directories under given path and copies the names
 // into a list (e.g. used by seq_ui_sysex.c)
@@ -942,7 +1506,7 @@ s32 FILE_DirExists(char *path)
 s32 FILE_GetDirs(char *path, char *dir_list, u8 num_of_items, u8 dir_offset)
 {
   s32 status = 0;
-  DIR di;
+  file_dir_t di;
   FILINFO de;
 
   if( !volume_available ) {
@@ -952,7 +1516,7 @@ s32 FILE_GetDirs(char *path, char *dir_list, u8 num_of_items, u8 dir_offset)
     return FILE_ERR_NO_VOLUME;
   }
 
-  if( f_opendir(&di, path) != FR_OK ) {
+  if( FILE_DirOpen(&di, path) != FR_OK ) {
 #if DEBUG_VERBOSE_LEVEL >= 2
     DEBUG_MSG("[FILE_GetDirs] ERROR: opening %s directory - please create it!\n", path);
 #endif
@@ -960,7 +1524,7 @@ s32 FILE_GetDirs(char *path, char *dir_list, u8 num_of_items, u8 dir_offset)
   }
 
   int num_dirs = 0;
-  while( status == 0 && f_readdir(&di, &de) == FR_OK && de.fname[0] != 0 ) {
+  while( status == 0 && FILE_DirRead(&di, &de) == FR_OK && de.fname[0] != 0 ) {
     if( de.fname[0] && de.fname[0] != '.' && (de.fattrib & AM_DIR) && !(de.fattrib & AM_HID) ) {
       ++num_dirs;
 
@@ -996,7 +1560,7 @@ s32 FILE_GetDirs(char *path, char *dir_list, u8 num_of_items, u8 dir_offset)
 s32 FILE_GetFiles(char *path, char *ext_filter, char *file_list, u8 num_of_items, u8 file_offset)
 {
   s32 status = 0;
-  DIR di;
+  file_dir_t di;
   FILINFO de;
 
   if( !volume_available ) {
@@ -1006,7 +1570,7 @@ s32 FILE_GetFiles(char *path, char *ext_filter, char *file_list, u8 num_of_items
     return FILE_ERR_NO_VOLUME;
   }
 
-  if( f_opendir(&di, path) != FR_OK ) {
+  if( FILE_DirOpen(&di, path) != FR_OK ) {
 #if DEBUG_VERBOSE_LEVEL >= 2
     DEBUG_MSG("[FILE_GetFiles] ERROR: opening %s directory - please create it!\n", path);
 #endif
@@ -1014,7 +1578,7 @@ s32 FILE_GetFiles(char *path, char *ext_filter, char *file_list, u8 num_of_items
   }
 
   int num_files = 0;
-  while( status == 0 && f_readdir(&di, &de) == FR_OK && de.fname[0] != 0 ) {
+  while( status == 0 && FILE_DirRead(&di, &de) == FR_OK && de.fname[0] != 0 ) {
     if( de.fname[0] && de.fname[0] != '.' &&
 	!(de.fattrib & AM_DIR) && !(de.fattrib & AM_HID) ) {
 
@@ -1069,7 +1633,7 @@ s32 FILE_GetFiles(char *path, char *ext_filter, char *file_list, u8 num_of_items
 /////////////////////////////////////////////////////////////////////////////
 s32 FILE_FindNextDir(char *path, char *dirname, char *next_dirname){
     s32 status = 0;
-  DIR di;
+  file_dir_t di;
   FILINFO de;
 
   if( !volume_available ) {
@@ -1079,7 +1643,7 @@ s32 FILE_FindNextDir(char *path, char *dirname, char *next_dirname){
     return FILE_ERR_NO_VOLUME;
   }
 
-  if( f_opendir(&di, path) != FR_OK ) {
+  if( FILE_DirOpen(&di, path) != FR_OK ) {
     #if DEBUG_VERBOSE_LEVEL >= 2
     DEBUG_MSG("[FILE_FindNextDir] ERROR: opening %s directory - please create it!\n", path);
     #endif
@@ -1087,7 +1651,7 @@ s32 FILE_FindNextDir(char *path, char *dirname, char *next_dirname){
   }
 
   u8 take_next = 0;
-  while( status == 0 && f_readdir(&di, &de) == FR_OK && de.fname[0] != 0 ) {
+  while( status == 0 && FILE_DirRead(&di, &de) == FR_OK && de.fname[0] != 0 ) {
     if( de.fname[0] && de.fname[0] != '.' &&
         (de.fattrib & AM_DIR) && !(de.fattrib & AM_HID) ) {
 
@@ -1134,7 +1698,7 @@ s32 FILE_FindNextDir(char *path, char *dirname, char *next_dirname){
 s32 FILE_FindPreviousDir(char *path, char *dirname, char *prev_dirname)
 {
   s32 status = 0;
-  DIR di;
+  file_dir_t di;
   FILINFO de;
 
   if( !volume_available ) {
@@ -1144,7 +1708,7 @@ s32 FILE_FindPreviousDir(char *path, char *dirname, char *prev_dirname)
     return FILE_ERR_NO_VOLUME;
   }
 
-  if( f_opendir(&di, path) != FR_OK ) {
+  if( FILE_DirOpen(&di, path) != FR_OK ) {
     #if DEBUG_VERBOSE_LEVEL >= 2
     DEBUG_MSG("[FILE_FindPreviousDir] ERROR: opening %s directory - please create it!\n", path);
     #endif
@@ -1152,7 +1716,7 @@ s32 FILE_FindPreviousDir(char *path, char *dirname, char *prev_dirname)
   }
 
   prev_dirname[0] = 0;
-  while( status == 0 && f_readdir(&di, &de) == FR_OK && de.fname[0] != 0 ) {
+  while( status == 0 && FILE_DirRead(&di, &de) == FR_OK && de.fname[0] != 0 ) {
     if( de.fname[0] && de.fname[0] != '.' &&
 	      (de.fattrib & AM_DIR) && !(de.fattrib & AM_HID) ) {
 
@@ -1204,7 +1768,7 @@ s32 FILE_FindPreviousDir(char *path, char *dirname, char *prev_dirname)
 s32 FILE_FindNextFile(char *path, char *filename, char *ext_filter, char *next_filename)
 {
   s32 status = 0;
-  DIR di;
+  file_dir_t di;
   FILINFO de;
 
   if( !volume_available ) {
@@ -1214,7 +1778,7 @@ s32 FILE_FindNextFile(char *path, char *filename, char *ext_filter, char *next_f
     return FILE_ERR_NO_VOLUME;
   }
 
-  if( f_opendir(&di, path) != FR_OK ) {
+  if( FILE_DirOpen(&di, path) != FR_OK ) {
 #if DEBUG_VERBOSE_LEVEL >= 2
     DEBUG_MSG("[FILE_FindNextFile] ERROR: opening %s directory - please create it!\n", path);
 #endif
@@ -1222,7 +1786,7 @@ s32 FILE_FindNextFile(char *path, char *filename, char *ext_filter, char *next_f
   }
 
   u8 take_next = 0;
-  while( status == 0 && f_readdir(&di, &de) == FR_OK && de.fname[0] != 0 ) {
+  while( status == 0 && FILE_DirRead(&di, &de) == FR_OK && de.fname[0] != 0 ) {
     if( de.fname[0] && de.fname[0] != '.' &&
 	!(de.fattrib & AM_DIR) && !(de.fattrib & AM_HID) ) {
 
@@ -1278,7 +1842,7 @@ s32 FILE_FindNextFile(char *path, char *filename, char *ext_filter, char *next_f
 s32 FILE_FindPreviousFile(char *path, char *filename, char *ext_filter, char *prev_filename)
 {
   s32 status = 0;
-  DIR di;
+  file_dir_t di;
   FILINFO de;
 
   if( !volume_available ) {
@@ -1288,7 +1852,7 @@ s32 FILE_FindPreviousFile(char *path, char *filename, char *ext_filter, char *pr
     return FILE_ERR_NO_VOLUME;
   }
 
-  if( f_opendir(&di, path) != FR_OK ) {
+  if( FILE_DirOpen(&di, path) != FR_OK ) {
 #if DEBUG_VERBOSE_LEVEL >= 2
     DEBUG_MSG("[FILE_FindPreviousFile] ERROR: opening %s directory - please create it!\n", path);
 #endif
@@ -1296,7 +1860,7 @@ s32 FILE_FindPreviousFile(char *path, char *filename, char *ext_filter, char *pr
   }
 
   prev_filename[0] = 0;
-  while( status == 0 && f_readdir(&di, &de) == FR_OK && de.fname[0] != 0 ) {
+  while( status == 0 && FILE_DirRead(&di, &de) == FR_OK && de.fname[0] != 0 ) {
     if( de.fname[0] && de.fname[0] != '.' &&
 	!(de.fattrib & AM_DIR) && !(de.fattrib & AM_HID) ) {
 
@@ -1501,6 +2065,22 @@ s32 FILE_PrintSDCardInfos(void)
     DEBUG_MSG("--------------------\n");
   }
 
+
+  // sector cache of the diskio layer
+  DISK_CACHE_STATS cache_stats;
+  disk_cache_stats(&cache_stats);
+  if( !cache_stats.num_sectors ) {
+    DEBUG_MSG("Sector Cache: disabled\n");
+  } else {
+    DEBUG_MSG("Sector Cache:\n");
+    DEBUG_MSG("- Size: %u sectors\n", cache_stats.num_sectors);
+    DEBUG_MSG("- Hits: %u\n", cache_stats.hits);
+    DEBUG_MSG("- Misses: %u\n", cache_stats.misses);
+    DEBUG_MSG("- Prefetched: %u\n", cache_stats.prefetched);
+    DEBUG_MSG("- Write-backs: %u\n", cache_stats.write_backs);
+  }
+  DEBUG_MSG("--------------------\n");
+
   return 0; // no error
 }
 
@@ -1568,16 +2148,16 @@ s32 FILE_BrowserHandler(mios32_midi_port_t port, char *command)
 
       char *path = (char *)&command[4];
       s32 status = 0;
-      DIR di;
+      file_dir_t di;
       FILINFO de;
 
       if( !volume_available ) {
 	status |= MIOS32_MIDI_SendDebugStringBody(port, "!", 1); // SD Card not mounted
       } else {
-	if( f_opendir(&di, path) != FR_OK ) {
+	if( FILE_DirOpen(&di, path) != FR_OK ) {
 	  status |= MIOS32_MIDI_SendDebugStringBody(port, "-", 1); // failed to access directory
 	} else {
-	  while( status == 0 && f_readdir(&di, &de) == FR_OK && de.fname[0] != 0 ) {
+	  while( status == 0 && FILE_DirRead(&di, &de) == FR_OK && de.fname[0] != 0 ) {
 	    if( de.fname[0] && de.fname[0] != '.' && !(de.fattrib & AM_HID) ) {
 	      char str[20];
 	      str[0] = ',';
@@ -51,6 +51,38 @@ extern "C" {
 #define FILE_ERR_INVALID_SESSION_NAME -24 // FILE_LoadSessionName()
 #define FILE_ERR_UPDATE_FREE      -25 // FILE_UpdateFreeBytes()
 #define FILE_ERR_REMOVE           -26 // FILE_Remove() failed
+#define FILE_ERR_NO_HANDLE        -27 // FILE_HandleOpen() failed because all handles are in use
+#define FILE_ERR_INVALID_HANDLE   -28 // FILE_Handle*() called with a handle which isn't open
+
+
+// number of directory entries which are kept in RAM for FILE_GetFiles, FILE_FindNextFile, ...
+// and the "dir" command of FILE_BrowserHandler (24 bytes per entry).
+// the entries of the last listed directory are sorted by name, so that browsing doesn't
+// require a directory scan on each step. Directories with more entries are read
+// from the SD Card like before (unsorted)
+// 0 disables the cache
+#ifndef FILE_DIR_CACHE_NUM_ENTRIES
+#define FILE_DIR_CACHE_NUM_ENTRIES 0
+#endif
+
+// max. length of the cached path (incl. terminator)
+#ifndef FILE_DIR_CACHE_PATH_LENGTH
+#define FILE_DIR_CACHE_PATH_LENGTH 64
+#endif
+
+// number of read handles which can be opened in parallel to the read and
+// write file with FILE_HandleOpen() (ca. 550 bytes + cluster map per handle)
+// 0 disables the handle functions
+#ifndef FILE_NUM_HANDLES
+#define FILE_NUM_HANDLES 0
+#endif
+
+// number of fragments (contiguous cluster runs) which are stored in the
+// cluster map of a handle (8 bytes per fragment). Seeks and cluster changes
+// of files with more fragments follow the FAT chain like FILE_ReadSeek()
+#ifndef FILE_HANDLE_MAX_FRAGMENTS
+#define FILE_HANDLE_MAX_FRAGMENTS 8
+#endif
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -70,6 +102,14 @@ typedef struct {
   u8 *dir_ptr; // pointer to the directory entry in the window
 } file_t;
 
+// directory entry of the directory cache
+typedef struct {
+  u32  fsize;     // file size
+  u32  fclust;    // first cluster
+  u8   fattrib;   // attributes (AM_DIR, ...)
+  char fname[13]; // short file name (8.3 format)
+} file_dir_entry_t;
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Prototypes
@@ -102,6 +142,15 @@ extern s32 FILE_ReadByte(u8 *byte);
 extern s32 FILE_ReadHWord(u16 *hword);
 extern s32 FILE_ReadWord(u32 *word);
 
+extern s32 FILE_HandleOpen(char *filepath);
+extern s32 FILE_HandleClose(s32 handle);
+extern s32 FILE_HandleSeek(s32 handle, u32 offset);
+extern u32 FILE_HandleGetSize(s32 handle);
+extern u32 FILE_HandleGetPosition(s32 handle);
+extern s32 FILE_HandleReadBuffer(s32 handle, u8 *buffer, u32 len);
+extern s32 FILE_HandleReadBufferUnknownLen(s32 handle, u8 *buffer, u32 len);
+extern s32 FILE_HandleReadByte(s32 handle, u8 *byte);
+
 extern s32 FILE_WriteOpen(char *filepath, u8 create);
 extern s32 FILE_WriteClose(void);
 extern s32 FILE_WriteSeek(u32 offset);
@@ -130,6 +179,9 @@ extern s32 FILE_FindPreviousDir(char *path, char *dirname, char *prev_dirname);
 extern s32 FILE_FindNextFile(char *path, char *filename, char *ext_filter, char *next_filename);
 extern s32 FILE_FindPreviousFile(char *path, char *filename, char *ext_filter, char *prev_filename);
 
+extern s32 FILE_DirCacheGet(char *path, file_dir_entry_t **entries);
+extern s32 FILE_DirCacheInvalidate(void);
+
 extern s32 FILE_SendSyxDump(char *path, mios32_midi_port_t port, u32 ms_delay_between_dumps);
 
 extern s32 FILE_PrintSDCardInfos(void);
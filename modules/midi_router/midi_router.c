@@ -35,6 +35,19 @@
 // SysEx buffer for each input (exclusive Default)
 #define NUM_SYSEX_BUFFERS     (MIDI_PORT_NUM_IN_PORTS-1)
 
+// node masks are stored in 32bit words
+#if MIDI_ROUTER_DISPATCH_TABLE && MIDI_ROUTER_NUM_NODES <= 32
+#define DISPATCH_TABLE_ENABLED 1
+#else
+#define DISPATCH_TABLE_ENABLED 0
+#endif
+
+// number of source ports in dispatch table: USB0..7, UART0..7, IIC0..7, OSC0..7
+#define DISPATCH_TABLE_NUM_PORTS 32
+
+// dispatch table entry for events which are not assigned to a MIDI channel
+#define DISPATCH_TABLE_SYSTEM    16
+
 
 /////////////////////////////////////////////////////////////////////////////
 // global variables
@@ -69,6 +82,15 @@ u32 midi_router_mclk_out;
 static u8 sysex_buffer[NUM_SYSEX_BUFFERS][MIDI_ROUTER_SYSEX_BUFFER_SIZE];
 static u32 sysex_buffer_len[NUM_SYSEX_BUFFERS];
 
+#if DISPATCH_TABLE_ENABLED
+// copy of midi_router_node[] from which the dispatch table has been built
+static midi_router_node_entry_t dispatch_nodes[MIDI_ROUTER_NUM_NODES];
+static volatile u8 dispatch_table_valid;
+
+// node mask for each source port and MIDI channel (+ system events)
+static u32 dispatch_table[DISPATCH_TABLE_NUM_PORTS][17];
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // This function initializes the MIDI router
@@ -88,6 +110,25 @@ s32 MIDI_ROUTER_Init(u32 mode)
   for(i=0; i<NUM_SYSEX_BUFFERS; ++i)
     sysex_buffer_len[i] = 0;
 
+#if DISPATCH_TABLE_ENABLED
+  // build dispatch table with the first received package
+  dispatch_table_valid = 0;
+#endif
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Should be called whenever midi_router_node[] has been changed
+// The dispatch table will be rebuilt with the next received package
+/////////////////////////////////////////////////////////////////////////////
+s32 MIDI_ROUTER_NodesChanged(void)
+{
+#if DISPATCH_TABLE_ENABLED
+  dispatch_table_valid = 0;
+#endif
+
   return 0; // no error
 }
 
@@ -105,6 +146,69 @@ static inline u32 MIDI_ROUTER_PortMaskGet(mios32_midi_port_t port)
   return 0;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Returns the index of USB0..7, UART0..7, IIC0..7, OSC0..7 (0..31)
+// Returns -1 if port not supported
+/////////////////////////////////////////////////////////////////////////////
+static inline s32 MIDI_ROUTER_PortIxGet(mios32_midi_port_t port)
+{
+  u8 port_ix = port & 0xf;
+  if( port >= USB0 && port <= OSC7 && port_ix <= 7 ) {
+    return (((port-USB0) & 0x30) >> 1) | port_ix;
+  }
+
+  return -1;
+}
+
+
+#if DISPATCH_TABLE_ENABLED
+/////////////////////////////////////////////////////////////////////////////
+// Rebuilds the dispatch table from midi_router_node[]
+// IMPORTANT: wrap this function with MUTEX_MIDIOUT_TAKE and MUTEX_MIDIOUT_GIVE!
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIDI_ROUTER_DispatchTableUpdate(void)
+{
+  // set valid before the copy, so that a change during the update isn't lost
+  dispatch_table_valid = 1;
+
+  memcpy(dispatch_nodes, midi_router_node, sizeof(dispatch_nodes));
+  memset(dispatch_table, 0, sizeof(dispatch_table));
+
+  u32 sysex_dst_fwd_done[DISPATCH_TABLE_NUM_PORTS];
+  memset(sysex_dst_fwd_done, 0, sizeof(sysex_dst_fwd_done));
+
+  int node;
+  midi_router_node_entry_t *n = &dispatch_nodes[0];
+  for(node=0; node<MIDI_ROUTER_NUM_NODES; ++node, ++n) {
+    s32 src_ix = MIDI_ROUTER_PortIxGet(n->src_port);
+    if( n->src_chn && n->dst_chn && src_ix >= 0 ) {
+
+      // forwarding OSC to OSC will very likely result into a stack overflow (or feedback loop) -> avoid this!
+      if( ((n->src_port & 0xf0) == OSC0) && ((n->dst_port & 0xf0) == OSC0) )
+	continue;
+
+      u32 node_mask = 1 << node;
+
+      // channel events
+      int chn;
+      for(chn=0; chn<16; ++chn) {
+	if( n->src_chn == 17 || chn == (n->src_chn-1) )
+	  dispatch_table[src_ix][chn] |= node_mask;
+      }
+
+      // Realtime events: ensure that they are only forwarded once
+      u32 mask = MIDI_ROUTER_PortMaskGet(n->dst_port);
+      if( !mask || !(sysex_dst_fwd_done[src_ix] & mask) ) {
+	sysex_dst_fwd_done[src_ix] |= mask;
+	dispatch_table[src_ix][DISPATCH_TABLE_SYSTEM] |= node_mask;
+      }
+    }
+  }
+
+  return 0; // no error
+}
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Receives a MIDI package from APP_NotifyReceivedEvent (-> app.c)
@@ -117,6 +221,42 @@ s32 MIDI_ROUTER_Receive(mios32_midi_port_t port, mios32_midi_package_t midi_pack
       (midi_package.cin >= 0x4 && midi_package.cin <= 0x7)) )
     return 0; // no error
 
+#if DISPATCH_TABLE_ENABLED
+  s32 src_ix = MIDI_ROUTER_PortIxGet(port);
+  if( src_ix >= 0 ) {
+    // rebuild dispatch table if nodes have been changed (see MIDI_ROUTER_NodesChanged())
+    if( !dispatch_table_valid ) {
+      MUTEX_MIDIOUT_TAKE;
+      if( !dispatch_table_valid )
+	MIDI_ROUTER_DispatchTableUpdate();
+      MUTEX_MIDIOUT_GIVE;
+    }
+
+    u8 is_chn_event = midi_package.event >= NoteOff && midi_package.event <= PitchBend;
+    u32 *table_entry = &dispatch_table[src_ix][is_chn_event ? midi_package.chn : DISPATCH_TABLE_SYSTEM];
+
+    if( *table_entry ) {
+      // send to all destinations with a single mutex request
+      MUTEX_MIDIOUT_TAKE;
+      // read again, the table could have been rebuilt in the meantime
+      u32 node_mask = *table_entry;
+      int node;
+      midi_router_node_entry_t *n = &dispatch_nodes[0];
+      for(node=0; node_mask; ++node, ++n, node_mask >>= 1) {
+	if( node_mask & 1 ) {
+	  mios32_midi_package_t fwd_package = midi_package;
+	  if( is_chn_event && n->dst_chn <= 16 )
+	    fwd_package.chn = (n->dst_chn-1);
+	  MIOS32_MIDI_SendPackage(n->dst_port, fwd_package);
+	}
+      }
+      MUTEX_MIDIOUT_GIVE;
+    }
+
+    return 0; // no error
+  }
+#endif
+
   u32 sysex_dst_fwd_done = 0;
   int node;
   midi_router_node_entry_t *n = (midi_router_node_entry_t *)&midi_router_node[0];
@@ -545,6 +685,7 @@ s32 MIDI_ROUTER_TerminalParseLine(char *input, void *_output_function)
 	n->src_chn = src_chn;
 	n->dst_port = dst_port;
 	n->dst_chn = dst_chn;
+	MIDI_ROUTER_NodesChanged();
 
 	out("Changed Node %d to SRC:%s %s  DST:%s %s",
 	    node+1,
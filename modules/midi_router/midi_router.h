@@ -40,6 +40,15 @@ extern "C" {
 #define MIDI_ROUTER_COMBINED_WITH_SEQ 0
 #endif
 
+// enable this define in mios32_config.h to use a dispatch table which stores the nodes
+// for each source port (USB0..7, UART0..7, IIC0..7, OSC0..7) and MIDI channel, so that
+// MIDI_ROUTER_Receive() doesn't have to scan all nodes for each incoming package.
+// The application has to call MIDI_ROUTER_NodesChanged() whenever midi_router_node[] has been changed!
+// Allocates 32*17*4 bytes, only supported for up to 32 nodes
+#ifndef MIDI_ROUTER_DISPATCH_TABLE
+#define MIDI_ROUTER_DISPATCH_TABLE 0
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 // Type definitions
 /////////////////////////////////////////////////////////////////////////////
@@ -58,6 +67,8 @@ typedef struct {
 
 extern s32 MIDI_ROUTER_Init(u32 mode);
 
+extern s32 MIDI_ROUTER_NodesChanged(void);
+
 extern s32 MIDI_ROUTER_Receive(mios32_midi_port_t port, mios32_midi_package_t midi_package);
 extern s32 MIDI_ROUTER_ReceiveSysEx(mios32_midi_port_t port, u8 midi_in);
 
@@ -44,8 +44,25 @@ typedef struct {
   u32  chunk_end;
   u32  tick;
   u8   running_status;
+#if MID_PARSER_READ_BUFFER_SIZE
+  u8  *buffer;         // read-ahead window of this track
+  u32  buffer_pos;     // file position of the first byte in the window
+  u32  buffer_len;     // number of valid bytes in the window
+#endif
+#if MID_PARSER_INDEX_SIZE
+  u8   tempo[3];       // last Set Tempo meta event (0 if none)
+#endif
 } midi_track_t;
 
+#if MID_PARSER_INDEX_SIZE
+typedef struct {
+  u32  file_pos;
+  u32  tick;
+  u8   running_status;
+  u8   tempo[3];
+} mid_parser_index_entry_t;
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Local prototypes
@@ -53,6 +70,11 @@ typedef struct {
 
 static u32 MID_PARSER_ReadWord(u8 len);
 static u32 MID_PARSER_ReadVarLen(u32 *pos);
+static u32 MID_PARSER_TrackRead(midi_track_t *mt, u8 *buffer, u32 len);
+static u32 MID_PARSER_TrackReadVarLen(midi_track_t *mt);
+#if MID_PARSER_INDEX_SIZE
+static s32 MID_PARSER_IndexGenerate(void);
+#endif
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -69,6 +91,21 @@ static midi_track_t midi_tracks[MID_PARSER_MAX_TRACKS];
 
 static u8 meta_buffer[MID_PARSER_META_BUFFER_SIZE];
 
+// set by MID_PARSER_TrackRead() if the file couldn't be read
+static u8 track_read_error;
+
+#if MID_PARSER_READ_BUFFER_SIZE
+static u8 read_buffer[MID_PARSER_READ_BUFFER_SIZE];
+static u32 read_buffer_track_size;
+#endif
+
+#if MID_PARSER_INDEX_SIZE
+// checkpoint <n> of track <t> is stored in index_entries[n*midi_tracks_num + t]
+static mid_parser_index_entry_t index_entries[MID_PARSER_INDEX_SIZE];
+static u16 index_num;
+static u32 index_interval;
+#endif
+
 // callback functions
 static u32 (*mid_parser_read_callback)(void *buffer, u32 len);
 static s32 (*mid_parser_eof_callback)(void);
@@ -87,6 +124,10 @@ s32 MID_PARSER_Init(u32 mode)
 
   midi_tracks_num = 0;
 
+#if MID_PARSER_INDEX_SIZE
+  index_num = 0;
+#endif
+
   mid_parser_read_callback = NULL;
   mid_parser_eof_callback = NULL;
   mid_parser_seek_callback = NULL;
@@ -134,6 +175,9 @@ s32 MID_PARSER_Read(void)
 
   // invalidate current file
   file_valid = 0;
+#if MID_PARSER_INDEX_SIZE
+  index_num = 0;
+#endif
 
   if( mid_parser_read_callback == NULL ||
       mid_parser_eof_callback == NULL ||
@@ -240,8 +284,28 @@ s32 MID_PARSER_Read(void)
   if( num_tracks ); // avoid warning (unused variable...)
 #endif
 
+#if MID_PARSER_READ_BUFFER_SIZE
+  // distribute read-ahead buffer over all tracks
+  if( midi_tracks_num ) {
+    read_buffer_track_size = MID_PARSER_READ_BUFFER_SIZE / midi_tracks_num;
+
+    u8 track;
+    midi_track_t *mt = &midi_tracks[0];
+    for(track=0; track<midi_tracks_num; ++mt, ++track) {
+      mt->buffer = &read_buffer[track * read_buffer_track_size];
+      mt->buffer_pos = 0;
+      mt->buffer_len = 0;
+    }
+  }
+#endif
+
   file_valid = 1;
 
+#if MID_PARSER_INDEX_SIZE
+  // generate song position index
+  MID_PARSER_IndexGenerate();
+#endif
+
   return 0; // no error
 }
 
@@ -301,15 +365,22 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
       if( mt->tick >= (tick_offset + num_ticks) )
 	break;
 
+#if !MID_PARSER_READ_BUFFER_SIZE
       // set file pos
       mid_parser_seek_callback(mt->file_pos);
+#endif
 
       // get event
       u8 event;
-      mt->file_pos += mid_parser_read_callback(&event, 1);
+      track_read_error = 0;
+      MID_PARSER_TrackRead(mt, &event, 1);
+      if( track_read_error ) {
+	mt->file_pos = mt->chunk_end; // stop track
+	break;
+      }
 
       if( event == 0xf0 ) { // SysEx event
-	u32 length = (u32)MID_PARSER_ReadVarLen(&mt->file_pos);
+	u32 length = MID_PARSER_TrackReadVarLen(mt);
 #if DEBUG_VERBOSE_LEVEL >= 3
 	DEBUG_MSG("[MID_PARSER:%d:%u] SysEx event with %u bytes\n\r", track, mt->tick, length);
 #endif
@@ -320,20 +391,20 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 
 	// initial 0xf0
 	midi_package.evnt0 = 0xf0;
-	if( mid_parser_playevent_callback != NULL )
+	if( mid_parser_playevent_callback != NULL && !track_read_error )
 	  mid_parser_playevent_callback(track, midi_package, mt->tick);
 
 	// remaining bytes
 	int i;
 	for(i=0; i<length; ++i) {
 	  u8 evnt0;
-	  mt->file_pos += mid_parser_read_callback(&evnt0, 1);
+	  MID_PARSER_TrackRead(mt, &evnt0, 1);
 	  midi_package.evnt0 = evnt0;
-	  if( mid_parser_playevent_callback != NULL )
+	  if( mid_parser_playevent_callback != NULL && !track_read_error )
 	    mid_parser_playevent_callback(track, midi_package, mt->tick);
 	}
       } else if( event == 0xf7 ) { // "Escaped" event (allows to send any MIDI data)
-	u32 length = (u32)MID_PARSER_ReadVarLen(&mt->file_pos);
+	u32 length = MID_PARSER_TrackReadVarLen(mt);
 #if DEBUG_VERBOSE_LEVEL >= 3
 	DEBUG_MSG("[MID_PARSER:%d:%u] Escaped event with %u bytes\n\r", track, mt->tick, length);
 #endif
@@ -342,17 +413,17 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 	int i;
 	for(i=0; i<length; ++i) {
 	  u8 evnt0;
-	  mt->file_pos += mid_parser_read_callback(&evnt0, 1);
+	  MID_PARSER_TrackRead(mt, &evnt0, 1);
 	  midi_package.evnt0 = evnt0;
-	  if( mid_parser_playevent_callback != NULL )
+	  if( mid_parser_playevent_callback != NULL && !track_read_error )
 	    mid_parser_playevent_callback(track, midi_package, mt->tick);
 	}
       } else if( event == 0xff ) { // Meta Event
 	u8 meta;
-	mt->file_pos += mid_parser_read_callback(&meta, 1);
-	u32 length = (u32)MID_PARSER_ReadVarLen(&mt->file_pos);
+	MID_PARSER_TrackRead(mt, &meta, 1);
+	u32 length = MID_PARSER_TrackReadVarLen(mt);
 
-	if( mid_parser_playmeta_callback != NULL ) {
+	if( !track_read_error ) {
 	  u32 buflen = length;
 	  if( buflen > (MID_PARSER_META_BUFFER_SIZE-1) ) {
 	    buflen = MID_PARSER_META_BUFFER_SIZE - 1;
@@ -367,21 +438,28 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 
 	  if( buflen ) {
 	    // copy bytes into buffer
-	    mt->file_pos += mid_parser_read_callback(meta_buffer, buflen);
+	    MID_PARSER_TrackRead(mt, meta_buffer, buflen);
 
 	    if( length > buflen ) {
 	      // no free memory: dummy reads
 	      int i;
 	      u8 dummy;
 	      for(i=buflen; i<length; ++i)
-		mt->file_pos += mid_parser_read_callback(&dummy, 1);
+		MID_PARSER_TrackRead(mt, &dummy, 1);
 	    }
 	  }
 
 	  meta_buffer[buflen] = 0; // terminate with 0 for the case that a string has been transfered
-	  
+
+#if MID_PARSER_INDEX_SIZE
+	  // the song position index has to restore the tempo
+	  if( meta == 0x51 && buflen == 3 )
+	    memcpy(mt->tempo, meta_buffer, 3);
+#endif
+
 	  // -> forward to callback function
-	  mid_parser_playmeta_callback(track, meta, buflen, meta_buffer, mt->tick);
+	  if( mid_parser_playmeta_callback != NULL && !track_read_error )
+	    mid_parser_playmeta_callback(track, meta, buflen, meta_buffer, mt->tick);
 	}
       } else { // common MIDI event
 	mios32_midi_package_t midi_package;
@@ -390,7 +468,7 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 	  mt->running_status = event;
 	  midi_package.evnt0 = event;
 	  u8 evnt1;
-	  mt->file_pos += mid_parser_read_callback(&evnt1, 1);
+	  MID_PARSER_TrackRead(mt, &evnt1, 1);
 	  midi_package.evnt1 = evnt1;
 	} else {
 	  midi_package.evnt0 = mt->running_status;
@@ -406,10 +484,10 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 	  case PitchBend:
 	  {
 	    u8 evnt2;
-	    mt->file_pos += mid_parser_read_callback(&evnt2, 1);
+	    MID_PARSER_TrackRead(mt, &evnt2, 1);
 	    midi_package.evnt2 = evnt2;
 
-	    if( mid_parser_playevent_callback != NULL )
+	    if( mid_parser_playevent_callback != NULL && !track_read_error )
 	      mid_parser_playevent_callback(track, midi_package, mt->tick);
 #if DEBUG_VERBOSE_LEVEL >= 3
 	    DEBUG_MSG("[MID_PARSER:%d:%u] %02x%02x%02x\n\r", track, mt->tick, midi_package.evnt0, midi_package.evnt1, midi_package.evnt2);
@@ -418,7 +496,7 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 	  break;
 	  case ProgramChange:
 	  case Aftertouch:
-	    if( mid_parser_playevent_callback != NULL )
+	    if( mid_parser_playevent_callback != NULL && !track_read_error )
 	      mid_parser_playevent_callback(track, midi_package, mt->tick);
 #if DEBUG_VERBOSE_LEVEL >= 3
 	    DEBUG_MSG("[MID_PARSER:%d:%u] %02x%02x\n\r", track, mt->tick, midi_package.evnt0, midi_package.evnt1);
@@ -434,9 +512,15 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 
       // get delta length to next event if end of track hasn't been reached yet
       if( mt->file_pos < mt->chunk_end ) {
-	u32 delta = (u32)MID_PARSER_ReadVarLen(&mt->file_pos);
+	u32 delta = MID_PARSER_TrackReadVarLen(mt);
 	mt->tick += delta;
       }
+
+      // stop track if the file couldn't be read
+      if( track_read_error ) {
+	mt->file_pos = mt->chunk_end;
+	break;
+      }
     }
   }
 
@@ -486,6 +570,89 @@ static u32 MID_PARSER_ReadVarLen(u32 *pos)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Help function: reads bytes of a track
+// Without read-ahead buffer the file position has to be set before.
+// With read-ahead buffer the bytes are taken from the window of the track,
+// which is refilled with a single seek and read if required.
+// Sets track_read_error if the file couldn't be read
+/////////////////////////////////////////////////////////////////////////////
+static u32 MID_PARSER_TrackRead(midi_track_t *mt, u8 *buffer, u32 len)
+{
+#if MID_PARSER_READ_BUFFER_SIZE
+  u32 num_read = 0;
+
+  while( num_read < len ) {
+    u32 offset = mt->file_pos - mt->buffer_pos;
+
+    if( mt->file_pos < mt->buffer_pos || offset >= mt->buffer_len ) {
+      // refill window, don't read beyond the end of the track chunk
+      u32 window_len = read_buffer_track_size;
+      if( mt->file_pos > mt->chunk_end ) {
+	window_len = 0;
+      } else if( window_len > (mt->chunk_end - mt->file_pos + 1) ) {
+	window_len = mt->chunk_end - mt->file_pos + 1;
+      }
+
+      mt->buffer_pos = mt->file_pos;
+      mt->buffer_len = 0;
+      offset = 0;
+
+      if( !window_len ||
+	  mid_parser_seek_callback(mt->file_pos) < 0 ||
+	  mid_parser_read_callback(mt->buffer, window_len) != window_len ) {
+	track_read_error = 1;
+	memset(&buffer[num_read], 0, len - num_read);
+	return num_read;
+      }
+
+      mt->buffer_len = window_len;
+    }
+
+    u32 copy_len = mt->buffer_len - offset;
+    if( copy_len > (len - num_read) )
+      copy_len = len - num_read;
+
+    memcpy(&buffer[num_read], &mt->buffer[offset], copy_len);
+    num_read += copy_len;
+    mt->file_pos += copy_len;
+  }
+
+  return num_read;
+#else
+  u32 num_read = mid_parser_read_callback(buffer, len);
+  if( num_read != len ) {
+    track_read_error = 1;
+    return 0;
+  }
+
+  mt->file_pos += num_read;
+  return num_read;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Help function: reads a variable-length number of a track
+/////////////////////////////////////////////////////////////////////////////
+static u32 MID_PARSER_TrackReadVarLen(midi_track_t *mt)
+{
+  u32 value;
+  u8 c;
+
+  MID_PARSER_TrackRead(mt, &c, 1);
+  if( (value = c) & 0x80 ) {
+    value &= 0x7f;
+
+    do {
+      MID_PARSER_TrackRead(mt, &c, 1);
+      value = (value << 7) | (c & 0x7f);
+    } while( (c & 0x80) && !track_read_error );
+  }
+
+  return value;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Restarts a song w/o reading the .mid file chunks again (saves time)
 /////////////////////////////////////////////////////////////////////////////
@@ -498,8 +665,135 @@ s32 MID_PARSER_RestartSong(void)
     mt->file_pos = mt->initial_file_pos;
     mt->tick = mt->initial_tick;
     mt->running_status = 0x80;
+#if MID_PARSER_INDEX_SIZE
+    memset(mt->tempo, 0, 3);
+#endif
   }
 
   return 0; // no error
 }
 
+
+/////////////////////////////////////////////////////////////////////////////
+// Restarts a song and continues at the checkpoint of the song position index
+// which is located at or before the given tick.
+// Events between the returned tick and the requested tick have to be
+// fetched by the caller (e.g. silently to fast forward)
+// If the index is not available, the song is restarted from the beginning.
+// returns the tick from which MID_PARSER_FetchEvents() has to continue
+/////////////////////////////////////////////////////////////////////////////
+s32 MID_PARSER_IndexSeek(u32 tick)
+{
+  MID_PARSER_RestartSong();
+
+#if MID_PARSER_INDEX_SIZE
+  if( !file_valid || !index_num )
+    return 0; // no index available
+
+  u32 checkpoint = tick / index_interval;
+  if( checkpoint >= index_num )
+    checkpoint = index_num - 1;
+  u32 checkpoint_tick = checkpoint * index_interval;
+
+  u8 track = 0;
+  midi_track_t *mt = &midi_tracks[0];
+  mid_parser_index_entry_t *entry = &index_entries[checkpoint * midi_tracks_num];
+  for(track=0; track<midi_tracks_num; ++mt, ++entry, ++track) {
+    mt->file_pos = entry->file_pos;
+    mt->tick = entry->tick;
+    mt->running_status = entry->running_status;
+    memcpy(mt->tempo, entry->tempo, 3);
+
+    // the skipped tempo changes would have been played while fast forwarding:
+    // forward the last one to the callback function
+    if( (mt->tempo[0] || mt->tempo[1] || mt->tempo[2]) && mid_parser_playmeta_callback != NULL ) {
+      memcpy(meta_buffer, mt->tempo, 3);
+      meta_buffer[3] = 0;
+      mid_parser_playmeta_callback(track, 0x51, 3, meta_buffer, checkpoint_tick);
+    }
+  }
+
+#if DEBUG_VERBOSE_LEVEL >= 1
+  DEBUG_MSG("[MID_PARSER] seek to tick %u continues at checkpoint %u (tick %u)\n\r", tick, checkpoint, checkpoint_tick);
+#endif
+
+  return checkpoint_tick;
+#else
+  return 0; // no index available
+#endif
+}
+
+
+#if MID_PARSER_INDEX_SIZE
+/////////////////////////////////////////////////////////////////////////////
+// Help function: parses the whole song and stores the track positions at
+// each checkpoint of the song position index
+/////////////////////////////////////////////////////////////////////////////
+static s32 MID_PARSER_IndexGenerate(void)
+{
+  index_num = 0;
+  index_interval = midifile_ppqn ? midifile_ppqn : 384;
+
+  if( !midi_tracks_num )
+    return -1; // no tracks
+
+  u16 max_checkpoints = MID_PARSER_INDEX_SIZE / midi_tracks_num;
+  if( !max_checkpoints )
+    return -2; // too many tracks
+
+  // events shouldn't be played while the song is parsed
+  s32 (*playevent_callback)(u8 track, mios32_midi_package_t midi_package, u32 tick) = mid_parser_playevent_callback;
+  s32 (*playmeta_callback)(u8 track, u8 meta, u32 len, u8 *buffer, u32 tick) = mid_parser_playmeta_callback;
+  mid_parser_playevent_callback = NULL;
+  mid_parser_playmeta_callback = NULL;
+
+  MID_PARSER_RestartSong();
+
+  u32 tick = 0;
+  while( 1 ) {
+    u32 next_tick = index_num * index_interval;
+    if( next_tick > tick ) {
+      s32 status = MID_PARSER_FetchEvents(tick, next_tick - tick);
+      tick = next_tick;
+      if( status <= 0 )
+	break; // end of song reached
+    }
+
+    if( index_num >= max_checkpoints ) {
+      // index full: double the interval and drop every second checkpoint
+      u16 checkpoint;
+      for(checkpoint=1; (2*checkpoint)<index_num; ++checkpoint)
+	memcpy(&index_entries[checkpoint * midi_tracks_num],
+	       &index_entries[2 * checkpoint * midi_tracks_num],
+	       midi_tracks_num * sizeof(mid_parser_index_entry_t));
+      index_num = checkpoint;
+      index_interval *= 2;
+      continue;
+    }
+
+    // store track positions
+    u8 track = 0;
+    midi_track_t *mt = &midi_tracks[0];
+    mid_parser_index_entry_t *entry = &index_entries[index_num * midi_tracks_num];
+    for(track=0; track<midi_tracks_num; ++mt, ++entry, ++track) {
+      entry->file_pos = mt->file_pos;
+      entry->tick = mt->tick;
+      entry->running_status = mt->running_status;
+      memcpy(entry->tempo, mt->tempo, 3);
+    }
+    ++index_num;
+  }
+
+  mid_parser_playevent_callback = playevent_callback;
+  mid_parser_playmeta_callback = playmeta_callback;
+
+  MID_PARSER_RestartSong();
+
+#if DEBUG_VERBOSE_LEVEL >= 1
+  DEBUG_MSG("[MID_PARSER] song position index: %u checkpoints, interval %u ticks\n\r", index_num, index_interval);
+#endif
+
+  return 0; // no error
+}
+#endif
+
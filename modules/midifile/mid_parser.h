@@ -27,6 +27,24 @@
 #define MID_PARSER_META_BUFFER_SIZE 80
 #endif
 
+// read-ahead buffer which is shared between all tracks
+// each track streams its events from an own window of
+// MID_PARSER_READ_BUFFER_SIZE / <number of tracks> bytes, so that the file is
+// accessed with a single seek and read per window instead of each byte
+// 0 disables the buffer
+#ifndef MID_PARSER_READ_BUFFER_SIZE
+#define MID_PARSER_READ_BUFFER_SIZE 0
+#endif
+
+// optional song position index, generated by MID_PARSER_Read()
+// number of entries (one entry per track and checkpoint), each entry allocates 12 bytes
+// the checkpoint interval starts at one quarter note and is doubled whenever
+// the index is full, so that long songs are covered as well
+// 0 disables the index
+#ifndef MID_PARSER_INDEX_SIZE
+#define MID_PARSER_INDEX_SIZE 0
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Global Types
@@ -46,6 +64,7 @@ extern s32 MID_PARSER_FileIsValid(void);
 extern s32 MID_PARSER_Read(void);
 extern s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks);
 extern s32 MID_PARSER_RestartSong(void);
+extern s32 MID_PARSER_IndexSeek(u32 tick);
 
 extern s32 MIDI_PARSER_FormatGet(void);
 extern s32 MIDI_PARSER_PPQN_Get(void);
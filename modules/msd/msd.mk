@@ -20,6 +20,13 @@ THUMB_SOURCE += \
 	$(MIOS32_PATH)/modules/msd/STM32F4xx/msd.c
 endif
 
+# the STM32F4xx variant is a dummy, it's re-used for the LINUX family
+ifeq ($(FAMILY),LINUX)
+C_INCLUDE += -I $(MIOS32_PATH)/modules/msd/STM32F4xx
+THUMB_SOURCE += \
+	$(MIOS32_PATH)/modules/msd/STM32F4xx/msd.c
+endif
+
 ifeq ($(FAMILY),LPC17xx)
 C_INCLUDE += -I $(MIOS32_PATH)/modules/msd/LPC17xx
 THUMB_SOURCE += \
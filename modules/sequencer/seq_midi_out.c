@@ -22,7 +22,7 @@
 #include "seq_midi_out.h"
 #include "seq_bpm.h"
 
-#if SEQ_MIDI_OUT_MALLOC_METHOD != 5
+#if SEQ_MIDI_OUT_SCHEDULER == 0 && SEQ_MIDI_OUT_MALLOC_METHOD != 5
 // FreeRTOS based malloc required
 #include <FreeRTOS.h>
 #endif
@@ -48,7 +48,11 @@ typedef struct seq_midi_out_queue_item_t {
   u16                   len;
   mios32_midi_package_t package;
   u32                   timestamp;
+#if SEQ_MIDI_OUT_SCHEDULER == 1
+  u32                   seq; // insertion order, keeps events with same timestamp and priority in FIFO order
+#else
   struct seq_midi_out_queue_item_t *next;
+#endif
 } seq_midi_out_queue_item_t;
 
 
@@ -56,8 +60,14 @@ typedef struct seq_midi_out_queue_item_t {
 // Local prototypes
 /////////////////////////////////////////////////////////////////////////////
 
+#if SEQ_MIDI_OUT_SCHEDULER == 1
+static void SEQ_MIDI_OUT_HeapSiftUp(u32 ix);
+static void SEQ_MIDI_OUT_HeapSiftDown(u32 ix);
+static void SEQ_MIDI_OUT_HeapRemoveFirst(void);
+#else
 static seq_midi_out_queue_item_t *SEQ_MIDI_OUT_SlotMalloc(void);
 static void SEQ_MIDI_OUT_SlotFree(seq_midi_out_queue_item_t *item);
+#endif
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -83,10 +93,33 @@ static s32 (*callback_bpm_is_running)(void);
 static u32 (*callback_bpm_tick_get)(void);
 static s32 (*callback_bpm_set)(float bpm);
 
+#if SEQ_MIDI_OUT_SCHEDULER == 1
+
+// binary min-heap, ordered by timestamp, event priority and insertion order
+// the root (heap[0]) is always the next event which has to be played
+static seq_midi_out_queue_item_t heap[SEQ_MIDI_OUT_MAX_EVENTS];
+static u32 heap_num;
+static u32 heap_seq;
+
+// priority of events with the same timestamp:
+// Clock and Tempo events are played first, then CCs, then notes in the order they have been queued
+static const u8 heap_event_prio[] = {
+  0, // SEQ_MIDI_OUT_ClkEvent
+  0, // SEQ_MIDI_OUT_TempoEvent
+  1, // SEQ_MIDI_OUT_CCEvent
+  2, // SEQ_MIDI_OUT_OnEvent
+  2, // SEQ_MIDI_OUT_OffEvent
+  2, // SEQ_MIDI_OUT_OnOffEvent
+};
+
+#else
+
 static seq_midi_out_queue_item_t *midi_queue;
 
+#endif
+
 
-#if SEQ_MIDI_OUT_MALLOC_METHOD >= 0 && SEQ_MIDI_OUT_MALLOC_METHOD <= 3
+#if SEQ_MIDI_OUT_SCHEDULER == 0 && SEQ_MIDI_OUT_MALLOC_METHOD >= 0 && SEQ_MIDI_OUT_MALLOC_METHOD <= 3
 
 // determine flag array width and mask
 #if SEQ_MIDI_OUT_MALLOC_METHOD == 0
@@ -313,6 +346,39 @@ s32 SEQ_MIDI_OUT_Send(mios32_midi_port_t port, mios32_midi_package_t midi_packag
   }
 #endif
 
+#if SEQ_MIDI_OUT_SCHEDULER == 1
+  // is there still a free slot?
+  if( heap_num >= SEQ_MIDI_OUT_MAX_EVENTS ) {
+#if SEQ_MIDI_OUT_MALLOC_ANALYSIS
+    ++seq_midi_out_dropouts;
+#endif
+    return -1; // allocation error
+  }
+
+#if DEBUG_VERBOSE_LEVEL >= 2
+#if DEBUG_VERBOSE_LEVEL == 2
+  if( event_type != SEQ_MIDI_OUT_ClkEvent )
+#endif
+  DEBUG_MSG("[SEQ_MIDI_OUT_Send:%u] (tag %d) %02x %02x %02x len:%u @%u\n", timestamp, midi_package.cable, midi_package.evnt0, midi_package.evnt1, midi_package.evnt2, len, SEQ_BPM_TickGet());
+#endif
+
+  // add item to the end of the heap, and move it up to its sorted position
+  seq_midi_out_queue_item_t *new_item = &heap[heap_num];
+  new_item->port = port;
+  new_item->package = midi_package;
+  new_item->event_type = event_type;
+  new_item->timestamp = timestamp;
+  new_item->len = len;
+  new_item->seq = heap_seq++;
+  SEQ_MIDI_OUT_HeapSiftUp(heap_num++);
+
+  seq_midi_out_allocated = heap_num;
+#if SEQ_MIDI_OUT_MALLOC_ANALYSIS
+  if( seq_midi_out_allocated > seq_midi_out_max_allocated )
+    seq_midi_out_max_allocated = seq_midi_out_allocated;
+#endif
+
+#else
   // create new item
   seq_midi_out_queue_item_t *new_item;
   if( (new_item=SEQ_MIDI_OUT_SlotMalloc()) == NULL ) {
@@ -401,6 +467,7 @@ s32 SEQ_MIDI_OUT_Send(mios32_midi_port_t port, mios32_midi_package_t midi_packag
       new_item->next = next_item;
     }
   }
+#endif
 
   // schedule off event now if length > 16bit (since it cannot be stored in event record)
   if( event_type == SEQ_MIDI_OUT_OnOffEvent && len > 0xffff ) {
@@ -408,7 +475,7 @@ s32 SEQ_MIDI_OUT_Send(mios32_midi_port_t port, mios32_midi_package_t midi_packag
   }
 
   // display queue
-#if DEBUG_VERBOSE_LEVEL >= 4
+#if DEBUG_VERBOSE_LEVEL >= 4 && SEQ_MIDI_OUT_SCHEDULER == 0
   DEBUG_MSG("--- vvv ---\n");
   item=midi_queue;
   while( item != NULL ) {
@@ -448,6 +515,43 @@ s32 SEQ_MIDI_OUT_Send(mios32_midi_port_t port, mios32_midi_package_t midi_packag
 /////////////////////////////////////////////////////////////////////////////
 s32 SEQ_MIDI_OUT_ReSchedule(u8 tag, seq_midi_out_event_type_t event_type, u32 timestamp, u32 *reschedule_filter)
 {
+#if SEQ_MIDI_OUT_SCHEDULER == 1
+  // search in heap for items with the given tag
+  // the timestamp of matching items is changed in place; since it can only be decreased,
+  // the item only has to be moved up, which never affects items which haven't been checked yet
+  u32 ix;
+  for(ix=0; ix<heap_num; ++ix) {
+    seq_midi_out_queue_item_t *item = &heap[ix];
+    u8 evnt1 = item->package.evnt1;
+    if( (item->event_type == event_type) && (item->package.cable == tag) &&
+	(reschedule_filter == NULL ||
+	 !(reschedule_filter[evnt1>>5] & (1 << (evnt1 & 0x1f)))) ) {
+
+      u32 delayed_timestamp = timestamp;
+#if SEQ_MIDI_OUT_SUPPORT_DELAY
+      if( item->port < PPQN_DELAY_NUM ) {
+	s8 delay = ppqn_delay[item->port];
+	if( (delay < 0) && (delayed_timestamp < -delay) ) {
+	  delayed_timestamp = 0;
+	} else {
+	  delayed_timestamp += delay;
+	}
+      }
+#endif
+      if( item->timestamp <= delayed_timestamp )
+	continue;
+
+#if DEBUG_VERBOSE_LEVEL >= 2
+      DEBUG_MSG("[SEQ_MIDI_OUT_ReSchedule:%u] (tag %d) %02x %02x %02x @%u\n", timestamp, item->package.cable, item->package.evnt0, item->package.evnt1, item->package.evnt2, SEQ_BPM_TickGet());
+#endif
+
+      // re-schedule item at new timestamp (queued behind events which already have been scheduled for this timestamp)
+      item->timestamp = delayed_timestamp;
+      item->seq = heap_seq++;
+      SEQ_MIDI_OUT_HeapSiftUp(ix);
+    }
+  }
+#else
   // search in queue for items with the given tag
 
   seq_midi_out_queue_item_t *prev_item = NULL;
@@ -535,6 +639,7 @@ s32 SEQ_MIDI_OUT_ReSchedule(u8 tag, seq_midi_out_event_type_t event_type, u32 ti
       item = item->next;
     }
   }
+#endif
 
   return 0; // no error
 }
@@ -546,6 +651,17 @@ s32 SEQ_MIDI_OUT_ReSchedule(u8 tag, seq_midi_out_event_type_t event_type, u32 ti
 /////////////////////////////////////////////////////////////////////////////
 s32 SEQ_MIDI_OUT_FlushQueue(void)
 {
+#if SEQ_MIDI_OUT_SCHEDULER == 1
+  while( heap_num ) {
+    seq_midi_out_queue_item_t *item = &heap[0];
+    if( item->event_type == SEQ_MIDI_OUT_OffEvent || item->event_type == SEQ_MIDI_OUT_OnOffEvent ) {
+      item->package.velocity = 0; // ensure that velocity is 0
+      callback_midi_send_package(item->port, item->package);
+    }
+
+    SEQ_MIDI_OUT_HeapRemoveFirst();
+  }
+#else
   seq_midi_out_queue_item_t *item;
   while( (item=midi_queue) != NULL ) {
     if( item->event_type == SEQ_MIDI_OUT_OffEvent || item->event_type == SEQ_MIDI_OUT_OnOffEvent ) {
@@ -556,6 +672,7 @@ s32 SEQ_MIDI_OUT_FlushQueue(void)
     midi_queue = item->next;
     SEQ_MIDI_OUT_SlotFree(item);
   }
+#endif
 
   return 0; // no error
 }
@@ -567,6 +684,12 @@ s32 SEQ_MIDI_OUT_FlushQueue(void)
 /////////////////////////////////////////////////////////////////////////////
 s32 SEQ_MIDI_OUT_FreeHeap(void)
 {
+#if SEQ_MIDI_OUT_SCHEDULER == 1
+  // slots are allocated statically, just drop all items
+  heap_num = 0;
+  heap_seq = 0;
+  seq_midi_out_allocated = 0;
+#else
   // ensure that all items are delocated
   seq_midi_out_queue_item_t *item;
   while( (item=midi_queue) != NULL ) {
@@ -591,6 +714,7 @@ s32 SEQ_MIDI_OUT_FreeHeap(void)
   int i;
   for(i=0; i<(SEQ_MIDI_OUT_MAX_EVENTS/SEQ_MIDI_OUT_MALLOC_FLAG_WIDTH); ++i)
     alloc_flags[i] = 0;
+#endif
 #endif
 
   return 0; // no error
@@ -613,6 +737,37 @@ s32 SEQ_MIDI_OUT_Handler(void)
   // note that we are going through a sorted list, therefore we can exit once a timestamp
   // has been found which has to be played later than now
 
+#if SEQ_MIDI_OUT_SCHEDULER == 1
+  seq_midi_out_queue_item_t *item = &heap[0];
+  while( heap_num && item->timestamp <= callback_bpm_tick_get() ) {
+#if DEBUG_VERBOSE_LEVEL >= 2
+#if DEBUG_VERBOSE_LEVEL == 2
+    if( item->event_type != SEQ_MIDI_OUT_ClkEvent )
+#endif
+    DEBUG_MSG("[SEQ_MIDI_OUT_Handler:%u] (tag %d) %02x %02x %02x @%u\n", item->timestamp, item->package.cable, item->package.evnt0, item->package.evnt1, item->package.evnt2, SEQ_BPM_TickGet());
+#endif
+
+    // if tempo event: change BPM stored in midi_package.ALL
+    if( item->event_type == SEQ_MIDI_OUT_TempoEvent ) {
+      callback_bpm_set(item->package.ALL);
+    } else {
+      callback_midi_send_package(item->port, item->package);
+    }
+
+    if( item->event_type == SEQ_MIDI_OUT_OnOffEvent && item->len ) {
+      // schedule Off event by re-using the slot: the port delay is already part of the timestamp
+      item->event_type = SEQ_MIDI_OUT_OffEvent;
+      item->package.velocity = 0; // ensure that velocity is 0
+      item->timestamp += item->len;
+      item->len = 0;
+      item->seq = heap_seq++;
+      SEQ_MIDI_OUT_HeapSiftDown(0);
+    } else {
+      // remove item from heap
+      SEQ_MIDI_OUT_HeapRemoveFirst();
+    }
+  }
+#else
   seq_midi_out_queue_item_t *item;
   while( (item=midi_queue) != NULL && item->timestamp <= callback_bpm_tick_get() ) {
 #if DEBUG_VERBOSE_LEVEL >= 2
@@ -670,11 +825,94 @@ s32 SEQ_MIDI_OUT_Handler(void)
       SEQ_MIDI_OUT_SlotFree(item);
     }
   }
+#endif
 
   return 0; // no error
 }
 
 
+#if SEQ_MIDI_OUT_SCHEDULER == 1
+/////////////////////////////////////////////////////////////////////////////
+// Local function which returns != 0 if item a has to be played before item b
+/////////////////////////////////////////////////////////////////////////////
+static inline u8 SEQ_MIDI_OUT_HeapBefore(seq_midi_out_queue_item_t *a, seq_midi_out_queue_item_t *b)
+{
+  if( a->timestamp != b->timestamp )
+    return a->timestamp < b->timestamp;
+
+  u8 prio_a = heap_event_prio[a->event_type];
+  u8 prio_b = heap_event_prio[b->event_type];
+  if( prio_a != prio_b )
+    return prio_a < prio_b;
+
+  return (s32)(a->seq - b->seq) < 0; // takes care for overrun of the sequence counter
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function which moves a heap item up until its parent is played earlier
+/////////////////////////////////////////////////////////////////////////////
+static void SEQ_MIDI_OUT_HeapSiftUp(u32 ix)
+{
+  seq_midi_out_queue_item_t item = heap[ix];
+
+  while( ix > 0 ) {
+    u32 parent_ix = (ix - 1) / 2;
+    if( !SEQ_MIDI_OUT_HeapBefore(&item, &heap[parent_ix]) )
+      break;
+    heap[ix] = heap[parent_ix];
+    ix = parent_ix;
+  }
+
+  heap[ix] = item;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function which moves a heap item down until its children are played later
+/////////////////////////////////////////////////////////////////////////////
+static void SEQ_MIDI_OUT_HeapSiftDown(u32 ix)
+{
+  seq_midi_out_queue_item_t item = heap[ix];
+
+  while( 1 ) {
+    u32 child_ix = 2*ix + 1;
+    if( child_ix >= heap_num )
+      break;
+
+    if( (child_ix+1) < heap_num && SEQ_MIDI_OUT_HeapBefore(&heap[child_ix+1], &heap[child_ix]) )
+      ++child_ix;
+
+    if( !SEQ_MIDI_OUT_HeapBefore(&heap[child_ix], &item) )
+      break;
+
+    heap[ix] = heap[child_ix];
+    ix = child_ix;
+  }
+
+  heap[ix] = item;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function which removes the root item (the next event) from the heap
+/////////////////////////////////////////////////////////////////////////////
+static void SEQ_MIDI_OUT_HeapRemoveFirst(void)
+{
+  if( !heap_num )
+    return;
+
+  if( --heap_num ) {
+    heap[0] = heap[heap_num];
+    SEQ_MIDI_OUT_HeapSiftDown(0);
+  }
+
+  seq_midi_out_allocated = heap_num;
+}
+
+#else
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Local function to allocate memory
 // returns NULL if no memory free
@@ -854,6 +1092,7 @@ static void SEQ_MIDI_OUT_SlotFree(seq_midi_out_queue_item_t *item)
   }
 #endif
 }
+#endif
 
 #if SEQ_MIDI_OUT_SUPPORT_DELAY
 /////////////////////////////////////////////////////////////////////////////
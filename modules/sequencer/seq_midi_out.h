@@ -23,6 +23,15 @@ extern "C" {
 // Global definitions
 /////////////////////////////////////////////////////////////////////////////
 
+// scheduler backend:
+// 0: timestamp sorted linked list (insertion cost grows with the queue depth)
+// 1: binary min-heap over a static slot array (O(log n) insertion and dispatch)
+//    SEQ_MIDI_OUT_MALLOC_METHOD is ignored in this mode, the slots are allocated
+//    statically (SEQ_MIDI_OUT_MAX_EVENTS * 16 bytes)
+#ifndef SEQ_MIDI_OUT_SCHEDULER
+#define SEQ_MIDI_OUT_SCHEDULER 0
+#endif
+
 // memory alloccation method:
 // 0: internal static allocation with one byte for each flag
 // 1: internal static allocation with 8bit flags
@@ -56,6 +56,14 @@
 #define MBNET_TX_STATE_DONE  9
 #endif
 
+// update order of the registers:
+// voice 1/2/3 w/o osc control registers, voice 1/2/3 control registers,
+// remaining SID registers and SwinSID registers
+// each group is transfered in ascending order
+#define UPDATE_MASK_OSC_CTRL  ((1 << 4) | (1 << 11) | (1 << 18))
+#define UPDATE_MASK_VOICES    (0x001fffff & ~UPDATE_MASK_OSC_CTRL)
+#define UPDATE_MASK_REMAINING 0xffe00000
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Global variables
@@ -63,6 +71,10 @@
 
 sid_regs_t sid_regs[SID_NUM];
 
+#if SID_DIRTY_BITMAP
+u32 sid_regs_dirty[SID_NUM]; // registers marked by SID_RegSet() and SID_RegDirtySet()
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Local variables
@@ -73,15 +85,6 @@ static sid_regs_t sid_regs_shadow[SID_NUM]; // to determine register changes
 static u32 sid_regs_shadow_updated[SID_NUM];
 #endif
 
-static const u8 update_order[SID_REGS_NUM] = { 
-   0,  1,  2,  3,  5,  6, // voice 1 w/o osc control register
-   7,  8,  9, 10, 12, 13, // voice 2 w/o osc control register
-  14, 15, 16, 17, 19, 20, // voice 3 w/o osc control register
-   4, 11, 18,             // voice 1/2/3 control registers
-  21, 22, 23, 24,         // remaining SID registers
-  25, 26, 27, 28, 29, 30, 31 // SwinSID registers
-};
-
 static u8 sid_available;
 
 #if SID_USE_MBNET
@@ -136,7 +139,10 @@ typedef struct {
 /////////////////////////////////////////////////////////////////////////////
 
 #if !SID_USE_MBNET
-static inline void SID_UpdateReg(sid_cs_pin_t *cs_pin0, sid_cs_pin_t *cs_pin1, u8 cs, u8 addr, u8 data, u8 reset);
+static inline void SID_UpdateReg(sid_cs_pin_t *cs_pin0, sid_cs_pin_t *cs_pin1, u16 cs, u8 addr, u8 data, u8 reset);
+#ifdef SID_UPDATE_REG_HOOK
+extern void SID_UPDATE_REG_HOOK(u16 cs, u8 addr, u8 data, u8 reset);
+#endif
 #else
 s32 SID_MBNET_TxHandler(mbnet_id_t *mbnet_id, mbnet_msg_t *msg, u8 *dlc);
 #endif
@@ -268,6 +274,9 @@ s32 SID_Init(u32 mode)
     }
 #if SID_USE_MBNET
     sid_regs_shadow_updated[sid] = 0xffffffff;
+#endif
+#if SID_DIRTY_BITMAP
+    sid_regs_dirty[sid] = 0;
 #endif
   }
 
@@ -315,6 +324,28 @@ u8 SID_AvailableGet(void)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Returns the registers of a SID which have to be checked by SID_Update(),
+// and clears the dirty flags
+/////////////////////////////////////////////////////////////////////////////
+static inline u32 SID_DirtyGet(int sid, u32 mode)
+{
+#if SID_DIRTY_BITMAP
+  if( sid >= SID_NUM )
+    return 0;
+
+  MIOS32_IRQ_Disable();
+  u32 dirty = sid_regs_dirty[sid];
+  sid_regs_dirty[sid] = 0;
+  MIOS32_IRQ_Enable();
+
+  return (mode >= 1) ? SID_REGS_MASK_ALL : dirty;
+#else
+  return SID_REGS_MASK_ALL;
+#endif
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Updates all SID registers
 // IN: <mode>: if 0: only register changes will be transfered to SID(s)
@@ -335,18 +366,23 @@ s32 SID_Update(u32 mode)
   }
 
   // transfer SID registers to shadow registers and check for updates
-  MIOS32_IRQ_Disable();
   for(sid=0; sid<SID_NUM; ++sid) {
     u8 *regs = (u8 *)&sid_regs[sid];
     u8 *regs_shadow = (u8 *)&sid_regs_shadow[sid];
+    u32 dirty = SID_DirtyGet(sid, mode);
 
-    for(reg=0; reg<SID_REGS_NUM; ++reg) {
-      if( *regs_shadow != *regs )
+    MIOS32_IRQ_Disable();
+    while( dirty ) {
+      reg = __builtin_ctz(dirty);
+      dirty &= dirty - 1;
+
+      if( regs_shadow[reg] != regs[reg] ) {
 	sid_regs_shadow_updated[sid] |= (1 << reg);
-      *regs_shadow++ = *regs++;
+	regs_shadow[reg] = regs[reg];
+      }
     }
+    MIOS32_IRQ_Enable();
   }
-  MIOS32_IRQ_Enable();
 
   // trigger next update
   if( mbnet_tx_state == MBNET_TX_STATE_DONE && sid_available ) {
@@ -470,14 +506,15 @@ s32 SID_Update(u32 mode)
   // this loop should run so fast as possible, 
   // we consider to update two SIDs at once if values are identical
   for(sid=0; sid<SID_NUM; sid+=2) {
-    u8 *update_order_ptr = (u8 *)&update_order[0];
+    u32 dirty = SID_DirtyGet(sid+0, mode) | SID_DirtyGet(sid+1, mode);
+    u32 update_mask[3] = { dirty & UPDATE_MASK_VOICES, dirty & UPDATE_MASK_OSC_CTRL, dirty & UPDATE_MASK_REMAINING };
     u8 *sidl = (u8 *)&sid_regs[sid+0].ALL[0];
     u8 *sidl_shadow = (u8 *)&sid_regs_shadow[sid+0].ALL[0];
     u8 *sidr = (u8 *)&sid_regs[sid+1].ALL[0];
     u8 *sidr_shadow = (u8 *)&sid_regs_shadow[sid+1].ALL[0];
-    u8 cs_both = (3 << (2*sid));
-    u8 cs_l_only = (1 << (2*sid));
-    u8 cs_r_only = (2 << (2*sid));
+    u16 cs_both = (3 << (2*sid)); // (u16: SID_NUM up to 8)
+    u16 cs_l_only = (1 << (2*sid));
+    u16 cs_r_only = (2 << (2*sid));
 #if defined(MIOS32_FAMILY_STM32F10x)
     sid_cs_pin_t *cs_pin0 = (sid_cs_pin_t *)&sid_cs_pin[2*sid+0];
     sid_cs_pin_t *cs_pin1 = (sid_cs_pin_t *)&sid_cs_pin[2*sid+1];
@@ -486,33 +523,38 @@ s32 SID_Update(u32 mode)
     sid_cs_pin_t *cs_pin1 = NULL;
 #endif
 
-    for(i=0; i<SID_REGS_NUM; ++i, update_order_ptr++) {
-      u8 data;
+    for(i=0; i<3; ++i) {
+      u32 mask = update_mask[i];
+      while( mask ) {
+	u8 data;
 
-      reg = *update_order_ptr;
-
-      // check if update of left/right channel SID are required
-      // partly duplicated code ensures best performance in all cases!
-      if( (data=sidl[reg]) != sidl_shadow[reg] ) {
-	// check if the value of the second SID is identical
-	if( data == sidr[reg] ) {
-	  SID_UpdateReg(cs_pin0, cs_pin1, cs_both, reg, data, 0); // CS lines, address, data, reset
-	  sidl_shadow[reg] = data;
-	  sidr_shadow[reg] = data;
-	} else {
-	  SID_UpdateReg(cs_pin0, NULL, cs_l_only, reg, data, 0); // CS lines, address, data, reset
-	  sidl_shadow[reg] = data;
+	// next register in update order
+	reg = __builtin_ctz(mask);
+	mask &= mask - 1;
 
-	  if( (data=sidr[reg]) != sidr_shadow[reg] ) {
-	    // individual update for second SID required
-	    SID_UpdateReg(cs_pin1, NULL, cs_r_only, reg, data, 0); // CS lines, address, data, reset
+	// check if update of left/right channel SID are required
+	// partly duplicated code ensures best performance in all cases!
+	if( (data=sidl[reg]) != sidl_shadow[reg] ) {
+	  // check if the value of the second SID is identical
+	  if( data == sidr[reg] ) {
+	    SID_UpdateReg(cs_pin0, cs_pin1, cs_both, reg, data, 0); // CS lines, address, data, reset
+	    sidl_shadow[reg] = data;
 	    sidr_shadow[reg] = data;
+	  } else {
+	    SID_UpdateReg(cs_pin0, NULL, cs_l_only, reg, data, 0); // CS lines, address, data, reset
+	    sidl_shadow[reg] = data;
+
+	    if( (data=sidr[reg]) != sidr_shadow[reg] ) {
+	      // individual update for second SID required
+	      SID_UpdateReg(cs_pin1, NULL, cs_r_only, reg, data, 0); // CS lines, address, data, reset
+	      sidr_shadow[reg] = data;
+	    }
 	  }
+	} else if( (data=sidr[reg]) != sidr_shadow[reg] ) {
+	  // individual update for second SID required
+	  SID_UpdateReg(cs_pin1, NULL, cs_r_only, reg, data, 0); // CS lines, address, data, reset
+	  sidr_shadow[reg] = data;
 	}
-      } else if( (data=sidr[reg]) != sidr_shadow[reg] ) {
-	// individual update for second SID required
-	SID_UpdateReg(cs_pin1, NULL, cs_r_only, reg, data, 0); // CS lines, address, data, reset
-	sidr_shadow[reg] = data;
       }
     }
   }
@@ -530,7 +572,7 @@ s32 SID_Update(u32 mode)
 //     reset pin in <reset> (inversion done internally)
 // OUT: -
 /////////////////////////////////////////////////////////////////////////////
-static inline void SID_UpdateReg(sid_cs_pin_t *cs_pin0, sid_cs_pin_t *cs_pin1, u8 cs, u8 addr, u8 data, u8 reset)
+static inline void SID_UpdateReg(sid_cs_pin_t *cs_pin0, sid_cs_pin_t *cs_pin1, u16 cs, u8 addr, u8 data, u8 reset)
 {
 #ifdef SIDEMU_ENABLED
   // currently only single SID available
@@ -538,6 +580,11 @@ static inline void SID_UpdateReg(sid_cs_pin_t *cs_pin0, sid_cs_pin_t *cs_pin1, u
     SIDEMU_setRegister(addr, data);
 #endif
 
+#ifdef SID_UPDATE_REG_HOOK
+  // optional hook which gets all register transfers (e.g. to record them in host builds)
+  SID_UPDATE_REG_HOOK(cs, addr, data, reset);
+#endif
+
 #ifdef MIOS32_FAMILY_STM32F10x
   // low-active reset is connected to "A6" of the first SR
   if( !reset )
@@ -123,6 +123,22 @@ extern "C" {
 #endif
 
 
+// if enabled, SID_Update(0) only checks the registers which have been marked
+// with SID_RegSet() or SID_RegDirtySet() since the last update, instead of
+// comparing all SID_REGS_NUM registers of all SIDs.
+// Note: all writers to sid_regs[] have to mark their changes in this mode!
+#ifndef SID_DIRTY_BITMAP
+#define SID_DIRTY_BITMAP 0
+#endif
+
+
+// register masks for SID_RegDirtySet()
+#define SID_REGS_MASK_VOICE(v) ((u32)0x7f << (7*(v)))  // voice 0..2
+#define SID_REGS_MASK_FILTER   ((u32)0x0f << 21)
+#define SID_REGS_MASK_SWINSID  ((u32)0x7f << 25)
+#define SID_REGS_MASK_ALL      0xffffffff
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Global Types
 /////////////////////////////////////////////////////////////////////////////
@@ -214,6 +230,30 @@ extern s32 SID_PrintStatistics(void);
 
 extern sid_regs_t sid_regs[SID_NUM];
 
+#if SID_DIRTY_BITMAP
+extern u32 sid_regs_dirty[SID_NUM];
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Inline functions
+/////////////////////////////////////////////////////////////////////////////
+
+// marks registers of a SID which have been changed directly in sid_regs[]
+static inline void SID_RegDirtySet(u8 sid, u32 reg_mask)
+{
+#if SID_DIRTY_BITMAP
+  sid_regs_dirty[sid] |= reg_mask;
+#endif
+}
+
+// sets a SID register and marks it for the next SID_Update()
+static inline void SID_RegSet(u8 sid, u8 reg, u8 value)
+{
+  sid_regs[sid].ALL[reg] = value;
+  SID_RegDirtySet(sid, (u32)1 << reg);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,61 @@
+// $Id$
+/*
+ * Access functions to network device
+ *
+ * There is no ENC28J60 on the host, accordingly the device is never
+ * available, and the uIP task stays in the "no network" state.
+ * OSC is not available in LINUX builds yet.
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+#include <mios32.h>
+#include "uip.h"
+#include "network-device.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+// locally administered address
+static u8 mac_addr[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Network Device Functions
+/////////////////////////////////////////////////////////////////////////////
+
+void network_device_init(void)
+{
+}
+
+void network_device_check(void)
+{
+}
+
+int network_device_available(void)
+{
+  return 0;
+}
+
+int network_device_read(void)
+{
+  return 0;
+}
+
+void network_device_send(void)
+{
+}
+
+
+unsigned char *network_device_mac_addr(void)
+{
+  return (unsigned char *)mac_addr;
+}
@@ -121,6 +121,9 @@ s32 OSC_SERVER_Init(u32 mode)
   ESP8266_UdpRxCallback_Init(OSC_SERVER_ESP8266_NotifyUdpPacket); // hook to notify received UDP packets
 #endif
 
+  // optional dispatch table for incoming packets (only available if MIOS32_OSC_DISPATCH_HASH_SIZE > 0)
+  MIOS32_OSC_DispatchCompile(parse_root);
+
   return 0; // no error
 }
 
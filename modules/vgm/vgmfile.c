@@ -39,12 +39,79 @@ static void BufferSkip(u32 bytes, u32* a, u32* bufstart, u8* buf){
         *bufstart = *a;
     }
 }
+static void BufferReadToken(VgmChipWriteCmd* cmd, u32* a, u32* bufstart, u8* buf){
+    //Reads the operands of a token file command, cmd->cmd already read
+    if(cmd->cmd == 0x50){
+        //PSG write
+        BufferRead(&cmd->data, 1, a, bufstart, buf);
+        if((cmd->data & 0x80) && !(cmd->data & 0x10) && (cmd->data < 0xE0)){
+            BufferRead(&cmd->data2, 1, a, bufstart, buf);
+        }
+    }else if((cmd->cmd & 0xFE) == 0x52){
+        //OPN2 write
+        BufferRead(&cmd->addr, 2, a, bufstart, buf);
+        if((cmd->addr & 0xF4) == 0xA4){
+            BufferRead(&cmd->data2, 1, a, bufstart, buf);
+        }
+    }else if(cmd->cmd >= 0x80 && cmd->cmd <= 0x8F){
+        //DAC and wait
+        cmd->addr = 0x2A;
+        BufferRead(&cmd->data, 1, a, bufstart, buf);
+    }else if(cmd->cmd == 0x61){
+        //Long wait
+        BufferRead(&cmd->data, 2, a, bufstart, buf);
+    }
+}
 static inline u32 ReadLittleEndianU32(u8* buf, u32 addr){
     return (u32)buf[addr+0] 
         | ((u32)buf[addr+1] << 8) 
         | ((u32)buf[addr+2] << 16) 
         | ((u32)buf[addr+3] << 24);
 }
+static s32 ReadTokenHeader(u8* buf, VgmFileMetadata* md){
+    if(ReadLittleEndianU32(buf, 0x04) != VGM_FILE_TOKENS_VERSION){
+        DBG("Token file version %d not supported!", ReadLittleEndianU32(buf, 0x04));
+        return -55;
+    }
+    md->format = VGM_FILE_FORMAT_TOKENS;
+    md->psgclock = ReadLittleEndianU32(buf, 0x08);
+    md->opn2clock = ReadLittleEndianU32(buf, 0x0C);
+    md->psgfreq0to1 = buf[0x10] & 1;
+    md->loopaddr = ReadLittleEndianU32(buf, 0x14);
+    md->loopsamples = ReadLittleEndianU32(buf, 0x18);
+    md->usage.all = ReadLittleEndianU32(buf, 0x20);
+    md->numcmds = md->numcmdsram = ReadLittleEndianU32(buf, 0x24);
+    md->vgmdatastartaddr = ReadLittleEndianU32(buf, 0x28);
+    if(md->vgmdatastartaddr < 0x40 || md->vgmdatastartaddr >= md->filesize){
+        DBG("Token file data offset 0x%X out of range!", md->vgmdatastartaddr);
+        return -55;
+    }
+    return 0;
+}
+static s32 ScanTokens(u8* buf, VgmFileMetadata* md){
+    //Header values are informational (vgm2vgt doesn't know the usage), scan
+    //the commands to get the usage and make sure the file is complete
+    u32 a = md->vgmdatastartaddr, bufstart;
+    VgmChipWriteCmd cmd;
+    md->usage.all = 0;
+    md->numcmds = 0;
+    FILE_ReadSeek(a); FILE_ReadBuffer(buf, VGM_SOURCESTREAM_BUFSIZE);
+    bufstart = a;
+    while(a < md->filesize){
+        cmd.all = 0;
+        BufferRead(&cmd.cmd, 1, &a, &bufstart, buf);
+        if(cmd.cmd == 0x66) break;
+        BufferReadToken(&cmd, &a, &bufstart, buf);
+        VGM_Cmd_UpdateUsage(&md->usage, cmd);
+        ++md->numcmds;
+    }
+    md->numcmdsram = md->numcmds;
+    if(cmd.cmd != 0x66){
+        DBG("VGM_File_ScanFile ran off end of token file!");
+        return -52;
+    }
+    return 0;
+}
 
 
 
@@ -62,6 +129,7 @@ s32 VGM_File_ScanFile(char* filename, VgmFileMetadata* md){
     md->psgclock = 0;
     md->psgfreq0to1 = 1;
     md->opn2clock = 0;
+    md->format = VGM_FILE_FORMAT_VGM;
     //Open file
     MUTEX_SDCARD_TAKE;
     s32 res = FILE_ReadOpen(&md->file, filename);
@@ -74,6 +142,24 @@ s32 VGM_File_ScanFile(char* filename, VgmFileMetadata* md){
     u8* buf = malloc(0x40); //DMA target, have to use normal malloc
     res = FILE_ReadBuffer(buf, 0x40);
     if(res < 0) goto Error_withBufferOpen;
+    if(buf[0] == 0x1F && buf[1] == 0x8B){
+        DBG("File is gzip compressed (vgz), not supported! Convert it with tools/vgm2vgt.");
+        res = -54;
+        goto Error_withBufferOpen;
+    }
+    if(buf[0] == 'V' && buf[1] == 'g' && buf[2] == 't' && buf[3] == ' '){
+        //Token file
+        res = ReadTokenHeader(buf, md);
+        if(res < 0) goto Error_withBufferOpen;
+        free(buf);
+        buf = malloc(VGM_SOURCESTREAM_BUFSIZE); //DMA target, have to use normal malloc
+        if(buf == NULL){
+            res = -50;
+            goto Error_Filesize;
+        }
+        res = ScanTokens(buf, md);
+        goto Error_withBufferOpen;
+    }
     if(buf[0] != 'V' || buf[1] != 'g' || buf[2] != 'm' || buf[3] != ' '){
         DBG("File doesn't have magic \"Vgm \" tag!");
         goto Error_withBufferOpen;
@@ -195,6 +281,7 @@ s32 VGM_File_StartStream(VgmSource* sourcestream, char* filepath, VgmFileMetadat
     vss->datalen = md->filesize;
     vss->vgmdatastartaddr = md->vgmdatastartaddr;
     vss->blocklen = md->totalblocksize;
+    vss->tokens = (md->format == VGM_FILE_FORMAT_TOKENS);
     //Copy filepath
     u8 len = strlen(filepath);
     vss->filepath = vgmh2_malloc(len+1);
@@ -266,6 +353,32 @@ Error_Opening:
     return res;
 }
 
+static s32 LoadRAMTokens(VgmSource* sourceram, VgmFileMetadata* md, u8* buf){
+    //Token files contain the commands the way they're stored in RAM
+    VgmSourceRAM* vsr = (VgmSourceRAM*)sourceram->data;
+    u32 a = md->vgmdatastartaddr, c = 0, bufstart;
+    VgmChipWriteCmd cmd;
+    sourceram->loopaddr = 0xFFFFFFFF;
+    FILE_ReadSeek(a); FILE_ReadBuffer(buf, VGM_SOURCESTREAM_BUFSIZE);
+    bufstart = a;
+    while(a < md->filesize && c < vsr->numcmds){
+        if(a == md->loopaddr){
+            //Loop point is a command index in RAM
+            sourceram->loopaddr = c;
+        }
+        cmd.all = 0;
+        BufferRead(&cmd.cmd, 1, &a, &bufstart, buf);
+        if(cmd.cmd == 0x66) break; //End of stream
+        BufferReadToken(&cmd, &a, &bufstart, buf);
+        vsr->cmds[c++] = cmd;
+    }
+    if(c < vsr->numcmds){
+        DBG("VGM_File_LoadRAM error: token file has too few commands!");
+        return -52;
+    }
+    return 0;
+}
+
 s32 VGM_File_LoadRAM(VgmSource* sourceram, VgmFileMetadata* md){
     if(sourceram == NULL) return -100;
     if(sourceram->type != VGM_SOURCE_TYPE_RAM) return -100;
@@ -277,6 +390,8 @@ s32 VGM_File_LoadRAM(VgmSource* sourceram, VgmFileMetadata* md){
         vsr->cmds = NULL;
         vsr->numcmds = 0;
     }
+    vsr->gapstart = 0;
+    vsr->gaplen = 0;
     //Copy data from metadata to source/sourceram
     sourceram->psgclock = md->psgclock;
     sourceram->opn2clock = md->opn2clock;
@@ -355,6 +470,10 @@ s32 VGM_File_LoadRAM(VgmSource* sourceram, VgmFileMetadata* md){
             goto Error_Inside;
         }
     }
+    if(md->format == VGM_FILE_FORMAT_TOKENS){
+        res = LoadRAMTokens(sourceram, md, buf);
+        goto Error_Inside;
+    }
     //Load VGM data
     a = md->vgmdatastartaddr;
     c = 0;
@@ -487,7 +606,7 @@ s32 VGM_File_SaveRAM(VgmSource* sourceram, char* filename){
     u8 type;
     VgmChipWriteCmd cmd;
     for(i=0; i<vsr->numcmds; ++i){
-        cmd = vsr->cmds[i];
+        cmd = VGM_SourceRAM_Cmd(vsr, i);
         type = cmd.cmd;
         if(type == 0x50){
             //PSG write
@@ -581,7 +700,7 @@ s32 VGM_File_SaveRAM(VgmSource* sourceram, char* filename){
         FILE_WriteWord(blocklen);
         for(i=0; i<vsr->numcmds; ++i){
             //Write block data
-            cmd = vsr->cmds[i];
+            cmd = VGM_SourceRAM_Cmd(vsr, i);
             type = cmd.cmd;
             if(type >= 0x80 && type <= 0x8F){
                 FILE_WriteByte(cmd.data);
@@ -594,7 +713,7 @@ s32 VGM_File_SaveRAM(VgmSource* sourceram, char* filename){
     //=============================Write VGM data===============================
     DBG("--Writing VGM data");
     for(i=0; i<vsr->numcmds; ++i){
-        cmd = vsr->cmds[i];
+        cmd = VGM_SourceRAM_Cmd(vsr, i);
         type = cmd.cmd;
         if(type == 0x50){
             //PSG write
@@ -649,3 +768,128 @@ s32 VGM_File_SaveRAM(VgmSource* sourceram, char* filename){
     return 0;
 }
 
+s32 VGM_File_SaveTokens(VgmSource* sourceram, char* filename){
+    if(sourceram == NULL) return -100;
+    if(sourceram->type != VGM_SOURCE_TYPE_RAM) return -100;
+    DBG("VGM_File_SaveTokens file %s", filename);
+    VgmSourceRAM* vsr = (VgmSourceRAM*)sourceram->data;
+    s32 res;
+    if(FILE_FileExists(filename)){
+        DBG("--Deleting existing file");
+        if((res = FILE_Remove(filename)) < 0) return res;
+    }
+    //===============================Scan data==================================
+    u32 datalen = 0, numtokens = 0, loopaddr = 0xFFFFFFFF, t = 0, i;
+    u8 type;
+    VgmChipWriteCmd cmd;
+    for(i=0; i<vsr->numcmds; ++i){
+        if(i == sourceram->loopaddr) loopaddr = 0x40 + datalen;
+        cmd = VGM_SourceRAM_Cmd(vsr, i);
+        type = cmd.cmd;
+        if(type == 0x50){
+            //PSG write
+            datalen += 2;
+            if((cmd.data & 0x80) && !(cmd.data & 0x10) && (cmd.data < 0xE0)){
+                //Frequency, LSB included
+                ++datalen;
+            }
+        }else if((type & 0xFE) == 0x52){
+            //OPN2 write
+            datalen += 3;
+            if((cmd.addr & 0xF4) == 0xA4){
+                //Frequency MSB write, LSB included
+                ++datalen;
+            }
+        }else if(type >= 0x80 && type <= 0x8F){
+            //OPN2 DAC write, sample included
+            datalen += 2;
+            t += type - 0x80;
+        }else if(type >= 0x70 && type <= 0x7F){
+            //Short wait
+            ++datalen;
+            t += type - 0x6F;
+        }else if(type == 0x61){
+            //Long wait
+            datalen += 3;
+            t += cmd.data | ((u32)cmd.data2 << 8);
+        }else if(type == 0x62){
+            //60 Hz wait
+            ++datalen;
+            t += VGM_DELAY62;
+        }else if(type == 0x63){
+            //50 Hz wait
+            ++datalen;
+            t += VGM_DELAY63;
+        }else{
+            //Unsupported command, not written
+            continue;
+        }
+        ++numtokens;
+    }
+    ++datalen; //0x66 End of Data command
+    DBG("--Data length %d (plus header), %d commands, total time %d", datalen, numtokens, t);
+    //===============================Open file==================================
+    if((res = FILE_UpdateFreeBytes()) < 0) return res;
+    if(FILE_VolumeBytesFree() < datalen + 0x40) return FILE_ERR_WRITECOUNT;
+    MUTEX_SDCARD_TAKE;
+    if((res = FILE_WriteOpen(filename, 1)) < 0){
+        MUTEX_SDCARD_GIVE;
+        return res;
+    }
+    //==============================Write header================================
+    FILE_WriteBuffer((u8*)"Vgt ", 4);
+    FILE_WriteWord(VGM_FILE_TOKENS_VERSION);
+    FILE_WriteWord(sourceram->psgclock);
+    FILE_WriteWord(sourceram->opn2clock);
+    FILE_WriteWord(sourceram->psgfreq0to1);
+    FILE_WriteWord(loopaddr);
+    FILE_WriteWord(sourceram->loopsamples);
+    FILE_WriteWord(t);
+    FILE_WriteWord(sourceram->usage.all);
+    FILE_WriteWord(numtokens);
+    FILE_WriteWord(0x40); //Data offset
+    for(i=0x2C; i<0x40; i+=4){
+        FILE_WriteWord(0);
+    }
+    //=============================Write commands===============================
+    DBG("--Writing commands");
+    for(i=0; i<vsr->numcmds; ++i){
+        cmd = VGM_SourceRAM_Cmd(vsr, i);
+        type = cmd.cmd;
+        if(type == 0x50){
+            //PSG write
+            FILE_WriteByte(type);
+            FILE_WriteByte(cmd.data);
+            if((cmd.data & 0x80) && !(cmd.data & 0x10) && (cmd.data < 0xE0)){
+                FILE_WriteByte(cmd.data2);
+            }
+        }else if((type & 0xFE) == 0x52){
+            //OPN2 write
+            FILE_WriteByte(type);
+            FILE_WriteByte(cmd.addr);
+            FILE_WriteByte(cmd.data);
+            if((cmd.addr & 0xF4) == 0xA4){
+                FILE_WriteByte(cmd.data2);
+            }
+        }else if(type >= 0x80 && type <= 0x8F){
+            //OPN2 DAC write
+            FILE_WriteByte(type);
+            FILE_WriteByte(cmd.data);
+        }else if(type == 0x61){
+            //Long wait
+            FILE_WriteByte(type);
+            FILE_WriteByte(cmd.data);
+            FILE_WriteByte(cmd.data2);
+        }else if((type >= 0x70 && type <= 0x7F) || type == 0x62 || type == 0x63){
+            //Other waits
+            FILE_WriteByte(type);
+        }
+    }
+    FILE_WriteByte(0x66); //End of Data
+    //==================================Done====================================
+    FILE_WriteClose();
+    MUTEX_SDCARD_GIVE;
+    DBG("--Done");
+    return 0;
+}
+
@@ -20,9 +20,42 @@
 #include "vgmstream.h"
 #include <file.h>
 
+/*
+Besides VGMs, files can be token files ("Vgt "), which contain the commands
+the way they are stored in VgmSourceRAM, so they can be streamed without any
+look-ahead and without keeping data blocks in RAM. They're written by
+VGM_File_SaveTokens() from a VGM loaded to RAM, or on the host by
+tools/vgm2vgt (which also reads vgz). Usage bits and number of commands in the
+header are informational, VGM_File_ScanFile() recomputes them.
+
+Header (0x40 bytes, little endian words):
+0x00 "Vgt "                     0x1C Total number of samples
+0x04 Version (1)                0x20 Usage bits (VgmUsageBits)
+0x08 PSG clock                  0x24 Number of commands
+0x0C OPN2 clock                 0x28 Data offset (absolute)
+0x10 Bit 0: psgfreq0to1         0x2C-0x3F reserved (0)
+0x14 Loop offset (absolute, 0xFFFFFFFF if none)
+0x18 Loop samples
+
+Each command is its type byte followed by the bytes it uses:
+0x50 dd [d2]        PSG write, d2 if dd is the first half of a frequency write
+0x52/0x53 aa dd [d2] OPN2 write, d2 (LSB) if aa is a frequency MSB register
+0x8n dd             DAC write of sample dd, then wait n samples
+0x61 ll hh          Long wait
+0x62, 0x63, 0x7n    Other waits, as in VGM
+0x66                End of data
+
+Gzip compressed VGMs (vgz) are not supported: inflating needs a 32k window
+per stream, which is more RAM than the whole stream buffer. Convert them with
+tools/vgm2vgt; token files are smaller than the VGM anyway.
+*/
+#define VGM_FILE_FORMAT_VGM 0
+#define VGM_FILE_FORMAT_TOKENS 1
+
+#define VGM_FILE_TOKENS_VERSION 1
 
 typedef union {
-    u8 ALL[sizeof(file_t)+44];
+    u8 ALL[sizeof(file_t)+48];
     struct{
         file_t file;
         u32 filesize;
@@ -41,6 +74,9 @@ typedef union {
         u32 psgclock:31;
         u8 psgfreq0to1:1;
         u32 opn2clock;
+        
+        u8 format;
+        u8 dummy[3];
     };
 } VgmFileMetadata;
 
@@ -51,6 +87,7 @@ extern s32 VGM_File_StartStream(VgmSource* sourcestream, char* filepath, VgmFile
 
 extern s32 VGM_File_LoadRAM(VgmSource* sourceram, VgmFileMetadata* md);
 extern s32 VGM_File_SaveRAM(VgmSource* sourceram, char* filename);
+extern s32 VGM_File_SaveTokens(VgmSource* sourceram, char* filename);
 
 
 
@@ -12,6 +12,7 @@
 
 
 #include "vgmhead.h"
+#include "vgmplayer.h"
 #include "vgmqueue.h"
 #include "vgmram.h"
 #include "vgmstream.h"
@@ -68,6 +69,7 @@ VgmHead* VGM_Head_Create(VgmSource* source, u32 freqmult, u32 tempomult){
     }
     vgm_heads[vgm_numheads] = head;
     ++vgm_numheads;
+    VGM_Player_Reschedule(head);
     MIOS32_IRQ_Enable();
     return head;
 }
@@ -78,6 +80,7 @@ s32 VGM_Head_Delete(VgmHead* head){
     u8 i;
     for(i=0; i<vgm_numheads; ++i){
         if(vgm_heads[i] == head){
+            VGM_Player_DeleteHead(i);
             for(; i<vgm_numheads-1; ++i){
                 vgm_heads[i] = vgm_heads[i+1];
             }
@@ -110,6 +113,7 @@ void VGM_Head_Restart(VgmHead* head, u32 vgm_time){
     }else if(head->source->type == VGM_SOURCE_TYPE_QUEUE){
         VGM_HeadQueue_Restart(head);
     }
+    VGM_Player_Reschedule(head);
 }
 void VGM_Head_cmdNext(VgmHead* head, u32 vgm_time){
     if(head == NULL) return;
@@ -18,8 +18,8 @@
 
 
 typedef struct {
-    u32 opn2_lastwritetime;
-    u32 psg_lastwritetime;
+    u32 opn2_busyuntil;
+    u32 psg_busyuntil;
 } vgmp_chipdata;
 
 static vgmp_chipdata chipdata[GENESIS_COUNT];
@@ -27,6 +27,204 @@ u8 VGM_Player_docapture;
 static u8 nextchiptocapture;
 static u32 lasttimecaptured;
 
+/*
+Scheduler: the ISR only touches heads which are actually due.
+- Waiting heads are in a min-heap keyed by the VGM time they're due at.
+- Heads with a pending chip write are in a FIFO per chip (OPN2 and PSG of
+  each Genesis), which is serviced once the busy-until time of the chip has
+  passed.
+- Finished and stopped heads are dropped when they come up.
+The structures contain indices into vgm_heads[]. A head which was started,
+restarted or re-timed from outside has to be passed to
+VGM_Player_Reschedule(); it's taken out and put back in at the next run.
+*/
+#define VGMP_NOHEAD 0xFF
+#define VGMP_NUMCHIPQUEUES (2*GENESIS_COUNT) //OPN2 at even, PSG at odd index
+
+typedef struct {
+    u8 heappos; //Position in sched_heap, VGMP_NOHEAD if not in there
+    u8 queue; //Chip queue, VGMP_NOHEAD if not in any
+    u8 next; //Links in chip queue
+    u8 prev;
+    u8 pending; //In sched_pending
+} vgmp_headsched;
+
+static vgmp_headsched hsched[VGM_HEAD_MAXNUM];
+static u8  sched_heap[VGM_HEAD_MAXNUM];
+static u32 sched_key[VGM_HEAD_MAXNUM];
+static u8  sched_heapsize;
+static u8  sched_first[VGMP_NUMCHIPQUEUES];
+static u8  sched_last[VGMP_NUMCHIPQUEUES];
+static u8  sched_pending[VGM_HEAD_MAXNUM];
+static volatile u8 sched_numpending;
+
+//Remaining busy time of a chip; a busy-until time in the past (including
+//wrapped ones after a long pause) returns 0
+static inline u32 BusyRemaining(u32 busyuntil){
+    u32 u = busyuntil - TIM2->CNT;
+    return (u <= VGMP_OPN2BUSYDELAY) ? u : 0;
+}
+
+static inline void HeapSet(u8 p, u8 i, u32 key){
+    sched_heap[p] = i;
+    sched_key[p] = key;
+    hsched[i].heappos = p;
+}
+//Puts head i into the hole at p, moving it up or down as needed
+static void HeapUp(u8 p, u8 i, u32 key){
+    u8 parent;
+    while(p > 0){
+        parent = (p - 1) >> 1;
+        if((s32)(sched_key[parent] - key) <= 0) break;
+        HeapSet(p, sched_heap[parent], sched_key[parent]);
+        p = parent;
+    }
+    HeapSet(p, i, key);
+}
+static void HeapDown(u8 p, u8 i, u32 key){
+    u8 c;
+    while((c = (p << 1) + 1) < sched_heapsize){
+        if(c + 1 < sched_heapsize && (s32)(sched_key[c+1] - sched_key[c]) < 0) ++c;
+        if((s32)(key - sched_key[c]) <= 0) break;
+        HeapSet(p, sched_heap[c], sched_key[c]);
+        p = c;
+    }
+    HeapSet(p, i, key);
+}
+static void HeapPush(u8 i, u32 key){
+    HeapUp(sched_heapsize++, i, key);
+}
+static void HeapRemove(u8 i){
+    u8 p = hsched[i].heappos;
+    hsched[i].heappos = VGMP_NOHEAD;
+    if(--sched_heapsize == p) return; //Was the last one
+    //Move the last one into the hole
+    u8 j = sched_heap[sched_heapsize];
+    u32 key = sched_key[sched_heapsize];
+    if(p > 0 && (s32)(key - sched_key[(p - 1) >> 1]) < 0){
+        HeapUp(p, j, key);
+    }else{
+        HeapDown(p, j, key);
+    }
+}
+
+static void QueueAppend(u8 i, u8 q){
+    hsched[i].queue = q;
+    hsched[i].next = VGMP_NOHEAD;
+    hsched[i].prev = sched_last[q];
+    if(sched_last[q] == VGMP_NOHEAD){
+        sched_first[q] = i;
+    }else{
+        hsched[sched_last[q]].next = i;
+    }
+    sched_last[q] = i;
+}
+static void QueueRemove(u8 i){
+    u8 q = hsched[i].queue, n = hsched[i].next, p = hsched[i].prev;
+    if(p == VGMP_NOHEAD){
+        sched_first[q] = n;
+    }else{
+        hsched[p].next = n;
+    }
+    if(n == VGMP_NOHEAD){
+        sched_last[q] = p;
+    }else{
+        hsched[n].prev = p;
+    }
+    hsched[i].queue = VGMP_NOHEAD;
+}
+
+static inline u8 ChipQueueOf(VgmChipWriteCmd cmd){
+    //Returns VGMP_NOHEAD for writes which can't be played (muted, unmapped)
+    u8 chip = (cmd.cmd >> 4), subcmd = (cmd.cmd & 0x0F);
+    if(chip >= GENESIS_COUNT || subcmd > 4 || subcmd == 1) return VGMP_NOHEAD;
+    return (chip << 1) | (subcmd == 0);
+}
+
+//Puts a head, which isn't scheduled, into the structure which matches its
+//current command
+static void Schedule(u8 i, u32 vgm_time){
+    VgmHead* h = vgm_heads[i];
+    u8 q;
+    while(h->playing && !h->isdone){
+        if(VGM_Head_cmdIsWait(h)){
+            HeapPush(i, h->ticks);
+            return;
+        }
+        if(!VGM_Head_cmdIsChipWrite(h)) return;
+        q = ChipQueueOf(h->writecmd);
+        if(q != VGMP_NOHEAD){
+            QueueAppend(i, q);
+            return;
+        }
+        //Skip writes which aren't played
+        VGM_Head_cmdNext(h, vgm_time);
+    }
+}
+static void Unschedule(u8 i){
+    if(hsched[i].heappos != VGMP_NOHEAD) HeapRemove(i);
+    if(hsched[i].queue != VGMP_NOHEAD) QueueRemove(i);
+}
+
+static void Schedule_Init(){
+    u8 i;
+    for(i=0; i<VGM_HEAD_MAXNUM; ++i){
+        hsched[i].heappos = VGMP_NOHEAD;
+        hsched[i].queue = VGMP_NOHEAD;
+        hsched[i].pending = 0;
+    }
+    for(i=0; i<VGMP_NUMCHIPQUEUES; ++i){
+        sched_first[i] = VGMP_NOHEAD;
+        sched_last[i] = VGMP_NOHEAD;
+    }
+    sched_heapsize = 0;
+    sched_numpending = 0;
+}
+
+void VGM_Player_Reschedule(VgmHead* head){
+    u8 i;
+    MIOS32_IRQ_Disable();
+    for(i=0; i<vgm_numheads; ++i){
+        if(vgm_heads[i] == head){
+            if(!hsched[i].pending){
+                hsched[i].pending = 1;
+                sched_pending[sched_numpending++] = i;
+            }
+            break;
+        }
+    }
+    MIOS32_IRQ_Enable();
+}
+
+static inline u8 Renumber(u8 x, u8 removed){
+    return (x != VGMP_NOHEAD && x > removed) ? (x - 1) : x;
+}
+void VGM_Player_DeleteHead(u8 i){
+    u8 j, k;
+    Unschedule(i);
+    for(j=0, k=0; j<sched_numpending; ++j){
+        if(sched_pending[j] != i) sched_pending[k++] = Renumber(sched_pending[j], i);
+    }
+    sched_numpending = k;
+    for(j=i; j+1<vgm_numheads; ++j){
+        hsched[j] = hsched[j+1];
+    }
+    hsched[j].heappos = VGMP_NOHEAD;
+    hsched[j].queue = VGMP_NOHEAD;
+    hsched[j].pending = 0;
+    for(j=0; j+1<vgm_numheads; ++j){
+        hsched[j].next = Renumber(hsched[j].next, i);
+        hsched[j].prev = Renumber(hsched[j].prev, i);
+    }
+    for(j=0; j<sched_heapsize; ++j){
+        sched_heap[j] = Renumber(sched_heap[j], i);
+    }
+    for(j=0; j<VGMP_NUMCHIPQUEUES; ++j){
+        sched_first[j] = Renumber(sched_first[j], i);
+        sched_last[j] = Renumber(sched_last[j], i);
+    }
+}
+
 u16 VgmPlayer_WorkCallback(){
     ////////////////////////////////////////////////////////////////////////
     // PLAY VGMS
@@ -37,81 +235,87 @@ u16 VgmPlayer_WorkCallback(){
     u32 minwait = 0xFFFFFFFF; s32 s; u32 u;
     u32 vgm_time = TIM5->CNT;
     VgmChipWriteCmd cmd;
-    u8 wrotetochip, chip, subcmd;
-    //Scan all VGMs for delays
-    u8 i;
-    for(i=0; i<vgm_numheads; ++i){
+    u8 wrotetochip, chip, q, i, k, numdue;
+    u8 due[VGM_HEAD_MAXNUM];
+    u32* busyuntil;
+    //Put heads which were changed from outside back in
+    while(sched_numpending > 0){
+        i = sched_pending[--sched_numpending];
+        hsched[i].pending = 0;
+        Unschedule(i);
+        Schedule(i, vgm_time);
+    }
+    //Take out all VGMs whose delay is over, then advance each of them once.
+    //A head which is due again right away (e.g. waiting for its stream
+    //buffer) is only handled on the next run, to give the tasks a chance.
+    numdue = 0;
+    while(sched_heapsize > 0 && (s32)(sched_key[0] - vgm_time) <= 0){
+        due[numdue++] = sched_heap[0];
+        HeapRemove(sched_heap[0]);
+    }
+    for(k=0; k<numdue; ++k){
+        i = due[k];
         h = vgm_heads[i];
-        if(h != NULL && h->playing){
-            //Check for delay
-            if(VGM_Head_cmdIsWait(h)){
-                s = VGM_Head_cmdGetWaitRemaining(h, vgm_time);
-                if(s <= 0){
-                    //Advance to next command
-                    VGM_Head_cmdNext(h, vgm_time);
-                }else{
-                    u = s * VGMP_HRTICKSPERSAMPLE;
-                    if(u < minwait){
-                        //Store it as the shortest remaining time
-                        minwait = u;
-                    }
-                }
+        if(!h->playing || h->isdone) continue;
+        if(VGM_Head_cmdIsWait(h)){
+            s = VGM_Head_cmdGetWaitRemaining(h, vgm_time);
+            if(s > 0){
+                //Has been re-timed in the meantime
+                HeapPush(i, h->ticks);
+                continue;
             }
+            VGM_Head_cmdNext(h, vgm_time);
         }
+        Schedule(i, vgm_time);
     }
-    //Scan all VGMs for pending chip write commands
+    //Play pending chip write commands while the chips aren't busy
     wrotetochip = 1;
     while(wrotetochip){
         wrotetochip = 0;
-        for(i=0; i<vgm_numheads; ++i){
-            h = vgm_heads[i];
-            if(h != NULL && h->playing){
-                //Check for command
-                if(VGM_Head_cmdIsChipWrite(h)){
-                    cmd = h->writecmd;
-                    chip = (cmd.cmd >> 4);
-                    subcmd = (cmd.cmd & 0x0F);
-                    if(chip >= GENESIS_COUNT || subcmd > 4 || subcmd == 1){
-                        VGM_Head_cmdNext(h, vgm_time);
-                        wrotetochip = 1;
-                    }else if(subcmd == 0){
-                        //PSG write
-                        u = TIM2->CNT - chipdata[chip].psg_lastwritetime;
-                        if(u < VGMP_PSGBUSYDELAY){
-                            u = VGMP_PSGBUSYDELAY - u;
-                            if(u < minwait){
-                                minwait = u;
-                            }
-                        }else{
-                            Genesis_PSGWrite(chip, cmd.data);
-                            VGM_Head_cmdNext(h, vgm_time);
-                            chipdata[chip].psg_lastwritetime = TIM2->CNT;
-                            wrotetochip = 1;
-                        }
+        for(q=0; q<VGMP_NUMCHIPQUEUES; ++q){
+            chip = q >> 1;
+            busyuntil = (q & 1) ? &chipdata[chip].psg_busyuntil : &chipdata[chip].opn2_busyuntil;
+            while((i = sched_first[q]) != VGMP_NOHEAD){
+                u = BusyRemaining(*busyuntil);
+                if(u > 0){
+                    if(u < minwait) minwait = u;
+                    break;
+                }
+                QueueRemove(i);
+                h = vgm_heads[i];
+                if(!h->playing || h->isdone) continue;
+                if(!VGM_Head_cmdIsChipWrite(h) || ChipQueueOf(h->writecmd) != q){
+                    //Has been changed in the meantime
+                    Schedule(i, vgm_time);
+                    continue;
+                }
+                cmd = h->writecmd;
+                if(q & 1){
+                    //PSG write
+                    Genesis_PSGWrite(chip, cmd.data);
+                    *busyuntil = TIM2->CNT + VGMP_PSGBUSYDELAY;
+                }else{
+                    //OPN2 write
+                    Genesis_OPN2Write(chip, (cmd.cmd & 0x01), cmd.addr, cmd.data);
+                    //Don't delay after 0x2x commands
+                    if(cmd.addr >= 0x20 && cmd.addr < 0x2F && cmd.addr != 0x28){
+                        *busyuntil = TIM2->CNT;
                     }else{
-                        //OPN2 write
-                        u = TIM2->CNT - chipdata[chip].opn2_lastwritetime;
-                        if(u < VGMP_OPN2BUSYDELAY){
-                            u = VGMP_OPN2BUSYDELAY - u;
-                            if(u < minwait){
-                                minwait = u;
-                            }
-                        }else{
-                            Genesis_OPN2Write(chip, (cmd.cmd & 0x01), cmd.addr, cmd.data);
-                            VGM_Head_cmdNext(h, vgm_time);
-                            //Don't delay after 0x2x commands
-                            if(cmd.addr >= 0x20 && cmd.addr < 0x2F && cmd.addr != 0x28){
-                                chipdata[chip].opn2_lastwritetime = TIM2->CNT - VGMP_OPN2BUSYDELAY;
-                            }else{
-                                chipdata[chip].opn2_lastwritetime = TIM2->CNT;
-                            }
-                            wrotetochip = 1;
-                        }
+                        *busyuntil = TIM2->CNT + VGMP_OPN2BUSYDELAY;
                     }
                 }
+                VGM_Head_cmdNext(h, vgm_time);
+                Schedule(i, vgm_time);
+                wrotetochip = 1;
             }
         }
     }
+    //Time until the next head is due
+    if(sched_heapsize > 0){
+        s = (s32)(sched_key[0] - vgm_time);
+        u = (s > 0) ? (s * VGMP_HRTICKSPERSAMPLE) : 0;
+        if(u < minwait) minwait = u;
+    }
     //Set up next delay
     if(minwait < 100){
         //TODO loop instead of returning and re-timing
@@ -119,7 +323,7 @@ u16 VgmPlayer_WorkCallback(){
     }else if(minwait > VGMP_MAXDELAY){
         if(VGM_Player_docapture 
                 && (TIM2->CNT - lasttimecaptured >= 30000)
-                && (TIM2->CNT - chipdata[nextchiptocapture].opn2_lastwritetime >= VGMP_OPN2BUSYDELAY)){
+                && BusyRemaining(chipdata[nextchiptocapture].opn2_busyuntil) == 0){
             //If we have plenty of time, capture some operator states
             Genesis_CaptureOPN2OpStates(nextchiptocapture);
             lasttimecaptured = TIM2->CNT;
@@ -151,6 +355,7 @@ void TIM3_IRQHandler(void){
 //#define TIM_PERIPHERAL_FRQ (MIOS32_SYS_CPU_FREQUENCY/2)
 
 void VGM_Player_Init(){
+    Schedule_Init();
     ////////////////////////////////////////////////////////////////////////////
     // Setup Timer 2: hr_time, max resolution (168 MHz / 2 = 84 MHz)
     ////////////////////////////////////////////////////////////////////////////
@@ -14,6 +14,7 @@
 #define _VGMPLAYER_H
 
 #include <mios32.h>
+#include "vgmhead.h"
 
 #define USE_GENESIS 3 //TODO
 
@@ -31,6 +32,15 @@ static inline u32 VGM_Player_GetVGMTime() { return TIM5->CNT; }
 
 // Call at startup
 extern void VGM_Player_Init();
+// Call after a head was started, restarted or re-timed from outside the player
+extern void VGM_Player_Reschedule(VgmHead* head);
+// Called by VGM_Head_Delete() with IRQs disabled, before vgm_heads[] is compacted
+extern void VGM_Player_DeleteHead(u8 index);
+
+// Masks the player interrupt (only this one), for short sections which
+// modify data read by the player (e.g. head addresses)
+static inline void VGM_Player_Lock() { NVIC_DisableIRQ(TIM3_IRQn); }
+static inline void VGM_Player_Unlock() { NVIC_EnableIRQ(TIM3_IRQn); }
 
 extern u8 VGM_Player_docapture;
 
@@ -95,40 +95,42 @@ void VGM_HeadRAM_Restart(VgmHead* head){
     VgmHeadRAM* vhr = (VgmHeadRAM*)head->data;
     head->srcaddr = head->source->markstart;
     head->isdone = 0;
-    vhr->bufferedcmd = vsr->cmds[head->srcaddr];
+    vhr->bufferedcmd = VGM_SourceRAM_Cmd(vsr, head->srcaddr);
     VGM_HeadRAM_SetUpBufferedCmd(head, vhr);
 }
+u8 VGM_HeadRAM_cmdSecondOfTwo(VgmHead* head, VgmHeadRAM* vhr){
+    head->firstoftwo = 0;
+    if(vhr->bufferedcmd.cmd == 0x50){
+        //Second PSG frequency write
+        head->writecmd.cmd = 0x00;
+        head->writecmd.data = vhr->bufferedcmd.data2;
+        head->iswrite = 1;
+        VGM_Head_doMapping(head, &(head->writecmd));
+        return 1;
+    }else if((vhr->bufferedcmd.cmd & 0xFE) == 0x52){
+        //Second OPN2 frequency write
+        head->writecmd.cmd = 0x02 | (vhr->bufferedcmd.cmd & 0x01);
+        head->writecmd.addr = vhr->bufferedcmd.addr & 0xFB; //A4 -> A0
+        head->writecmd.data = vhr->bufferedcmd.data2;
+        head->iswrite = 1;            
+        VGM_Head_doMapping(head, &(head->writecmd));
+        return 1;
+    }else if((vhr->bufferedcmd.cmd & 0xF0) == 0x80){
+        //Wait after a sample
+        head->iswait = 1;
+        head->ticks += vhr->bufferedcmd.cmd - 0x80;
+        return 1;
+    }
+    //Otherwise there wasn't actually a second command...?
+    return 0;
+}
 void VGM_HeadRAM_cmdNext(VgmHead* head, u32 vgm_time){
     if(head->isdone) return;
     VgmSourceRAM* vsr = (VgmSourceRAM*)head->source->data;
     VgmHeadRAM* vhr = (VgmHeadRAM*)head->data;
     head->iswait = 0;
     head->iswrite = 0;
-    if(head->firstoftwo){
-        head->firstoftwo = 0;
-        if(vhr->bufferedcmd.cmd == 0x50){
-            //Second PSG frequency write
-            head->writecmd.cmd = 0x00;
-            head->writecmd.data = vhr->bufferedcmd.data2;
-            head->iswrite = 1;
-            VGM_Head_doMapping(head, &(head->writecmd));
-            return;
-        }else if((vhr->bufferedcmd.cmd & 0xFE) == 0x52){
-            //Second OPN2 frequency write
-            head->writecmd.cmd = 0x02 | (vhr->bufferedcmd.cmd & 0x01);
-            head->writecmd.addr = vhr->bufferedcmd.addr & 0xFB; //A4 -> A0
-            head->writecmd.data = vhr->bufferedcmd.data2;
-            head->iswrite = 1;            
-            VGM_Head_doMapping(head, &(head->writecmd));
-            return;
-        }else if((vhr->bufferedcmd.cmd & 0xF0) == 0x80){
-            //Wait after a sample
-            head->iswait = 1;
-            head->ticks += vhr->bufferedcmd.cmd - 0x80;
-            return;
-        }
-        //Otherwise there wasn't actually a second command...?
-    }
+    if(head->firstoftwo && VGM_HeadRAM_cmdSecondOfTwo(head, vhr)) return;
     //Read new command
     ++head->srcaddr;
     if(head->srcaddr > head->source->markend){
@@ -148,7 +150,7 @@ void VGM_HeadRAM_cmdNext(VgmHead* head, u32 vgm_time){
             return;
         }
     }
-    vhr->bufferedcmd = vsr->cmds[head->srcaddr];
+    vhr->bufferedcmd = VGM_SourceRAM_Cmd(vsr, head->srcaddr);
     VGM_HeadRAM_SetUpBufferedCmd(head, vhr);
 }
 
@@ -168,6 +170,8 @@ VgmSource* VGM_SourceRAM_Create(){
     source->data = vsr;
     vsr->cmds = NULL;
     vsr->numcmds = 0;
+    vsr->gapstart = 0;
+    vsr->gaplen = 0;
     return source;
 }
 void VGM_SourceRAM_Delete(void* sourceram){
@@ -183,35 +187,75 @@ void VGM_SourceRAM_UpdateUsage(VgmSource* source){
     source->usage.all = 0;
     u32 a;
     for(a=0; a<vsr->numcmds; ++a){
-        VGM_Cmd_UpdateUsage(&source->usage, vsr->cmds[a]);
+        VGM_Cmd_UpdateUsage(&source->usage, VGM_SourceRAM_Cmd(vsr, a));
     }
     VGM_Cmd_DebugPrintUsage(source->usage);
 }
 
+//Reallocates the commands with a gap of at least mingap slots at the end.
+//The copy is done before the player sees the new array, so it keeps playing.
+static s32 ResizeGap(VgmSourceRAM* vsr, u32 mingap){
+    u32 newgap = vsr->numcmds >> 3;
+    if(newgap < mingap) newgap = mingap;
+    VgmChipWriteCmd* newcmds = vgmh2_malloc((vsr->numcmds + newgap)*sizeof(VgmChipWriteCmd));
+    if(newcmds == NULL) return -1;
+    u32 a;
+    for(a=0; a<vsr->numcmds; ++a){
+        newcmds[a] = VGM_SourceRAM_Cmd(vsr, a);
+    }
+    VgmChipWriteCmd* oldcmds = vsr->cmds;
+    VGM_Player_Lock();
+    vsr->cmds = newcmds;
+    vsr->gapstart = vsr->numcmds;
+    vsr->gaplen = newgap;
+    VGM_Player_Unlock();
+    if(oldcmds != NULL) vgmh2_free(oldcmds);
+    return 0;
+}
+
+//Moves the gap to the given address. Each step copies one command to the
+//other side of the gap before the gap start is changed, so the player
+//always sees valid data and doesn't have to be locked.
+static void MoveGap(VgmSourceRAM* vsr, u32 addr){
+    u32 gs;
+    if(vsr->gaplen == 0){
+        vsr->gapstart = addr;
+        return;
+    }
+    while(vsr->gapstart > addr){
+        gs = vsr->gapstart - 1;
+        vsr->cmds[gs + vsr->gaplen] = vsr->cmds[gs];
+        __DMB();
+        vsr->gapstart = gs;
+    }
+    while(vsr->gapstart < addr){
+        gs = vsr->gapstart;
+        vsr->cmds[gs] = vsr->cmds[gs + vsr->gaplen];
+        __DMB();
+        vsr->gapstart = gs + 1;
+    }
+}
+
 void VGM_SourceRAM_InsertCmd(VgmSource* source, u32 addr, VgmChipWriteCmd newcmd){
-    MIOS32_IRQ_Disable();
     VgmSourceRAM* vsr = (VgmSourceRAM*)source->data;
     if(addr > vsr->numcmds) addr = vsr->numcmds;
-    //Allocate additional memory
-    vsr->cmds = vgmh2_realloc(vsr->cmds, (vsr->numcmds+1)*sizeof(VgmChipWriteCmd));
-    if(vsr->cmds == NULL){
-        DBG("Out of memory trying to enlarge VgmSourceRAM! Crashing soon!");
-        vsr->numcmds = 0;
-        MIOS32_IRQ_Enable();
+    //Allocate additional memory if the gap is used up
+    if(vsr->gaplen == 0 && ResizeGap(vsr, VGM_SOURCERAM_MINGAP) < 0){
+        DBG("Out of memory trying to enlarge VgmSourceRAM!");
         return;
     }
-    //Move later data
-    u32 a;
-    for(a=vsr->numcmds; a>addr; --a){
-        vsr->cmds[a].all = vsr->cmds[a-1].all;
-    }
-    //Insert new data
-    vsr->cmds[addr] = newcmd;
+    MoveGap(vsr, addr);
+    //Store new data at the end of the gap, it becomes visible when the gap shrinks
+    vsr->cmds[addr + vsr->gaplen - 1] = newcmd;
+    __DMB();
+    VGM_Player_Lock();
     //Change length
+    --vsr->gaplen;
     ++vsr->numcmds;
     if(source->markstart >= addr && addr > 0) source->markstart++;
     if(source->markend >= addr && source->markend < 0xFFFFFFFF) source->markend++;
     //Move any heads playing this forward by one command
+    u32 a;
     VgmHead* head;
     for(a=0; a<VGM_HEAD_MAXNUM; ++a){
         head = vgm_heads[a];
@@ -219,24 +263,20 @@ void VGM_SourceRAM_InsertCmd(VgmSource* source, u32 addr, VgmChipWriteCmd newcmd
             if(head->srcaddr >= addr && addr > 0) ++head->srcaddr;
         }
     }
-    MIOS32_IRQ_Enable();
+    VGM_Player_Unlock();
 }
 void VGM_SourceRAM_DeleteCmd(VgmSource* source, u32 addr){
-    MIOS32_IRQ_Disable();
     VgmSourceRAM* vsr = (VgmSourceRAM*)source->data;
     if(addr >= vsr->numcmds) return;
-    //Move later data
-    u32 a;
-    for(a=addr; a<vsr->numcmds-1; ++a){
-        vsr->cmds[a].all = vsr->cmds[a+1].all;
-    }
-    //Change length
+    MoveGap(vsr, addr);
+    VGM_Player_Lock();
+    //Change length, the gap swallows the command
+    ++vsr->gaplen;
     --vsr->numcmds;
     if(source->markstart > addr) source->markstart--;
     if(source->markend > addr && source->markend < 0xFFFFFFFF) source->markend--;
-    //Deallocate extra memory
-    vsr->cmds = vgmh2_realloc(vsr->cmds, vsr->numcmds*sizeof(VgmChipWriteCmd));
     //Move any heads playing this backward by one command
+    u32 a;
     VgmHead* head;
     for(a=0; a<VGM_HEAD_MAXNUM; ++a){
         head = vgm_heads[a];
@@ -244,7 +284,11 @@ void VGM_SourceRAM_DeleteCmd(VgmSource* source, u32 addr){
             if(head->srcaddr > addr) --head->srcaddr;
         }
     }
-    MIOS32_IRQ_Enable();
+    VGM_Player_Unlock();
+    //Deallocate extra memory if the gap got too large
+    if(vsr->gaplen > 4*VGM_SOURCERAM_MINGAP && vsr->gaplen > (vsr->numcmds >> 2)){
+        ResizeGap(vsr, VGM_SOURCERAM_MINGAP);
+    }
 }
 
 static void PlayCommandNow(VgmHead* head, VgmSourceRAM* vsr, VgmHeadRAM* vhr, VgmChipWriteCmd cmd){
@@ -286,7 +330,7 @@ s32 VGM_HeadRAM_Forward1(VgmHead* head){
         return -1;
     }
     //Play the current command, which should be buffered in head->writecmd
-    PlayCommandNow(head, vsr, vhr, vsr->cmds[head->srcaddr]);
+    PlayCommandNow(head, vsr, vhr, VGM_SourceRAM_Cmd(vsr, head->srcaddr));
     //Forward one command
     ++head->srcaddr;
     //If we would now be going off the end, don't loop back
@@ -296,7 +340,7 @@ s32 VGM_HeadRAM_Forward1(VgmHead* head){
         return 0;
     }
     //Otherwise, prepare the next command
-    vhr->bufferedcmd = vsr->cmds[head->srcaddr];
+    vhr->bufferedcmd = VGM_SourceRAM_Cmd(vsr, head->srcaddr);
     VGM_HeadRAM_SetUpBufferedCmd(head, vhr);
     return 0;
 }
@@ -311,14 +355,14 @@ s32 VGM_HeadRAM_Backward1(VgmHead* head){
     //Back one command
     --head->srcaddr;
     head->isdone = 0;
-    VgmChipWriteCmd curcmd = vsr->cmds[head->srcaddr];
+    VgmChipWriteCmd curcmd = VGM_SourceRAM_Cmd(vsr, head->srcaddr);
     //Find the most recent command before this one, which this one overwrote the state of
     s32 a; u8 flag = 0;
     VgmChipWriteCmd oldcmd;
     if(curcmd.cmd >= 0x80 && curcmd.cmd <= 0x8F) curcmd.cmd = 0x52; //Turn DAC sample into regular DAC write
     if(curcmd.cmd == 0x50){
         for(a=(s32)head->srcaddr-1; a>=0; --a){
-            oldcmd = vsr->cmds[a];
+            oldcmd = VGM_SourceRAM_Cmd(vsr, a);
             //Has to be PSG Write command
             if(oldcmd.cmd != 0x50) continue;
             //Has to be the same address
@@ -345,7 +389,7 @@ s32 VGM_HeadRAM_Backward1(VgmHead* head){
         }
     }else if((curcmd.cmd & 0xFE) == 0x52){
         for(a=(s32)head->srcaddr-1; a>=0; --a){
-            oldcmd = vsr->cmds[a];
+            oldcmd = VGM_SourceRAM_Cmd(vsr, a);
             if(oldcmd.cmd >= 0x80 && oldcmd.cmd <= 0x8F) oldcmd.cmd = 0x52; //Turn DAC sample into regular DAC write
             //Has to be OPN2 Write command with the same addrhi
             if(oldcmd.cmd != curcmd.cmd) continue;
@@ -373,7 +417,7 @@ s32 VGM_HeadRAM_Backward1(VgmHead* head){
         }
     }
     //Prepare the next command
-    vhr->bufferedcmd = vsr->cmds[head->srcaddr];
+    vhr->bufferedcmd = VGM_SourceRAM_Cmd(vsr, head->srcaddr);
     VGM_HeadRAM_SetUpBufferedCmd(head, vhr);
     return 0;
 }
@@ -424,7 +468,7 @@ s32 VGM_HeadRAM_ForwardState(VgmHead* head, u32 maxt, u32 maxdt, u8 allowstay){
     u32 totalt = 0, thist;
     u32 origsrcaddr = head->srcaddr;
     while(head->srcaddr < vsr->numcmds){
-        cmd = vsr->cmds[head->srcaddr];
+        cmd = VGM_SourceRAM_Cmd(vsr, head->srcaddr);
         thist = GetWaitTime(cmd);
         if(state == 0){
             if(thist == 0 || (cmd.cmd >= 0x80 && cmd.cmd <= 0x8F)){
@@ -459,7 +503,7 @@ s32 VGM_HeadRAM_BackwardState(VgmHead* head, u32 maxt, u32 maxdt){
     u32 totalt = 0, thist;
     u32 origsrcaddr = head->srcaddr;
     while(head->srcaddr > 0){
-        cmd = vsr->cmds[head->srcaddr-1];
+        cmd = VGM_SourceRAM_Cmd(vsr, head->srcaddr-1);
         thist = GetWaitTime(cmd);
         if(state == 0){
             totalt += thist;
@@ -15,6 +15,13 @@
  * PSG write (same for frequency command), sample+wait (0x80-0x8F, except the
  * actual command for the sample write is in addr and data), and all the timing
  * comamnds. All other commands are ignored.
+ *
+ * The array is a gap buffer: after the commands were edited, the unused
+ * slots (the gap) are located at the last edit position, so that inserting
+ * and deleting commands around this position doesn't require to move the
+ * rest of the array. Accordingly commands have to be accessed with
+ * VGM_SourceRAM_Cmd(); cmds[] can only be indexed directly if gaplen is 0,
+ * which is the case after a VGM file has been loaded.
  */
 
 #ifndef _VGMRAM_H
@@ -35,6 +42,9 @@ extern VgmHeadRAM* VGM_HeadRAM_Create(VgmSource* source);
 extern void VGM_HeadRAM_Delete(void* headram);
 extern void VGM_HeadRAM_Restart(VgmHead* head);
 extern void VGM_HeadRAM_cmdNext(VgmHead* head, u32 vgm_time);
+//Also used by VgmSourceStream heads to play token files
+extern void VGM_HeadRAM_SetUpBufferedCmd(VgmHead* head, VgmHeadRAM* vhr);
+extern u8 VGM_HeadRAM_cmdSecondOfTwo(VgmHead* head, VgmHeadRAM* vhr);
 
 extern s32 VGM_HeadRAM_Forward1(VgmHead* head);
 extern s32 VGM_HeadRAM_Backward1(VgmHead* head);
@@ -43,13 +53,26 @@ extern s32 VGM_HeadRAM_ForwardState(VgmHead* head, u32 maxt, u32 maxdt, u8 allow
 extern s32 VGM_HeadRAM_BackwardState(VgmHead* head, u32 maxt, u32 maxdt);
 
 typedef union {
-    u8 ALL[8];
+    u8 ALL[16];
     struct{
         VgmChipWriteCmd* cmds;
-        u32 numcmds;
+        u32 numcmds; //Number of commands, not including the gap
+        u32 gapstart; //Index of the first unused slot
+        u32 gaplen; //Number of unused slots
     };
 } VgmSourceRAM;
 
+//Minimum number of slots allocated when the gap is used up; the gap grows
+//with 1/8 of the number of commands for long VGMs
+#ifndef VGM_SOURCERAM_MINGAP
+#define VGM_SOURCERAM_MINGAP 32
+#endif
+
+static inline u32 VGM_SourceRAM_PhysAddr(VgmSourceRAM* vsr, u32 addr){
+    return (addr < vsr->gapstart) ? addr : (addr + vsr->gaplen);
+}
+#define VGM_SourceRAM_Cmd(vsr, addr) ((vsr)->cmds[VGM_SourceRAM_PhysAddr((vsr), (addr))])
+
 extern VgmSource* VGM_SourceRAM_Create();
 extern void VGM_SourceRAM_Delete(void* sourceram);
 
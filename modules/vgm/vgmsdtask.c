@@ -13,6 +13,7 @@
 
 #include "vgmsdtask.h"
 #include "vgmhead.h"
+#include "vgmplayer.h"
 #include "vgmstream.h"
 
 #include <FreeRTOS.h>
@@ -22,34 +23,58 @@
 #include <semphr.h>
 
 #define VGM_SDTASK_PRIORITY 3
+//Samples per task period (1 ms)
+#define VGM_SDTASK_TICKSAMPLES 44
 
 xSemaphoreHandle xSDCardSemaphore;
 
 u8 vgm_sdtask_disable;
 u8 vgm_sdtask_usingsdcard;
 
+//Average time to load one buffer, in samples
+static u32 loadtime;
+
 static void VGM_SDTask(void* pvParameters){
     portTickType xLastExecutionTime;
     xLastExecutionTime = xTaskGetTickCount();
-    u8 i, fi = 0;
+    u8 i, numwanting;
+    u32 slack, minslack, t;
     VgmHead* vh;
+    VgmHead* next;
     while(1){
         vTaskDelayUntil(&xLastExecutionTime, 1 / portTICK_RATE_MS);
-        i = fi;
-        while(1){
-            if(vgm_sdtask_disable){
-                fi = i; //start back where you are now
-                break; //stop immediately
-            }
+        for(i=0; i<vgm_numheads; ++i){
             vh = vgm_heads[i];
-            if(vh != NULL){
-                if(vh->playing && vh->source->type == VGM_SOURCE_TYPE_STREAM){
-                    VGM_HeadStream_BackgroundBuffer(vh);
+            if(vh != NULL && vh->playing && vh->source->type == VGM_SOURCE_TYPE_STREAM){
+                VGM_HeadStream_UpdateRate(vh, VGM_Player_GetVGMTime());
+            }
+        }
+        //Load one buffer at a time, for the head which runs out of data first.
+        //Heads which can wait until the next period, even if all the other
+        //waiting heads are loaded first, are deferred, so the card is free
+        //for other tasks.
+        while(!vgm_sdtask_disable){
+            next = NULL;
+            minslack = 0xFFFFFFFF;
+            numwanting = 0;
+            for(i=0; i<vgm_numheads; ++i){
+                vh = vgm_heads[i];
+                if(vh != NULL && vh->playing && vh->source->type == VGM_SOURCE_TYPE_STREAM){
+                    slack = VGM_HeadStream_GetSlack(vh);
+                    if(slack == 0xFFFFFFFF) continue;
+                    ++numwanting;
+                    if(slack < minslack){
+                        minslack = slack;
+                        next = vh;
+                    }
                 }
             }
-            ++i;
-            if(i >= vgm_numheads) i = 0;
-            if(i == fi) break; //Have done them all
+            if(next == NULL) break; //Have done them all
+            if(minslack > loadtime * numwanting + VGM_SDTASK_TICKSAMPLES) break; //Defer
+            t = VGM_Player_GetVGMTime();
+            VGM_HeadStream_BackgroundBuffer(next);
+            t = VGM_Player_GetVGMTime() - t;
+            loadtime = (loadtime * 3 + t + 3) >> 2;
         }
     }
 }
@@ -58,5 +83,6 @@ void VGM_SDTask_Init(){
     xSDCardSemaphore = xSemaphoreCreateRecursiveMutex();
     vgm_sdtask_disable = 0;
     vgm_sdtask_usingsdcard = 0;
+    loadtime = VGM_SDTASK_TICKSAMPLES;
     xTaskCreate(VGM_SDTask, "VGM_SD", configMINIMAL_STACK_SIZE, NULL, VGM_SDTASK_PRIORITY, NULL);
 }
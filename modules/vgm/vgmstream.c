@@ -55,6 +55,10 @@ VgmHeadStream* VGM_HeadStream_Create(VgmSource* source){
     vhs->buffer2addr = 0xFFFFFFFF;
     vhs->wantbuffer = 0;
     vhs->wantbufferaddr = 0;
+    vhs->token.bufferedcmd.all = 0;
+    vhs->ratetime = VGM_Player_GetVGMTime();
+    vhs->rateaddr = 0;
+    vhs->rate = VGM_HEADSTREAM_DEFAULTRATE;
     return vhs;
 }
 void VGM_HeadStream_Delete(void* headstream){
@@ -73,12 +77,104 @@ void VGM_HeadStream_Restart(VgmHead* head){
     vhs->buffer2addr = 0xFFFFFFFF;
     vhs->wantbufferaddr = head->srcaddr;
     vhs->wantbuffer = 1;
+    vhs->ratetime = VGM_Player_GetVGMTime();
+    vhs->rateaddr = head->srcaddr;
+    head->firstoftwo = 0;
     DBG("HeadStream_Restart srcaddr=%d", head->srcaddr);
     VGM_HeadStream_cmdNext(head, VGM_Player_GetVGMTime());
 }
+//Checks if the next command can be read from the buffers. If not, sets up
+//the buffer to be loaded and turns the command into a wait.
+u8 VGM_HeadStream_checkBuffer(VgmHead* head, VgmHeadStream* vhs){
+    //Check if we're about to run out of buffer
+    if(head->srcaddr >= vhs->buffer1addr && head->srcaddr < (vhs->buffer1addr + VGM_SOURCESTREAM_BUFSIZE)){
+        //We're in buffer1
+        if((vhs->buffer1addr + VGM_SOURCESTREAM_BUFSIZE - head->srcaddr) < VGM_HEADSTREAM_SUBBUFFER_MAXLEN 
+                && vhs->buffer2addr != (vhs->buffer1addr + VGM_SOURCESTREAM_BUFSIZE)){
+            //About to run out of buffer1, and buffer2 isn't ready
+            vhs->wantbufferaddr = (vhs->buffer1addr + VGM_SOURCESTREAM_BUFSIZE);
+            vhs->wantbuffer = 2; //in case you didn't know already
+            head->iswait = 1; //Act as a wait for 0 (or negative) time
+            return 0; //Report that the command couldn't be loaded
+        }
+    }else if(head->srcaddr >= vhs->buffer2addr && head->srcaddr < (vhs->buffer2addr + VGM_SOURCESTREAM_BUFSIZE)){
+        //We're in buffer2
+        if((vhs->buffer2addr + VGM_SOURCESTREAM_BUFSIZE - head->srcaddr) < VGM_HEADSTREAM_SUBBUFFER_MAXLEN 
+                && vhs->buffer1addr != (vhs->buffer2addr + VGM_SOURCESTREAM_BUFSIZE)){
+            //About to run out of buffer2, and buffer1 isn't ready
+            vhs->wantbufferaddr = (vhs->buffer2addr + VGM_SOURCESTREAM_BUFSIZE);
+            vhs->wantbuffer = 1; //in case you didn't know already
+            head->iswait = 1; //Act as a wait for 0 (or negative) time
+            return 0; //Report that the command couldn't be loaded
+        }
+    }else{
+        //We're not in either buffer
+        vhs->wantbufferaddr = head->srcaddr;
+        vhs->wantbuffer = 1; //in case you didn't know already
+        head->iswait = 1; //Act as a wait for 0 (or negative) time
+        return 0; //Report that the command couldn't be loaded
+    }
+    return 1;
+}
+//Token files contain the commands like VgmSourceRAM, so they're played
+//with the same code, and there's nothing to look ahead for.
+u8 VGM_HeadStream_cmdNextToken(VgmHead* head, VgmHeadStream* vhs, VgmSourceStream* vss){
+    VgmChipWriteCmd* cmd = &(vhs->token.bufferedcmd);
+    u8 type;
+    head->iswait = head->iswrite = 0;
+    if(head->isdone) return 1;
+    if(head->firstoftwo && VGM_HeadRAM_cmdSecondOfTwo(head, &(vhs->token))) return 1;
+    if(!VGM_HeadStream_checkBuffer(head, vhs)) return 0;
+    if(head->srcaddr > head->source->markend){
+        head->isdone = 1;
+        return 1;
+    }
+    type = VGM_HeadStream_getByte(vss, vhs, head->srcaddr++);
+    if(type == 0x66){
+        //End of data
+        if(head->source->loopaddr >= vss->vgmdatastartaddr && head->source->loopaddr < vss->datalen){
+            //Jump to loop point
+            head->srcaddr = head->source->loopaddr;
+            vhs->wantbufferaddr = head->srcaddr;
+            vhs->wantbuffer = 1;
+            head->iswait = 1; //Act as a wait for 0 (or negative) time
+            return 0; //Report that the command couldn't be loaded
+        }
+        //Behaves like endless stream of 65535-tick waits
+        head->isdone = 1;
+        return 1;
+    }
+    cmd->all = 0;
+    cmd->cmd = type;
+    if(type == 0x50){
+        //PSG write, with second half if frequency
+        cmd->data = VGM_HeadStream_getByte(vss, vhs, head->srcaddr++);
+        if((cmd->data & 0x80) && !(cmd->data & 0x10) && (cmd->data < 0xE0)){
+            cmd->data2 = VGM_HeadStream_getByte(vss, vhs, head->srcaddr++);
+        }
+    }else if((type & 0xFE) == 0x52){
+        //OPN2 write, with LSB if frequency MSB write
+        cmd->addr = VGM_HeadStream_getByte(vss, vhs, head->srcaddr++);
+        cmd->data = VGM_HeadStream_getByte(vss, vhs, head->srcaddr++);
+        if((cmd->addr & 0xF4) == 0xA4){
+            cmd->data2 = VGM_HeadStream_getByte(vss, vhs, head->srcaddr++);
+        }
+    }else if(type >= 0x80 && type <= 0x8F){
+        //DAC and wait, with sample
+        cmd->addr = 0x2A;
+        cmd->data = VGM_HeadStream_getByte(vss, vhs, head->srcaddr++);
+    }else if(type == 0x61){
+        //Long wait
+        cmd->data = VGM_HeadStream_getByte(vss, vhs, head->srcaddr++);
+        cmd->data2 = VGM_HeadStream_getByte(vss, vhs, head->srcaddr++);
+    }
+    VGM_HeadRAM_SetUpBufferedCmd(head, &(vhs->token));
+    return 1;
+}
 u8 VGM_HeadStream_cmdNext(VgmHead* head, u32 vgm_time){
     VgmHeadStream* vhs = (VgmHeadStream*)head->data;
     VgmSourceStream* vss = (VgmSourceStream*)head->source->data;
+    if(vss->tokens) return VGM_HeadStream_cmdNextToken(head, vhs, vss);
     u8 type, cmdlen;
     head->iswait = head->iswrite = 0;
     u8 dontunbuffer;
@@ -96,34 +192,7 @@ u8 VGM_HeadStream_cmdNext(VgmHead* head, u32 vgm_time){
             head->iswait = 1; //Act as a wait for 0 (or negative) time
             return 0; //Report that the command couldn't be loaded
         }else if(vhs->subbufferlen == 0){
-            //Check if we're about to run out of buffer
-            if(head->srcaddr >= vhs->buffer1addr && head->srcaddr < (vhs->buffer1addr + VGM_SOURCESTREAM_BUFSIZE)){
-                //We're in buffer1
-                if((vhs->buffer1addr + VGM_SOURCESTREAM_BUFSIZE - head->srcaddr) < VGM_HEADSTREAM_SUBBUFFER_MAXLEN 
-                        && vhs->buffer2addr != (vhs->buffer1addr + VGM_SOURCESTREAM_BUFSIZE)){
-                    //About to run out of buffer1, and buffer2 isn't ready
-                    vhs->wantbufferaddr = (vhs->buffer1addr + VGM_SOURCESTREAM_BUFSIZE);
-                    vhs->wantbuffer = 2; //in case you didn't know already
-                    head->iswait = 1; //Act as a wait for 0 (or negative) time
-                    return 0; //Report that the command couldn't be loaded
-                }
-            }else if(head->srcaddr >= vhs->buffer2addr && head->srcaddr < (vhs->buffer2addr + VGM_SOURCESTREAM_BUFSIZE)){
-                //We're in buffer2
-                if((vhs->buffer2addr + VGM_SOURCESTREAM_BUFSIZE - head->srcaddr) < VGM_HEADSTREAM_SUBBUFFER_MAXLEN 
-                        && vhs->buffer1addr != (vhs->buffer2addr + VGM_SOURCESTREAM_BUFSIZE)){
-                    //About to run out of buffer2, and buffer1 isn't ready
-                    vhs->wantbufferaddr = (vhs->buffer2addr + VGM_SOURCESTREAM_BUFSIZE);
-                    vhs->wantbuffer = 1; //in case you didn't know already
-                    head->iswait = 1; //Act as a wait for 0 (or negative) time
-                    return 0; //Report that the command couldn't be loaded
-                }
-            }else{
-                //We're not in either buffer
-                vhs->wantbufferaddr = head->srcaddr;
-                vhs->wantbuffer = 1; //in case you didn't know already
-                head->iswait = 1; //Act as a wait for 0 (or negative) time
-                return 0; //Report that the command couldn't be loaded
-            }
+            if(!VGM_HeadStream_checkBuffer(head, vhs)) return 0;
         }
         if(head->srcaddr > head->source->markend){
             head->isdone = 1;
@@ -325,6 +394,38 @@ void VGM_HeadStream_BackgroundBuffer(VgmHead* head){
         *addrto = vhs->wantbufferaddr;
     }
 }
+void VGM_HeadStream_UpdateRate(VgmHead* head, u32 vgm_time){
+    VgmHeadStream* vhs = (VgmHeadStream*)head->data;
+    u32 dt = vgm_time - vhs->ratetime;
+    if(dt < VGM_HEADSTREAM_RATEPERIOD) return;
+    u32 addr = head->srcaddr;
+    //Skip measurements across jumps (loops, restarts) and long pauses
+    if(addr >= vhs->rateaddr && (addr - vhs->rateaddr) < 0x00100000 
+            && dt < (VGM_HEADSTREAM_RATEPERIOD << 4)){
+        //Average with the previous rate
+        vhs->rate = (vhs->rate + (((addr - vhs->rateaddr) << 10) / dt)) >> 1;
+    }
+    vhs->ratetime = vgm_time;
+    vhs->rateaddr = addr;
+}
+u32 VGM_HeadStream_GetSlack(VgmHead* head){
+    //Returns the number of samples until the head runs out of buffered data,
+    //0 if it's already waiting for data, 0xFFFFFFFF if nothing is to be loaded
+    VgmHeadStream* vhs = (VgmHeadStream*)head->data;
+    if(!vhs->wantbuffer) return 0xFFFFFFFF;
+    u32 addr = head->srcaddr, left;
+    if(addr >= vhs->buffer1addr && addr < (vhs->buffer1addr + VGM_SOURCESTREAM_BUFSIZE)){
+        left = vhs->buffer1addr + VGM_SOURCESTREAM_BUFSIZE - addr;
+    }else if(addr >= vhs->buffer2addr && addr < (vhs->buffer2addr + VGM_SOURCESTREAM_BUFSIZE)){
+        left = vhs->buffer2addr + VGM_SOURCESTREAM_BUFSIZE - addr;
+    }else{
+        return 0;
+    }
+    //The head stalls when less than a subbuffer is left
+    if(left <= VGM_HEADSTREAM_SUBBUFFER_MAXLEN) return 0;
+    left -= VGM_HEADSTREAM_SUBBUFFER_MAXLEN;
+    return (left << 10) / (vhs->rate + 1);
+}
 
 VgmSource* VGM_SourceStream_Create(){
     VgmSource* source = vgmh2_malloc(sizeof(VgmSource));
@@ -345,6 +446,7 @@ VgmSource* VGM_SourceStream_Create(){
     vss->vgmdatastartaddr = 0;
     vss->block = NULL;
     vss->blocklen = 0;
+    vss->tokens = 0;
     return source;
 }
 void VGM_SourceStream_Delete(void* sourcestream){
@@ -16,6 +16,7 @@
 #include <mios32.h>
 #include "vgmsource.h"
 #include "vgmhead.h"
+#include "vgmram.h"
 #include <file.h>
 
 #ifndef VGM_SOURCESTREAM_BUFSIZE
@@ -24,8 +25,17 @@
 
 #define VGM_HEADSTREAM_SUBBUFFER_MAXLEN 16
 
+//Period in samples over which the data rate of a stream is measured
+#ifndef VGM_HEADSTREAM_RATEPERIOD
+#define VGM_HEADSTREAM_RATEPERIOD 4410
+#endif
+//Rate assumed until it's been measured, in bytes per 1024 samples
+#ifndef VGM_HEADSTREAM_DEFAULTRATE
+#define VGM_HEADSTREAM_DEFAULTRATE 1024
+#endif
+
 typedef union {
-    u8 ALL[28+VGM_HEADSTREAM_SUBBUFFER_MAXLEN];
+    u8 ALL[44+VGM_HEADSTREAM_SUBBUFFER_MAXLEN];
     struct{
         u32 srcblockaddr;
         
@@ -40,11 +50,16 @@ typedef union {
         u8 wantbuffer;
         u16 dummy2;
         u32 wantbufferaddr;
+        
+        VgmHeadRAM token; //Current command of a token file
+        u32 ratetime;
+        u32 rateaddr;
+        u32 rate; //Bytes per 1024 samples
     };
 } VgmHeadStream;
 
 typedef union {
-    u8 ALL[20+sizeof(file_t)];
+    u8 ALL[24+sizeof(file_t)];
     struct{
         file_t file;
         char* filepath;
@@ -54,6 +69,10 @@ typedef union {
         
         u8* block;
         u32 blocklen;
+        
+        u8 tokens:1; //File is a token file (see vgmfile.h), not a VGM
+        u8 dummy1:7;
+        u8 dummy2[3];
     };
 } VgmSourceStream;
 
@@ -64,6 +83,8 @@ extern void VGM_HeadStream_Restart(VgmHead* head);
 extern u8 VGM_HeadStream_cmdNext(VgmHead* head, u32 vgm_time);
 extern u8 VGM_HeadStream_getByte(VgmSourceStream* vss, VgmHeadStream* vhs, u32 addr);
 extern void VGM_HeadStream_BackgroundBuffer(VgmHead* head);
+extern void VGM_HeadStream_UpdateRate(VgmHead* head, u32 vgm_time);
+extern u32 VGM_HeadStream_GetSlack(VgmHead* head);
 
 extern VgmSource* VGM_SourceStream_Create();
 extern void VGM_SourceStream_Delete(void* sourcestream);
@@ -67,6 +67,8 @@
 
 #if defined(MIOS32_FAMILY_STM32F4xx)
 #define WS2812_SUPPORTED 1
+#elif defined(MIOS32_FAMILY_LINUX)
+#define WS2812_SUPPORTED 0 // no LEDs on the host
 #else
 #warning "WS2812 driver not supported for this derivative yet!"
 #define WS2812_SUPPORTED 0
@@ -99,7 +101,9 @@
 // Local variables
 /////////////////////////////////////////////////////////////////////////////
 
+#if WS2812_SUPPORTED
 static u16 send_buffer[WS2812_BUFFER_SIZE];
+#endif
 
 /////////////////////////////////////////////////////////////////////////////
 // Local Prototypes
@@ -31,7 +31,9 @@
 // External Prototypes
 /////////////////////////////////////////////////////////////////////////////
 
+#if !defined(MIOS32_FAMILY_LINUX)
 extern void __libc_init_array(void);  /* calls CTORS of static objects */
+#endif
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -151,8 +153,11 @@ int main(void)
   MIOS32_I2S_Init(0);
 #endif
 
+#if !defined(MIOS32_FAMILY_LINUX)
   // call C++ constructors
+  // (LINUX: already done by the C runtime of the host)
   __libc_init_array();
+#endif
 
   // initialize application
   APP_Init();
@@ -423,6 +428,9 @@ void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackT
 #endif
 
 
+// the LINUX family uses the C runtime of the host, hard faults are reported as signals
+#if !defined(MIOS32_FAMILY_LINUX)
+
 /////////////////////////////////////////////////////////////////////////////
 // _exit() for newer newlib versions
 /////////////////////////////////////////////////////////////////////////////
@@ -524,6 +532,8 @@ void HardFault_Handler(void)
   __asm("B HardFault_Handler_c");
 }
 
+#endif /* !MIOS32_FAMILY_LINUX */
+
 // used if configCHECK_FOR_STACK_OVERFLOW enabled (set to 1 or 2) in FreeRTOSConfig.h
 #if configCHECK_FOR_STACK_OVERFLOW
 void vApplicationStackOverflowHook(xTaskHandle xTask, signed portCHAR *pcTaskName)
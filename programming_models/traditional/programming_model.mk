@@ -5,6 +5,25 @@
 
 # where is FreeRTOS located
 
+ifeq ($(FAMILY),LINUX)
+# FreeRTOS API emulation based on pthreads (see $(MIOS32_PATH)/mios32/LINUX/README.txt)
+FREE_RTOS      =    $(MIOS32_PATH)/mios32/LINUX/FreeRTOS
+
+# extend include path
+C_INCLUDE += 	-I $(MIOS32_PATH)/programming_models/traditional \
+		-I $(FREE_RTOS)/Source/include \
+		-I $(FREE_RTOS)/Source/portable/GCC/LINUX \
+
+# add modules to thumb sources
+# (C library and C++ runtime of the host are used)
+THUMB_SOURCE += \
+		$(MIOS32_PATH)/programming_models/traditional/main.c \
+		$(FREE_RTOS)/Source/tasks.c \
+		$(FREE_RTOS)/Source/queue.c \
+		$(FREE_RTOS)/Source/portable/GCC/LINUX/port.c
+
+else
+
 FREE_RTOS      =    $(MIOS32_PATH)/FreeRTOS
 
 # extend include path
@@ -40,6 +59,8 @@ endif
 THUMB_CPP_SOURCE += $(MIOS32_PATH)/programming_models/traditional/mini_cpp.cpp \
 		    $(MIOS32_PATH)/programming_models/traditional/freertos_heap.cpp
 
+endif
+
 # add MIOS32 sources
 include $(MIOS32_PATH)/mios32/mios32.mk
 
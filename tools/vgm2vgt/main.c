@@ -0,0 +1,379 @@
+// $Id$
+/*
+ * VGM -> VGM token file converter
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 Ricard Wanderlof (polluxsynth@midibox.org)
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <zlib.h>
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// see modules/vgm/vgmfile.h
+#define TOKENS_VERSION     1
+#define TOKENS_HEADER_SIZE 0x40
+
+#define VGM_DELAY62 735
+#define VGM_DELAY63 882
+
+// a command in the same format like VgmChipWriteCmd of modules/vgm
+typedef struct {
+  uint8_t cmd;
+  uint8_t addr;
+  uint8_t data;
+  uint8_t data2;
+} token_t;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+static uint8_t *vgm;
+static uint32_t vgm_len;
+
+static uint8_t *block;
+static uint32_t block_len;
+
+static token_t *tokens;
+static uint32_t num_tokens;
+static uint32_t max_tokens;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Helpers
+/////////////////////////////////////////////////////////////////////////////
+
+static uint32_t ReadU32(uint32_t addr)
+{
+  if( addr + 4 > vgm_len )
+    return 0;
+  return (uint32_t)vgm[addr+0] | ((uint32_t)vgm[addr+1] << 8) | ((uint32_t)vgm[addr+2] << 16) | ((uint32_t)vgm[addr+3] << 24);
+}
+
+static uint8_t ReadU8(uint32_t addr)
+{
+  return (addr < vgm_len) ? vgm[addr] : 0x66; // runs into "end of data"
+}
+
+static void WriteU32(FILE *f, uint32_t word)
+{
+  fputc(word & 0xff, f);
+  fputc((word >> 8) & 0xff, f);
+  fputc((word >> 16) & 0xff, f);
+  fputc((word >> 24) & 0xff, f);
+}
+
+// number of bytes past the type, see VGM_Cmd_GetCmdLen() of modules/vgm
+static uint8_t CmdLen(uint8_t type)
+{
+  if( (type & 0xfe) == 0x52 || type == 0x61 ) return 2;
+  if( type == 0x50 ) return 1;
+  if( type >= 0x70 && type <= 0x8f ) return 0;
+  if( type == 0x64 ) return 3;
+  if( type >= 0x62 && type <= 0x66 ) return 0;
+  if( type == 0x67 ) return 6;
+  if( type == 0xe0 ) return 4;
+  if( type == 0x90 || type == 0x91 || type == 0x95 ) return 4;
+  if( type == 0x92 ) return 5;
+  if( type == 0x93 ) return 10;
+  if( type == 0x94 ) return 1;
+  if( type == 0x68 ) return 11;
+  if( type >= 0x30 && type <= 0x3f ) return 1;
+  if( (type >= 0x40 && type <= 0x4e) || (type >= 0xa0 && type <= 0xbf) ) return 2;
+  if( type >= 0xc0 && type <= 0xdf ) return 3;
+  if( type >= 0xe1 ) return 4;
+  return 0;
+}
+
+static token_t *NewToken(uint8_t type)
+{
+  if( num_tokens >= max_tokens ) {
+    max_tokens = max_tokens ? 2*max_tokens : 4096;
+    tokens = (token_t *)realloc(tokens, max_tokens * sizeof(token_t));
+    if( tokens == NULL ) {
+      fprintf(stderr, "ERROR: out of memory!\n");
+      exit(1);
+    }
+  }
+  token_t *t = &tokens[num_tokens++];
+  memset(t, 0, sizeof(token_t));
+  t->cmd = type;
+  return t;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Reads a .vgm or .vgz file (zlib reads uncompressed files transparently)
+/////////////////////////////////////////////////////////////////////////////
+static int ReadFile(const char *filename)
+{
+  gzFile f = gzopen(filename, "rb");
+  if( f == NULL ) {
+    fprintf(stderr, "ERROR: can't open '%s'\n", filename);
+    return -1;
+  }
+
+  uint32_t size = 0;
+  int n;
+  do {
+    if( vgm_len + 65536 > size ) {
+      size = size ? 2*size : 65536;
+      vgm = (uint8_t *)realloc(vgm, size);
+      if( vgm == NULL ) {
+        fprintf(stderr, "ERROR: out of memory!\n");
+        gzclose(f);
+        return -1;
+      }
+    }
+    n = gzread(f, vgm + vgm_len, 65536);
+    if( n > 0 )
+      vgm_len += n;
+  } while( n > 0 );
+
+  if( n < 0 ) {
+    int err;
+    fprintf(stderr, "ERROR: reading '%s' failed: %s\n", filename, gzerror(f, &err));
+    gzclose(f);
+    return -1;
+  }
+
+  gzclose(f);
+  return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Converts the commands like VGM_File_LoadRAM() does
+// returns the token index of the loop point in *loop_token (or 0xffffffff)
+/////////////////////////////////////////////////////////////////////////////
+static int Convert(uint32_t start, uint32_t loop_addr, uint32_t *loop_token, uint32_t *total_samples)
+{
+  uint32_t a, blockaddr = 0;
+  int32_t lastpsgfreqwrite = -1, lastopn2freqwrite = -1;
+  uint8_t type;
+
+  // collect data blocks
+  for(a=start; a < vgm_len; a += 1 + CmdLen(type)) {
+    type = vgm[a];
+    if( type == 0x66 )
+      break;
+    if( type == 0x67 ) {
+      uint32_t len = ReadU32(a+3);
+      if( a + 7 + len > vgm_len ) {
+        fprintf(stderr, "ERROR: data block of %u bytes at 0x%x exceeds the file!\n", len, a);
+        return -1;
+      }
+      block = (uint8_t *)realloc(block, block_len + len);
+      memcpy(block + block_len, vgm + a + 7, len);
+      block_len += len;
+      a += len;
+    }
+  }
+
+  *loop_token = 0xffffffff;
+  *total_samples = 0;
+  for(a=start; a < vgm_len; ) {
+    if( *loop_token == 0xffffffff && a >= loop_addr )
+      *loop_token = num_tokens;
+
+    type = ReadU8(a);
+    uint8_t b1 = ReadU8(a+1);
+    uint8_t b2 = ReadU8(a+2);
+
+    if( type == 0x66 ) {
+      break;
+    } else if( type == 0x67 ) {
+      a += 7 + ReadU32(a+3);
+      continue;
+    } else if( type == 0xe0 ) {
+      blockaddr = ReadU32(a+1);
+    } else if( type == 0x50 ) {
+      if( !(b1 & 0x80) ) {
+        // second half of freq write
+        if( lastpsgfreqwrite < 0 ) {
+          fprintf(stderr, "WARNING: second half of PSG freq write with no first half at 0x%x\n", a);
+        } else {
+          tokens[lastpsgfreqwrite].data2 = b1;
+          lastpsgfreqwrite = -1;
+        }
+      } else {
+        token_t *t = NewToken(type);
+        t->data = b1;
+        if( !(b1 & 0x10) && b1 < 0xe0 )
+          lastpsgfreqwrite = num_tokens - 1; // first half of freq write
+      }
+    } else if( (type & 0xfe) == 0x52 ) {
+      if( (b1 & 0xf4) == 0xa0 ) {
+        // second half of freq write
+        if( lastopn2freqwrite < 0 ) {
+          fprintf(stderr, "WARNING: second half of OPN2 freq write with no first half at 0x%x\n", a);
+        } else {
+          tokens[lastopn2freqwrite].data2 = b2;
+          lastopn2freqwrite = -1;
+        }
+      } else {
+        token_t *t = NewToken(type);
+        t->addr = b1;
+        t->data = b2;
+        if( (b1 & 0xf4) == 0xa4 )
+          lastopn2freqwrite = num_tokens - 1; // first half of freq write
+      }
+    } else if( type >= 0x80 && type <= 0x8f ) {
+      token_t *t = NewToken(type);
+      t->addr = 0x2a;
+      t->data = (blockaddr < block_len) ? block[blockaddr] : 0x80;
+      ++blockaddr;
+      *total_samples += type - 0x80;
+    } else if( type >= 0x70 && type <= 0x7f ) {
+      NewToken(type);
+      *total_samples += type - 0x6f;
+    } else if( type == 0x62 || type == 0x63 ) {
+      NewToken(type);
+      *total_samples += (type == 0x62) ? VGM_DELAY62 : VGM_DELAY63;
+    } else if( type == 0x61 ) {
+      token_t *t = NewToken(type);
+      t->data = b1;
+      t->data2 = b2;
+      *total_samples += b1 | ((uint32_t)b2 << 8);
+    }
+    // all other commands are dropped, like VGM_File_LoadRAM() does
+
+    a += 1 + CmdLen(type);
+  }
+
+  return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Writes the token file like VGM_File_SaveTokens() does
+/////////////////////////////////////////////////////////////////////////////
+static int WriteTokens(const char *filename, uint32_t psgclock, uint32_t opn2clock, uint8_t psgfreq0to1,
+                       uint32_t loop_token, uint32_t loop_samples, uint32_t total_samples)
+{
+  FILE *f = fopen(filename, "wb");
+  if( f == NULL ) {
+    fprintf(stderr, "ERROR: can't create '%s'\n", filename);
+    return -1;
+  }
+
+  // determine the offset of the loop token
+  uint32_t i, offset = TOKENS_HEADER_SIZE, loop_addr = 0xffffffff;
+  for(i=0; i<num_tokens; ++i) {
+    token_t *t = &tokens[i];
+    if( i == loop_token )
+      loop_addr = offset;
+    offset += 1;
+    if( t->cmd == 0x50 )
+      offset += ((t->data & 0x80) && !(t->data & 0x10) && t->data < 0xe0) ? 2 : 1;
+    else if( (t->cmd & 0xfe) == 0x52 )
+      offset += ((t->addr & 0xf4) == 0xa4) ? 3 : 2;
+    else if( (t->cmd & 0xf0) == 0x80 )
+      offset += 1;
+    else if( t->cmd == 0x61 )
+      offset += 2;
+  }
+
+  fwrite("Vgt ", 1, 4, f);
+  WriteU32(f, TOKENS_VERSION);
+  WriteU32(f, psgclock);
+  WriteU32(f, opn2clock);
+  WriteU32(f, psgfreq0to1);
+  WriteU32(f, loop_addr);
+  WriteU32(f, loop_samples);
+  WriteU32(f, total_samples);
+  WriteU32(f, 0); // usage bits: determined by VGM_File_ScanFile()
+  WriteU32(f, num_tokens);
+  WriteU32(f, TOKENS_HEADER_SIZE);
+  for(i=0x2c; i<TOKENS_HEADER_SIZE; i+=4)
+    WriteU32(f, 0);
+
+  for(i=0; i<num_tokens; ++i) {
+    token_t *t = &tokens[i];
+    fputc(t->cmd, f);
+    if( t->cmd == 0x50 ) {
+      fputc(t->data, f);
+      if( (t->data & 0x80) && !(t->data & 0x10) && t->data < 0xe0 )
+        fputc(t->data2, f);
+    } else if( (t->cmd & 0xfe) == 0x52 ) {
+      fputc(t->addr, f);
+      fputc(t->data, f);
+      if( (t->addr & 0xf4) == 0xa4 )
+        fputc(t->data2, f);
+    } else if( (t->cmd & 0xf0) == 0x80 ) {
+      fputc(t->data, f);
+    } else if( t->cmd == 0x61 ) {
+      fputc(t->data, f);
+      fputc(t->data2, f);
+    }
+  }
+  fputc(0x66, f);
+
+  if( fclose(f) != 0 ) {
+    fprintf(stderr, "ERROR: writing '%s' failed!\n", filename);
+    return -1;
+  }
+
+  printf("%s: %u commands, %u bytes (VGM: %u bytes uncompressed, %u bytes data blocks)\n",
+         filename, num_tokens, offset + 1, vgm_len, block_len);
+  return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Main
+/////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+  if( argc != 3 ) {
+    fprintf(stderr, "SYNTAX: %s <input.vgm|input.vgz> <output.vgt>\n", argv[0]);
+    return 1;
+  }
+
+  if( ReadFile(argv[1]) < 0 )
+    return 1;
+
+  if( vgm_len <= 0x40 || memcmp(vgm, "Vgm ", 4) != 0 ) {
+    fprintf(stderr, "ERROR: '%s' is not a VGM file!\n", argv[1]);
+    return 1;
+  }
+
+  // header, like VGM_File_ScanFile()
+  uint32_t psgclock = ReadU32(0x0c);
+  uint32_t loop_addr = ReadU32(0x1c) ? (ReadU32(0x1c) + 0x1c) : 0xffffffff;
+  uint32_t loop_samples = ReadU32(0x20);
+  uint32_t opn2clock = ReadU32(0x2c);
+  uint8_t psgfreq0to1 = (~vgm[0x2b]) & 1;
+  if( opn2clock == 0 )
+    psgfreq0to1 = 0; // probably a SMS
+  uint32_t version = ReadU32(0x08);
+  uint32_t start = (version < 0x150 || ReadU32(0x34) == 0) ? 0x40 : (ReadU32(0x34) + 0x34);
+
+  uint32_t loop_token, total_samples;
+  if( Convert(start, loop_addr, &loop_token, &total_samples) < 0 )
+    return 1;
+
+  if( WriteTokens(argv[2], psgclock, opn2clock, psgfreq0to1, loop_token, loop_samples, total_samples) < 0 )
+    return 1;
+
+  return 0;
+}